@@ -60,6 +60,8 @@ typedef enum {
 	nvethmgr_get_status,
 	nvethmgr_verify_ts,
 	nvethmgr_get_avb_perf,
+	handle_ioctl_compact,
+	handle_ioctl_batch,
 }ivc_cmd;
 
 /**
@@ -98,6 +100,116 @@ typedef struct {
 	nveu32_t tx_fifo_size;
 } ivc_core_args;
 
+/**
+ * @brief Length of the IPv4 address of OSI_CMD_ARP_OFFLOAD in compact
+ * ioctl messages
+ */
+#define IVC_ARP_IP_LEN	4U
+
+/**
+ * @brief Scalar arguments of osi_ioctl carried by compact ioctl messages.
+ * Pointer arguments are only valid in the address space of the guest and
+ * are not carried, see ivc_ioctl_pack().
+ */
+typedef struct {
+	/** ioctl command */
+	nveu32_t cmd;
+	/** arg1_u32 of osi_ioctl */
+	nveu32_t arg1_u32;
+	/** arg2_u32 of osi_ioctl */
+	nveu32_t arg2_u32;
+	/** arg3_u32 of osi_ioctl */
+	nveu32_t arg3_u32;
+	/** arg4_u32 of osi_ioctl */
+	nveu32_t arg4_u32;
+	/** arg5_u64 of osi_ioctl */
+	nveul64_t arg5_u64;
+	/** arg6_32 of osi_ioctl */
+	nve32_t arg6_32;
+	/** arg8_64 of osi_ioctl */
+	nvel64_t arg8_64;
+} ivc_ioctl_args;
+
+/**
+ * @brief Compact ioctl payload of handle_ioctl_compact messages. Only the
+ * osi_ioctl member used by the command follows the scalar arguments, so
+ * messages are sized to the command instead of to osi_ioctl.
+ */
+typedef struct {
+	/** Scalar arguments */
+	ivc_ioctl_args args;
+	/** osi_ioctl member used by args.cmd, see ivc_ioctl_pack() */
+	union {
+		/** L2 filter */
+		struct osi_filter l2_filter;
+		/** L3/L4 filter */
+		struct osi_l3_l4_filter l3l4_filter;
+		/** HW features */
+		struct osi_hw_features hw_feat;
+		/** AVB algorithm */
+		struct osi_core_avb_algorithm avb;
+#ifndef OSI_STRIPPED_LIB
+		/** VLAN filter */
+		struct osi_vlan_filter vlan_filter;
+		/** PTP offload config */
+		struct osi_pto_config pto_config;
+		/** RXQ route */
+		struct osi_rxq_route rxq_route;
+		/** Flow steering rule */
+		struct osi_flow_rule flow_rule;
+		/** RSS rebalance */
+		struct osi_rss_rebalance rss_rebalance;
+		/** RSS profile */
+		struct osi_rss_profile rss_profile;
+		/** IPv4 address of OSI_CMD_ARP_OFFLOAD, by value of arg7_u8_p */
+		nveu8_t arp_ip[IVC_ARP_IP_LEN];
+#endif /* !OSI_STRIPPED_LIB */
+		/** FRP command */
+		struct osi_core_frp_cmd frp_cmd;
+		/** EST config */
+		struct osi_est_config est;
+		/** FPE config */
+		struct osi_fpe_config fpe;
+		/** PTP config */
+		struct osi_ptp_config ptp_config;
+		/** TX timestamp */
+		struct osi_core_tx_ts tx_ts;
+		/** PTP TSC data */
+		struct osi_core_ptp_tsc_data ptp_tsc;
+	} m;
+} ivc_ioctl_compact;
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief Maximum number of ioctls in one batch message
+ */
+#define IVC_BATCH_MAX	16U
+
+/**
+ * @brief Size of batch message buffer for compact ioctl payloads. Keeps
+ * ivc_ioctl_batch within the size of struct osi_ioctl, so that batches
+ * don't grow ivc_msg_common_t.
+ */
+#define IVC_BATCH_BUF	1536U
+
+/**
+ * @brief Batch payload of handle_ioctl_batch messages. buf holds num
+ * compact ioctl payloads back to back, each one starting 8 byte aligned.
+ * Response has the same layout, with outputs and status of each command.
+ */
+typedef struct {
+	/** Number of ioctls */
+	nveu32_t num;
+	/** Length of compact payload of each ioctl */
+	nveu32_t len[IVC_BATCH_MAX];
+	/** Return value of each ioctl, set in response */
+	nve32_t status[IVC_BATCH_MAX];
+	/** Compact ioctl payloads, 8 byte words so that each payload can be
+	 * accessed in place */
+	nveu64_t buf[IVC_BATCH_BUF / 8U];
+} ivc_ioctl_batch;
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief macsec config structure.
  */
@@ -134,8 +246,13 @@ typedef struct ivc_msg_common {
 
 	/** IVC argument structure */
 	ivc_args args;
+	/** Number of valid bytes of data, in request and in response */
+	nveu32_t data_len;
+	/** Request ID echoed in response, 0 for synchronous requests */
+	nveu32_t req_id;
 
-	union {
+	/** Payload, only the member used by cmd is valid */
+	union ivc_msg_data {
 		/** avb algorithm structure */
 		struct osi_core_avb_algorithm avb_algo;
 		/** OSI filter structure */
@@ -150,6 +267,12 @@ typedef struct ivc_msg_common {
 		ivc_core_args init_args;
 		/** ioctl command structure */
 		struct osi_ioctl ioctl_data;
+		/** compact ioctl command structure */
+		ivc_ioctl_compact ioctl_c;
+#ifndef OSI_STRIPPED_LIB
+		/** batch of compact ioctl commands */
+		ivc_ioctl_batch ioctl_b;
+#endif /* !OSI_STRIPPED_LIB */
 #ifdef MACSEC_SUPPORT
 		/** lut config */
 		struct osi_macsec_lut_config lut_config;
@@ -169,12 +292,173 @@ typedef struct ivc_msg_common {
 	}data;
 } ivc_msg_common_t;
 
+/**
+ * @brief Length of IVC message header, i.e. bytes in front of data. An IVC
+ * message is IVC_MSG_HDR_LEN + data_len bytes long.
+ */
+#define IVC_MSG_HDR_LEN	((nveu32_t)(sizeof(ivc_msg_common_t) - \
+				    sizeof(union ivc_msg_data)))
+
+/**
+ * @brief ivc_ioctl_pack - Encode an ioctl into compact ioctl payload.
+ *
+ * Algorithm: Copy scalar arguments and the osi_ioctl member used by the
+ * command, OSI_CMD_ASYNC_START uses the member of the command it starts.
+ * arg7_u8_p is not carried, the IPv4 address it points to for
+ * OSI_CMD_ARP_OFFLOAD is copied into c->m.arp_ip.
+ *
+ * @param[in] data: OSI IOCTL data structure.
+ * @param[out] c: Compact ioctl payload.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: Yes
+ * - De-initialization: Yes
+ *
+ * @retval Number of valid bytes of c.
+ */
+nveu32_t ivc_ioctl_pack(struct osi_ioctl *data, ivc_ioctl_compact *c);
+
+/**
+ * @brief ivc_ioctl_unpack - Decode compact ioctl payload into an ioctl.
+ *
+ * Algorithm: Copy scalar arguments and the osi_ioctl member used by the
+ * command, other members of data and arg7_u8_p are left untouched.
+ *
+ * @param[in] c: Compact ioctl payload.
+ * @param[in] len: Number of valid bytes of c.
+ * @param[out] data: OSI IOCTL data structure.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: Yes
+ * - De-initialization: Yes
+ *
+ * @retval 0 on success
+ * @retval -1 if len is too short for the command.
+ */
+nve32_t ivc_ioctl_unpack(const ivc_ioctl_compact *c, const nveu32_t len,
+			 struct osi_ioctl *data);
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief ivc_batch_add - Append an ioctl to a batch payload.
+ *
+ * @param[in, out] b: Batch payload, num must be 0 for the first ioctl.
+ * @param[in] data: OSI IOCTL data structure.
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 if batch is full or for OSI_CMD_ARP_OFFLOAD.
+ */
+nve32_t ivc_batch_add(ivc_ioctl_batch *b, struct osi_ioctl *data);
+
+/**
+ * @brief ivc_batch_get - Decode one ioctl of a batch payload.
+ *
+ * @param[in] b: Batch payload.
+ * @param[in] idx: Index of the ioctl.
+ * @param[out] data: OSI IOCTL data structure.
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on invalid index or payload.
+ */
+nve32_t ivc_batch_get(const ivc_ioctl_batch *b, const nveu32_t idx,
+		      struct osi_ioctl *data);
+
+/**
+ * @brief ivc_batch_put - Store outputs and status of one ioctl of a batch
+ * payload, for the response.
+ *
+ * @param[in, out] b: Batch payload.
+ * @param[in] idx: Index of the ioctl.
+ * @param[in] data: OSI IOCTL data structure with outputs.
+ * @param[in] status: Return value of the ioctl.
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on invalid index or if command of data differs.
+ */
+nve32_t ivc_batch_put(ivc_ioctl_batch *b, const nveu32_t idx,
+		      struct osi_ioctl *data, const nve32_t status);
+
+/**
+ * @brief ivc_batch_len - Number of valid bytes of a batch payload.
+ *
+ * @param[in] b: Batch payload.
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval data_len of the message carrying b.
+ */
+nveu32_t ivc_batch_len(const ivc_ioctl_batch *b);
+
+#ifdef OSI_IVC_TEST_SERVER
+/**
+ * @brief osi_ivc_server_handle - Serve an IVC request of a guest.
+ *
+ * Algorithm: Decode the request, run it on a non-virtualized core with
+ * the regular osi_* APIs and encode the response in place, the same way
+ * ivc_core.c guests expect it. Requests for core init and deinit and for
+ * MACsec configuration are refused, the server owns those.
+ *
+ * Wiring guest osd_ops.ivc_send to this function gives an in-process
+ * loopback server for the virtualized core path. Call statistics of the
+ * guest (OSI_CMD_LAT_STATS) then include the IVC overhead, those of the
+ * server core don't, so their difference measures it per command.
+ *
+ * Only built with OSI_IVC_TEST_SERVER for the host tests in osi/test,
+ * production libraries leave serving guests to the hypervisor side.
+ *
+ * @param[in] osi_core: OSI core private data structure of the server,
+ *		        without virtualization.
+ * @param[in, out] msg: IVC request, response is written back into it.
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval Length of the response message, IVC_MSG_HDR_LEN + data_len.
+ *	    Status of the request is in msg->status.
+ */
+nveu32_t osi_ivc_server_handle(struct osi_core_priv_data *const osi_core,
+			       ivc_msg_common_t *const msg);
+#endif /* OSI_IVC_TEST_SERVER */
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief osd_ivc_send_cmd - OSD ivc send cmd
  *
+ * Request is IVC_MSG_HDR_LEN + data_len bytes long. Response is written
+ * back into ivc_buf, with data_len of the response payload.
+ *
  * @param[in] priv: OSD private data
- * @param[in] ivc_buf: ivc_msg_common structure
- * @param[in] len: length of data
+ * @param[in, out] ivc_buf: ivc_msg_common structure
+ * @param[in] len: length of request message
  * @note
  * API Group:
  * - Initialization: Yes
@@ -248,6 +248,10 @@ struct osi_stats {
 
 /**
  * @brief osi_mmc_counters - The structure to hold RMON counter values
+ *
+ * Each counter holds the full 64 bit count since the last MMC reset,
+ * including the upper 32 bits of MGBE 64 bit counters. The *_h members
+ * are kept for layout compatibility and remain zero.
  */
 struct osi_mmc_counters {
 	/** This counter provides the number of bytes transmitted, exclusive of
@@ -194,6 +194,31 @@
 #define OSI_MGBE_MAX_NUM_QUEUES		10U
 #define OSI_EQOS_XP_MAX_CHANS		4U
 
+/**
+ * @addtogroup RSS related information
+ *
+ * @brief RSS hash key and table size.
+ * @{
+ */
+#define OSI_RSS_HASH_KEY_SIZE	40U
+#define OSI_RSS_MAX_TABLE_SIZE	128U
+/** @} */
+
+/**
+ * @addtogroup RSS hash types
+ *
+ * @brief Packet types hashed by RSS. TCP and UDP select 4-tuple hashing
+ * of both IPv4 and IPv6 packets, IP selects 2-tuple hashing of other IP
+ * packets.
+ * @{
+ */
+#define OSI_RSS_HASH_IP		OSI_BIT(0)
+#define OSI_RSS_HASH_TCP	OSI_BIT(1)
+#define OSI_RSS_HASH_UDP	OSI_BIT(2)
+#define OSI_RSS_HASH_ALL	(OSI_RSS_HASH_IP | OSI_RSS_HASH_TCP | \
+				 OSI_RSS_HASH_UDP)
+/** @} */
+
 /* MACSEC max SC's supported 16*/
 #define OSI_MACSEC_SC_INDEX_MAX		16
 
@@ -260,6 +285,132 @@
  */
 #define OSI_UNUSED  __attribute__((__unused__))
 
+#ifdef OSI_MMIO_HOOK
+/**
+ * @brief osi_mmio_hook_read - Register read backend.
+ *
+ * @note
+ * Provided by the environment the library is linked with, e.g. a
+ * simulated MAC/DMA device model running on a host. All register reads of
+ * the library end up here instead of a memory mapped access.
+ *
+ * @param[in] priv: OSI core private data for osi_readla(), OSI_NULL
+ *		    for osi_readl().
+ * @param[in] addr: Register address inside the mapped base.
+ *
+ * @return Register value.
+ */
+nveu32_t osi_mmio_hook_read(void *priv, void *addr);
+
+/**
+ * @brief osi_mmio_hook_write - Register write backend.
+ *
+ * @note
+ * Counterpart of osi_mmio_hook_read() for all register writes.
+ *
+ * @param[in] priv: OSI core private data for osi_writela(), OSI_NULL
+ *		    for osi_writel().
+ * @param[in] val: Value to be written.
+ * @param[in] addr: Register address inside the mapped base.
+ */
+void osi_mmio_hook_write(void *priv, nveu32_t val, void *addr);
+#endif /* OSI_MMIO_HOOK */
+
+#ifdef OSI_MMIO_TRACE
+/**
+ * @addtogroup MMIO_TRACE MMIO trace defines
+ *
+ * @brief Number of records kept in MMIO trace ring (power of two) and
+ * access directions
+ * @{
+ */
+#define OSI_MMIO_TRACE_SZ	4096U
+#define OSI_MMIO_TRACE_RD	0U
+#define OSI_MMIO_TRACE_WR	1U
+/** @} */
+
+/**
+ * @brief One recorded MMIO access
+ */
+struct osi_mmio_trace_ent {
+	/** Sequence number of record plus one, 0 while record is written */
+	nveu64_t seq;
+	/** Time of access from osi_mmio_trace.get_ts, 0 without clock */
+	nveu64_t ts;
+	/** Register address */
+	void *addr;
+	/** Value read or written */
+	nveu32_t val;
+	/** OSI_MMIO_TRACE_RD or OSI_MMIO_TRACE_WR */
+	nveu32_t dir;
+	/** Function which did the access */
+	const nve8_t *func;
+	/** Source line which did the access */
+	nveu32_t line;
+};
+
+/**
+ * @brief MMIO trace ring, allocated by the caller of osi_mmio_trace_start().
+ * Writers claim records with an atomic increment of head, so accesses from
+ * any context are recorded without locking. Oldest records are overwritten.
+ */
+struct osi_mmio_trace {
+	/** Ring of records indexed by sequence number */
+	struct osi_mmio_trace_ent ent[OSI_MMIO_TRACE_SZ];
+	/** Sequence number of next record, i.e. number of accesses seen */
+	nveu64_t head;
+	/** Timestamp source, can be NULL */
+	nveu64_t (*get_ts)(void);
+};
+
+/**
+ * @brief osi_mmio_trace_start - Start or stop recording MMIO accesses.
+ *
+ * @param[in] trace: Trace ring to record into, OSI_NULL to stop recording.
+ */
+void osi_mmio_trace_start(struct osi_mmio_trace *trace);
+
+/**
+ * @brief osi_mmio_trace_record - Record one MMIO access.
+ *
+ * @note
+ * Called by the traced register accessors, does nothing while recording
+ * is stopped.
+ *
+ * @param[in] addr: Register address.
+ * @param[in] val: Value read or written.
+ * @param[in] dir: OSI_MMIO_TRACE_RD or OSI_MMIO_TRACE_WR.
+ * @param[in] func: Function which did the access.
+ * @param[in] line: Source line which did the access.
+ */
+void osi_mmio_trace_record(void *addr, nveu32_t val, nveu32_t dir,
+			   const nve8_t *func, nveu32_t line);
+
+/**
+ * @brief osi_mmio_trace_replay - Feed recorded accesses in order to a
+ * consumer, e.g. a simulated device or an offline analysis.
+ *
+ * @note
+ * Algorithm:
+ *  - Start at sequence number from, or at the oldest record still in the
+ *    ring if it was overwritten since.
+ *  - Call fn for each completely written record up to head. fn gets a
+ *    copy of the record, taken while no writer reused it.
+ *
+ * @param[in] trace: Trace ring.
+ * @param[in] from: First sequence number to replay.
+ * @param[in] fn: Consumer called for each record.
+ * @param[in] priv: Consumer private data.
+ *
+ * @return Sequence number to continue the next replay from.
+ */
+nveu64_t osi_mmio_trace_replay(const struct osi_mmio_trace *trace,
+			       nveu64_t from,
+			       void (*fn)(void *priv,
+					  const struct osi_mmio_trace_ent *ent),
+			       void *priv);
+#endif /* OSI_MMIO_TRACE */
+
 /**
  * @brief osi_update_stats_counter - update value by increment passed
  *	as parameter
@@ -293,4 +444,82 @@ static inline nveu64_t osi_update_stats_counter(nveu64_t last_value,
 
 	return temp;
 }
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief Number of attempts of a statistics snapshot before giving up
+ */
+#define OSI_STATS_SNAP_RETRY	64U
+
+/**
+ * @brief Update sequence of statistics read through lock-free snapshots.
+ *
+ * Writers count every update section at its start and at its end, so
+ * concurrent writers on different channels need no lock. A reader copy
+ * is coherent if both counts were equal before the copy and no section
+ * started during it.
+ */
+struct osi_stats_seq {
+	/** Number of update sections started */
+	nveu32_t begin;
+	/** Number of update sections completed */
+	nveu32_t end;
+};
+
+/**
+ * @brief osi_stats_write_begin - Start a statistics update section.
+ *
+ * @param[in, out] seq: Update sequence of the statistics.
+ */
+static inline void osi_stats_write_begin(struct osi_stats_seq *const seq)
+{
+	(void)__sync_fetch_and_add(&seq->begin, 1U);
+}
+
+/**
+ * @brief osi_stats_write_end - Complete a statistics update section.
+ *
+ * @param[in, out] seq: Update sequence of the statistics.
+ */
+static inline void osi_stats_write_end(struct osi_stats_seq *const seq)
+{
+	(void)__sync_fetch_and_add(&seq->end, 1U);
+}
+
+/**
+ * @brief osi_stats_read_begin - Start a statistics snapshot copy.
+ *
+ * @param[in] seq: Update sequence of the statistics.
+ * @param[out] gen: Generation of the statistics, i.e. number of update
+ *		    sections started.
+ *
+ * @retval OSI_ENABLE if no update is in progress and copy can start
+ * @retval OSI_DISABLE otherwise
+ */
+static inline nveu32_t osi_stats_read_begin(struct osi_stats_seq *const seq,
+					    nveu32_t *const gen)
+{
+	nveu32_t end = __sync_fetch_and_add(&seq->end, 0U);
+
+	*gen = __sync_fetch_and_add(&seq->begin, 0U);
+
+	return (end == *gen) ? OSI_ENABLE : OSI_DISABLE;
+}
+
+/**
+ * @brief osi_stats_read_done - Check a statistics snapshot copy.
+ *
+ * @param[in] seq: Update sequence of the statistics.
+ * @param[in] gen: Generation returned by osi_stats_read_begin().
+ *
+ * @retval OSI_ENABLE if no update started during the copy
+ * @retval OSI_DISABLE if the copy has to be retried
+ */
+static inline nveu32_t osi_stats_read_done(struct osi_stats_seq *const seq,
+					   const nveu32_t gen)
+{
+	return (__sync_fetch_and_add(&seq->begin, 0U) == gen) ?
+	       OSI_ENABLE : OSI_DISABLE;
+}
+#endif /* !OSI_STRIPPED_LIB */
 #endif /* OSI_COMMON_H */
@@ -54,16 +54,6 @@ typedef my_lint_64		nvel64_t;
 #define OSI_RXQ_ROUTE_PTP	0U
 #define EQOS_MAX_HTR_REGS		8U
 
-/**
- * @addtogroup RSS related information
- *
- * @brief RSS hash key and table size.
- * @{
- */
-#define OSI_RSS_HASH_KEY_SIZE	40U
-#define OSI_RSS_MAX_TABLE_SIZE	128U
-/** @} */
-
 #define OSI_CMD_RESET_MMC		12U
 #define OSI_CMD_MDC_CONFIG		1U
 #define OSI_CMD_MAC_LB			14U
@@ -273,8 +263,124 @@ typedef my_lint_64		nvel64_t;
 #define OSI_CMD_HSI_INJECT_ERR		55U
 #endif
 #define OSI_CMD_READ_STATS		56U
+#ifndef OSI_STRIPPED_LIB
+#define OSI_CMD_L3L4_FILTER_HIT		57U
+#define OSI_CMD_FLOW_STEER		58U
+#define OSI_CMD_RSS_TABLE_UPDATE	59U
+#define OSI_CMD_RSS_REBALANCE		60U
+#define OSI_CMD_RSS_PROFILE		61U
+#define OSI_CMD_ASYNC_START		62U
+#define OSI_CMD_ASYNC_POLL		63U
+#define OSI_CMD_LAT_STATS		64U
+#endif /* !OSI_STRIPPED_LIB */
+#define OSI_CMD_READ_MMC_GRP		65U
+#ifndef OSI_STRIPPED_LIB
+#define OSI_CMD_STATS_SNAPSHOT		66U
+#define OSI_CMD_REMAP_VM_IRQ		67U
+#endif /* !OSI_STRIPPED_LIB */
+/** @} */
+
+/**
+ * @addtogroup OSI_MMC_GRP MMC counter groups
+ *
+ * @brief Bitmap of MMC counter groups read by OSI_CMD_READ_MMC_GRP
+ * @{
+ */
+#define OSI_MMC_GRP_TX			OSI_BIT(0)
+#define OSI_MMC_GRP_RX			OSI_BIT(1)
+#define OSI_MMC_GRP_SIZE		OSI_BIT(2)
+#define OSI_MMC_GRP_ERR			OSI_BIT(3)
+#define OSI_MMC_GRP_LPI			OSI_BIT(4)
+#define OSI_MMC_GRP_FPE			OSI_BIT(5)
+#define OSI_MMC_GRP_CSUM		OSI_BIT(6)
+#define OSI_MMC_GRP_ALL			(OSI_MMC_GRP_TX | OSI_MMC_GRP_RX | \
+					 OSI_MMC_GRP_SIZE | OSI_MMC_GRP_ERR | \
+					 OSI_MMC_GRP_LPI | OSI_MMC_GRP_FPE | \
+					 OSI_MMC_GRP_CSUM)
+/** @} */
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @addtogroup OSI_LAT Latency statistics indices
+ *
+ * @brief Index of statistics read by OSI_CMD_LAT_STATS. OSI_CMD_* commands
+ * use their command number, MACsec entry points follow them.
+ * @{
+ */
+#define OSI_LAT_CMD_CNT			(OSI_CMD_REMAP_VM_IRQ + 1U)
+#define OSI_LAT_MACSEC_INIT		(OSI_LAT_CMD_CNT + 0U)
+#define OSI_LAT_MACSEC_DEINIT		(OSI_LAT_CMD_CNT + 1U)
+#define OSI_LAT_MACSEC_LUT		(OSI_LAT_CMD_CNT + 2U)
+#define OSI_LAT_MACSEC_KT		(OSI_LAT_CMD_CNT + 3U)
+#define OSI_LAT_MACSEC_CIPHER		(OSI_LAT_CMD_CNT + 4U)
+#define OSI_LAT_MACSEC_LOOPBACK		(OSI_LAT_CMD_CNT + 5U)
+#define OSI_LAT_MACSEC_EN		(OSI_LAT_CMD_CNT + 6U)
+#define OSI_LAT_MACSEC_CONFIG		(OSI_LAT_CMD_CNT + 7U)
+#define OSI_LAT_MACSEC_MMC		(OSI_LAT_CMD_CNT + 8U)
+#define OSI_LAT_MACSEC_DBG_BUF		(OSI_LAT_CMD_CNT + 9U)
+#define OSI_LAT_MACSEC_DBG_EVENTS	(OSI_LAT_CMD_CNT + 10U)
+#define OSI_LAT_MACSEC_KEY_INDEX	(OSI_LAT_CMD_CNT + 11U)
+#define OSI_LAT_MACSEC_MTU		(OSI_LAT_CMD_CNT + 12U)
+#define OSI_LAT_MAX			(OSI_LAT_CMD_CNT + 13U)
+/** @} */
+
+/**
+ * @brief Number of log2 latency histogram buckets. Bucket n counts calls
+ * which took [2^n, 2^(n+1)) nsec, the first and last ones are open ended.
+ */
+#define OSI_LAT_HIST_CNT		32U
+
+/**
+ * @brief Call statistics of one ioctl command or MACsec entry point
+ */
+struct osi_lat_stats {
+	/** Number of calls */
+	nveu64_t calls;
+	/** Number of failed calls */
+	nveu64_t fails;
+	/** Latency histogram, only updated with osd_ops.get_time_ns */
+	nveu64_t hist[OSI_LAT_HIST_CNT];
+};
+
+/**
+ * @brief Coherent copy of core statistics read by OSI_CMD_STATS_SNAPSHOT
+ */
+struct osi_core_stats_snap {
+	/** Generation of the copy, i.e. number of statistics updates done
+	 * before it. Equal generations mean unchanged statistics. */
+	nveu32_t gen;
+	/** Copy of osi_core_priv_data stats */
+	struct osi_stats stats;
+	/** Copy of osi_core_priv_data mmc */
+	struct osi_mmc_counters mmc;
+};
+#endif /* !OSI_STRIPPED_LIB */
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @addtogroup OSI_ASYNC asynchronous ioctl states
+ *
+ * @brief State reported by OSI_CMD_ASYNC_POLL
+ * @{
+ */
+#define OSI_ASYNC_IDLE			0U
+#define OSI_ASYNC_PENDING		1U
+#define OSI_ASYNC_DONE			2U
 /** @} */
 
+/**
+ * @brief Maximum number of ioctls submitted with osi_ioctl_submit() and
+ * not yet collected with osi_ioctl_result()
+ */
+#define OSI_IOCTL_MAX_PENDING		16U
+
+/**
+ * @brief Minimum imbalance between VM IRQs for osi_vm_irq_remap_hint() to
+ * suggest a remap, as divisor of the busiest VM IRQ load
+ */
+#define OSI_VM_IRQ_IMBAL_DIV		4U
+#endif /* !OSI_STRIPPED_LIB */
+
 #ifdef LOG_OSI
 /**
  * @brief OSI error macro definition,
@@ -357,6 +463,11 @@ typedef my_lint_64		nvel64_t;
 #define OSI_FRP_MATCH_L4_S_TPORT	7U
 #define OSI_FRP_MATCH_L4_D_TPORT	8U
 #define OSI_FRP_MATCH_VLAN		9U
+#ifndef OSI_STRIPPED_LIB
+/* FRP IDs used by OSI for rules it places itself, rejected from OSD */
+#define OSI_FRP_ID_RSVD_BASE		0x46530000
+#define OSI_FRP_ID_RSVD_CNT		0x200
+#endif /* !OSI_STRIPPED_LIB */
 /** @} */
 
 #define XPCS_WRITE_FAIL_CODE	-9
@@ -487,6 +598,78 @@ struct osi_rxq_route {
 	/** RX queue index */
 	nveu32_t idx;
 };
+
+/**
+ * @addtogroup FLOW_STEER Flow steering rule defines
+ *
+ * @brief Flow steering rule operations, match fields, actions and
+ * backing HW
+ * @{
+ */
+#define OSI_FLOW_MAX_RULES		64U
+#define OSI_FLOW_OP_ADD			0U
+#define OSI_FLOW_OP_DEL			1U
+#define OSI_FLOW_OP_HIT			2U
+#define OSI_FLOW_OP_STATS		3U
+#define OSI_FLOW_MATCH_DMAC		OSI_BIT(0)
+#define OSI_FLOW_MATCH_VLAN_ID		OSI_BIT(1)
+#define OSI_FLOW_MATCH_VLAN_PRIO	OSI_BIT(2)
+#define OSI_FLOW_MATCH_ETHTYPE		OSI_BIT(3)
+#define OSI_FLOW_MATCH_PROTO		OSI_BIT(4)
+#define OSI_FLOW_MATCH_SIP		OSI_BIT(5)
+#define OSI_FLOW_MATCH_DIP		OSI_BIT(6)
+#define OSI_FLOW_MATCH_SPORT		OSI_BIT(7)
+#define OSI_FLOW_MATCH_DPORT		OSI_BIT(8)
+#define OSI_FLOW_ACTION_DMA		0U
+#define OSI_FLOW_ACTION_DROP		1U
+#define OSI_FLOW_ACTION_RSS		2U
+#define OSI_FLOW_HW_NONE		0U
+#define OSI_FLOW_HW_L3L4		1U
+#define OSI_FLOW_HW_FRP			2U
+#define OSI_FLOW_HW_VLAN_PRIO		3U
+/** @} */
+
+/**
+ * @brief OSI core structure for flow steering rule
+ */
+struct osi_flow_rule {
+	/** Rule operation OSI_FLOW_OP_* */
+	nveu32_t op;
+	/** Rule ID, less than OSI_FLOW_MAX_RULES */
+	nveu32_t rule_id;
+	/** Match fields OSI_FLOW_MATCH_* */
+	nveu32_t match;
+	/** Destination MAC address */
+	nveu8_t dmac[OSI_ETH_ALEN];
+	/** VLAN ID */
+	nveu16_t vlan_id;
+	/** VLAN priority (PCP) */
+	nveu8_t vlan_prio;
+	/** EtherType */
+	nveu16_t ethtype;
+	/** ipv6 (OSI_TRUE) or ipv4 (OSI_FALSE) */
+	nveu32_t is_ipv6;
+	/** IP protocol, TCP(6) or UDP(17) is needed for port match */
+	nveu8_t proto;
+	/** Source IP address in network byte order, ipv4 uses first 4 bytes */
+	nveu8_t sip[16];
+	/** Destination IP address in network byte order */
+	nveu8_t dip[16];
+	/** L4 source port */
+	nveu16_t sport;
+	/** L4 destination port */
+	nveu16_t dport;
+	/** Rule action OSI_FLOW_ACTION_* */
+	nveu32_t action;
+	/** DMA channel for OSI_FLOW_ACTION_DMA */
+	nveu32_t dma_chan;
+	/** HW backing the rule OSI_FLOW_HW_*, output of OSI_FLOW_OP_ADD and
+	 * OSI_FLOW_OP_STATS */
+	nveu32_t hw;
+	/** Hits since last report for OSI_FLOW_OP_HIT, total hits output of
+	 * OSI_FLOW_OP_STATS */
+	nveu64_t hits;
+};
 #endif
 
 /**
@@ -854,8 +1037,43 @@ struct osi_core_rss {
 	nveu8_t key[OSI_RSS_HASH_KEY_SIZE];
 	/** Array for storing RSS Hash table */
 	nveu32_t table[OSI_RSS_MAX_TABLE_SIZE];
+	/** Hashed packet types, OSI_RSS_HASH_* bitmap, 0 for
+	 * OSI_RSS_HASH_ALL */
+	nveu32_t hash_types;
+};
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief osi_rss_rebalance - Structure used to rebalance RSS indirection
+ * table entries across Rx DMA channels based on per channel load.
+ */
+struct osi_rss_rebalance {
+	/** Per channel Rx packet counters as accumulated by OSI DMA
+	 * (dstats.q_rx_pkt_n), indexed by DMA channel */
+	nveu64_t q_rx_pkt_n[OSI_MGBE_MAX_NUM_CHANS];
+	/** Allowed load of hottest channel over coldest channel in percent
+	 * before moving entries, 0 for default */
+	nveu32_t threshold;
+	/** Number of indirection table entries moved (output), see
+	 * OSI_CMD_ASYNC_POLL when started asynchronously */
+	nveu32_t moved;
 };
 
+/**
+ * @brief osi_rss_profile - Structure used to select RSS hash key kind
+ * and hashed packet types.
+ */
+struct osi_rss_profile {
+	/** Hashed packet types, OSI_RSS_HASH_* bitmap */
+	nveu32_t hash_types;
+	/** Generate symmetric key (OSI_ENABLE) so that both directions of
+	 * a flow get the same hash, or keep rss.key (OSI_DISABLE) */
+	nveu32_t symmetric;
+	/** 16-bit pattern repeated over symmetric key, 0 for default */
+	nveu16_t sym_seed;
+};
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief Max num of MAC core registers to backup. It should be max of or >=
  * (EQOS_MAX_BAK_IDX=380, coreX,...etc) backup registers.
@@ -966,7 +1184,8 @@ struct osd_core_ops {
 	void (*usleep_range)(nveu64_t umin, nveu64_t umax);
 	/** msleep callback */
 	void (*msleep)(nveu32_t msec);
-	/** ivcsend callback*/
+	/** ivcsend callback, len is the request length. Response is written
+	 * back into ivc, sized by its data_len */
 	nve32_t (*ivc_send)(void *priv, struct ivc_msg_common *ivc,
 			    nveu32_t len);
 #ifdef MACSEC_SUPPORT
@@ -983,6 +1202,18 @@ struct osd_core_ops {
 #endif
 	/** Lane bringup restart callback */
 	void (*restart_lane_bringup)(void *priv, nveu32_t en_disable);
+#ifndef OSI_STRIPPED_LIB
+	/** Asynchronous ioctl completion callback with the started command
+	 * and its final status, can be NULL */
+	void (*async_done)(void *priv, nveu32_t cmd, nve32_t status);
+	/** Monotonic clock in nsec for latency statistics, can be NULL */
+	nveu64_t (*get_time_ns)(void *priv);
+	/** Non-blocking IVC send of an osi_ioctl_submit() request, the
+	 * response must be passed to osi_ioctl_complete(). Can be NULL, then
+	 * submitted ioctls complete synchronously with ivc_send */
+	nve32_t (*ivc_post)(void *priv, struct ivc_msg_common *ivc,
+			    nveu32_t len);
+#endif /* !OSI_STRIPPED_LIB */
 };
 
 #ifdef MACSEC_SUPPORT
@@ -1160,6 +1391,17 @@ struct osi_ioctl {
 	struct osi_pto_config pto_config;
 	/** RXQ route structure */
 	struct osi_rxq_route rxq_route;
+	/** Flow steering rule structure */
+	struct osi_flow_rule flow_rule;
+	/** RSS rebalance structure */
+	struct osi_rss_rebalance rss_rebalance;
+	/** RSS profile structure */
+	struct osi_rss_profile rss_profile;
+	/** Caller buffer for latency statistics, only used locally so that
+	 * IVC messages don't grow */
+	struct osi_lat_stats *lat_stats;
+	/** Caller buffer for statistics snapshot, only used locally */
+	struct osi_core_stats_snap *stats_snap;
 #endif /* !OSI_STRIPPED_LIB */
 	/** FRP structure */
 	struct osi_core_frp_cmd frp_cmd;
@@ -1251,6 +1493,31 @@ struct osi_hsi_data {
 };
 #endif
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief Statistics page shared by the server with virtualized guests.
+ *
+ * The server instance publishes its statistics into the page, guests map it
+ * read-only and copy it out without any IVC message. seq is odd while the
+ * server updates the page and is incremented again once the update is done.
+ * Server and guests have to agree on MACSEC_SUPPORT, which adds MACsec fields.
+ */
+struct osi_stats_page {
+	/** Update sequence, odd while an update is in progress */
+	nveu32_t seq;
+	/** Copy of server osi_core_priv_data mmc */
+	struct osi_mmc_counters mmc;
+	/** Copy of server osi_core_priv_data stats */
+	struct osi_stats stats;
+#ifdef MACSEC_SUPPORT
+	/** Copy of server osi_core_priv_data macsec_mmc */
+	struct osi_macsec_mmc_counters macsec_mmc;
+	/** Copy of server osi_core_priv_data macsec_irq_stats */
+	struct osi_macsec_irq_stats macsec_irq_stats;
+#endif /* MACSEC_SUPPORT */
+};
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief The OSI Core (MAC & MTL) private data structure.
  */
@@ -1334,6 +1601,10 @@ struct osi_core_priv_data {
 	struct osi_core_rss rss;
 	/** DT entry to enable(1) or disable(0) pause frame support */
 	nveu32_t pause_frames;
+	/** Shared statistics page mapped by OSD, writable for the server
+	 * instance and read-only for virtualized guests. OSI_NULL disables
+	 * statistics publishing and local guest reads. */
+	struct osi_stats_page *stats_page;
 #endif
 	/** Residual queue valid with FPE support */
 	nveu32_t residual_queue;
@@ -1589,6 +1860,15 @@ nve32_t osi_init_core_ops(struct osi_core_priv_data *const osi_core);
  *  - OSI_CMD_READ_MMC
  *	invoke function to read actual registers and update
  *     structure variable mmc
+ *  - OSI_CMD_READ_MMC_GRP
+ *	invoke function to read registers of selected counter groups
+ *     only and update structure variable mmc
+ *	arg1_u32 - bitmap of OSI_MMC_GRP_* counter groups
+ *	With virtualization and stats_page mapped, OSI_CMD_READ_MMC,
+ *	OSI_CMD_READ_MMC_GRP and OSI_CMD_READ_STATS copy mmc and stats
+ *	published by the server from stats_page, without IVC messages.
+ *	If the server didn't publish since the last copy, the command is
+ *	sent to the server, which reads HW counters and publishes them
  *  - OSI_CMD_GET_MAC_VER
  *	Reading MAC version
  *	arg1_u32 - holds mac version
@@ -1665,6 +1945,14 @@ nve32_t osi_init_core_ops(struct osi_core_priv_data *const osi_core);
  *	arg3_u32 - dma channel for routing based on filter.
  *		   Max OSI_EQOS_MAX_NUM_CHANS.
  *	arg4_u32 - API call for L3 filter(0) or L4 filter(1)
+ *  - OSI_CMD_L3L4_FILTER_HIT
+ *	Report hits of an L3/L4 rule to rebalance HW filter slots
+ *	l3l4_filter - l3_l4 filter structure of the rule
+ *	arg1_u32 - Number of hits since last report
+ *  - OSI_CMD_FLOW_STEER
+ *	Add, delete, report hits of or read stats of a flow steering rule.
+ *	OSI selects L3/L4 filter, FRP or VLAN priority to back the rule.
+ *	flow_rule - flow steering rule structure
  *  - OSI_CMD_SET_SYSTOHW_TIME
  *	set system to MAC hardware
  *	arg1_u32 - sec
@@ -1677,9 +1965,69 @@ nve32_t osi_init_core_ops(struct osi_core_priv_data *const osi_core);
  *	rxq_route - rxq routing information in structure
  *  - OSI_CMD_CONFIG_FRP
  *	Issue FRP command to HW
- *	frp_cmd - FRP command parameter
+ *	frp_cmd - FRP command parameter, IDs from OSI_FRP_ID_RSVD_BASE on
+ *	are used by OSI itself and rejected
  *  - OSI_CMD_CONFIG_RSS
  *	Configure RSS
+ *  - OSI_CMD_RSS_TABLE_UPDATE
+ *	Program only RSS indirection table entries from rss.table which
+ *	differ from what is in HW. RSS hash key is not reprogrammed.
+ *  - OSI_CMD_RSS_REBALANCE
+ *	Move RSS indirection table entries from most loaded to least loaded
+ *	Rx channel in the table based on Rx packets since last successful
+ *	call, and program only changed entries.
+ *	rss_rebalance - RSS rebalance structure
+ *  - OSI_CMD_RSS_PROFILE
+ *	Select hashed packet types and optionally generate a symmetric RSS
+ *	hash key, then program RSS.
+ *	rss_profile - RSS profile structure
+ *  - OSI_CMD_ASYNC_START
+ *	Queue the HW writes of a command without waiting for HW. Supported
+ *	for OSI_CMD_CONFIG_RSS, OSI_CMD_RSS_TABLE_UPDATE,
+ *	OSI_CMD_RSS_REBALANCE and OSI_CMD_RSS_PROFILE. Only one command can
+ *	be pending at a time.
+ *	arg1_u32 - command to be started, with its usual arguments
+ *  - OSI_CMD_ASYNC_POLL
+ *	Issue queued HW writes as far as HW accepts them without delay and
+ *	run completion steps after the last one. osd_ops.async_done is
+ *	called when a started command completes or fails. HW busy for
+ *	longer than the indirect access timeout fails the command, timed
+ *	with osd_ops.get_time_ns. Without it each poll finding HW busy
+ *	counts as one back-off delay, poll no faster than that delay.
+ *	arg1_u32 - output OSI_ASYNC_PENDING, OSI_ASYNC_DONE or OSI_ASYNC_IDLE
+ *	arg2_u32 - output command which was started
+ *	arg3_u32 - output entries moved by OSI_CMD_RSS_REBALANCE once it is
+ *	done, its rss_rebalance.moved stays 0 when started asynchronously
+ *  - OSI_CMD_SUSPEND
+ *	Record configuration which differs from HW reset defaults and
+ *	deinitialize MAC.
+ *  - OSI_CMD_RESUME
+ *	Initialize MAC and restore only the configuration recorded on suspend.
+ *	arg1_u32 - output bitmap of restored configuration categories
+ *	arg2_u32 - output number of restored entries
+ *	arg3_u32 - output indirect access back-off delay in usec
+ *	arg4_u32 - output wall clock restore time in usec, 0 without
+ *	osd_ops.get_time_ns
+ *	arg5_u64 - output number of indirect register accesses
+ *  - OSI_CMD_LAT_STATS
+ *	Read call statistics of an ioctl command or MACsec entry point
+ *	arg1_u32 - OSI_CMD_* command or OSI_LAT_MACSEC_* index
+ *	arg2_u32 - clear statistics after read (1) or keep them (0)
+ *	lat_stats - buffer for output call statistics
+ *  - OSI_CMD_STATS_SNAPSHOT
+ *	Copy stats and mmc as they were between two updates, without
+ *	locking out updates from other contexts
+ *	stats_snap - buffer for output statistics and their generation
+ *  - OSI_CMD_REMAP_VM_IRQ
+ *	Move a DMA channel to another VM IRQ at runtime. Only the VM
+ *	routing of the channel changes, its interrupt enables are kept. An
+ *	interrupt raised during the switch may be signalled on the old VM
+ *	IRQ only, so the channel virtual interrupt status is read after the
+ *	switch and returned. If it is not 0 the OSD must run the channel
+ *	interrupt handling as if the new VM IRQ had fired
+ *	arg1_u32 - DMA channel
+ *	arg2_u32 - index of target VM IRQ in irq_data
+ *	arg3_u32 - output VIRT_INTR_CHX_STATUS bits pending after switch
  *  - OSI_CMD_CONFIG_EST
  *	Configure EST registers and GCL to hw
  *	est - EST configuration structure
@@ -1729,6 +2077,171 @@ nve32_t osi_init_core_ops(struct osi_core_priv_data *const osi_core);
 nve32_t osi_handle_ioctl(struct osi_core_priv_data *osi_core,
 			 struct osi_ioctl *data);
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief osi_handle_ioctl_batch - Run several runtime commands at once.
+ *
+ * @note
+ * Algorithm:
+ *  - Same as osi_handle_ioctl() for each entry of data, in order. With
+ *    virtualization the commands are sent in as few IVC round trips as
+ *    fit into batch messages. OSI_CMD_READ_MMC, OSI_CMD_READ_MMC_GRP and
+ *    OSI_CMD_READ_STATS can't be batched.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: Array of ioctl data, outputs updated per entry.
+ * @param[out] status: Array of return values of each command.
+ * @param[in] num: Number of entries in data and status.
+ *
+ * @pre MAC should be init and started. see osi_start_mac()
+ *
+ * @usage
+ * - Allowed context for the API call
+ *  - Interrupt handler: No
+ *  - Signal handler: No
+ *  - Thread safe: No
+ *  - Async/Sync: Sync
+ *  - Required Privileges: None
+ * - API Group:
+ *  - Initialization: No
+ *  - Run time: Yes
+ *  - De-initialization: No
+ *
+ * @retval 0 when all commands ran, see status for their results
+ * @retval -1 on invalid arguments or transport failure.
+ */
+nve32_t osi_handle_ioctl_batch(struct osi_core_priv_data *osi_core,
+			       struct osi_ioctl *data, nve32_t *status,
+			       const nveu32_t num);
+
+/**
+ * @brief osi_ioctl_submit - Start a runtime command without waiting.
+ *
+ * @note
+ * Algorithm:
+ *  - Allocate a request ID and send the command. With virtualization and
+ *    osd_ops.ivc_post the command completes when OSD passes the response
+ *    to osi_ioctl_complete(), so up to OSI_IOCTL_MAX_PENDING commands can
+ *    be in flight. Otherwise it completes before this call returns.
+ *  - data must stay valid until osi_ioctl_result() reports completion.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: ioctl data, outputs updated on completion.
+ * @param[out] req_id: Request ID for osi_ioctl_result().
+ *
+ * @usage
+ * - Allowed context for the API call
+ *  - Interrupt handler: No
+ *  - Signal handler: No
+ *  - Thread safe: No
+ *  - Async/Sync: Async
+ *  - Required Privileges: None
+ * - API Group:
+ *  - Initialization: No
+ *  - Run time: Yes
+ *  - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on invalid arguments, too many pending commands or send failure.
+ */
+nve32_t osi_ioctl_submit(struct osi_core_priv_data *osi_core,
+			 struct osi_ioctl *data, nveu32_t *req_id);
+
+/**
+ * @brief osi_ioctl_complete - Complete a submitted command from its response.
+ *
+ * @note
+ * Algorithm:
+ *  - Match the response to its request ID, copy outputs into the
+ *    submitted ioctl data and record the command status.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] reply: IVC response of a request sent with osd_ops.ivc_post.
+ *
+ * @usage
+ * - Allowed context for the API call
+ *  - Interrupt handler: No
+ *  - Signal handler: No
+ *  - Thread safe: No
+ *  - Async/Sync: Sync
+ *  - Required Privileges: None
+ * - API Group:
+ *  - Initialization: No
+ *  - Run time: Yes
+ *  - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on unknown request ID or without virtualization.
+ */
+nve32_t osi_ioctl_complete(struct osi_core_priv_data *osi_core,
+			   struct ivc_msg_common *reply);
+
+/**
+ * @brief osi_ioctl_result - Collect status of a submitted command.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] req_id: Request ID returned by osi_ioctl_submit().
+ * @param[out] state: OSI_ASYNC_PENDING or OSI_ASYNC_DONE. The request ID
+ *		      is released once OSI_ASYNC_DONE is reported.
+ * @param[out] status: Return value of the command when done.
+ *
+ * @usage
+ * - Allowed context for the API call
+ *  - Interrupt handler: No
+ *  - Signal handler: No
+ *  - Thread safe: No
+ *  - Async/Sync: Sync
+ *  - Required Privileges: None
+ * - API Group:
+ *  - Initialization: No
+ *  - Run time: Yes
+ *  - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on unknown request ID.
+ */
+nve32_t osi_ioctl_result(struct osi_core_priv_data *osi_core,
+			 const nveu32_t req_id, nveu32_t *state,
+			 nve32_t *status);
+
+/**
+ * @brief osi_vm_irq_remap_hint - Suggest a DMA channel to VM IRQ remap.
+ *
+ * Algorithm:
+ * - Sum interrupt counts of the channels of each VM IRQ in irq_data.
+ * - Take the busiest and the least busy VM IRQ. Skip if their difference
+ *   is below 1/OSI_VM_IRQ_IMBAL_DIV of the busiest one, so that small
+ *   fluctuations don't move channels back and forth.
+ * - Suggest the channel of the busiest VM IRQ whose count is closest to
+ *   half the difference, provided moving it lowers the busiest load.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] irq_cnt: Interrupts of each DMA channel since previous call,
+ *		       indexed by channel, OSI_MGBE_MAX_NUM_CHANS entries.
+ * @param[out] chan: DMA channel to move.
+ * @param[out] irq_idx: irq_data index of VM IRQ to move it to, to be
+ *			passed with chan to OSI_CMD_REMAP_VM_IRQ.
+ *
+ * @usage
+ * - Allowed context for the API call
+ *  - Interrupt handler: No
+ *  - Signal handler: No
+ *  - Thread safe: No
+ *  - Async/Sync: Sync
+ *  - Required Privileges: None
+ * - API Group:
+ *  - Initialization: No
+ *  - Run time: Yes
+ *  - De-initialization: No
+ *
+ * @retval 0 if a remap is suggested
+ * @retval -1 on invalid arguments or if no remap improves the balance.
+ */
+nve32_t osi_vm_irq_remap_hint(struct osi_core_priv_data *const osi_core,
+			      const nveu64_t *const irq_cnt, nveu32_t *chan,
+			      nveu32_t *irq_idx);
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief osi_get_core - Get pointer to osi_core data structure.
  *
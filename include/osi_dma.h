@@ -255,6 +255,69 @@
 #endif /* OSI_DEBUG */
 /** @} */
 
+#ifdef OSI_DMA_PROFILE
+/**
+ * @addtogroup OSI_DMA-PROF Profiled DMA hot paths
+ *
+ * @brief Index of each hot path into osi_dma_priv_data.prof
+ * @{
+ */
+#define OSI_DMA_PROF_XMIT	0U
+#define OSI_DMA_PROF_TX_DONE	1U
+#define OSI_DMA_PROF_RX_DONE	2U
+#define OSI_DMA_PROF_MAX	3U
+/** @} */
+
+/**
+ * @brief Cost accounting of one DMA hot path. Cycles are in units of
+ * osd_ops.get_cycles and include time spent in OSD callbacks.
+ */
+struct osi_dma_prof {
+	/** Number of calls */
+	nveu64_t calls;
+	/** Number of packets handled by all calls */
+	nveu64_t pkts;
+	/** Total cycles of all calls */
+	nveu64_t cycles;
+	/** Maximum cycles of one call */
+	nveu64_t max_cycles;
+};
+#endif /* OSI_DMA_PROFILE */
+
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+/**
+ * @brief Number of log2 histogram buckets. Bucket n counts values in
+ * [2^n, 2^(n+1)), bucket 0 also counts 0 and the last one is open ended.
+ */
+#define OSI_DMA_HIST_CNT	17U
+
+/**
+ * @brief Number of Rx budget utilization buckets. Bucket n counts polls
+ * which received at least n/8 and less than (n+1)/8 of the budget, the
+ * last one polls which exhausted the budget.
+ */
+#define OSI_DMA_HIST_UTIL_CNT	9U
+
+/**
+ * @brief Per channel histograms for sizing rings and buffers, cleared
+ * by OSD
+ */
+struct osi_dma_hist {
+	/** Rx packet length in bytes */
+	nveu64_t rx_len[OSI_DMA_HIST_CNT];
+	/** Rx descriptors completed by HW and consumed by one poll */
+	nveu64_t rx_desc[OSI_DMA_HIST_CNT];
+	/** Rx budget utilization of one poll */
+	nveu64_t rx_budget[OSI_DMA_HIST_UTIL_CNT];
+	/** Tx packet length in bytes, headers included */
+	nveu64_t tx_len[OSI_DMA_HIST_CNT];
+	/** Descriptors used by one Tx packet, context descriptor included */
+	nveu64_t tx_desc[OSI_DMA_HIST_CNT];
+	/** Tx descriptors not yet cleaned when a packet is queued */
+	nveu64_t tx_occ[OSI_DMA_HIST_CNT];
+};
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
+
 /**
  * @brief Maximum buffer length per DMA descriptor (16KB - 1).
  */
@@ -356,6 +419,9 @@ struct osi_rx_pkt_cx {
 	nveu32_t rx_hash;
 	/** Store type of packet for which hash carries at rx_hash */
 	nveu32_t rx_hash_type;
+	/** Software RSS steering hint, sw_rss.table entry selected by
+	 * rx_hash. Valid only if osi_sw_rss_hash() computed rx_hash */
+	nveu32_t rss_hint;
 #endif /* !OSI_STRIPPED_LIB */
 };
 
@@ -512,6 +578,40 @@ struct osi_xtra_dma_stat_counters {
 };
 #endif /* !OSI_STRIPPED_LIB */
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief osi_dma_sw_rss - Software RSS configuration. Key and table use
+ * the same format as osi_core_rss, so that packets are hashed bit exact
+ * with MGBE HW RSS.
+ */
+struct osi_dma_sw_rss {
+	/** Flag to represent to enable software RSS or not */
+	nveu32_t enable;
+	/** Array for storing RSS Hash key */
+	nveu8_t key[OSI_RSS_HASH_KEY_SIZE];
+	/** Array for storing RSS Hash table, entries are OSD defined
+	 * steering targets such as CPU backlogs */
+	nveu32_t table[OSI_RSS_MAX_TABLE_SIZE];
+	/** Hashed packet types, OSI_RSS_HASH_* bitmap, 0 for
+	 * OSI_RSS_HASH_ALL */
+	nveu32_t hash_types;
+};
+
+/**
+ * @brief osi_dma_stats_snap - Coherent copy of DMA statistics read by
+ * osi_dma_stats_snapshot()
+ */
+struct osi_dma_stats_snap {
+	/** Generation of the copy, i.e. number of statistics updates done
+	 * before it. Equal generations mean unchanged statistics. */
+	nveu32_t gen;
+	/** Copy of osi_dma_priv_data pkt_err_stats */
+	struct osi_pkt_err_stats pkt_err_stats;
+	/** Copy of osi_dma_priv_data dstats */
+	struct osi_xtra_dma_stat_counters dstats;
+};
+#endif /* !OSI_STRIPPED_LIB */
+
 struct osi_dma_priv_data;
 
 /**
@@ -536,6 +636,11 @@ struct osd_dma_ops {
 			nveul64_t loga);
 	/**.ops_log function callback */
 	void (*udelay)(nveu64_t usec);
+#ifdef OSI_DMA_PROFILE
+	/** Free running cycle or time counter for hot path profiling,
+	 * can be NULL to disable profiling */
+	nveu64_t (*get_cycles)(void);
+#endif /* OSI_DMA_PROFILE */
 #ifdef OSI_DEBUG
 	/**.printf function callback */
 	void (*printf)(struct osi_dma_priv_data *osi_dma,
@@ -602,6 +707,15 @@ struct osi_dma_priv_data {
 	nveu32_t use_tx_frames;
 	/** DMA callback ops structure */
 	struct osd_dma_ops osd_ops;
+#ifdef OSI_DMA_PROFILE
+	/** Hot path cost accounting indexed by OSI_DMA_PROF_*, cleared
+	 * by OSD */
+	struct osi_dma_prof prof[OSI_DMA_PROF_MAX];
+#endif /* OSI_DMA_PROFILE */
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	/** Ring and packet size histograms indexed by DMA channel */
+	struct osi_dma_hist hist[OSI_MGBE_MAX_NUM_CHANS];
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 #ifndef OSI_STRIPPED_LIB
 	/** Flag which decides virtualization is enabled(1) or disabled(0) */
 	nveu32_t use_virtualization;
@@ -613,6 +727,8 @@ struct osi_dma_priv_data {
 	void *resv_buf_virt_addr;
 	/** Physical address of reserved DMA buffer */
 	nveu64_t resv_buf_phy_addr;
+	/** Software RSS configuration, see osi_config_sw_rss() */
+	struct osi_dma_sw_rss sw_rss;
 #endif /* !OSI_STRIPPED_LIB */
 	/** PTP flags
 	 * OSI_PTP_SYNC_MASTER - acting as master
@@ -1246,6 +1362,94 @@ nve32_t osi_clear_rx_pkt_err_stats(struct osi_dma_priv_data *osi_dma);
  * @retval 0 if ring has outstanding packets.
  */
 nve32_t osi_txring_empty(struct osi_dma_priv_data *osi_dma, nveu32_t chan);
+
+/**
+ * @brief osi_config_sw_rss - Configure software RSS.
+ *
+ * @note
+ * Algorithm:
+ *  - This function will be invoked by OSD layer after filling
+ *    osi_dma->sw_rss to (re)build the Toeplitz hash lookup table from
+ *    the key. When enabled, osi_sw_rss_hash() computes rx_hash,
+ *    rx_hash_type and rss_hint for packets without HW RSS hash, e.g. on
+ *    EQOS.
+ *  - IPv4/IPv6 TCP/UDP packets are hashed on addresses and ports, other
+ *    IP packets on addresses, limited to sw_rss.hash_types as MGBE HW
+ *    RSS does.
+ *
+ * @param[in, out] osi_dma: OSI DMA private data structure.
+ *
+ * @pre Rx processing must not run concurrently.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t osi_config_sw_rss(struct osi_dma_priv_data *osi_dma);
+
+/**
+ * @brief osi_sw_rss_hash - Compute software RSS hash of a received packet.
+ *
+ * @note
+ * Algorithm:
+ *  - This function will be invoked by OSD layer from receive_packet
+ *    callback, after the Rx buffer is synced for CPU access, with the
+ *    address of packet data.
+ *  - Packets already carrying a HW RSS hash (OSI_PKT_CX_RSS) are left
+ *    untouched. Otherwise Ethernet, IP and TCP/UDP headers within len
+ *    bytes are hashed and rx_hash, rx_hash_type and rss_hint are filled.
+ *
+ * @param[in] osi_dma: OSI DMA private data structure.
+ * @param[in] pkt: Start of packet data (Ethernet header).
+ * @param[in] len: Number of valid bytes at pkt, at most rx_pkt_cx->pkt_len.
+ * @param[in, out] rx_pkt_cx: Rx packet context of receive_packet callback.
+ *
+ * @pre Software RSS enabled with osi_config_sw_rss().
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t osi_sw_rss_hash(struct osi_dma_priv_data *osi_dma,
+			const nveu8_t *pkt, nveu32_t len,
+			struct osi_rx_pkt_cx *rx_pkt_cx);
+
+/**
+ * @brief osi_dma_stats_snapshot - Read a coherent copy of DMA statistics.
+ *
+ * @note
+ * Algorithm:
+ *  - Copy pkt_err_stats and dstats while no channel or stats clear is
+ *    updating them, and retry the copy up to OSI_STATS_SNAP_RETRY times
+ *    if an update started meanwhile. Tx/Rx paths update the counters of a
+ *    channel once per completion call, outside of OSD callbacks.
+ *  - Updates are never blocked, so this can be called from any context
+ *    concurrently with the Tx/Rx paths of all channels.
+ *
+ * @param[in] osi_dma: OSI DMA private data structure.
+ * @param[out] snap: Copy of the statistics and their generation.
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on invalid arguments or if updates never paused.
+ */
+nve32_t osi_dma_stats_snapshot(struct osi_dma_priv_data *osi_dma,
+			       struct osi_dma_stats_snap *snap);
 #endif /* !OSI_STRIPPED_LIB */
 
 /**
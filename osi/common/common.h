@@ -176,7 +176,11 @@ static inline void osi_unlock_irq_enabled(nveu32_t *lock)
  */
 static inline nveu32_t osi_readl(void *addr)
 {
+#ifdef OSI_MMIO_HOOK
+	return osi_mmio_hook_read(OSI_NULL, addr);
+#else
 	return *(volatile nveu32_t *)addr;
+#endif /* OSI_MMIO_HOOK */
 }
 
 /**
@@ -195,7 +199,11 @@ static inline nveu32_t osi_readl(void *addr)
  */
 static inline void osi_writel(nveu32_t val, void *addr)
 {
+#ifdef OSI_MMIO_HOOK
+	osi_mmio_hook_write(OSI_NULL, val, addr);
+#else
 	*(volatile nveu32_t *)addr = val;
+#endif /* OSI_MMIO_HOOK */
 }
 
 /**
@@ -215,7 +223,11 @@ static inline void osi_writel(nveu32_t val, void *addr)
  */
 static inline nveu32_t osi_readla(OSI_UNUSED void *priv, void *addr)
 {
+#ifdef OSI_MMIO_HOOK
+	return osi_mmio_hook_read(priv, addr);
+#else
 	return *(volatile nveu32_t *)addr;
+#endif /* OSI_MMIO_HOOK */
 }
 
 /**
@@ -234,7 +246,198 @@ static inline nveu32_t osi_readla(OSI_UNUSED void *priv, void *addr)
  */
 static inline void osi_writela(OSI_UNUSED void *priv, nveu32_t val, void *addr)
 {
+#ifdef OSI_MMIO_HOOK
+	osi_mmio_hook_write(priv, val, addr);
+#else
 	*(volatile nveu32_t *)addr = val;
+#endif /* OSI_MMIO_HOOK */
+}
+
+#ifdef OSI_MMIO_TRACE
+/**
+ * @brief osi_mmio_trace_readl - Read a register and record the access.
+ *
+ * @param[in] priv: Priv address.
+ * @param[in] addr: Memory mapped address.
+ * @param[in] func: Calling function.
+ * @param[in] line: Calling source line.
+ *
+ * @return Data from memory mapped register.
+ */
+static inline nveu32_t osi_mmio_trace_readl(void *priv, void *addr,
+					    const nve8_t *func,
+					    nveu32_t line)
+{
+	nveu32_t val = osi_readla(priv, addr);
+
+	osi_mmio_trace_record(addr, val, OSI_MMIO_TRACE_RD, func, line);
+
+	return val;
+}
+
+/**
+ * @brief osi_mmio_trace_writel - Write a register and record the access.
+ *
+ * @param[in] priv: Priv address.
+ * @param[in] val: Value to be written.
+ * @param[in] addr: Memory mapped address.
+ * @param[in] func: Calling function.
+ * @param[in] line: Calling source line.
+ */
+static inline void osi_mmio_trace_writel(void *priv, nveu32_t val,
+					 void *addr, const nve8_t *func,
+					 nveu32_t line)
+{
+	osi_writela(priv, val, addr);
+	osi_mmio_trace_record(addr, val, OSI_MMIO_TRACE_WR, func, line);
+}
+
+/* Route all register accesses from here on through the traced variants
+ * so that the calling site gets recorded.
+ */
+#define osi_readl(addr) \
+	osi_mmio_trace_readl(OSI_NULL, (addr), __func__, __LINE__)
+#define osi_writel(val, addr) \
+	osi_mmio_trace_writel(OSI_NULL, (val), (addr), __func__, __LINE__)
+#define osi_readla(priv, addr) \
+	osi_mmio_trace_readl((priv), (addr), __func__, __LINE__)
+#define osi_writela(priv, val, addr) \
+	osi_mmio_trace_writel((priv), (val), (addr), __func__, __LINE__)
+#endif /* OSI_MMIO_TRACE */
+
+/**
+ * @addtogroup REG_SHADOW Register shadow defines
+ *
+ * @brief Shadowed registers of one shadow row. DMA keeps one row per
+ * channel, core keeps a single row
+ * @{
+ */
+#define OSI_REG_SHADOW_MAX		8U
+/** DMA channel interrupt enable */
+#define OSI_SHADOW_DMA_INTR_ENA		0U
+/** DMA channel control */
+#define OSI_SHADOW_DMA_CTRL		1U
+/** DMA channel Tx control */
+#define OSI_SHADOW_DMA_TX_CTRL		2U
+/** DMA channel Rx control */
+#define OSI_SHADOW_DMA_RX_CTRL		3U
+/** DMA channel Rx interrupt watchdog timer */
+#define OSI_SHADOW_DMA_RX_WDT		4U
+/** MGBE DMA channel Tx control 2, EQOS Tx descriptor ring length */
+#define OSI_SHADOW_DMA_TX_CTRL2		5U
+/** MGBE DMA channel Rx control 2, EQOS Rx descriptor ring length */
+#define OSI_SHADOW_DMA_RX_CTRL2		6U
+/** MTL EST overhead */
+#define OSI_SHADOW_MTL_EST_OVERHEAD	0U
+/** MGBE MAC RSS control */
+#define OSI_SHADOW_MAC_RSS_CTRL		1U
+/** @} */
+
+/**
+ * @brief osi_reg_shadow - Write-through cache of configuration registers
+ * which only change on SW writes, indexed by OSI_SHADOW_* register. All
+ * accesses to a register must go through osi_shadow_readl()/
+ * osi_shadow_writel() once shadowed, and the shadow must be reset along
+ * with the MAC. A row is only accessed from the context owning it, e.g.
+ * its DMA channel, so rows need no locking.
+ */
+struct osi_reg_shadow {
+	/** Last value read from or written to register */
+	nveu32_t val[OSI_REG_SHADOW_MAX];
+	/** Bit per register set once val holds its value */
+	nveu32_t valid;
+#ifdef OSI_REG_SHADOW_CHECK
+	/** Number of shadow hits which didn't match HW */
+	nveu32_t mismatch;
+#endif /* OSI_REG_SHADOW_CHECK */
+};
+
+/**
+ * @brief osi_shadow_reset - Drop all shadowed register values.
+ *
+ * @param[out] sh: Register shadow.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: No
+ * - De-initialization: No
+ */
+static inline void osi_shadow_reset(struct osi_reg_shadow *const sh)
+{
+	sh->valid = 0U;
+#ifdef OSI_REG_SHADOW_CHECK
+	sh->mismatch = 0U;
+#endif /* OSI_REG_SHADOW_CHECK */
+}
+
+/**
+ * @brief osi_shadow_readl - Read a configuration register from shadow.
+ *
+ * @note
+ * Algorithm:
+ *  - Return shadowed value, or read the register and shadow it.
+ *  - With OSI_REG_SHADOW_CHECK, also read the register on a shadow hit,
+ *    count a mismatch and return HW value.
+ *
+ * @param[in, out] sh: Register shadow.
+ * @param[in] reg: Shadowed register, OSI_SHADOW_*.
+ * @param[in] base: Memory mapped MAC base address.
+ * @param[in] off: Register offset from MAC base.
+ *
+ * @return Register value.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: Yes
+ * - De-initialization: Yes
+ */
+static inline nveu32_t osi_shadow_readl(struct osi_reg_shadow *const sh,
+					nveu32_t reg, void *base, nveu32_t off)
+{
+	nveu32_t val;
+
+	if ((sh->valid & OSI_BIT(reg)) == 0U) {
+		val = osi_readl((nveu8_t *)base + off);
+		sh->val[reg] = val;
+		sh->valid |= OSI_BIT(reg);
+	} else {
+		val = sh->val[reg];
+#ifdef OSI_REG_SHADOW_CHECK
+		if (osi_readl((nveu8_t *)base + off) != val) {
+			sh->mismatch++;
+			val = osi_readl((nveu8_t *)base + off);
+			sh->val[reg] = val;
+		}
+#endif /* OSI_REG_SHADOW_CHECK */
+	}
+
+	return val;
+}
+
+/**
+ * @brief osi_shadow_writel - Write a configuration register and shadow it.
+ *
+ * @param[in, out] sh: Register shadow.
+ * @param[in] reg: Shadowed register, OSI_SHADOW_*.
+ * @param[in] val: Value to be written.
+ * @param[in] base: Memory mapped MAC base address.
+ * @param[in] off: Register offset from MAC base.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: Yes
+ * - De-initialization: Yes
+ */
+static inline void osi_shadow_writel(struct osi_reg_shadow *const sh,
+				     nveu32_t reg, nveu32_t val, void *base,
+				     nveu32_t off)
+{
+	osi_writel(val, (nveu8_t *)base + off);
+	sh->val[reg] = val;
+	sh->valid |= OSI_BIT(reg);
 }
 
 /**
@@ -74,3 +74,77 @@ nveu64_t div_u64_rem(nveu64_t dividend, nveu64_t divisor,
 
 	return ret;
 }
+
+#ifdef OSI_MMIO_TRACE
+/** Active MMIO trace ring, OSI_NULL while recording is stopped */
+static struct osi_mmio_trace *mmio_trace = OSI_NULL;
+
+void osi_mmio_trace_start(struct osi_mmio_trace *trace)
+{
+	mmio_trace = trace;
+	__sync_synchronize();
+}
+
+void osi_mmio_trace_record(void *addr, nveu32_t val, nveu32_t dir,
+			   const nve8_t *func, nveu32_t line)
+{
+	struct osi_mmio_trace *trace = mmio_trace;
+	struct osi_mmio_trace_ent *ent;
+	nveu64_t seq;
+
+	if (trace != OSI_NULL) {
+		/* Claim a record, concurrent writers get distinct ones */
+		seq = __sync_fetch_and_add(&trace->head, 1ULL);
+		ent = &trace->ent[seq & (OSI_MMIO_TRACE_SZ - 1U)];
+
+		ent->seq = 0U;
+		__sync_synchronize();
+		ent->ts = (trace->get_ts != OSI_NULL) ? trace->get_ts() : 0U;
+		ent->addr = addr;
+		ent->val = val;
+		ent->dir = dir;
+		ent->func = func;
+		ent->line = line;
+		/* Publish record only once it is complete */
+		__sync_synchronize();
+		ent->seq = seq + 1U;
+	}
+}
+
+nveu64_t osi_mmio_trace_replay(const struct osi_mmio_trace *trace,
+			       nveu64_t from,
+			       void (*fn)(void *priv,
+					  const struct osi_mmio_trace_ent *ent),
+			       void *priv)
+{
+	const struct osi_mmio_trace_ent *ent;
+	struct osi_mmio_trace_ent copy;
+	nveu64_t head = trace->head;
+	nveu64_t seq = from;
+
+	__sync_synchronize();
+
+	if ((head > OSI_MMIO_TRACE_SZ) &&
+	    (seq < (head - OSI_MMIO_TRACE_SZ))) {
+		/* Records were overwritten, start at oldest one */
+		seq = head - OSI_MMIO_TRACE_SZ;
+	}
+
+	while (seq < head) {
+		ent = &trace->ent[seq & (OSI_MMIO_TRACE_SZ - 1U)];
+		/* Skip records still being written or already overwritten */
+		if (ent->seq == (seq + 1U)) {
+			__sync_synchronize();
+			(void)osi_memcpy(&copy, ent, sizeof(copy));
+			/* Writer may have reused the record during the copy */
+			__sync_synchronize();
+			if (ent->seq == (seq + 1U)) {
+				fn(priv, &copy);
+			}
+		}
+		seq++;
+	}
+
+	return seq;
+}
+#endif /* OSI_MMIO_TRACE */
@@ -609,6 +609,14 @@ fail:
 	return ret;
 }
 
+/**
+ * @brief MTL_EST_GCL_Control indirect access protocol
+ */
+static const struct indir_proto est_proto = {
+	INDIR_PROTO_EST, MTL_EST_SRWO, MTL_EST_ERR0,
+	OSI_DELAY_1US, RETRY_COUNT
+};
+
 /**
  * @brief hw_est_read - indirect read the GCL to Software own list
  * (SWOL)
@@ -632,42 +640,18 @@ static inline nve32_t hw_est_read(struct osi_core_priv_data *osi_core,
 				  nveu32_t gcla, nveu32_t bunk,
 				  nveu32_t mac)
 {
-	nve32_t retry = 1000;
+	nveu8_t *base = (nveu8_t *)osi_core->base;
 	nveu32_t val = 0U;
-	nve32_t ret;
 	const nveu32_t MTL_EST_GCL_CONTROL[MAX_MAC_IP_TYPES] = {
 			EQOS_MTL_EST_GCL_CONTROL, MGBE_MTL_EST_GCL_CONTROL};
 	const nveu32_t MTL_EST_DATA[MAX_MAC_IP_TYPES] = {EQOS_MTL_EST_DATA, MGBE_MTL_EST_DATA};
 
-	*data = 0U;
 	val &= ~MTL_EST_ADDR_MASK;
 	val |= (gcla == 1U) ? 0x0U : MTL_EST_GCRR;
 	val |= MTL_EST_SRWO | MTL_EST_R1W0 | MTL_EST_DBGM | bunk | addr_val;
-	osi_writela(osi_core, val, (nveu8_t *)osi_core->base +
-		    MTL_EST_GCL_CONTROL[mac]);
-
-	while (--retry > 0) {
-		val = osi_readla(osi_core, (nveu8_t *)osi_core->base +
-				 MTL_EST_GCL_CONTROL[mac]);
-		if ((val & MTL_EST_SRWO) == MTL_EST_SRWO) {
-			continue;
-		}
-		osi_core->osd_ops.udelay(OSI_DELAY_1US);
 
-		break;
-	}
-
-	if (((val & MTL_EST_ERR0) == MTL_EST_ERR0) ||
-	    (retry <= 0)) {
-		ret = -1;
-		goto err;
-	}
-
-	*data = osi_readla(osi_core, (nveu8_t *)osi_core->base +
-			   MTL_EST_DATA[mac]);
-	ret = 0;
-err:
-	return ret;
+	return indir_read(osi_core, &est_proto, base + MTL_EST_DATA[mac],
+			  base + MTL_EST_GCL_CONTROL[mac], val, data);
 }
 
 /**
@@ -874,41 +858,22 @@ static nve32_t hw_est_write(struct osi_core_priv_data *osi_core,
 			    nveu32_t addr_val, nveu32_t data,
 			    nveu32_t gcla)
 {
-	nve32_t retry = 1000;
+	nveu8_t *base = (nveu8_t *)osi_core->base;
 	nveu32_t val = 0x0;
-	nve32_t ret = 0;
 	const nveu32_t MTL_EST_DATA[MAX_MAC_IP_TYPES] = {EQOS_MTL_EST_DATA,
 						MGBE_MTL_EST_DATA};
 	const nveu32_t MTL_EST_GCL_CONTROL[MAX_MAC_IP_TYPES] = {EQOS_MTL_EST_GCL_CONTROL,
 						MGBE_MTL_EST_GCL_CONTROL};
 
-	osi_writela(osi_core, data, (nveu8_t *)osi_core->base +
-		   MTL_EST_DATA[osi_core->mac]);
-
 	val &= ~MTL_EST_ADDR_MASK;
 	val |= (gcla == 1U) ? 0x0U : MTL_EST_GCRR;
 	val |= MTL_EST_SRWO;
 	val |= addr_val;
-	osi_writela(osi_core, val, (nveu8_t *)osi_core->base +
-		    MTL_EST_GCL_CONTROL[osi_core->mac]);
-
-	while (--retry > 0) {
-		val = osi_readla(osi_core, (nveu8_t *)osi_core->base +
-				 MTL_EST_GCL_CONTROL[osi_core->mac]);
-		if ((val & MTL_EST_SRWO) == MTL_EST_SRWO) {
-			osi_core->osd_ops.udelay(OSI_DELAY_1US);
-			continue;
-		}
 
-		break;
-	}
-
-	if (((val & MTL_EST_ERR0) == MTL_EST_ERR0) ||
-	    (retry <= 0)) {
-		ret = -1;
-	}
-
-	return ret;
+	return indir_write(osi_core, &est_proto,
+			   base + MTL_EST_DATA[osi_core->mac],
+			   base + MTL_EST_GCL_CONTROL[osi_core->mac],
+			   data, val);
 }
 
 /**
@@ -1360,6 +1325,7 @@ static inline void save_gcl_params(struct osi_core_priv_data *osi_core)
 void hw_tsn_init(struct osi_core_priv_data *osi_core,
 		 nveu32_t est_sel, nveu32_t fpe_sel)
 {
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
 	nveu32_t val = 0x0;
 	nveu32_t temp = 0U;
 	const nveu32_t MTL_EST_CONTROL[MAX_MAC_IP_TYPES] = {EQOS_MTL_EST_CONTROL,
@@ -1431,13 +1397,17 @@ void hw_tsn_init(struct osi_core_priv_data *osi_core,
 		osi_writela(osi_core, val, (nveu8_t *)osi_core->base +
 			    MTL_EST_CONTROL[osi_core->mac]);
 
-		val = osi_readla(osi_core, (nveu8_t *)osi_core->base +
-				MTL_EST_OVERHEAD[osi_core->mac]);
+		val = osi_shadow_readl(&l_core->reg_shadow,
+				       OSI_SHADOW_MTL_EST_OVERHEAD,
+				       osi_core->base,
+				       MTL_EST_OVERHEAD[osi_core->mac]);
 		val &= ~MTL_EST_OVERHEAD_OVHD[osi_core->mac];
 		/* As per hardware programming info */
 		val |= MTL_EST_OVERHEAD_RECOMMEND[osi_core->mac];
-		osi_writela(osi_core, val, (nveu8_t *)osi_core->base +
-			    MTL_EST_OVERHEAD[osi_core->mac]);
+		osi_shadow_writel(&l_core->reg_shadow,
+				  OSI_SHADOW_MTL_EST_OVERHEAD, val,
+				  osi_core->base,
+				  MTL_EST_OVERHEAD[osi_core->mac]);
 
 		enable_mtl_interrupts(osi_core);
 	}
@@ -1833,3 +1803,202 @@ nve32_t hw_validate_avb_input(struct osi_core_priv_data *const osi_core,
 fail:
 	return ret;
 }
+
+/** Saturation value of MMC SW counters */
+#define MMC_CNT_MAX	(~0ULL)
+
+/**
+ * @brief mmc_sts_bit - Check if a counter crossed half or maximum value.
+ *
+ * Algorithm: Read the status register of the counter once per pass and
+ *	return the counter bit of it. Status bits are cleared by HW when
+ *	the counter is read, so status is read before the counters.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ * @param[in] cnt: Counter.
+ *
+ * @retval OSI_ENABLE if status bit of counter is set
+ * @retval OSI_DISABLE otherwise
+ */
+static nveu32_t mmc_sts_bit(struct osi_core_priv_data *const osi_core,
+			    struct mmc_sts *const sts,
+			    const struct mmc_cnt *const cnt)
+{
+	nveu32_t ret = OSI_DISABLE;
+
+	if ((cnt->sts < MMC_STS_MAX) && (sts->reg[cnt->sts] != 0U)) {
+		if ((sts->read & OSI_BIT(cnt->sts)) == OSI_NONE) {
+			sts->val[cnt->sts] = osi_readla(osi_core,
+							(nveu8_t *)osi_core->base +
+							sts->reg[cnt->sts]);
+			sts->read |= OSI_BIT(cnt->sts);
+		}
+		if ((sts->val[cnt->sts] & OSI_BIT(cnt->bit)) != OSI_NONE) {
+			ret = OSI_ENABLE;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief mmc_read_cnt - Accumulate MMC counter registers into 64 bit
+ *	SW counters.
+ *
+ * Algorithm:
+ * - Counters are reset on read, so each read returns the count since the
+ *   previous one and is added to the SW counter.
+ * - 64 bit counters combine lower and upper 32 bit registers.
+ * - A 32 bit counter whose status bit is set but reads below half of its
+ *   range went past its maximum value, account for the rollover.
+ * - When harvesting from the MMC interrupt, skip counters whose status
+ *   bit is not set.
+ * - SW counters saturate instead of wrapping, they are only cleared by
+ *   an explicit MMC reset.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] cnt: Counter registers and SW counters.
+ * @param[in] num: Number of entries in cnt.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+void mmc_read_cnt(struct osi_core_priv_data *const osi_core,
+		  const struct mmc_cnt *const cnt, const nveu32_t num,
+		  struct mmc_sts *const sts)
+{
+	nveu8_t *base = (nveu8_t *)osi_core->base;
+	nveu32_t wrap;
+	nveu64_t delta;
+	nveu32_t i;
+
+	for (i = 0U; i < num; i++) {
+		wrap = OSI_DISABLE;
+		if ((cnt[i].reg_h == 0U) || (sts->harvest == OSI_ENABLE)) {
+			wrap = mmc_sts_bit(osi_core, sts, &cnt[i]);
+		}
+
+		if ((sts->harvest == OSI_ENABLE) && (wrap == OSI_DISABLE)) {
+			continue;
+		}
+
+		delta = osi_readla(osi_core, base + cnt[i].reg);
+		if (cnt[i].reg_h != 0U) {
+			delta |= ((nveu64_t)osi_readla(osi_core, base +
+						       cnt[i].reg_h)) << 32U;
+		} else if ((wrap == OSI_ENABLE) && (delta < TWO_POWER_31)) {
+			delta += TWO_POWER_32;
+		} else {
+			/* No rollover since previous read */
+		}
+
+		if (*cnt[i].val <= (MMC_CNT_MAX - delta)) {
+			*cnt[i].val += delta;
+		} else {
+			*cnt[i].val = MMC_CNT_MAX;
+		}
+	}
+}
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief hw_remap_vm_irq - Move a DMA channel to another VM IRQ.
+ *
+ * Algorithm:
+ * 1) Find the VM IRQ the channel is currently mapped to in irq_data.
+ * 2) Route the channel to the target VM with a single write of the APB
+ *    routing register and read it back to make sure the write landed.
+ *    The channel interrupt enables in VIRT_INTR_CHX_CNTRL belong to the
+ *    DMA instance and are not touched.
+ * 3) Read the channel virtual interrupt status after the switch. Bits
+ *    still set there were raised before or during the switch and may have
+ *    been signalled on the old VM IRQ only, return them to the caller so
+ *    that the OSD handles them on the new VM IRQ.
+ * 4) Move the channel between irq_data entries, so that a later core
+ *    init programs the same mapping.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] chan: DMA channel.
+ * @param[in] irq_idx: Index of target VM IRQ in irq_data.
+ * @param[out] pending: VIRT_INTR_CHX_STATUS bits pending after the
+ *		       switch, 0 if none or on failure.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t hw_remap_vm_irq(struct osi_core_priv_data *const osi_core,
+			const nveu32_t chan, const nveu32_t irq_idx,
+			nveu32_t *const pending)
+{
+	nveu8_t *base = (nveu8_t *)osi_core->base;
+	const nveu32_t max_chans[MAX_MAC_IP_TYPES] = { OSI_EQOS_MAX_NUM_CHANS,
+						       OSI_MGBE_MAX_NUM_CHANS };
+	struct osi_vm_irq_data *src = OSI_NULL;
+	struct osi_vm_irq_data *dst;
+	nveu32_t i, j;
+	nveu32_t pos = 0U;
+	nve32_t ret = -1;
+
+	*pending = 0U;
+	if ((osi_core->mac == OSI_MAC_HW_EQOS) &&
+	    (osi_core->mac_ver < OSI_EQOS_MAC_5_30)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OPNOTSUPP,
+			     "VM IRQ mapping not supported\n",
+			     (nveul64_t)osi_core->mac_ver);
+		goto fail;
+	}
+
+	if ((chan >= max_chans[osi_core->mac]) ||
+	    (irq_idx >= osi_core->num_vm_irqs) ||
+	    (osi_core->num_vm_irqs > OSI_MAX_VM_IRQS)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Invalid VM IRQ remap arguments\n",
+			     (nveul64_t)chan);
+		goto fail;
+	}
+
+	for (i = 0U; (i < osi_core->num_vm_irqs) && (src == OSI_NULL); i++) {
+		for (j = 0U; (j < osi_core->irq_data[i].num_vm_chans) &&
+		     (j < OSI_MGBE_MAX_NUM_CHANS); j++) {
+			if (osi_core->irq_data[i].vm_chans[j] == chan) {
+				src = &osi_core->irq_data[i];
+				pos = j;
+				break;
+			}
+		}
+	}
+
+	dst = &osi_core->irq_data[irq_idx];
+	if (src == OSI_NULL) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "DMA channel not mapped to any VM IRQ\n",
+			     (nveul64_t)chan);
+		goto fail;
+	}
+
+	if (src == dst) {
+		/* Already mapped as requested */
+		ret = 0;
+		goto fail;
+	}
+
+	if (dst->num_vm_chans >= OSI_MGBE_MAX_NUM_CHANS) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
+			     "VM IRQ has no room for channel\n",
+			     (nveul64_t)irq_idx);
+		goto fail;
+	}
+
+	osi_writela(osi_core, OSI_BIT(dst->vm_num),
+		    base + HW_VIRT_INTR_APB_CHX_CNTRL(chan));
+	(void)osi_readla(osi_core, base + HW_VIRT_INTR_APB_CHX_CNTRL(chan));
+	*pending = osi_readla(osi_core, base + HW_VIRT_INTR_CHX_STATUS(chan));
+
+	src->num_vm_chans--;
+	src->vm_chans[pos] = src->vm_chans[src->num_vm_chans];
+	dst->vm_chans[dst->num_vm_chans] = chan;
+	dst->num_vm_chans++;
+	ret = 0;
+fail:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
@@ -97,6 +97,10 @@
 #define MAC_PKT_FILTER_REG		0x0008
 #define HW_MAC_IER				0x00B4U
 #define WRAP_COMMON_INTR_ENABLE		0x8704U
+#ifndef OSI_STRIPPED_LIB
+#define HW_VIRT_INTR_APB_CHX_CNTRL(x)	(0x8200U + ((x) * 4U))
+#define HW_VIRT_INTR_CHX_STATUS(x)	(0x8604U + ((x) * 8U))
+#endif /* !OSI_STRIPPED_LIB */
 
 /* common l3 l4 register bit fields for eqos and mgbe */
 #ifndef OSI_STRIPPED_LIB
@@ -178,4 +182,12 @@ nve32_t hsi_common_error_inject(struct osi_core_priv_data *osi_core,
 #endif
 nve32_t hw_validate_avb_input(struct osi_core_priv_data *const osi_core,
 			      const struct osi_core_avb_algorithm *const avb);
+void mmc_read_cnt(struct osi_core_priv_data *const osi_core,
+		  const struct mmc_cnt *const cnt, const nveu32_t num,
+		  struct mmc_sts *const sts);
+#ifndef OSI_STRIPPED_LIB
+nve32_t hw_remap_vm_irq(struct osi_core_priv_data *const osi_core,
+			const nveu32_t chan, const nveu32_t irq_idx,
+			nveu32_t *const pending);
+#endif /* !OSI_STRIPPED_LIB */
 #endif /* INCLUDED_CORE_COMMON_H */
@@ -25,6 +25,8 @@
 
 #include <osi_core.h>
 #include <local_common.h>
+#include "../osi/common/common.h"
+#include "indir.h"
 
 /**
  * @brief Maximum number of OSI core instances.
@@ -104,6 +106,20 @@ struct if_core_ops {
 	/** Interface function called to handle runtime commands */
 	nve32_t (*if_handle_ioctl)(struct osi_core_priv_data *osi_core,
 				   struct osi_ioctl *data);
+#ifndef OSI_STRIPPED_LIB
+	/** Interface function called to handle several runtime commands */
+	nve32_t (*if_handle_ioctl_batch)(struct osi_core_priv_data *osi_core,
+					 struct osi_ioctl *data,
+					 nve32_t *status, const nveu32_t num);
+	/** Interface function called to start a runtime command, which
+	 * completes with ioctl_req_done() */
+	nve32_t (*if_ioctl_submit)(struct osi_core_priv_data *osi_core,
+				   struct osi_ioctl *data,
+				   const nveu32_t req_id);
+	/** Interface function called with response of a submitted command */
+	nve32_t (*if_ioctl_complete)(struct osi_core_priv_data *osi_core,
+				     struct ivc_msg_common *reply);
+#endif /* !OSI_STRIPPED_LIB */
 };
 
 /**
@@ -130,8 +146,9 @@ struct core_ops {
 				  const nveu32_t nsec,
 				  const nveu32_t neg_adj,
 				  const nveu32_t one_nsec_accuracy);
-	/** Called to update MMC counter from HW register */
-	void (*read_mmc)(struct osi_core_priv_data *const osi_core);
+	/** Called to update MMC counter groups from HW register */
+	void (*read_mmc)(struct osi_core_priv_data *const osi_core,
+			 const nveu32_t groups);
 	/** Called to write into a PHY reg over MDIO bus */
 	nve32_t (*write_phy_reg)(struct osi_core_priv_data *const osi_core,
 				 const nveu32_t phyaddr,
@@ -202,12 +219,24 @@ struct core_ops {
 	nve32_t (*config_mac_loopback)(
 				struct osi_core_priv_data *const osi_core,
 				const nveu32_t lb_mode);
-	/** Called to configure RSS for MAC */
-	nve32_t (*config_rss)(struct osi_core_priv_data *osi_core);
+	/** Called to configure RSS for MAC with the given hash key and hash
+	 * types, queued into job if not OSI_NULL */
+	nve32_t (*config_rss)(struct osi_core_priv_data *osi_core,
+			      const nveu8_t *const key,
+			      const nveu32_t hash_types,
+			      struct indir_job *const job);
+	/** Called to program one RSS indirection table entry, queued into
+	 * job if not OSI_NULL */
+	nve32_t (*write_rss_entry)(struct osi_core_priv_data *const osi_core,
+				   const nveu32_t idx, const nveu32_t chan,
+				   struct indir_job *const job);
 	/** Called to configure the PTP RX packets Queue */
 	nve32_t (*config_ptp_rxq)(struct osi_core_priv_data *const osi_core,
 				  const nveu32_t rxq_idx,
 				  const nveu32_t enable);
+	/** Called to map user priorities to Rx queues from rxq_prio and
+	 * flow_rxq_prio, can be OSI_NULL if not supported by HW */
+	void (*config_rxq_prio)(struct osi_core_priv_data *const osi_core);
 #endif /* !OSI_STRIPPED_LIB */
 	/** Called to set av parameter */
 	nve32_t (*set_avb_algorithm)(struct osi_core_priv_data *const osi_core,
@@ -304,6 +333,84 @@ struct core_l2 {
 	struct osi_filter filter;
 };
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @addtogroup L3L4 filter manager helper macros
+ *
+ * @brief Rule table size, hashing and placement defines
+ * @{
+ */
+/** Maximum number of L3/L4 rules tracked by the filter manager */
+#define L3L4_MGR_MAX_RULES		256U
+/** Number of hash buckets, must be power of 2 */
+#define L3L4_MGR_HASH_SIZE		64U
+/** Rule is not placed, only while it moves between placements */
+#define L3L4_MGR_PLACE_NONE		0U
+/** Rule is programmed in an L3/L4 HW filter slot */
+#define L3L4_MGR_PLACE_HW		1U
+/** Rule is programmed as FRP instruction chain */
+#define L3L4_MGR_PLACE_FRP		2U
+/** FRP ID range reserved for rules spilled by the filter manager */
+#define L3L4_MGR_FRP_ID_BASE		(OSI_FRP_ID_RSVD_BASE + 0x100)
+/** Hit difference needed to swap a rule into a HW slot */
+#define L3L4_MGR_SWAP_HYST		64U
+/** Hit count at which all rule counters are halved */
+#define L3L4_MGR_HITS_AGE_LIMIT		((nveu64_t)1U << 48U)
+/** @} */
+
+/**
+ * @brief L3/L4 filter manager rule
+ */
+struct l3l4_mgr_rule {
+	/** Rule as requested by OSD */
+	struct osi_l3_l4_filter filter;
+	/** Hits reported for this rule */
+	nveu64_t hits;
+	/** Next rule index + 1 in the hash chain, 0 for end of chain */
+	nveu32_t next;
+	/** Rule placement, one of L3L4_MGR_PLACE_* */
+	nveu32_t place;
+	/** HW filter index when placement is L3L4_MGR_PLACE_HW */
+	nveu32_t hw_idx;
+	/** Rule slot in use (OSI_ENABLE) or free (OSI_DISABLE) */
+	nveu32_t in_use;
+};
+
+/**
+ * @brief L3/L4 filter manager context
+ */
+struct l3l4_mgr {
+	/** Rule storage */
+	struct l3l4_mgr_rule rules[L3L4_MGR_MAX_RULES];
+	/** Hash bucket heads, rule index + 1, 0 for empty bucket */
+	nveu32_t bucket[L3L4_MGR_HASH_SIZE];
+	/** Rule index + 1 owning each HW filter slot, 0 for free slot */
+	nveu32_t hw_owner[OSI_MGBE_MAX_L3_L4_FILTER];
+	/** Number of rules in use */
+	nveu32_t rule_cnt;
+};
+
+/** FRP ID range reserved for flow steering rules */
+#define FLOW_STEER_FRP_ID_BASE		OSI_FRP_ID_RSVD_BASE
+
+/**
+ * @brief Flow steering rule context
+ */
+struct flow_steer_rule {
+	/** Rule as requested by OSD */
+	struct osi_flow_rule rule;
+	/** Total hits reported for this rule */
+	nveu64_t hits;
+	/** HW backing the rule OSI_FLOW_HW_*, L3/L4 filter manager owned
+	 * rules may move between L3/L4 filter and FRP */
+	nveu32_t hw;
+	/** Rule owned by L3/L4 filter manager (OSI_ENABLE) or not */
+	nveu32_t l3l4_mgr;
+	/** Rule in use (OSI_ENABLE) or free (OSI_DISABLE) */
+	nveu32_t in_use;
+};
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief Dynamic config storage structure
  */
@@ -334,6 +441,107 @@ struct dynamic_cfg {
 	struct core_l2 l2[EQOS_MAX_MAC_ADDRESS_FILTER];
 };
 
+/**
+ * @brief Number of 32 bit words in VLAN ID bitmap of resume snapshot
+ */
+#define RESUME_VID_WORDS	(VLAN_NUM_VID / 32U)
+
+/**
+ * @brief Compact record of dynamic configuration taken on suspend, only
+ * holding what differs from HW reset defaults
+ */
+struct core_resume_snap {
+	/** DYNAMIC_CFG_* categories to be restored on resume */
+	nveu32_t flags;
+	/** Bitmap of enabled L3/L4 filters */
+	nveu32_t l3l4_map;
+	/** Bitmap of queues with AVB configuration */
+	nveu32_t avb_map;
+#ifndef OSI_STRIPPED_LIB
+	/** Bitmap of VLAN IDs to be added back */
+	nveu32_t vid_map[RESUME_VID_WORDS];
+#endif /* !OSI_STRIPPED_LIB */
+	/** Number of entries restored by last resume */
+	nveu32_t entries;
+};
+
+/**
+ * @addtogroup MMC_STS MMC interrupt status registers
+ *
+ * @brief Index of MMC interrupt status register flagging counters which
+ * crossed half or maximum value
+ * @{
+ */
+#define MMC_STS_TX		0U
+#define MMC_STS_RX		1U
+#define MMC_STS_IPC		2U
+#define MMC_STS_FPE_TX		3U
+#define MMC_STS_FPE_RX		4U
+#define MMC_STS_MAX		5U
+/** Counter without interrupt status bit */
+#define MMC_STS_NONE		MMC_STS_MAX
+/** @} */
+
+/**
+ * @brief MMC counter register and the SW counter it is accumulated into
+ */
+struct mmc_cnt {
+	/** Counter register offset, lower 32 bits for 64 bit counters */
+	nveu32_t reg;
+	/** Upper 32 bits register offset, 0 for 32 bit counters */
+	nveu32_t reg_h;
+	/** MMC_STS_* status register of counter */
+	nveu32_t sts;
+	/** Bit of counter in status register */
+	nveu32_t bit;
+	/** SW counter in osi_core_priv_data->mmc */
+	nveu64_t *val;
+};
+
+/**
+ * @brief MMC interrupt status registers read while accumulating counters
+ */
+struct mmc_sts {
+	/** Status register offsets indexed by MMC_STS_*, 0 if not present */
+	const nveu32_t *reg;
+	/** Status register values */
+	nveu32_t val[MMC_STS_MAX];
+	/** Bitmap of status registers already read into val */
+	nveu32_t read;
+	/** OSI_ENABLE to only read counters whose status bit is set */
+	nveu32_t harvest;
+};
+
+/**
+ * @brief FRP match atom, match data of one FRP instruction
+ */
+struct frp_atom {
+	/** Match data */
+	nveu32_t match_data;
+	/** Match enable mask */
+	nveu32_t match_en;
+	/** Frame offset in FRP_MD_SIZE units */
+	nveu8_t frame_offset;
+	/** Inverse match (OSI_ENABLE) or normal match (OSI_DISABLE) */
+	nveu8_t inverse;
+};
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief Command started with osi_ioctl_submit()
+ */
+struct ioctl_req {
+	/** Request ID, 0 for a free entry */
+	nveu32_t id;
+	/** OSI_ASYNC_PENDING or OSI_ASYNC_DONE */
+	nveu32_t state;
+	/** Caller ioctl data, updated with outputs on completion */
+	struct osi_ioctl *data;
+	/** Return value of the command once done */
+	nve32_t status;
+};
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief Core local data structure.
  */
@@ -378,14 +586,81 @@ struct core_local {
 	struct dynamic_cfg cfg;
 	/** Hardware dynamic configuration state */
 	nveu32_t state;
+	/** Dynamic configuration recorded on suspend */
+	struct core_resume_snap resume_snap;
 	/** XPCS Lane bringup/Block lock status */
 	nveu32_t lane_status;
 	/** Exact MAC used across SOCs 0:Legacy EQOS, 1:Orin EQOS, 2:Orin MGBE */
 	nveu32_t l_mac_ver;
+	/** FRP rule set, commands of one rule are consecutive with same ID */
+	struct osi_core_frp_cmd frp_rules[OSI_FRP_MAX_ENTRY];
+	/** Number of commands in FRP rule set */
+	nveu32_t frp_rules_cnt;
+	/** First atom of each FRP rule, indexed by its first command. Only
+	 * used while compiling the rule set */
+	struct frp_atom frp_first[OSI_FRP_MAX_ENTRY];
+	/** FRP_INFO_* flags of each FRP rule, indexed by its first command.
+	 * Only used while compiling the rule set */
+	nveu8_t frp_flags[OSI_FRP_MAX_ENTRY];
+	/** Shadow of FRP instruction table entries written into HW */
+	struct osi_core_frp_data frp_hw[OSI_FRP_MAX_ENTRY];
+	/** HW location of active FRP table, 0 when HW shadow isn't valid */
+	nveu32_t frp_hw_start;
+	/** Number of HW entries of active FRP table including BYPASS */
+	nveu32_t frp_hw_len;
+	/** Shadow of MAC configuration registers only changed by SW */
+	struct osi_reg_shadow reg_shadow;
+	/** Indirect register access statistics indexed by INDIR_PROTO_* */
+	struct indir_stats indir_stats[INDIR_PROTO_MAX];
 #if defined(L3L4_WILDCARD_FILTER)
 	/** l3l4 wildcard filter configured (OSI_ENABLE) / not configured (OSI_DISABLE) */
 	nveu32_t l3l4_wildcard_filter_configured;
 #endif /* L3L4_WILDCARD_FILTER */
+#ifndef OSI_STRIPPED_LIB
+	/** L3/L4 filter manager context */
+	struct l3l4_mgr l3l4_mgr;
+	/** Flow steering rules indexed by rule ID */
+	struct flow_steer_rule flow_rules[OSI_FLOW_MAX_RULES];
+	/** VLAN priorities mapped to each Rx queue by flow steering rules,
+	 * programmed along with the OSD owned osi_core->rxq_prio */
+	nveu32_t flow_rxq_prio[OSI_MGBE_MAX_NUM_CHANS];
+	/** Shadow of RSS indirection table entries written into HW */
+	nveu32_t rss_hw_table[OSI_RSS_MAX_TABLE_SIZE];
+	/** rss_hw_table matches HW (OSI_ENABLE) or not (OSI_DISABLE) */
+	nveu32_t rss_hw_valid;
+	/** Hash types last written or queued into HW by config_rss */
+	nveu32_t rss_hw_hash_types;
+	/** Hash key of an asynchronous RSS profile, stored in osi_core->rss
+	 * once its job completed */
+	nveu8_t rss_stage_key[OSI_RSS_HASH_KEY_SIZE];
+	/** Hash types of an asynchronous RSS profile */
+	nveu32_t rss_stage_hash_types;
+	/** Per channel Rx packet counters at last RSS rebalance */
+	nveu64_t rss_rx_pkt_n[OSI_MGBE_MAX_NUM_CHANS];
+	/** Indirection table of an asynchronous RSS rebalance, stored in
+	 * osi_core->rss once its job completed */
+	nveu32_t rss_stage_table[OSI_RSS_MAX_TABLE_SIZE];
+	/** Rx packet counters of an asynchronous RSS rebalance */
+	nveu64_t rss_stage_rx_pkt_n[OSI_MGBE_MAX_NUM_CHANS];
+	/** Entries moved by the last asynchronous RSS rebalance, 0 until
+	 * its job completed */
+	nveu32_t rss_stage_moved;
+	/** Pending asynchronous ioctl HW writes */
+	struct indir_job async_job;
+	/** Call statistics indexed by OSI_CMD_* and OSI_LAT_MACSEC_* */
+	struct osi_lat_stats lat_stats[OSI_LAT_MAX];
+	/** Update sequence of osi_core stats and mmc, held only while they
+	 * are written so that snapshots run concurrently with any ioctl */
+	struct osi_stats_seq stats_seq;
+	/** Commands started with osi_ioctl_submit() */
+	struct ioctl_req ioctl_req[OSI_IOCTL_MAX_PENDING];
+	/** Last allocated request ID */
+	nveu32_t ioctl_req_id;
+	/** stats_page sequence of the last mmc and stats copy */
+	nveu32_t stats_page_gen;
+	/** stats_page sequence of the last MACsec counters copy */
+	nveu32_t stats_page_gen_macsec;
+#endif /* !OSI_STRIPPED_LIB */
 };
 
 /**
@@ -476,6 +751,26 @@ void hw_interface_init_core_ops(struct if_core_ops *if_ops_p);
  */
 void ivc_interface_init_core_ops(struct if_core_ops *if_ops_p);
 
+/**
+ * @brief configure_l3l4_filter_helper - Program L3/L4 HW filter slot.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] filter_no: HW filter index.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t configure_l3l4_filter_helper(struct osi_core_priv_data *const osi_core,
+				     nveu32_t filter_no,
+				     const struct osi_l3_l4_filter *const l3_l4);
+
 /**
  * @brief get osi pointer for PTP primary/sec interface
  *
@@ -507,4 +802,83 @@ void ivc_interface_init_core_ops(struct if_core_ops *if_ops_p);
  * @retval NULL on failure.
  */
 struct osi_core_priv_data *get_role_pointer(nveu32_t role);
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief lat_start - Sample clock at start of an instrumented call.
+ *
+ * @param[in] osi_core: OSI core private data structure, can be OSI_NULL.
+ *
+ * @return Time in nsec, 0 without clock callback.
+ */
+nveu64_t lat_start(struct osi_core_priv_data *const osi_core);
+
+/**
+ * @brief lat_end - Account one instrumented call.
+ *
+ * @note
+ * Algorithm:
+ *  - Count call and failure, then add latency into log2 histogram when
+ *    OSD provides a clock.
+ *
+ * @param[in] osi_core: OSI core private data structure, can be OSI_NULL.
+ * @param[in] idx: OSI_CMD_* command or OSI_LAT_MACSEC_* index.
+ * @param[in] start: Time returned by lat_start().
+ * @param[in] ret: Return value of the call.
+ */
+void lat_end(struct osi_core_priv_data *const osi_core, const nveu32_t idx,
+	     const nveu64_t start, const nve32_t ret);
+
+/**
+ * @brief ioctl_req_data - Find ioctl data of a pending submitted command.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] req_id: Request ID of the command.
+ *
+ * @return ioctl data, OSI_NULL if req_id is not pending.
+ */
+struct osi_ioctl *ioctl_req_data(struct osi_core_priv_data *const osi_core,
+				 const nveu32_t req_id);
+
+/**
+ * @brief ioctl_req_done - Record completion of a submitted command.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] req_id: Request ID of the command.
+ * @param[in] status: Return value of the command.
+ */
+void ioctl_req_done(struct osi_core_priv_data *const osi_core,
+		    const nveu32_t req_id, const nve32_t status);
+
+/**
+ * @brief stats_page_publish - Publish server statistics to stats page.
+ *
+ * Algorithm: Make page sequence odd, copy mmc, stats and MACsec counters
+ * into the page and make the sequence even again. Nothing is done for
+ * virtualized instances or when no page is mapped. Core and MACsec calls
+ * are expected to be serialized by OSD, so there is a single writer.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ */
+void stats_page_publish(struct osi_core_priv_data *const osi_core);
+
+/**
+ * @brief stats_page_read - Copy statistics published by the server.
+ *
+ * Algorithm: Copy from the read-only stats page while its sequence is even
+ * and retry if the sequence changed during the copy. The server publishes
+ * only after some commands, so a page not updated since the last read is
+ * not copied and the caller asks the server over IVC instead.
+ *
+ * @param[in, out] osi_core: OSI core private data structure with stats_page.
+ * @param[in] macsec: Copy MACsec counters (OSI_ENABLE) or mmc and
+ *		      stats (OSI_DISABLE).
+ *
+ * @retval 0 on success
+ * @retval -1 if the page is unchanged since the last read or the server
+ *	   never paused updating it.
+ */
+nve32_t stats_page_read(struct osi_core_priv_data *const osi_core,
+			const nveu32_t macsec);
+#endif /* !OSI_STRIPPED_LIB */
 #endif /* INCLUDED_CORE_LOCAL_H */
@@ -571,13 +571,23 @@ done:
 }
 
 /**
- * @brief eqos_frp_write - Write FRP entry into HW
+ * @brief MTL_RXP_Indirect_Acc_Control_Status indirect access protocol
+ */
+static const struct indir_proto eqos_frp_proto = {
+	INDIR_PROTO_FRP, EQOS_MTL_RXP_IND_CS_BUSY, OSI_NONE,
+	EQOS_MTL_FRP_READ_UDELAY, EQOS_MTL_FRP_READ_RETRY
+};
+
+/**
+ * @brief eqos_frp_write - Write FRP entry registers into HW
  *
- * Algorithm: This function will write FRP entry registers into HW.
+ * Algorithm: This function waits for FRP indirect access to be ready and
+ * writes the queued FRP registers back to back.
  *
  * @param[in] osi_core: OSI core private data structure.
- * @param[in] addr: FRP register address.
- * @param[in] data: FRP register data.
+ * @param[in, out] ent: FRP register data and address in ctrl field,
+ *		   ctrl is updated with complete control register value.
+ * @param[in] num: Number of registers in ent.
  *
  * @note MAC should be init and started. see osi_start_mac()
  *
@@ -585,58 +595,37 @@ done:
  * @retval -1 on failure.
  */
 static nve32_t eqos_frp_write(struct osi_core_priv_data *osi_core,
-			      nveu32_t addr,
-			      nveu32_t data)
+			      struct indir_entry *const ent,
+			      const nveu32_t num)
 {
 	nve32_t ret = 0;
 	nveu8_t *base = osi_core->base;
 	nveu32_t val = 0U;
+	nveu32_t i;
 
 	/* Wait for ready */
-	ret = osi_readl_poll_timeout((base + EQOS_MTL_RXP_IND_CS),
-				     (osi_core->osd_ops.udelay),
-				     (val),
-				     ((val & EQOS_MTL_RXP_IND_CS_BUSY) ==
-				      OSI_NONE),
-				     (EQOS_MTL_FRP_READ_UDELAY),
-				     (EQOS_MTL_FRP_READ_RETRY));
+	ret = indir_poll(osi_core, &eqos_frp_proto, base + EQOS_MTL_RXP_IND_CS,
+			 &val);
 	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to write\n",
-			val);
-		ret = -1;
 		goto done;
 	}
 
-	/* Write data into MTL_RXP_Indirect_Acc_Data */
-	osi_writel(data, base + EQOS_MTL_RXP_IND_DATA);
-
 	/* Program MTL_RXP_Indirect_Acc_Control_Status */
-	val = osi_readl(base + EQOS_MTL_RXP_IND_CS);
 	/* Set WRRDN for write */
 	val |= EQOS_MTL_RXP_IND_CS_WRRDN;
-	/* Clear and add ADDR */
+	/* Clear ADDR */
 	val &= ~EQOS_MTL_RXP_IND_CS_ADDR;
-	val |= (addr & EQOS_MTL_RXP_IND_CS_ADDR);
 	/* Start write */
 	val |= EQOS_MTL_RXP_IND_CS_BUSY;
-	osi_writel(val, base + EQOS_MTL_RXP_IND_CS);
-
-	/* Wait for complete */
-	ret = osi_readl_poll_timeout((base + EQOS_MTL_RXP_IND_CS),
-				     (osi_core->osd_ops.udelay),
-				     (val),
-				     ((val & EQOS_MTL_RXP_IND_CS_BUSY) ==
-				      OSI_NONE),
-				     (EQOS_MTL_FRP_READ_UDELAY),
-				     (EQOS_MTL_FRP_READ_RETRY));
-	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to write\n",
-			val);
-		ret = -1;
+	for (i = 0U; i < num; i++) {
+		ent[i].ctrl = val | (ent[i].ctrl & EQOS_MTL_RXP_IND_CS_ADDR);
 	}
 
+	/* Each write starts as soon as the previous one completed */
+	ret = indir_write_batch(osi_core, &eqos_frp_proto,
+				base + EQOS_MTL_RXP_IND_DATA,
+				base + EQOS_MTL_RXP_IND_CS, ent, num);
+
 done:
 	return ret;
 }
@@ -659,6 +648,7 @@ static nve32_t eqos_update_frp_entry(struct osi_core_priv_data *const osi_core,
 				     const nveu32_t pos,
 				     struct osi_core_frp_data *const data)
 {
+	struct indir_entry ent[EQOS_MTL_FRP_IE_CNT];
 	nveu32_t val = 0U, tmp = 0U;
 	nve32_t ret = -1;
 
@@ -671,25 +661,15 @@ static nve32_t eqos_update_frp_entry(struct osi_core_priv_data *const osi_core,
 		goto done;
 	}
 
-	/** Write Match Data into IE0 **/
-	val = data->match_data;
-	ret = eqos_frp_write(osi_core, EQOS_MTL_FRP_IE0(pos), val);
-	if (ret < 0) {
-		/* Match Data Write fail */
-		ret = -1;
-		goto done;
-	}
+	/** Match Data into IE0 **/
+	ent[0].data = data->match_data;
+	ent[0].ctrl = EQOS_MTL_FRP_IE0(pos);
 
-	/** Write Match Enable into IE1 **/
-	val = data->match_en;
-	ret = eqos_frp_write(osi_core, EQOS_MTL_FRP_IE1(pos), val);
-	if (ret < 0) {
-		/* Match Enable Write fail */
-		ret = -1;
-		goto done;
-	}
+	/** Match Enable into IE1 **/
+	ent[1].data = data->match_en;
+	ent[1].ctrl = EQOS_MTL_FRP_IE1(pos);
 
-	/** Write AF, RF, IM, NIC, FO and OKI into IE2 **/
+	/** AF, RF, IM, NIC, FO and OKI into IE2 **/
 	val = 0;
 	if (data->accept_frame == OSI_ENABLE) {
 		/* Set AF Bit */
@@ -713,20 +693,15 @@ static nve32_t eqos_update_frp_entry(struct osi_core_priv_data *const osi_core,
 	val |= ((tmp << EQOS_MTL_FRP_IE2_OKI_SHIFT) & EQOS_MTL_FRP_IE2_OKI);
 	tmp = data->dma_chsel;
 	val |= ((tmp << EQOS_MTL_FRP_IE2_DCH_SHIFT) & EQOS_MTL_FRP_IE2_DCH);
-	ret = eqos_frp_write(osi_core, EQOS_MTL_FRP_IE2(pos), val);
-	if (ret < 0) {
-		/* FRP IE2 Write fail */
-		ret = -1;
-		goto done;
-	}
+	ent[2].data = val;
+	ent[2].ctrl = EQOS_MTL_FRP_IE2(pos);
 
-	/** Write DCH into IE3 **/
-	val = OSI_NONE;
-	ret = eqos_frp_write(osi_core, EQOS_MTL_FRP_IE3(pos), val);
-	if (ret < 0) {
-		/* DCH Write fail */
-		ret = -1;
-	}
+	/** DCH into IE3 **/
+	ent[3].data = OSI_NONE;
+	ent[3].ctrl = EQOS_MTL_FRP_IE3(pos);
+
+	/* Write IE0-IE3 */
+	ret = eqos_frp_write(osi_core, ent, EQOS_MTL_FRP_IE_CNT);
 
 done:
 	return ret;
@@ -740,7 +715,8 @@ done:
  * @note
  * Algorithm:
  *  - This takes care of mapping user priority to Rx queue.
- *    User provided priority mask updated to register. Valid input can have
+ *    User provided priority mask, along with priorities of flow steering
+ *    rules, updated to register. Valid input can have
  *    all TC(0xFF) in one queue to None(0x00) in rx queue.
  *    The software must ensure that the content of this field is mutually
  *    exclusive to the PSRQ fields for other queues, that is, the same
@@ -753,14 +729,18 @@ done:
  * @note
  * API Group:
  * - Initialization: Yes
- * - Run time: No
+ * - Run time: Yes
  * - De-initialization: No
  */
 static void eqos_configure_rxq_priority(
 				struct osi_core_priv_data *const osi_core)
 {
+#ifndef OSI_STRIPPED_LIB
+	const struct core_local *l_core = (struct core_local *)(void *)osi_core;
+#endif /* !OSI_STRIPPED_LIB */
 	nveu32_t val;
 	nveu32_t temp;
+	nveu32_t prio;
 	nveu32_t qinx, mtlq;
 	nveu32_t pmask = 0x0U;
 	nveu32_t mfix_var1, mfix_var2;
@@ -771,12 +751,20 @@ static void eqos_configure_rxq_priority(
 
 	for (qinx = 0; qinx < osi_core->num_mtl_queues; qinx++) {
 		mtlq = osi_core->mtl_queues[qinx];
+		prio = osi_core->rxq_prio[mtlq];
+#ifndef OSI_STRIPPED_LIB
+		/* Priorities of flow steering rules */
+		prio |= l_core->flow_rxq_prio[mtlq];
+#endif /* !OSI_STRIPPED_LIB */
+		if (prio == 0U) {
+			/* No priority mapped to this queue */
+			continue;
+		}
+
 		/* check for PSRQ field mutual exclusive for all queues */
-		if ((osi_core->rxq_prio[mtlq] <= 0xFFU) &&
-		    (osi_core->rxq_prio[mtlq] > 0x0U) &&
-		    ((pmask & osi_core->rxq_prio[mtlq]) == 0U)) {
-			pmask |= osi_core->rxq_prio[mtlq];
-			temp = osi_core->rxq_prio[mtlq];
+		if ((prio <= 0xFFU) && ((pmask & prio) == 0U)) {
+			pmask |= prio;
+			temp = prio;
 		} else {
 			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
 				     "Invalid rxq Priority for Q\n",
@@ -1078,22 +1066,25 @@ static void eqos_configure_mac(struct osi_core_priv_data *const osi_core)
 	}
 	osi_writela(osi_core, value, (nveu8_t *)osi_core->base + EQOS_MAC_RQC1R);
 
-	/* Disable all MMC interrupts */
-	/* Disable all MMC Tx Interrupts */
-	osi_writela(osi_core, EQOS_MMC_INTR_DISABLE, (nveu8_t *)osi_core->base +
-		   EQOS_MMC_TX_INTR_MASK);
-	/* Disable all MMC RX interrupts */
-	osi_writela(osi_core, EQOS_MMC_INTR_DISABLE, (nveu8_t *)osi_core->base +
-		    EQOS_MMC_RX_INTR_MASK);
-	/* Disable MMC Rx interrupts for IPC */
-	osi_writela(osi_core, EQOS_MMC_INTR_DISABLE, (nveu8_t *)osi_core->base +
-		    EQOS_MMC_IPC_RX_INTR_MASK);
-
-	/* Configure MMC counters */
+	/* Unmask MMC interrupts of counters harvested on half or max value */
+	/* MMC Tx Interrupts */
+	osi_writela(osi_core, (EQOS_MMC_INTR_DISABLE & ~EQOS_MMC_TX_INTR_CNT),
+		    (nveu8_t *)osi_core->base + EQOS_MMC_TX_INTR_MASK);
+	/* MMC RX interrupts */
+	osi_writela(osi_core, (EQOS_MMC_INTR_DISABLE & ~EQOS_MMC_RX_INTR_CNT),
+		    (nveu8_t *)osi_core->base + EQOS_MMC_RX_INTR_MASK);
+	/* MMC Rx interrupts for IPC */
+	osi_writela(osi_core,
+		    (EQOS_MMC_INTR_DISABLE & ~EQOS_MMC_IPC_RX_INTR_CNT),
+		    (nveu8_t *)osi_core->base + EQOS_MMC_IPC_RX_INTR_MASK);
+
+	/* Configure MMC counters. Counters are not preset, a preset close to
+	 * maximum value would be accounted as rollover.
+	 */
 	value = osi_readla(osi_core,
 			   (nveu8_t *)osi_core->base + EQOS_MMC_CNTRL);
-	value |= EQOS_MMC_CNTRL_CNTRST | EQOS_MMC_CNTRL_RSTONRD |
-		 EQOS_MMC_CNTRL_CNTPRST | EQOS_MMC_CNTRL_CNTPRSTLVL;
+	value &= ~(EQOS_MMC_CNTRL_CNTPRST | EQOS_MMC_CNTRL_CNTPRSTLVL);
+	value |= EQOS_MMC_CNTRL_CNTRST | EQOS_MMC_CNTRL_RSTONRD;
 	osi_writela(osi_core, value,
 		    (nveu8_t *)osi_core->base + EQOS_MMC_CNTRL);
 
@@ -1515,6 +1506,11 @@ static void eqos_handle_mac_intrs(struct osi_core_priv_data *const osi_core,
 
 	/* Handle MAC interrupts */
 	if ((dma_isr & EQOS_DMA_ISR_MACIS) == EQOS_DMA_ISR_MACIS) {
+		/* MMC interrupts are not gated by MAC_IMR */
+		if ((mac_isr & EQOS_MAC_ISR_MMCIS) == EQOS_MAC_ISR_MMCIS) {
+			eqos_mmc_harvest(osi_core);
+		}
+
 #ifdef HSI_SUPPORT
 		if (osi_core->mac_ver >= OSI_EQOS_MAC_5_30) {
 			/* T23X-EQOS_HSIv2-19: Consistency Monitor for TX Frame */
@@ -4099,12 +4095,44 @@ static nve32_t eqos_post_pad_calibrate(
  * Algorithm: Programes RSS hash table or RSS hash key.
  *
  * @param[in] osi_core: OSI core private data.
+ * @param[in] key: RSS hash key, unused.
+ * @param[in] hash_types: Hashed packet types, unused.
+ * @param[in] job: Asynchronous job, unused.
  *
  * @retval -1 Always
  */
-static nve32_t eqos_config_rss(struct osi_core_priv_data *osi_core)
+static nve32_t eqos_config_rss(struct osi_core_priv_data *osi_core,
+			       const nveu8_t *const key,
+			       const nveu32_t hash_types,
+			       struct indir_job *const job)
 {
 	(void) osi_core;
+	(void)key;
+	(void)hash_types;
+	(void)job;
+	OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+		     "RSS not supported by EQOS\n", 0ULL);
+
+	return -1;
+}
+
+/**
+ * @brief eqos_write_rss_entry - Program one RSS indirection table entry
+ *
+ * @param[in] osi_core: OSI core private data.
+ * @param[in] idx: Hash table index
+ * @param[in] chan: DMA channel for the entry
+ * @param[in] job: Asynchronous job, unused.
+ *
+ * @retval -1 Always
+ */
+static nve32_t eqos_write_rss_entry(struct osi_core_priv_data *const osi_core,
+				    const nveu32_t idx, const nveu32_t chan,
+				    struct indir_job *const job)
+{
+	(void)idx;
+	(void)chan;
+	(void)job;
 	OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
 		     "RSS not supported by EQOS\n", 0ULL);
 
@@ -4256,7 +4284,9 @@ void eqos_init_core_ops(struct core_ops *ops)
 	ops->set_mdc_clk_rate = eqos_set_mdc_clk_rate;
 	ops->config_mac_loopback = eqos_config_mac_loopback;
 	ops->config_rss = eqos_config_rss;
+	ops->write_rss_entry = eqos_write_rss_entry;
 	ops->config_ptp_rxq = eqos_config_ptp_rxq;
+	ops->config_rxq_prio = eqos_configure_rxq_priority;
 #endif /* !OSI_STRIPPED_LIB */
 #ifdef HSI_SUPPORT
 	ops->core_hsi_configure = eqos_hsi_configure;
@@ -221,6 +221,7 @@
 #define EQOS_MTL_FRP_IE1(x)			(((x) * 0x4U) + 0x1U)
 #define EQOS_MTL_FRP_IE2(x)			(((x) * 0x4U) + 0x2U)
 #define EQOS_MTL_FRP_IE3(x)			(((x) * 0x4U) + 0x3U)
+#define EQOS_MTL_FRP_IE_CNT			4U
 #define EQOS_MTL_FRP_IE2_DCH			(OSI_BIT(31) | OSI_BIT(30) | \
 						 OSI_BIT(29) | OSI_BIT(28) | \
 						 OSI_BIT(27) | OSI_BIT(26) | \
@@ -404,6 +405,7 @@
 
 #define EQOS_MAC_ISR_RGSMIIS			OSI_BIT(0)
 #define EQOS_MAC_IMR_FPEIS			OSI_BIT(17)
+#define EQOS_MAC_ISR_MMCIS			OSI_BIT(8)
 #define EQOS_MTL_TXQ_QW_ISCQW			OSI_BIT(4)
 #define EQOS_RXQ_EN_MASK                       (OSI_BIT(0) | OSI_BIT(1))
 #define EQOS_DMA_SBUS_RD_OSR_LMT		0x001F0000U
@@ -507,6 +509,10 @@
 				 (TEGRA_SID_EQOS_CH5) |\
 				 (TEGRA_SID_EQOS))
 #define EQOS_MMC_INTR_DISABLE	0xFFFFFFFFU
+/* MMC counters harvested from MMC interrupt */
+#define EQOS_MMC_TX_INTR_CNT	0x0FFFFFFFU
+#define EQOS_MMC_RX_INTR_CNT	0x0FFFFFFFU
+#define EQOS_MMC_IPC_RX_INTR_CNT	0x3FFF3FFFU
 
 /* MAC FPE control/statusOSI_BITmap */
 #define EQOS_MAC_FPE_CTS_EFPE			OSI_BIT(0)
@@ -24,18 +24,13 @@
 #include <osi_core.h>
 #include "eqos_mmc.h"
 #include "eqos_core.h"
+#include "core_common.h"
 
 /**
- * @brief update_mmc_val - function to read register and return value to callee
- *
- * @note
- * Algorithm:
- *  - Read the registers, check for boundary, if more, reset
- *    counters else return same to caller.
+ * @brief eqos_reset_mmc - To reset MMC registers and ether_mmc_counter
+ *        structure variable
  *
  * @param[in, out] osi_core: OSI core private data structure.
- * @param[in] last_value: previous value of stats variable.
- * @param[in] offset: HW register offset
  *
  * @pre
  *  - MAC should be init and started. see osi_start_mac()
@@ -46,57 +41,369 @@
  * - Initialization: No
  * - Run time: Yes
  * - De-initialization: No
+ */
+void eqos_reset_mmc(struct osi_core_priv_data *const osi_core)
+{
+	nveu32_t value;
+
+	value = osi_readla(osi_core,
+			   (nveu8_t *)osi_core->base + EQOS_MMC_CNTRL);
+	/* self-clear bit in one clock cycle */
+	value |= EQOS_MMC_CNTRL_CNTRST;
+	osi_writela(osi_core, value,
+		    (nveu8_t *)osi_core->base + EQOS_MMC_CNTRL);
+	osi_memset(&osi_core->mmc, 0U, sizeof(struct osi_mmc_counters));
+}
+
+/**
+ * @brief MMC interrupt status registers indexed by MMC_STS_*
+ */
+static const nveu32_t eqos_mmc_sts_reg[MMC_STS_MAX] = {
+	MMC_TX_INTR,
+	MMC_RX_INTR,
+	MMC_IPC_RX_INTR,
+	MMC_FPE_TX_INTR,
+	MMC_FPE_RX_INTR,
+};
+
+/**
+ * @brief eqos_read_mmc_tx - Read Tx packet and octet counters
  *
- * @retval 0 on success
- * @retval -1 on failure
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
  */
-static inline nveu64_t update_mmc_val(struct osi_core_priv_data *const osi_core,
-				      nveu64_t last_value,
-				      nveu64_t offset)
+static void eqos_read_mmc_tx(struct osi_core_priv_data *const osi_core,
+			     struct mmc_sts *const sts)
 {
-	nveu64_t temp = 0;
-	nveu32_t value = osi_readla(osi_core,
-				    (nveu8_t *)osi_core->base + offset);
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TXOCTETCOUNT_GB, 0U, MMC_STS_TX, 0U,
+		  &mmc->mmc_tx_octetcount_gb },
+		{ MMC_TXPACKETCOUNT_GB, 0U, MMC_STS_TX, 1U,
+		  &mmc->mmc_tx_framecount_gb },
+		{ MMC_TXBROADCASTPACKETS_G, 0U, MMC_STS_TX, 2U,
+		  &mmc->mmc_tx_broadcastframe_g },
+		{ MMC_TXMULTICASTPACKETS_G, 0U, MMC_STS_TX, 3U,
+		  &mmc->mmc_tx_multicastframe_g },
+		{ MMC_TXUNICASTPACKETS_GB, 0U, MMC_STS_TX, 10U,
+		  &mmc->mmc_tx_unicast_gb },
+		{ MMC_TXMULTICASTPACKETS_GB, 0U, MMC_STS_TX, 11U,
+		  &mmc->mmc_tx_multicast_gb },
+		{ MMC_TXBROADCASTPACKETS_GB, 0U, MMC_STS_TX, 12U,
+		  &mmc->mmc_tx_broadcast_gb },
+		{ MMC_TXOCTETCOUNT_G, 0U, MMC_STS_TX, 20U,
+		  &mmc->mmc_tx_octetcount_g },
+		{ MMC_TXPACKETSCOUNT_G, 0U, MMC_STS_TX, 21U,
+		  &mmc->mmc_tx_framecount_g },
+		{ MMC_TXPAUSEPACKETS, 0U, MMC_STS_TX, 23U,
+		  &mmc->mmc_tx_pause_frame },
+		{ MMC_TXVLANPACKETS_G, 0U, MMC_STS_TX, 24U,
+		  &mmc->mmc_tx_vlan_frame_g },
+	};
 
-	temp = last_value + value;
-	if (temp < last_value) {
-		OSI_CORE_ERR(osi_core->osd,
-			     OSI_LOG_ARG_OUTOFBOUND,
-			     "Value overflow resetting  all counters\n",
-			     (nveul64_t)offset);
-		eqos_reset_mmc(osi_core);
-	}
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
 
-	return temp;
+/**
+ * @brief eqos_read_mmc_rx - Read Rx packet and octet counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void eqos_read_mmc_rx(struct osi_core_priv_data *const osi_core,
+			     struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_RXPACKETCOUNT_GB, 0U, MMC_STS_RX, 0U,
+		  &mmc->mmc_rx_framecount_gb },
+		{ MMC_RXOCTETCOUNT_GB, 0U, MMC_STS_RX, 1U,
+		  &mmc->mmc_rx_octetcount_gb },
+		{ MMC_RXOCTETCOUNT_G, 0U, MMC_STS_RX, 2U,
+		  &mmc->mmc_rx_octetcount_g },
+		{ MMC_RXBROADCASTPACKETS_G, 0U, MMC_STS_RX, 3U,
+		  &mmc->mmc_rx_broadcastframe_g },
+		{ MMC_RXMULTICASTPACKETS_G, 0U, MMC_STS_RX, 4U,
+		  &mmc->mmc_rx_multicastframe_g },
+		{ MMC_RXUNICASTPACKETS_G, 0U, MMC_STS_RX, 17U,
+		  &mmc->mmc_rx_unicast_g },
+		{ MMC_RXPAUSEPACKETS, 0U, MMC_STS_RX, 20U,
+		  &mmc->mmc_rx_pause_frames },
+		{ MMC_RXVLANPACKETS_GB, 0U, MMC_STS_RX, 22U,
+		  &mmc->mmc_rx_vlan_frames_gb },
+		{ MMC_RXCTRLPACKETS_G, 0U, MMC_STS_RX, 25U,
+		  &mmc->mmc_rx_ctrl_frames_g },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
 }
 
 /**
- * @brief eqos_reset_mmc - To reset MMC registers and ether_mmc_counter
- *        structure variable
+ * @brief eqos_read_mmc_size - Read Tx and Rx packet size histogram counters
  *
  * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void eqos_read_mmc_size(struct osi_core_priv_data *const osi_core,
+			       struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TX64OCTETS_GB, 0U, MMC_STS_TX, 4U,
+		  &mmc->mmc_tx_64_octets_gb },
+		{ MMC_TX65TO127OCTETS_GB, 0U, MMC_STS_TX, 5U,
+		  &mmc->mmc_tx_65_to_127_octets_gb },
+		{ MMC_TX128TO255OCTETS_GB, 0U, MMC_STS_TX, 6U,
+		  &mmc->mmc_tx_128_to_255_octets_gb },
+		{ MMC_TX256TO511OCTETS_GB, 0U, MMC_STS_TX, 7U,
+		  &mmc->mmc_tx_256_to_511_octets_gb },
+		{ MMC_TX512TO1023OCTETS_GB, 0U, MMC_STS_TX, 8U,
+		  &mmc->mmc_tx_512_to_1023_octets_gb },
+		{ MMC_TX1024TOMAXOCTETS_GB, 0U, MMC_STS_TX, 9U,
+		  &mmc->mmc_tx_1024_to_max_octets_gb },
+		{ MMC_TXOVERSIZE_G, 0U, MMC_STS_TX, 25U,
+		  &mmc->mmc_tx_osize_frame_g },
+		{ MMC_RXUNDERSIZE_G, 0U, MMC_STS_RX, 9U,
+		  &mmc->mmc_rx_undersize_g },
+		{ MMC_RXOVERSIZE_G, 0U, MMC_STS_RX, 10U,
+		  &mmc->mmc_rx_oversize_g },
+		{ MMC_RX64OCTETS_GB, 0U, MMC_STS_RX, 11U,
+		  &mmc->mmc_rx_64_octets_gb },
+		{ MMC_RX65TO127OCTETS_GB, 0U, MMC_STS_RX, 12U,
+		  &mmc->mmc_rx_65_to_127_octets_gb },
+		{ MMC_RX128TO255OCTETS_GB, 0U, MMC_STS_RX, 13U,
+		  &mmc->mmc_rx_128_to_255_octets_gb },
+		{ MMC_RX256TO511OCTETS_GB, 0U, MMC_STS_RX, 14U,
+		  &mmc->mmc_rx_256_to_511_octets_gb },
+		{ MMC_RX512TO1023OCTETS_GB, 0U, MMC_STS_RX, 15U,
+		  &mmc->mmc_rx_512_to_1023_octets_gb },
+		{ MMC_RX1024TOMAXOCTETS_GB, 0U, MMC_STS_RX, 16U,
+		  &mmc->mmc_rx_1024_to_max_octets_gb },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief eqos_read_mmc_err - Read Tx and Rx error counters
  *
- * @pre
- *  - MAC should be init and started. see osi_start_mac()
- *  - osi_core->osd should be populated
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void eqos_read_mmc_err(struct osi_core_priv_data *const osi_core,
+			      struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TXUNDERFLOWERROR, 0U, MMC_STS_TX, 13U,
+		  &mmc->mmc_tx_underflow_error },
+		{ MMC_TXSINGLECOL_G, 0U, MMC_STS_TX, 14U,
+		  &mmc->mmc_tx_singlecol_g },
+		{ MMC_TXMULTICOL_G, 0U, MMC_STS_TX, 15U,
+		  &mmc->mmc_tx_multicol_g },
+		{ MMC_TXDEFERRED, 0U, MMC_STS_TX, 16U,
+		  &mmc->mmc_tx_deferred },
+		{ MMC_TXLATECOL, 0U, MMC_STS_TX, 17U,
+		  &mmc->mmc_tx_latecol },
+		{ MMC_TXEXESSCOL, 0U, MMC_STS_TX, 18U,
+		  &mmc->mmc_tx_exesscol },
+		{ MMC_TXCARRIERERROR, 0U, MMC_STS_TX, 19U,
+		  &mmc->mmc_tx_carrier_error },
+		{ MMC_TXEXCESSDEF, 0U, MMC_STS_TX, 22U,
+		  &mmc->mmc_tx_excessdef },
+		{ MMC_RXCRCERROR, 0U, MMC_STS_RX, 5U,
+		  &mmc->mmc_rx_crc_error },
+		{ MMC_RXALIGNMENTERROR, 0U, MMC_STS_RX, 6U,
+		  &mmc->mmc_rx_align_error },
+		{ MMC_RXRUNTERROR, 0U, MMC_STS_RX, 7U,
+		  &mmc->mmc_rx_runt_error },
+		{ MMC_RXJABBERERROR, 0U, MMC_STS_RX, 8U,
+		  &mmc->mmc_rx_jabber_error },
+		{ MMC_RXLENGTHERROR, 0U, MMC_STS_RX, 18U,
+		  &mmc->mmc_rx_length_error },
+		{ MMC_RXOUTOFRANGETYPE, 0U, MMC_STS_RX, 19U,
+		  &mmc->mmc_rx_outofrangetype },
+		{ MMC_RXFIFOOVERFLOW, 0U, MMC_STS_RX, 21U,
+		  &mmc->mmc_rx_fifo_overflow },
+		{ MMC_RXWATCHDOGERROR, 0U, MMC_STS_RX, 23U,
+		  &mmc->mmc_rx_watchdog_error },
+		{ MMC_RXRCVERROR, 0U, MMC_STS_RX, 24U,
+		  &mmc->mmc_rx_receive_error },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief eqos_read_mmc_lpi - Read LPI counters
  *
- * @note
- * API Group:
- * - Initialization: No
- * - Run time: Yes
- * - De-initialization: No
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
  */
-void eqos_reset_mmc(struct osi_core_priv_data *const osi_core)
+static void eqos_read_mmc_lpi(struct osi_core_priv_data *const osi_core,
+			      struct mmc_sts *const sts)
 {
-	nveu32_t value;
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TXLPIUSECCNTR, 0U, MMC_STS_TX, 26U,
+		  &mmc->mmc_tx_lpi_usec_cntr },
+		{ MMC_TXLPITRANCNTR, 0U, MMC_STS_TX, 27U,
+		  &mmc->mmc_tx_lpi_tran_cntr },
+		{ MMC_RXLPIUSECCNTR, 0U, MMC_STS_RX, 26U,
+		  &mmc->mmc_rx_lpi_usec_cntr },
+		{ MMC_RXLPITRANCNTR, 0U, MMC_STS_RX, 27U,
+		  &mmc->mmc_rx_lpi_tran_cntr },
+	};
 
-	value = osi_readla(osi_core,
-			   (nveu8_t *)osi_core->base + EQOS_MMC_CNTRL);
-	/* self-clear bit in one clock cycle */
-	value |= EQOS_MMC_CNTRL_CNTRST;
-	osi_writela(osi_core, value,
-		    (nveu8_t *)osi_core->base + EQOS_MMC_CNTRL);
-	osi_memset(&osi_core->mmc, 0U, sizeof(struct osi_mmc_counters));
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief eqos_read_mmc_fpe - Read frame preemption counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void eqos_read_mmc_fpe(struct osi_core_priv_data *const osi_core,
+			      struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TX_FPE_FRAG_COUNTER, 0U, MMC_STS_FPE_TX, 0U,
+		  &mmc->mmc_tx_fpe_frag_cnt },
+		{ MMC_TX_HOLD_REQ_COUNTER, 0U, MMC_STS_FPE_TX, 1U,
+		  &mmc->mmc_tx_fpe_hold_req_cnt },
+		{ MMC_RX_PKT_ASSEMBLY_ERR_CNTR, 0U, MMC_STS_FPE_RX, 0U,
+		  &mmc->mmc_rx_packet_reass_err_cnt },
+		{ MMC_RX_PKT_SMD_ERR_CNTR, 0U, MMC_STS_FPE_RX, 1U,
+		  &mmc->mmc_rx_packet_smd_err_cnt },
+		{ MMC_RX_PKT_ASSEMBLY_OK_CNTR, 0U, MMC_STS_FPE_RX, 2U,
+		  &mmc->mmc_rx_packet_asm_ok_cnt },
+		{ MMC_RX_FPE_FRAG_CNTR, 0U, MMC_STS_FPE_RX, 3U,
+		  &mmc->mmc_rx_fpe_fragment_cnt },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief eqos_read_mmc_csum - Read Rx checksum offload counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void eqos_read_mmc_csum(struct osi_core_priv_data *const osi_core,
+			       struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_RXIPV4_GD_PKTS, 0U, MMC_STS_IPC, 0U,
+		  &mmc->mmc_rx_ipv4_gd },
+		{ MMC_RXIPV4_HDRERR_PKTS, 0U, MMC_STS_IPC, 1U,
+		  &mmc->mmc_rx_ipv4_hderr },
+		{ MMC_RXIPV4_NOPAY_PKTS, 0U, MMC_STS_IPC, 2U,
+		  &mmc->mmc_rx_ipv4_nopay },
+		{ MMC_RXIPV4_FRAG_PKTS, 0U, MMC_STS_IPC, 3U,
+		  &mmc->mmc_rx_ipv4_frag },
+		{ MMC_RXIPV4_UBSBL_PKTS, 0U, MMC_STS_IPC, 4U,
+		  &mmc->mmc_rx_ipv4_udsbl },
+		{ MMC_RXIPV6_GD_PKTS, 0U, MMC_STS_IPC, 5U,
+		  &mmc->mmc_rx_ipv6_gd },
+		{ MMC_RXIPV6_HDRERR_PKTS, 0U, MMC_STS_IPC, 6U,
+		  &mmc->mmc_rx_ipv6_hderr },
+		{ MMC_RXIPV6_NOPAY_PKTS, 0U, MMC_STS_IPC, 7U,
+		  &mmc->mmc_rx_ipv6_nopay },
+		{ MMC_RXUDP_GD_PKTS, 0U, MMC_STS_IPC, 8U,
+		  &mmc->mmc_rx_udp_gd },
+		{ MMC_RXUDP_ERR_PKTS, 0U, MMC_STS_IPC, 9U,
+		  &mmc->mmc_rx_udp_err },
+		{ MMC_RXTCP_GD_PKTS, 0U, MMC_STS_IPC, 10U,
+		  &mmc->mmc_rx_tcp_gd },
+		{ MMC_RXTCP_ERR_PKTS, 0U, MMC_STS_IPC, 11U,
+		  &mmc->mmc_rx_tcp_err },
+		{ MMC_RXICMP_GD_PKTS, 0U, MMC_STS_IPC, 12U,
+		  &mmc->mmc_rx_icmp_gd },
+		{ MMC_RXICMP_ERR_PKTS, 0U, MMC_STS_IPC, 13U,
+		  &mmc->mmc_rx_icmp_err },
+		{ MMC_RXIPV4_GD_OCTETS, 0U, MMC_STS_IPC, 16U,
+		  &mmc->mmc_rx_ipv4_gd_octets },
+		{ MMC_RXIPV4_HDRERR_OCTETS, 0U, MMC_STS_IPC, 17U,
+		  &mmc->mmc_rx_ipv4_hderr_octets },
+		{ MMC_RXIPV4_NOPAY_OCTETS, 0U, MMC_STS_IPC, 18U,
+		  &mmc->mmc_rx_ipv4_nopay_octets },
+		{ MMC_RXIPV4_FRAG_OCTETS, 0U, MMC_STS_IPC, 19U,
+		  &mmc->mmc_rx_ipv4_frag_octets },
+		{ MMC_RXIPV4_UDSBL_OCTETS, 0U, MMC_STS_IPC, 20U,
+		  &mmc->mmc_rx_ipv4_udsbl_octets },
+		{ MMC_RXUDP_GD_OCTETS, 0U, MMC_STS_IPC, 24U,
+		  &mmc->mmc_rx_udp_gd_octets },
+		{ MMC_RXIPV6_GD_OCTETS, 0U, MMC_STS_IPC, 21U,
+		  &mmc->mmc_rx_ipv6_gd_octets },
+		{ MMC_RXIPV6_HDRERR_OCTETS, 0U, MMC_STS_IPC, 22U,
+		  &mmc->mmc_rx_ipv6_hderr_octets },
+		{ MMC_RXIPV6_NOPAY_OCTETS, 0U, MMC_STS_IPC, 23U,
+		  &mmc->mmc_rx_ipv6_nopay_octets },
+		{ MMC_RXUDP_ERR_OCTETS, 0U, MMC_STS_IPC, 25U,
+		  &mmc->mmc_rx_udp_err_octets },
+		{ MMC_RXTCP_GD_OCTETS, 0U, MMC_STS_IPC, 26U,
+		  &mmc->mmc_rx_tcp_gd_octets },
+		{ MMC_RXTCP_ERR_OCTETS, 0U, MMC_STS_IPC, 27U,
+		  &mmc->mmc_rx_tcp_err_octets },
+		{ MMC_RXICMP_GD_OCTETS, 0U, MMC_STS_IPC, 28U,
+		  &mmc->mmc_rx_icmp_gd_octets },
+		{ MMC_RXICMP_ERR_OCTETS, 0U, MMC_STS_IPC, 29U,
+		  &mmc->mmc_rx_icmp_err_octets },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief eqos_mmc_accumulate - Accumulate MMC counter groups
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in] groups: Bitmap of OSI_MMC_GRP_* counter groups to read.
+ * @param[in] harvest: OSI_ENABLE to only read counters flagged in MMC
+ *	      interrupt status.
+ */
+static void eqos_mmc_accumulate(struct osi_core_priv_data *const osi_core,
+				const nveu32_t groups,
+				const nveu32_t harvest)
+{
+	struct mmc_sts sts;
+
+	sts.reg = eqos_mmc_sts_reg;
+	sts.read = 0U;
+	sts.harvest = harvest;
+
+	if ((groups & OSI_MMC_GRP_TX) != OSI_NONE) {
+		eqos_read_mmc_tx(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_RX) != OSI_NONE) {
+		eqos_read_mmc_rx(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_SIZE) != OSI_NONE) {
+		eqos_read_mmc_size(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_ERR) != OSI_NONE) {
+		eqos_read_mmc_err(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_LPI) != OSI_NONE) {
+		eqos_read_mmc_lpi(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_FPE) != OSI_NONE) {
+		eqos_read_mmc_fpe(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_CSUM) != OSI_NONE) {
+		eqos_read_mmc_csum(osi_core, &sts);
+	}
 }
 
 /**
@@ -105,11 +412,12 @@ void eqos_reset_mmc(struct osi_core_priv_data *const osi_core)
  *
  * @note
  * Algorithm:
- *  - Read corresponding register value of #osi_core_priv_data->mmc(#osi_mmc_counters)
- *    member and increment its value.
- *  - If any counter overflows, reset all Sw counters and reset HW counter register.
+ *  - For each counter group selected in groups, read corresponding register
+ *    value of #osi_core_priv_data->mmc(#osi_mmc_counters) member and
+ *    increment its value, see mmc_read_cnt().
  *
  * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in] groups: Bitmap of OSI_MMC_GRP_* counter groups to read.
  *
  * @pre
  *  - MAC should be init and started. see osi_start_mac()
@@ -121,281 +429,24 @@ void eqos_reset_mmc(struct osi_core_priv_data *const osi_core)
  * - Run time: Yes
  * - De-initialization: No
  */
-void eqos_read_mmc(struct osi_core_priv_data *const osi_core)
+void eqos_read_mmc(struct osi_core_priv_data *const osi_core,
+		   const nveu32_t groups)
 {
-	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	eqos_mmc_accumulate(osi_core, groups, OSI_DISABLE);
+}
 
-	mmc->mmc_tx_octetcount_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_octetcount_gb,
-			       MMC_TXOCTETCOUNT_GB);
-	mmc->mmc_tx_framecount_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_framecount_gb,
-			       MMC_TXPACKETCOUNT_GB);
-	mmc->mmc_tx_broadcastframe_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_broadcastframe_g,
-			       MMC_TXBROADCASTPACKETS_G);
-	mmc->mmc_tx_multicastframe_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_multicastframe_g,
-			       MMC_TXMULTICASTPACKETS_G);
-	mmc->mmc_tx_64_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_64_octets_gb,
-			       MMC_TX64OCTETS_GB);
-	mmc->mmc_tx_65_to_127_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_65_to_127_octets_gb,
-			       MMC_TX65TO127OCTETS_GB);
-	mmc->mmc_tx_128_to_255_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_128_to_255_octets_gb,
-			       MMC_TX128TO255OCTETS_GB);
-	mmc->mmc_tx_256_to_511_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_256_to_511_octets_gb,
-			       MMC_TX256TO511OCTETS_GB);
-	mmc->mmc_tx_512_to_1023_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_512_to_1023_octets_gb,
-			       MMC_TX512TO1023OCTETS_GB);
-	mmc->mmc_tx_1024_to_max_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_1024_to_max_octets_gb,
-			       MMC_TX1024TOMAXOCTETS_GB);
-	mmc->mmc_tx_unicast_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_unicast_gb,
-			       MMC_TXUNICASTPACKETS_GB);
-	mmc->mmc_tx_multicast_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_multicast_gb,
-			       MMC_TXMULTICASTPACKETS_GB);
-	mmc->mmc_tx_broadcast_gb =
-		update_mmc_val(osi_core, mmc->mmc_tx_broadcast_gb,
-			       MMC_TXBROADCASTPACKETS_GB);
-	mmc->mmc_tx_underflow_error =
-		update_mmc_val(osi_core, mmc->mmc_tx_underflow_error,
-			       MMC_TXUNDERFLOWERROR);
-	mmc->mmc_tx_singlecol_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_singlecol_g,
-			       MMC_TXSINGLECOL_G);
-	mmc->mmc_tx_multicol_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_multicol_g,
-			       MMC_TXMULTICOL_G);
-	mmc->mmc_tx_deferred =
-		update_mmc_val(osi_core, mmc->mmc_tx_deferred,
-			       MMC_TXDEFERRED);
-	mmc->mmc_tx_latecol =
-		update_mmc_val(osi_core, mmc->mmc_tx_latecol,
-			       MMC_TXLATECOL);
-	mmc->mmc_tx_exesscol =
-		update_mmc_val(osi_core, mmc->mmc_tx_exesscol,
-			       MMC_TXEXESSCOL);
-	mmc->mmc_tx_carrier_error =
-		update_mmc_val(osi_core, mmc->mmc_tx_exesscol,
-			       MMC_TXCARRIERERROR);
-	mmc->mmc_tx_octetcount_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_octetcount_g,
-			       MMC_TXOCTETCOUNT_G);
-	mmc->mmc_tx_framecount_g =
-		 update_mmc_val(osi_core, mmc->mmc_tx_framecount_g,
-				MMC_TXPACKETSCOUNT_G);
-	mmc->mmc_tx_excessdef =
-		update_mmc_val(osi_core, mmc->mmc_tx_excessdef,
-			       MMC_TXEXCESSDEF);
-	mmc->mmc_tx_pause_frame =
-		update_mmc_val(osi_core, mmc->mmc_tx_pause_frame,
-			       MMC_TXPAUSEPACKETS);
-	mmc->mmc_tx_vlan_frame_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_vlan_frame_g,
-			       MMC_TXVLANPACKETS_G);
-	mmc->mmc_tx_osize_frame_g =
-		update_mmc_val(osi_core, mmc->mmc_tx_osize_frame_g,
-			       MMC_TXOVERSIZE_G);
-	mmc->mmc_rx_framecount_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_framecount_gb,
-			       MMC_RXPACKETCOUNT_GB);
-	mmc->mmc_rx_octetcount_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_octetcount_gb,
-			       MMC_RXOCTETCOUNT_GB);
-	mmc->mmc_rx_octetcount_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_octetcount_g,
-			       MMC_RXOCTETCOUNT_G);
-	mmc->mmc_rx_broadcastframe_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_broadcastframe_g,
-			       MMC_RXBROADCASTPACKETS_G);
-	mmc->mmc_rx_multicastframe_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_multicastframe_g,
-			       MMC_RXMULTICASTPACKETS_G);
-	mmc->mmc_rx_crc_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_crc_error,
-			       MMC_RXCRCERROR);
-	mmc->mmc_rx_align_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_align_error,
-			       MMC_RXALIGNMENTERROR);
-	mmc->mmc_rx_runt_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_runt_error,
-			       MMC_RXRUNTERROR);
-	mmc->mmc_rx_jabber_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_jabber_error,
-			       MMC_RXJABBERERROR);
-	mmc->mmc_rx_undersize_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_undersize_g,
-			       MMC_RXUNDERSIZE_G);
-	mmc->mmc_rx_oversize_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_oversize_g,
-			       MMC_RXOVERSIZE_G);
-	mmc->mmc_rx_64_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_64_octets_gb,
-			       MMC_RX64OCTETS_GB);
-	mmc->mmc_rx_65_to_127_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_65_to_127_octets_gb,
-			       MMC_RX65TO127OCTETS_GB);
-	mmc->mmc_rx_128_to_255_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_128_to_255_octets_gb,
-			       MMC_RX128TO255OCTETS_GB);
-	mmc->mmc_rx_256_to_511_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_256_to_511_octets_gb,
-			       MMC_RX256TO511OCTETS_GB);
-	mmc->mmc_rx_512_to_1023_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_512_to_1023_octets_gb,
-			       MMC_RX512TO1023OCTETS_GB);
-	mmc->mmc_rx_1024_to_max_octets_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_1024_to_max_octets_gb,
-			       MMC_RX1024TOMAXOCTETS_GB);
-	mmc->mmc_rx_unicast_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_unicast_g,
-			       MMC_RXUNICASTPACKETS_G);
-	mmc->mmc_rx_length_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_length_error,
-			       MMC_RXLENGTHERROR);
-	mmc->mmc_rx_outofrangetype =
-		update_mmc_val(osi_core, mmc->mmc_rx_outofrangetype,
-			       MMC_RXOUTOFRANGETYPE);
-	mmc->mmc_rx_pause_frames =
-		update_mmc_val(osi_core, mmc->mmc_rx_pause_frames,
-			       MMC_RXPAUSEPACKETS);
-	mmc->mmc_rx_fifo_overflow =
-		update_mmc_val(osi_core, mmc->mmc_rx_fifo_overflow,
-			       MMC_RXFIFOOVERFLOW);
-	mmc->mmc_rx_vlan_frames_gb =
-		update_mmc_val(osi_core, mmc->mmc_rx_vlan_frames_gb,
-			       MMC_RXVLANPACKETS_GB);
-	mmc->mmc_rx_watchdog_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_watchdog_error,
-			       MMC_RXWATCHDOGERROR);
-	mmc->mmc_rx_receive_error =
-		update_mmc_val(osi_core, mmc->mmc_rx_receive_error,
-			       MMC_RXRCVERROR);
-	mmc->mmc_rx_ctrl_frames_g =
-		update_mmc_val(osi_core, mmc->mmc_rx_ctrl_frames_g,
-			       MMC_RXCTRLPACKETS_G);
-	mmc->mmc_tx_lpi_usec_cntr =
-		update_mmc_val(osi_core, mmc->mmc_tx_lpi_usec_cntr,
-			       MMC_TXLPIUSECCNTR);
-	mmc->mmc_tx_lpi_tran_cntr =
-		update_mmc_val(osi_core, mmc->mmc_tx_lpi_tran_cntr,
-			       MMC_TXLPITRANCNTR);
-	mmc->mmc_rx_lpi_usec_cntr =
-		update_mmc_val(osi_core, mmc->mmc_rx_lpi_usec_cntr,
-			       MMC_RXLPIUSECCNTR);
-	mmc->mmc_rx_lpi_tran_cntr =
-		update_mmc_val(osi_core, mmc->mmc_rx_lpi_tran_cntr,
-			       MMC_RXLPITRANCNTR);
-	mmc->mmc_rx_ipv4_gd =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_gd,
-			       MMC_RXIPV4_GD_PKTS);
-	mmc->mmc_rx_ipv4_hderr =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_hderr,
-			       MMC_RXIPV4_HDRERR_PKTS);
-	mmc->mmc_rx_ipv4_nopay =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_nopay,
-			       MMC_RXIPV4_NOPAY_PKTS);
-	mmc->mmc_rx_ipv4_frag =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_frag,
-			       MMC_RXIPV4_FRAG_PKTS);
-	mmc->mmc_rx_ipv4_udsbl =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_udsbl,
-			       MMC_RXIPV4_UBSBL_PKTS);
-	mmc->mmc_rx_ipv6_gd =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv6_gd,
-			       MMC_RXIPV6_GD_PKTS);
-	mmc->mmc_rx_ipv6_hderr =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv6_hderr,
-			       MMC_RXIPV6_HDRERR_PKTS);
-	mmc->mmc_rx_ipv6_nopay =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv6_nopay,
-			       MMC_RXIPV6_NOPAY_PKTS);
-	mmc->mmc_rx_udp_gd =
-		update_mmc_val(osi_core, mmc->mmc_rx_udp_gd,
-			       MMC_RXUDP_GD_PKTS);
-	mmc->mmc_rx_udp_err =
-		update_mmc_val(osi_core, mmc->mmc_rx_udp_err,
-			       MMC_RXUDP_ERR_PKTS);
-	mmc->mmc_rx_tcp_gd =
-		update_mmc_val(osi_core, mmc->mmc_rx_tcp_gd,
-			       MMC_RXTCP_GD_PKTS);
-	mmc->mmc_rx_tcp_err =
-		update_mmc_val(osi_core, mmc->mmc_rx_tcp_err,
-			       MMC_RXTCP_ERR_PKTS);
-	mmc->mmc_rx_icmp_gd =
-		update_mmc_val(osi_core, mmc->mmc_rx_icmp_gd,
-			       MMC_RXICMP_GD_PKTS);
-	mmc->mmc_rx_icmp_err =
-		update_mmc_val(osi_core, mmc->mmc_rx_icmp_err,
-			       MMC_RXICMP_ERR_PKTS);
-	mmc->mmc_rx_ipv4_gd_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_gd_octets,
-			       MMC_RXIPV4_GD_OCTETS);
-	mmc->mmc_rx_ipv4_hderr_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_hderr_octets,
-			       MMC_RXIPV4_HDRERR_OCTETS);
-	mmc->mmc_rx_ipv4_nopay_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_nopay_octets,
-			       MMC_RXIPV4_NOPAY_OCTETS);
-	mmc->mmc_rx_ipv4_frag_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_frag_octets,
-			       MMC_RXIPV4_FRAG_OCTETS);
-	mmc->mmc_rx_ipv4_udsbl_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv4_udsbl_octets,
-			       MMC_RXIPV4_UDSBL_OCTETS);
-	mmc->mmc_rx_udp_gd_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_udp_gd_octets,
-			       MMC_RXUDP_GD_OCTETS);
-	mmc->mmc_rx_ipv6_gd_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv6_gd_octets,
-			       MMC_RXIPV6_GD_OCTETS);
-	mmc->mmc_rx_ipv6_hderr_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv6_hderr_octets,
-			       MMC_RXIPV6_HDRERR_OCTETS);
-	mmc->mmc_rx_ipv6_nopay_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_ipv6_nopay_octets,
-			       MMC_RXIPV6_NOPAY_OCTETS);
-	mmc->mmc_rx_udp_gd_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_udp_gd_octets,
-			       MMC_RXUDP_GD_OCTETS);
-	mmc->mmc_rx_udp_err_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_udp_err_octets,
-			       MMC_RXUDP_ERR_OCTETS);
-	mmc->mmc_rx_tcp_gd_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_tcp_gd_octets,
-			       MMC_RXTCP_GD_OCTETS);
-	mmc->mmc_rx_tcp_err_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_tcp_err_octets,
-			       MMC_RXTCP_ERR_OCTETS);
-	mmc->mmc_rx_icmp_gd_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_icmp_gd_octets,
-			       MMC_RXICMP_GD_OCTETS);
-	mmc->mmc_rx_icmp_err_octets =
-		update_mmc_val(osi_core, mmc->mmc_rx_icmp_err_octets,
-			       MMC_RXICMP_ERR_OCTETS);
-	mmc->mmc_tx_fpe_frag_cnt =
-		update_mmc_val(osi_core, mmc->mmc_tx_fpe_frag_cnt,
-			       MMC_TX_FPE_FRAG_COUNTER);
-	mmc->mmc_tx_fpe_hold_req_cnt =
-		update_mmc_val(osi_core, mmc->mmc_tx_fpe_hold_req_cnt,
-			       MMC_TX_HOLD_REQ_COUNTER);
-	mmc->mmc_rx_packet_reass_err_cnt =
-		update_mmc_val(osi_core, mmc->mmc_rx_packet_reass_err_cnt,
-			       MMC_RX_PKT_ASSEMBLY_ERR_CNTR);
-	mmc->mmc_rx_packet_smd_err_cnt =
-		update_mmc_val(osi_core, mmc->mmc_rx_packet_smd_err_cnt,
-			       MMC_RX_PKT_SMD_ERR_CNTR);
-	mmc->mmc_rx_packet_asm_ok_cnt =
-		update_mmc_val(osi_core, mmc->mmc_rx_packet_asm_ok_cnt,
-			       MMC_RX_PKT_ASSEMBLY_OK_CNTR);
-	mmc->mmc_rx_fpe_fragment_cnt =
-		update_mmc_val(osi_core, mmc->mmc_rx_fpe_fragment_cnt,
-			       MMC_RX_FPE_FRAG_CNTR);
+/**
+ * @brief eqos_mmc_harvest - Harvest MMC counters from MMC interrupt
+ *
+ * Algorithm: Read the MMC interrupt status registers and accumulate only
+ *	the counters whose half or maximum value status bit is set. Reading
+ *	a counter clears its status bit.
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ *
+ * @note MMC interrupts need to be enabled
+ */
+void eqos_mmc_harvest(struct osi_core_priv_data *const osi_core)
+{
+	eqos_mmc_accumulate(osi_core, OSI_MMC_GRP_ALL, OSI_ENABLE);
 }
@@ -29,6 +29,11 @@
  * @brief MMC HW register offsets
  * @{
  */
+#define MMC_RX_INTR			0x00704
+#define MMC_TX_INTR			0x00708
+#define MMC_IPC_RX_INTR			0x00808
+#define MMC_FPE_TX_INTR			0x008A0
+#define MMC_FPE_RX_INTR			0x008C0
 #define MMC_TXOCTETCOUNT_GB		0x00714U
 #define MMC_TXPACKETCOUNT_GB		0x00718
 #define MMC_TXBROADCASTPACKETS_G	0x0071c
@@ -121,6 +126,8 @@
 #define MMC_RX_FPE_FRAG_CNTR		0x008D4
 /** @} */
 
-void eqos_read_mmc(struct osi_core_priv_data *const osi_core);
+void eqos_read_mmc(struct osi_core_priv_data *const osi_core,
+		   const nveu32_t groups);
 void eqos_reset_mmc(struct osi_core_priv_data *const osi_core);
+void eqos_mmc_harvest(struct osi_core_priv_data *const osi_core);
 #endif /* INCLUDED_EQOS_MMC_H */
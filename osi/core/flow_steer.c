@@ -0,0 +1,677 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OSI_STRIPPED_LIB
+#include "../osi/common/common.h"
+#include "core_common.h"
+#include "flow_steer.h"
+#include "frp.h"
+#include "l3l4_mgr.h"
+
+/**
+ * @addtogroup Flow steering helper macros
+ *
+ * @brief Match field groups and protocol defines
+ * @{
+ */
+#define FLOW_STEER_VLAN_MATCH	(OSI_FLOW_MATCH_VLAN_ID | \
+				 OSI_FLOW_MATCH_VLAN_PRIO)
+#define FLOW_STEER_PORT_MATCH	(OSI_FLOW_MATCH_SPORT | \
+				 OSI_FLOW_MATCH_DPORT)
+#define FLOW_STEER_IP_MATCH	(OSI_FLOW_MATCH_PROTO | \
+				 OSI_FLOW_MATCH_SIP | \
+				 OSI_FLOW_MATCH_DIP | \
+				 FLOW_STEER_PORT_MATCH)
+#define FLOW_STEER_ALL_MATCH	(OSI_FLOW_MATCH_DMAC | \
+				 FLOW_STEER_VLAN_MATCH | \
+				 OSI_FLOW_MATCH_ETHTYPE | \
+				 FLOW_STEER_IP_MATCH)
+#define FLOW_STEER_PROTO_TCP	6U
+#define FLOW_STEER_PROTO_UDP	17U
+#define FLOW_STEER_VLAN_ID_MAX	0xFFFU
+#define FLOW_STEER_VLAN_PRIO_MAX	7U
+#define FLOW_STEER_VLAN_PRIO_SHIFT	13U
+#define FLOW_STEER_VLAN_TAG_LEN	4U
+/** PSRQ fields of MAC_RxQ_Ctrl2 cover Rx queues 0 to 3 */
+#define FLOW_STEER_PRIO_MAX_Q	4U
+/** @} */
+
+/**
+ * @brief flow_steer_validate - Validate flow steering rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] rule: Flow steering rule.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t flow_steer_validate(const struct osi_core_priv_data *const osi_core,
+				   const struct osi_flow_rule *const rule)
+{
+	const nveu32_t max_dma_chan[2] = {
+		OSI_EQOS_MAX_NUM_CHANS,
+		OSI_MGBE_MAX_NUM_CHANS
+	};
+	nve32_t ret = -1;
+
+	if ((rule->match == 0U) ||
+	    ((rule->match & ~FLOW_STEER_ALL_MATCH) != 0U) ||
+	    (rule->is_ipv6 > OSI_TRUE)) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: Invalid match fields: "), (rule->match));
+		goto exit_func;
+	}
+
+	if ((rule->action > OSI_FLOW_ACTION_RSS) ||
+	    ((rule->action == OSI_FLOW_ACTION_DMA) &&
+	     (rule->dma_chan >= max_dma_chan[osi_core->mac]))) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: Invalid action or DMA channel: "),
+			(rule->dma_chan));
+		goto exit_func;
+	}
+
+	if ((rule->vlan_id > FLOW_STEER_VLAN_ID_MAX) ||
+	    (rule->vlan_prio > FLOW_STEER_VLAN_PRIO_MAX)) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: Invalid VLAN tag: "), (rule->vlan_id));
+		goto exit_func;
+	}
+
+	/* Port match needs TCP or UDP protocol */
+	if (((rule->match & FLOW_STEER_PORT_MATCH) != 0U) &&
+	    (((rule->match & OSI_FLOW_MATCH_PROTO) == 0U) ||
+	     ((rule->proto != FLOW_STEER_PROTO_TCP) &&
+	      (rule->proto != FLOW_STEER_PROTO_UDP)))) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: Port match without TCP/UDP: "), (rule->proto));
+		goto exit_func;
+	}
+
+	ret = 0;
+exit_func:
+	return ret;
+}
+
+/**
+ * @brief flow_steer_prio_config - Map VLAN priority to Rx queue.
+ *
+ * Algorithm: Rx queue N is served by DMA channel N. Add or remove the
+ *	priority from the flow steering priorities of the queue and program
+ *	them along with the OSD owned rxq_prio. A priority can't be mapped
+ *	to more than one queue.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] rule: Flow steering rule.
+ * @param[in] enable: Add (OSI_ENABLE) or remove (OSI_DISABLE) mapping.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t flow_steer_prio_config(struct osi_core_priv_data *const osi_core,
+				      const struct osi_flow_rule *const rule,
+				      nveu32_t enable)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu32_t prio = OSI_BIT(rule->vlan_prio);
+	nveu32_t mtlq = rule->dma_chan;
+	nveu32_t found = OSI_DISABLE;
+	nveu32_t i, q;
+	nve32_t ret = -1;
+
+	if ((l_core->ops_p->config_rxq_prio == OSI_NULL) ||
+	    (mtlq >= FLOW_STEER_PRIO_MAX_Q)) {
+		goto exit_func;
+	}
+
+	for (i = 0U; i < osi_core->num_mtl_queues; i++) {
+		q = osi_core->mtl_queues[i];
+		if (q == mtlq) {
+			found = OSI_ENABLE;
+		}
+		if ((enable == OSI_ENABLE) &&
+		    (((osi_core->rxq_prio[q] | l_core->flow_rxq_prio[q]) &
+		      prio) != 0U)) {
+			/* priority already mapped */
+			goto exit_func;
+		}
+	}
+
+	if (found == OSI_DISABLE) {
+		goto exit_func;
+	}
+
+	if (enable == OSI_ENABLE) {
+		l_core->flow_rxq_prio[mtlq] |= prio;
+	} else {
+		l_core->flow_rxq_prio[mtlq] &= ~prio;
+	}
+	l_core->ops_p->config_rxq_prio(osi_core);
+
+	ret = 0;
+exit_func:
+	return ret;
+}
+
+/**
+ * @brief flow_steer_is_l3l4 - Check rule can be backed by L3/L4 filter.
+ *
+ * Algorithm: L3/L4 filter routes to a DMA channel on L3 address and L4
+ *	port match. Protocol is matched only along with ports, ipv6 filter
+ *	matches either source or destination address.
+ *
+ * @param[in] rule: Flow steering rule.
+ *
+ * @retval OSI_ENABLE if L3/L4 filter can back the rule
+ * @retval OSI_DISABLE otherwise
+ */
+static nveu32_t flow_steer_is_l3l4(const struct osi_flow_rule *const rule)
+{
+	nveu32_t match = rule->match;
+	nveu32_t ret = OSI_DISABLE;
+
+	if ((rule->action == OSI_FLOW_ACTION_DMA) &&
+	    ((match & ~FLOW_STEER_IP_MATCH) == 0U) &&
+	    ((match & ~OSI_FLOW_MATCH_PROTO) != 0U) &&
+	    (((match & OSI_FLOW_MATCH_PROTO) == 0U) ||
+	     ((match & FLOW_STEER_PORT_MATCH) != 0U)) &&
+	    !((rule->is_ipv6 == OSI_TRUE) &&
+	      ((match & OSI_FLOW_MATCH_SIP) != 0U) &&
+	      ((match & OSI_FLOW_MATCH_DIP) != 0U))) {
+		ret = OSI_ENABLE;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief flow_steer_l3l4_fill - Translate rule to L3/L4 filter.
+ *
+ * @param[in] rule: Flow steering rule.
+ * @param[out] l3_l4: L3/L4 filter structure (#osi_l3_l4_filter)
+ * @param[in] enable: Filter enable (OSI_TRUE) or disable (OSI_FALSE).
+ */
+static void flow_steer_l3l4_fill(const struct osi_flow_rule *const rule,
+				 struct osi_l3_l4_filter *const l3_l4,
+				 nveu32_t enable)
+{
+	nveu32_t i;
+
+	(void)osi_memset(l3_l4, 0, sizeof(struct osi_l3_l4_filter));
+	l3_l4->filter_enb_dis = enable;
+	/* dma_chan is validated for OSI_FLOW_ACTION_DMA only */
+	if (rule->action == OSI_FLOW_ACTION_DMA) {
+		l3_l4->dma_routing_enable = OSI_TRUE;
+		l3_l4->dma_chan = rule->dma_chan;
+	}
+	l3_l4->data.is_ipv6 = rule->is_ipv6;
+	l3_l4->data.is_udp = (rule->proto == FLOW_STEER_PROTO_UDP) ?
+			     OSI_TRUE : OSI_FALSE;
+
+	if ((rule->match & OSI_FLOW_MATCH_SIP) != 0U) {
+		l3_l4->data.src.addr_match = OSI_TRUE;
+	}
+	if ((rule->match & OSI_FLOW_MATCH_DIP) != 0U) {
+		l3_l4->data.dst.addr_match = OSI_TRUE;
+	}
+	if (rule->is_ipv6 == OSI_TRUE) {
+		for (i = 0U; i < 8U; i++) {
+			l3_l4->data.src.ip6_addr[i] =
+				(nveu16_t)(((nveu32_t)rule->sip[i * 2U] << 8U) |
+					   rule->sip[(i * 2U) + 1U]);
+			l3_l4->data.dst.ip6_addr[i] =
+				(nveu16_t)(((nveu32_t)rule->dip[i * 2U] << 8U) |
+					   rule->dip[(i * 2U) + 1U]);
+		}
+	} else {
+		(void)osi_memcpy(l3_l4->data.src.ip4_addr, rule->sip, 4U);
+		(void)osi_memcpy(l3_l4->data.dst.ip4_addr, rule->dip, 4U);
+	}
+
+	if ((rule->match & OSI_FLOW_MATCH_SPORT) != 0U) {
+		l3_l4->data.src.port_match = OSI_TRUE;
+		l3_l4->data.src.port_no = rule->sport;
+	}
+	if ((rule->match & OSI_FLOW_MATCH_DPORT) != 0U) {
+		l3_l4->data.dst.port_match = OSI_TRUE;
+		l3_l4->data.dst.port_no = rule->dport;
+	}
+}
+
+/**
+ * @brief flow_steer_l3l4_config - Add, delete or account hits of L3/L4 rule.
+ *
+ * Algorithm: Hand the rule to the L3/L4 filter manager directly, the
+ *	caller already runs inside osi_hal_handle_ioctl().
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] rule: Flow steering rule.
+ * @param[in] cmd: OSI_CMD_L3L4_FILTER or OSI_CMD_L3L4_FILTER_HIT.
+ * @param[in] arg: Filter enable for OSI_CMD_L3L4_FILTER, hits for
+ *	OSI_CMD_L3L4_FILTER_HIT.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t flow_steer_l3l4_config(struct osi_core_priv_data *const osi_core,
+				      const struct osi_flow_rule *const rule,
+				      nveu32_t cmd, nveu32_t arg)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_l3_l4_filter l3_l4;
+	nve32_t ret;
+
+	(void)osi_memset(&l3_l4, 0, sizeof(l3_l4));
+	if (cmd == OSI_CMD_L3L4_FILTER) {
+		flow_steer_l3l4_fill(rule, &l3_l4, arg);
+		ret = l3l4_mgr_config(osi_core, &l3_l4);
+		if (ret == 0) {
+			l_core->cfg.flags |= DYNAMIC_CFG_L3_L4;
+		}
+	} else {
+		flow_steer_l3l4_fill(rule, &l3_l4, OSI_TRUE);
+		ret = l3l4_mgr_update_hits(osi_core, &l3_l4, arg);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief flow_steer_hw - Get HW currently backing a rule.
+ *
+ * Algorithm: L3/L4 filter manager moves its rules between HW filter
+ *	slots and FRP, so ask it for the placement of managed rules.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] fr: Flow steering rule context.
+ *
+ * @retval OSI_FLOW_HW_* backing the rule.
+ */
+static nveu32_t flow_steer_hw(const struct osi_core_priv_data *const osi_core,
+			      const struct flow_steer_rule *const fr)
+{
+	struct osi_l3_l4_filter l3_l4;
+	nveu32_t hw = fr->hw;
+
+	if (fr->l3l4_mgr == OSI_ENABLE) {
+		(void)osi_memset(&l3_l4, 0, sizeof(l3_l4));
+		flow_steer_l3l4_fill(&fr->rule, &l3_l4, OSI_TRUE);
+		hw = (l3l4_mgr_place(osi_core, &l3_l4) == L3L4_MGR_PLACE_HW) ?
+		     OSI_FLOW_HW_L3L4 : OSI_FLOW_HW_FRP;
+	}
+
+	return hw;
+}
+
+/**
+ * @brief flow_steer_frp_set - Set match bytes of FRP rule.
+ *
+ * @param[in, out] md: Match data indexed by frame offset.
+ * @param[in, out] used: Match byte used flags indexed by frame offset.
+ * @param[in] offset: Frame offset.
+ * @param[in] data: Match data in frame byte order.
+ * @param[in] len: Match data length.
+ */
+static void flow_steer_frp_set(nveu8_t *const md, nveu8_t *const used,
+			       nveu32_t offset, const nveu8_t *const data,
+			       nveu32_t len)
+{
+	nveu32_t i;
+
+	for (i = 0U; i < len; i++) {
+		md[offset + i] = data[i];
+		used[offset + i] = OSI_ENABLE;
+	}
+}
+
+/**
+ * @brief flow_steer_frp_prepare - Translate rule to FRP commands.
+ *
+ * Algorithm:
+ * - Place all match fields at their frame offset. VLAN tag shifts the
+ *   L3 header, EtherType is matched for L3/L4 fields. VLAN tag can only
+ *   be matched as full TCI, i.e. with both ID and priority.
+ * - Emit one FRP command per run of adjacent match bytes, the last one
+ *   carries the rule action.
+ *
+ * @param[in] rule: Flow steering rule.
+ * @param[out] cmds: FRP commands, FRP_RULE_MAX_CMDS entries.
+ *
+ * @retval number of FRP commands, 0 if rule can't be backed by FRP
+ */
+static nveu32_t flow_steer_frp_prepare(const struct osi_flow_rule *const rule,
+				       struct osi_core_frp_cmd *const cmds)
+{
+	nveu8_t md[OSI_FRP_OFFSET_MAX];
+	nveu8_t used[OSI_FRP_OFFSET_MAX];
+	nveu8_t val[2];
+	nveu32_t match = rule->match;
+	nveu32_t ipv6 = rule->is_ipv6;
+	nveu32_t ip_len = (ipv6 == OSI_TRUE) ? 16U : 4U;
+	nveu32_t l3 = FRP_L2_ETHTYPE_OFFSET;
+	nveu32_t n = 0U, i = 0U, len, tci;
+	nveu32_t dma_sel = OSI_NONE;
+
+	if (((match & FLOW_STEER_VLAN_MATCH) != 0U) &&
+	    ((match & FLOW_STEER_VLAN_MATCH) != FLOW_STEER_VLAN_MATCH)) {
+		goto done;
+	}
+
+	/* dma_chan is validated for OSI_FLOW_ACTION_DMA only */
+	if (rule->action == OSI_FLOW_ACTION_DMA) {
+		dma_sel = OSI_BIT(rule->dma_chan);
+	}
+
+	(void)osi_memset(md, 0, sizeof(md));
+	(void)osi_memset(used, 0, sizeof(used));
+
+	if ((match & OSI_FLOW_MATCH_DMAC) != 0U) {
+		flow_steer_frp_set(md, used, FRP_L2_DA_OFFSET, rule->dmac,
+				   OSI_ETH_ALEN);
+	}
+
+	if ((match & FLOW_STEER_VLAN_MATCH) != 0U) {
+		val[0] = FRP_L2_VLAN_MD0;
+		val[1] = FRP_L2_VLAN_MD1;
+		flow_steer_frp_set(md, used, FRP_L2_VLAN_PROTO_OFFSET, val, 2U);
+		tci = ((nveu32_t)rule->vlan_prio << FLOW_STEER_VLAN_PRIO_SHIFT) |
+		      rule->vlan_id;
+		val[0] = (nveu8_t)(tci >> 8U);
+		val[1] = (nveu8_t)(tci & 0xFFU);
+		flow_steer_frp_set(md, used, FRP_L2_VLAN_TAG_OFFSET, val, 2U);
+		l3 += FLOW_STEER_VLAN_TAG_LEN;
+	}
+
+	if ((match & OSI_FLOW_MATCH_ETHTYPE) != 0U) {
+		val[0] = (nveu8_t)(rule->ethtype >> 8U);
+		val[1] = (nveu8_t)(rule->ethtype & 0xFFU);
+		flow_steer_frp_set(md, used, l3, val, 2U);
+	} else if ((match & FLOW_STEER_IP_MATCH) != 0U) {
+		val[0] = (ipv6 == OSI_TRUE) ? 0x86U : 0x08U;
+		val[1] = (ipv6 == OSI_TRUE) ? 0xDDU : 0x00U;
+		flow_steer_frp_set(md, used, l3, val, 2U);
+	} else {
+		/* L2 only rule */
+	}
+
+	/* L3 header follows EtherType */
+	l3 += 2U;
+	if ((match & OSI_FLOW_MATCH_PROTO) != 0U) {
+		flow_steer_frp_set(md, used,
+				   l3 + ((ipv6 == OSI_TRUE) ? 6U : 9U),
+				   &rule->proto, 1U);
+	}
+	if ((match & OSI_FLOW_MATCH_SIP) != 0U) {
+		flow_steer_frp_set(md, used,
+				   l3 + ((ipv6 == OSI_TRUE) ? 8U : 12U),
+				   rule->sip, ip_len);
+	}
+	if ((match & OSI_FLOW_MATCH_DIP) != 0U) {
+		flow_steer_frp_set(md, used,
+				   l3 + ((ipv6 == OSI_TRUE) ? 24U : 16U),
+				   rule->dip, ip_len);
+	}
+
+	/* L4 header follows L3 header without options */
+	l3 += (ipv6 == OSI_TRUE) ? 40U : 20U;
+	if ((match & OSI_FLOW_MATCH_SPORT) != 0U) {
+		val[0] = (nveu8_t)(rule->sport >> 8U);
+		val[1] = (nveu8_t)(rule->sport & 0xFFU);
+		flow_steer_frp_set(md, used, l3, val, 2U);
+	}
+	if ((match & OSI_FLOW_MATCH_DPORT) != 0U) {
+		val[0] = (nveu8_t)(rule->dport >> 8U);
+		val[1] = (nveu8_t)(rule->dport & 0xFFU);
+		flow_steer_frp_set(md, used, l3 + 2U, val, 2U);
+	}
+
+	/* One FRP command per run of adjacent match bytes */
+	while (i < OSI_FRP_OFFSET_MAX) {
+		if (used[i] == OSI_DISABLE) {
+			i++;
+			continue;
+		}
+		if (n == FRP_RULE_MAX_CMDS) {
+			n = 0U;
+			goto done;
+		}
+
+		len = 0U;
+		while (((i + len) < OSI_FRP_OFFSET_MAX) &&
+		       (used[i + len] == OSI_ENABLE) &&
+		       (len < OSI_FRP_MATCH_DATA_MAX)) {
+			len++;
+		}
+
+		(void)osi_memset(&cmds[n], 0, sizeof(struct osi_core_frp_cmd));
+		cmds[n].cmd = OSI_FRP_CMD_ADD;
+		cmds[n].match_type = OSI_FRP_MATCH_NORMAL;
+		(void)osi_memcpy(cmds[n].match, &md[i], len);
+		cmds[n].match_length = (nveu8_t)len;
+		cmds[n].offset = (nveu8_t)i;
+		cmds[n].filter_mode = OSI_FRP_MODE_ROUTE;
+		cmds[n].dma_sel = dma_sel;
+		n++;
+		i += len;
+	}
+
+	if (rule->action == OSI_FLOW_ACTION_DROP) {
+		cmds[n - 1U].filter_mode = OSI_FRP_MODE_DROP;
+	} else if (rule->action == OSI_FLOW_ACTION_RSS) {
+		/* Bypass the parser, frame takes default RSS routing */
+		cmds[n - 1U].filter_mode = OSI_FRP_MODE_BYPASS;
+	} else {
+		/* Route to DMA channel */
+	}
+
+done:
+	return n;
+}
+
+/**
+ * @brief flow_steer_add - Add flow steering rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] rule: Flow steering rule.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t flow_steer_add(struct osi_core_priv_data *const osi_core,
+			      struct osi_flow_rule *const rule)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct flow_steer_rule *fr = &l_core->flow_rules[rule->rule_id];
+	struct osi_core_frp_cmd cmds[FRP_RULE_MAX_CMDS];
+	nveu32_t hw = OSI_FLOW_HW_NONE;
+	nveu32_t n;
+	nve32_t ret = -1;
+
+	if (fr->in_use == OSI_ENABLE) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: Rule ID already in use: "), (rule->rule_id));
+		goto exit_func;
+	}
+
+	ret = flow_steer_validate(osi_core, rule);
+	if (ret < 0) {
+		goto exit_func;
+	}
+
+	if ((rule->match == OSI_FLOW_MATCH_VLAN_PRIO) &&
+	    (rule->action == OSI_FLOW_ACTION_DMA)) {
+		ret = flow_steer_prio_config(osi_core, rule, OSI_ENABLE);
+		if (ret == 0) {
+			hw = OSI_FLOW_HW_VLAN_PRIO;
+		}
+	}
+
+	if ((hw == OSI_FLOW_HW_NONE) &&
+	    (flow_steer_is_l3l4(rule) == OSI_ENABLE)) {
+		/* L3/L4 filter manager spills to FRP when out of HW slots */
+		ret = flow_steer_l3l4_config(osi_core, rule,
+					     OSI_CMD_L3L4_FILTER, OSI_TRUE);
+		if (ret < 0) {
+			goto exit_func;
+		}
+		fr->l3l4_mgr = OSI_ENABLE;
+		hw = OSI_FLOW_HW_L3L4;
+	}
+
+	if (hw == OSI_FLOW_HW_NONE) {
+		ret = -1;
+		n = flow_steer_frp_prepare(rule, cmds);
+		if ((n == 0U) || (frp_supported(osi_core) == OSI_DISABLE)) {
+			OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+				("FLOW: No HW to back the rule: "),
+				(rule->match));
+			goto exit_func;
+		}
+
+		ret = frp_add_chain(osi_core, l_core->ops_p,
+				    FLOW_STEER_FRP_ID_BASE +
+				    (nve32_t)rule->rule_id, cmds, n);
+		if (ret < 0) {
+			goto exit_func;
+		}
+		l_core->cfg.flags |= DYNAMIC_CFG_FRP;
+		hw = OSI_FLOW_HW_FRP;
+	}
+
+	(void)osi_memcpy(&fr->rule, rule, sizeof(struct osi_flow_rule));
+	fr->hw = hw;
+	fr->hits = 0U;
+	fr->in_use = OSI_ENABLE;
+	rule->hw = flow_steer_hw(osi_core, fr);
+
+exit_func:
+	return ret;
+}
+
+/**
+ * @brief flow_steer_del - Delete flow steering rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] fr: Flow steering rule context.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t flow_steer_del(struct osi_core_priv_data *const osi_core,
+			      struct flow_steer_rule *const fr)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_core_frp_cmd cmd;
+	nve32_t ret;
+
+	if (fr->hw == OSI_FLOW_HW_VLAN_PRIO) {
+		ret = flow_steer_prio_config(osi_core, &fr->rule, OSI_DISABLE);
+	} else if (fr->l3l4_mgr == OSI_ENABLE) {
+		ret = flow_steer_l3l4_config(osi_core, &fr->rule,
+					     OSI_CMD_L3L4_FILTER, OSI_FALSE);
+	} else {
+		(void)osi_memset(&cmd, 0, sizeof(cmd));
+		cmd.cmd = OSI_FRP_CMD_DEL;
+		cmd.frp_id = FLOW_STEER_FRP_ID_BASE + (nve32_t)fr->rule.rule_id;
+		ret = setup_frp(osi_core, l_core->ops_p, &cmd);
+	}
+
+	if (ret == 0) {
+		fr->l3l4_mgr = OSI_DISABLE;
+		fr->in_use = OSI_DISABLE;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief flow_steer_config - Handle flow steering rule operation.
+ *
+ * Algorithm:
+ * - On add, back the rule with VLAN priority Rx queue mapping, L3/L4
+ *   filter or FRP, in this order of preference, based on match fields
+ *   and action.
+ * - On delete, remove the rule from its backing HW.
+ * - On hit, account OSD reported hits and forward them to the L3/L4
+ *   filter manager for rules it owns.
+ * - On stats, return backing HW and total hits of the rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] rule: Flow steering rule (#osi_flow_rule)
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t flow_steer_config(struct osi_core_priv_data *const osi_core,
+			  struct osi_flow_rule *const rule)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct flow_steer_rule *fr;
+	nveu32_t hits;
+	nve32_t ret = -1;
+
+	if (rule->rule_id >= OSI_FLOW_MAX_RULES) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_OUTOFBOUND),
+			("FLOW: Invalid rule ID: "), (rule->rule_id));
+		goto exit_func;
+	}
+
+	fr = &l_core->flow_rules[rule->rule_id];
+	if ((rule->op != OSI_FLOW_OP_ADD) && (fr->in_use == OSI_DISABLE)) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: No rule with ID: "), (rule->rule_id));
+		goto exit_func;
+	}
+
+	switch (rule->op) {
+	case OSI_FLOW_OP_ADD:
+		ret = flow_steer_add(osi_core, rule);
+		break;
+	case OSI_FLOW_OP_DEL:
+		ret = flow_steer_del(osi_core, fr);
+		break;
+	case OSI_FLOW_OP_HIT:
+		fr->hits += rule->hits;
+		ret = 0;
+		if (fr->l3l4_mgr == OSI_ENABLE) {
+			hits = (rule->hits > UINT_MAX) ? UINT_MAX :
+			       (nveu32_t)rule->hits;
+			ret = flow_steer_l3l4_config(osi_core, &fr->rule,
+						     OSI_CMD_L3L4_FILTER_HIT,
+						     hits);
+		}
+		break;
+	case OSI_FLOW_OP_STATS:
+		rule->hw = flow_steer_hw(osi_core, fr);
+		rule->hits = fr->hits;
+		ret = 0;
+		break;
+	default:
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("FLOW: Invalid operation: "), (rule->op));
+		break;
+	}
+
+exit_func:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
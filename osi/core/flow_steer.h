@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FLOW_STEER_H
+#define FLOW_STEER_H
+
+#include <osi_core.h>
+#include "core_local.h"
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief flow_steer_config - Handle flow steering rule operation.
+ *
+ * Algorithm:
+ * - On add, back the rule with VLAN priority Rx queue mapping, L3/L4
+ *   filter or FRP, in this order of preference, based on match fields
+ *   and action.
+ * - On delete, remove the rule from its backing HW.
+ * - On hit, account OSD reported hits and forward them to the L3/L4
+ *   filter manager for L3/L4 backed rules.
+ * - On stats, return backing HW and total hits of the rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] rule: Flow steering rule (#osi_flow_rule)
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t flow_steer_config(struct osi_core_priv_data *const osi_core,
+			  struct osi_flow_rule *const rule);
+#endif /* !OSI_STRIPPED_LIB */
+#endif /* FLOW_STEER_H */
@@ -20,126 +20,10 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+
 #include "../osi/common/common.h"
 #include "frp.h"
 
-/**
- * @brief frp_entry_copy - Copy FRP entry
- *
- * Algorithm: Copy source FRP entry data into destination entry
- *
- * @param[in] dst: Destination FRP entry pointer.
- * @param[in] src: source FRP entry pointer.
- *
- */
-static void frp_entry_copy(struct osi_core_frp_entry *dst,
-			   struct osi_core_frp_entry *const src)
-{
-	dst->frp_id = src->frp_id;
-	dst->data.match_data = src->data.match_data;
-	dst->data.match_en = src->data.match_en;
-	dst->data.accept_frame = src->data.accept_frame;
-	dst->data.reject_frame = src->data.reject_frame;
-	dst->data.inverse_match = src->data.inverse_match;
-	dst->data.next_ins_ctrl = src->data.next_ins_ctrl;
-	dst->data.frame_offset = src->data.frame_offset;
-	dst->data.ok_index = src->data.ok_index;
-	dst->data.dma_chsel = src->data.dma_chsel;
-}
-
-/**
- * @brief frp_entry_find - Find FRP entry in table
- *
- * Algorithm: Parse FRP table for given ID and bookmark
- * start position and count of entries for a given ID.
- *
- * @param[in] osi_core: OSI core private data structure.
- * @param[in] frp_id: FRP ID to find.
- * @param[out] start: Pointer to store start index for given frp_id.
- * @param[out] no_entries: No of FRP index's used for given frp_id.
- *
- * @retval 0 on success.
- * @retval -1 on failure.
- */
-static nve32_t frp_entry_find(struct osi_core_priv_data *const osi_core,
-			      nve32_t frp_id,
-			      nveu8_t *start,
-			      nveu8_t *no_entries)
-{
-	nveu8_t count = OSI_NONE, found = OSI_NONE;
-	struct osi_core_frp_entry *entry = OSI_NULL;
-	nve32_t ret = 0;
-
-	/* Parse the FRP table for give frp_id */
-	for (count = 0U; count < osi_core->frp_cnt; count++) {
-		entry = &osi_core->frp_table[count];
-		if (entry->frp_id == frp_id) {
-			/* Entry found break */
-			if (found == OSI_NONE) {
-				*start = count;
-				*no_entries = 1;
-				found = OSI_ENABLE;
-			} else {
-				/* Increment entries */
-				*no_entries =  (nveu8_t)(*no_entries + 1U);
-			}
-		}
-	}
-
-	if (found == OSI_NONE) {
-		/* No entry found return error */
-		ret = -1;
-	}
-
-	return ret;
-}
-
-/**
- * @brief frp_req_entries - Calculates required FRP entries.
- *
- * Algorithm: Calculates required FRP entries for
- *	the given offset and data length.
- *
- * @param[in] offset: Actual match data offset position.
- * @param[in] match_length: Match data length.
- *
- * @retval No of FRP entries required.
- */
-static nveu8_t frp_req_entries(nveu8_t offset,
-			       nveu8_t match_length)
-{
-	nveu8_t req = 0U;
-	nveu8_t temp_match_length = match_length;
-
-	/* Validate for temp_match_length */
-	if ((temp_match_length == OSI_NONE) ||
-	    (temp_match_length > OSI_FRP_MATCH_DATA_MAX)) {
-		/* return zero */
-		goto done;
-	}
-
-	/* Check does the given length can fit in fist entry */
-	if (temp_match_length <= (nveu8_t)FRP_OFFSET_BYTES(offset)) {
-		/* Require one entry */
-		req = 1U;
-		goto done;
-	}
-	/* Initialize req as 1U and decrement length by FRP_OFFSET_BYTES */
-	req = 1U;
-	temp_match_length = (nveu8_t)(temp_match_length -
-				      (nveu8_t)FRP_OFFSET_BYTES(offset));
-	if ((temp_match_length / FRP_MD_SIZE) < OSI_FRP_MATCH_DATA_MAX) {
-		req = (nveu8_t)(req + (temp_match_length /  FRP_MD_SIZE));
-		if ((temp_match_length % FRP_MD_SIZE) != OSI_NONE) {
-			/* Need one more entry */
-			req  = (nveu8_t)(req + 1U);
-		}
-	}
-
-done:
-	return req;
-}
-
 /**
  * @brief frp_entry_mode_parse - Filter mode parse function.
  *
@@ -201,407 +85,961 @@ static void frp_entry_mode_parse(nveu8_t filter_mode,
 	}
 }
 
+
+/**
+ * @brief frp_parse_offset - Process and update FRP Command offset.
+ *
+ * Algorithm: Parse give FRP command match type and update it's offset.
+ *
+ * @param[in] cmd: OSI FRP command structure.
+ *
+ */
+static void frp_parse_mtype(struct osi_core_frp_cmd *const cmd)
+{
+	nveu8_t offset;
+	nveu8_t match_type = cmd->match_type;
+
+	switch (match_type) {
+	case OSI_FRP_MATCH_L2_DA:
+		offset = FRP_L2_DA_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L2_SA:
+		offset = FRP_L2_SA_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L3_SIP:
+		offset = FRP_L3_IP4_SIP_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L3_DIP:
+		offset = FRP_L3_IP4_DIP_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L4_S_UPORT:
+		offset = FRP_L4_IP4_SPORT_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L4_D_UPORT:
+		offset = FRP_L4_IP4_DPORT_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L4_S_TPORT:
+		offset = FRP_L4_IP4_SPORT_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L4_D_TPORT:
+		offset = FRP_L4_IP4_DPORT_OFFSET;
+		break;
+	case OSI_FRP_MATCH_VLAN:
+		offset = FRP_L2_VLAN_TAG_OFFSET;
+		break;
+	case OSI_FRP_MATCH_NORMAL:
+	default:
+		offset = cmd->offset;
+		break;
+	}
+
+	/* Update command offset */
+	cmd->offset = offset;
+}
+
+
 /**
- * @brief frp_entry_add - Add new FRP entries in table.
+ * @brief frp_entry_equal - Compare two FRP entries data.
  *
- * Algorithm: This function will prepare the FRP entries
- *	for given inputs add or update them from a given
- *	position into the FRP table.
+ * @param[in] a: First FRP entry data.
+ * @param[in] b: Second FRP entry data.
+ *
+ * @retval OSI_ENABLE if HW instructions are same.
+ * @retval OSI_DISABLE otherwise.
+ */
+static nveu32_t frp_entry_equal(const struct osi_core_frp_data *const a,
+				const struct osi_core_frp_data *const b)
+{
+	return ((a->match_data == b->match_data) &&
+		(a->match_en == b->match_en) &&
+		(a->accept_frame == b->accept_frame) &&
+		(a->reject_frame == b->reject_frame) &&
+		(a->inverse_match == b->inverse_match) &&
+		(a->next_ins_ctrl == b->next_ins_ctrl) &&
+		(a->frame_offset == b->frame_offset) &&
+		(a->ok_index == b->ok_index) &&
+		(a->dma_chsel == b->dma_chsel)) ? OSI_ENABLE : OSI_DISABLE;
+}
+
+/**
+ * @brief frp_hw_entry_write - Write FRP entry into HW.
+ *
+ * Algorithm: Skip the write when HW shadow already holds the same entry
+ *	unless a write is forced. Shadow is invalidated on write failure.
  *
  * @param[in] osi_core: OSI core private data structure.
- * @param[in] frp_id: FRP ID to add.
- * @param[in] pos: FRP entry position.
- * @param[in] match: Pointer to match data.
- * @param[in] length: Match data length.
- * @param[in] offset: Actual match data offset position.
- * @param[in] filter_mode: Filter mode from FRP command.
- * @param[in] next_frp_id: FRP ID to link this ID.
- * @param[in] dma_sel: Indicate the DMA Channel Number (1-bit for each).
+ * @param[in] ops_p: Core operations data structure.
+ * @param[in] pos: FRP Instruction Table entry location.
+ * @param[in] data: FRP entry data.
+ * @param[in] force: Write entry regardless of HW shadow.
  *
  * @retval 0 on success.
  * @retval -1 on failure.
  */
-static nve32_t frp_entry_add(struct osi_core_priv_data *const osi_core,
-			     nve32_t frp_id,
-			     nveu8_t pos,
-			     nveu8_t *const match,
-			     nveu8_t length,
-			     nveu8_t offset,
-			     nveu8_t filter_mode,
-			     nve32_t next_frp_id,
-			     nveu32_t dma_sel)
+static nve32_t frp_hw_entry_write(struct osi_core_priv_data *const osi_core,
+				  struct core_ops *const ops_p,
+				  nveu32_t pos,
+				  struct osi_core_frp_data *const data,
+				  nveu32_t force)
 {
-	struct osi_core_frp_entry *entry = OSI_NULL;
-	struct osi_core_frp_data *data = OSI_NULL;
-	nveu32_t req_entries = 0U;
-	nveu8_t ok_index = 0U;
-	nveu8_t fo_t = 0U;
-	nveu8_t fp_t = 0U;
-	nveu8_t i = 0U, j = 0U, md_pos = 0U;
-	nveu8_t temp_pos = pos;
-	nve32_t ret;
-	nveu32_t dma_sel_val[MAX_MAC_IP_TYPES] = {0xFFU, 0x3FF};
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nve32_t ret = 0;
 
-	/* Validate length */
-	if (length > OSI_FRP_MATCH_DATA_MAX) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
-			"Invalid match length\n",
-			length);
-		ret = -1;
+	if ((force == OSI_DISABLE) &&
+	    (frp_entry_equal(&l_core->frp_hw[pos], data) == OSI_ENABLE)) {
 		goto done;
 	}
 
-	/* Validate filter_mode */
-	if (filter_mode >= OSI_FRP_MODE_MAX) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			"Invalid filter mode argment\n",
-			filter_mode);
-		ret = -1;
+	ret = ops_p->update_frp_entry(osi_core, pos, data);
+	if (ret < 0) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			     "Fail to update FRP entry\n",
+			     pos);
+		l_core->frp_hw_start = OSI_NONE;
 		goto done;
 	}
+	l_core->frp_hw[pos] = *data;
 
-	/* Validate offset */
-	if (offset >= OSI_FRP_OFFSET_MAX) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			"Invalid offset value\n",
-			offset);
+done:
+	return ret;
+}
+
+/**
+ * @brief frp_hw_stage - Write FRP table into HW at given location.
+ *
+ * Algorithm: Write FRP table entries with relocated OKI followed by the
+ *	BYPASS entry for XDCS starting from given HW entry location.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] ops_p: Core operations data structure.
+ * @param[in] start: First HW entry location of the table.
+ * @param[in] force: Write entries regardless of HW shadow.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+static nve32_t frp_hw_stage(struct osi_core_priv_data *const osi_core,
+			    struct core_ops *const ops_p,
+			    nveu32_t start,
+			    nveu32_t force)
+{
+	struct osi_core_frp_data data;
+	nveu32_t i;
+	nve32_t ret = 0;
+
+	for (i = 0U; i < osi_core->frp_cnt; i++) {
+		data = osi_core->frp_table[i].data;
+		if (data.next_ins_ctrl == OSI_ENABLE) {
+			data.ok_index = (nveu8_t)(data.ok_index + start);
+		}
+		ret = frp_hw_entry_write(osi_core, ops_p, start + i, &data,
+					 force);
+		if (ret < 0) {
+			goto done;
+		}
+	}
+
+	/* Write BYPASS rule for XDCS */
+	(void)osi_memset(&data, 0U, sizeof(data));
+	data.accept_frame = OSI_ENABLE;
+	data.reject_frame = OSI_ENABLE;
+	ret = frp_hw_entry_write(osi_core, ops_p, start + osi_core->frp_cnt,
+				 &data, force);
+
+done:
+	return ret;
+}
+
+/**
+ * @brief frp_hw_root_write - Point FRP root entry to a table.
+ *
+ * Algorithm: Root entry at location 0 matches every frame and jumps to
+ *	the active table. Only OKI differs between two root entries, so
+ *	the switch is a single instruction word update in HW.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] ops_p: Core operations data structure.
+ * @param[in] start: First HW entry location of the table.
+ * @param[in] force: Write entry regardless of HW shadow.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+static nve32_t frp_hw_root_write(struct osi_core_priv_data *const osi_core,
+				 struct core_ops *const ops_p,
+				 nveu32_t start,
+				 nveu32_t force)
+{
+	struct osi_core_frp_data root;
+
+	(void)osi_memset(&root, 0U, sizeof(root));
+	root.next_ins_ctrl = OSI_ENABLE;
+	root.ok_index = (nveu8_t)start;
+
+	return frp_hw_entry_write(osi_core, ops_p, FRP_HW_ROOT_ENTRY, &root,
+				  force);
+}
+
+/**
+ * @brief frp_hw_full_write - Rewrite complete FRP table in HW.
+ *
+ * Algorithm: Disable the FRP, write the table next to the root entry,
+ *	update NVE and enable the FRP.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] ops_p: Core operations data structure.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+static nve32_t frp_hw_full_write(struct osi_core_priv_data *const osi_core,
+				 struct core_ops *const ops_p)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	const nveu32_t start = FRP_HW_ROOT_ENTRY + 1U;
+	nve32_t ret = 0;
+	nve32_t tmp = 0;
+
+	/* HW content is unknown, no valid entry has all bits set */
+	l_core->frp_hw_start = OSI_NONE;
+	(void)osi_memset(l_core->frp_hw, 0xFFU, sizeof(l_core->frp_hw));
+
+	/* Disable the FRP in HW */
+	ret = ops_p->config_frp(osi_core, OSI_DISABLE);
+	if (ret < 0) {
+		/* Fail to disable try to enable it back */
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			"HW Fail on FRP update\n",
+			OSI_NONE);
+		goto hw_write_enable_frp;
+	}
+
+	ret = frp_hw_stage(osi_core, ops_p, start, OSI_ENABLE);
+	if (ret < 0) {
+		goto hw_write_enable_frp;
+	}
+
+	ret = frp_hw_root_write(osi_core, ops_p, start, OSI_ENABLE);
+	if (ret < 0) {
+		goto hw_write_enable_frp;
+	}
+
+	/* Update the NVE */
+	ret = ops_p->update_frp_nve(osi_core, start + osi_core->frp_cnt);
+	if (ret < 0) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			"Fail to update FRP NVE\n",
+			OSI_NONE);
+		goto hw_write_enable_frp;
+	}
+
+	l_core->frp_hw_start = start;
+	l_core->frp_hw_len = osi_core->frp_cnt + 1U;
+
+	/* Enable the FRP in HW */
+hw_write_enable_frp:
+	tmp = ops_p->config_frp(osi_core, OSI_ENABLE);
+	if (tmp < 0) {
+		l_core->frp_hw_start = OSI_NONE;
+	}
+
+	return (ret < 0) ? ret : tmp;
+}
+
+/**
+ * @brief frp_hw_write - Update HW FRP table.
+ *
+ * Algorithm:
+ * - HW table starts with a root entry jumping to the active table.
+ * - New table is written into the HW entries not used by active table,
+ *   only the entries which differ from the HW shadow are written. These
+ *   entries are not reachable by the parser while being written.
+ * - NVE is raised to cover the new table, root entry is switched to the
+ *   new table and NVE is lowered to its end. FRP stays enabled, so a
+ *   frame is parsed either by the old or the new table.
+ * - Fallback to FRP disable and full rewrite when HW shadow isn't valid
+ *   or there is no free space for the new table.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] ops_p: Core operations data structure.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+nve32_t frp_hw_write(struct osi_core_priv_data *const osi_core,
+		     struct core_ops *const ops_p)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu32_t frp_cnt = osi_core->frp_cnt;
+	nveu32_t len = frp_cnt + 1U;
+	nveu32_t old_start = l_core->frp_hw_start;
+	nveu32_t old_nve = OSI_NONE, new_nve, start = OSI_NONE;
+	nve32_t ret = 0;
+
+	/* Check space for root and XCS BYPASS rules */
+	if ((frp_cnt + FRP_HW_RSVD_ENTRIES) > OSI_FRP_MAX_ENTRY) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			     "No space for rules\n", OSI_NONE);
 		ret = -1;
 		goto done;
 	}
 
-	/* Validate channel selection */
-	if (dma_sel > dma_sel_val[osi_core->mac]) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			     "Invalid DMA selection\n",
-			     (nveu64_t)dma_sel);
-		ret = -1;
+	/* Empty table, keep FRP disabled */
+	if (frp_cnt == 0U) {
+		l_core->frp_hw_start = OSI_NONE;
+		ret = ops_p->config_frp(osi_core, OSI_DISABLE);
 		goto done;
 	}
 
-	/* Check for avilable space */
-	req_entries = frp_req_entries(offset, length);
-	if ((req_entries >= OSI_FRP_MAX_ENTRY) ||
-	    ((req_entries + temp_pos) >= OSI_FRP_MAX_ENTRY)) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			"No space to update FRP ID\n",
-			OSI_NONE);
-		ret = -1;
+	/* Find HW entries not used by active table */
+	if (old_start != OSI_NONE) {
+		old_nve = old_start + l_core->frp_hw_len - 1U;
+		if ((FRP_HW_ROOT_ENTRY + 1U + len) <= old_start) {
+			start = FRP_HW_ROOT_ENTRY + 1U;
+		} else if ((old_nve + 1U + len) <= OSI_FRP_MAX_ENTRY) {
+			start = old_nve + 1U;
+		} else {
+			/* No free space, full rewrite */
+		}
+	}
+
+	if (start == OSI_NONE) {
+		ret = frp_hw_full_write(osi_core, ops_p);
 		goto done;
 	}
 
-	/* Validate next_frp_id index ok_index */
-	if ((filter_mode == OSI_FRP_MODE_LINK) ||
-	    (filter_mode == OSI_FRP_MODE_IM_LINK)) {
-		if (frp_entry_find(osi_core, next_frp_id, &i, &j) < 0) {
-			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				"No Link FRP ID index found\n",
-				OSI_NONE);
-			i = (nveu8_t)next_frp_id;
+	ret = frp_hw_stage(osi_core, ops_p, start, OSI_DISABLE);
+	if (ret < 0) {
+		goto done;
+	}
+
+	new_nve = start + frp_cnt;
+	if (new_nve > old_nve) {
+		ret = ops_p->update_frp_nve(osi_core, new_nve);
+		if (ret < 0) {
+			goto nve_fail;
 		}
-		ok_index = i;
 	}
 
-	/* Start data fill from 0U ... (length - 1U) */
-	fo_t = (offset / FRP_MD_SIZE);
-	fp_t = (offset % FRP_MD_SIZE);
-	md_pos = 0U;
-	for (i = 0U; i < req_entries; i++) {
-		/* Get FRP entry*/
-		entry = &osi_core->frp_table[temp_pos];
-		data = &entry->data;
+	ret = frp_hw_root_write(osi_core, ops_p, start, OSI_DISABLE);
+	if (ret < 0) {
+		goto done;
+	}
+
+	if (new_nve < old_nve) {
+		ret = ops_p->update_frp_nve(osi_core, new_nve);
+		if (ret < 0) {
+			goto nve_fail;
+		}
+	}
+
+	l_core->frp_hw_start = start;
+	l_core->frp_hw_len = len;
+	goto done;
+
+nve_fail:
+	OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+		     "Fail to update FRP NVE\n",
+		     OSI_NONE);
+	l_core->frp_hw_start = OSI_NONE;
+done:
+	return ret;
+}
+
+/**
+ * @brief frp_rule_end - Get end of FRP rule in rule set.
+ *
+ * Algorithm: A rule is the run of consecutive commands with same FRP ID.
+ *
+ * @param[in] l_core: OSI local core data structure.
+ * @param[in] start: Index of first command of the rule.
+ *
+ * @retval Index of first command after the rule.
+ */
+static nveu32_t frp_rule_end(const struct core_local *const l_core,
+			     nveu32_t start)
+{
+	nveu32_t i = start + 1U;
+
+	while ((i < l_core->frp_rules_cnt) &&
+	       (l_core->frp_rules[i].frp_id == l_core->frp_rules[start].frp_id)) {
+		i++;
+	}
+
+	return i;
+}
+
+/**
+ * @brief frp_rule_find - Find FRP rule in rule set.
+ *
+ * @param[in] l_core: OSI local core data structure.
+ * @param[in] frp_id: FRP ID to find.
+ * @param[out] start: Index of first command of the rule.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+static nve32_t frp_rule_find(const struct core_local *const l_core,
+			     nve32_t frp_id, nveu32_t *start)
+{
+	nveu32_t i;
+	nve32_t ret = -1;
+
+	for (i = 0U; i < l_core->frp_rules_cnt; i++) {
+		if (l_core->frp_rules[i].frp_id == frp_id) {
+			*start = i;
+			ret = 0;
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief frp_mode_is_inverse - Check for inverse match filter mode.
+ *
+ * @param[in] filter_mode: Filter mode from FRP command.
+ *
+ * @retval OSI_ENABLE for inverse route, drop and bypass modes.
+ * @retval OSI_DISABLE otherwise.
+ */
+static nveu8_t frp_mode_is_inverse(nveu8_t filter_mode)
+{
+	return ((filter_mode == OSI_FRP_MODE_IM_ROUTE) ||
+		(filter_mode == OSI_FRP_MODE_IM_DROP) ||
+		(filter_mode == OSI_FRP_MODE_IM_BYPASS)) ?
+		(nveu8_t)OSI_ENABLE : (nveu8_t)OSI_DISABLE;
+}
+
+/**
+ * @brief frp_mode_is_link - Check for link filter mode.
+ *
+ * @param[in] filter_mode: Filter mode from FRP command.
+ *
+ * @retval OSI_ENABLE for link modes.
+ * @retval OSI_DISABLE otherwise.
+ */
+static nveu32_t frp_mode_is_link(nveu8_t filter_mode)
+{
+	return ((filter_mode == OSI_FRP_MODE_LINK) ||
+		(filter_mode == OSI_FRP_MODE_IM_LINK)) ?
+		OSI_ENABLE : OSI_DISABLE;
+}
+
+/**
+ * @brief frp_match_atoms - Split match data into FRP atoms.
+ *
+ * Algorithm: Fill match data bytes into FRP_MD_SIZE aligned atoms starting
+ *	from given offset.
+ *
+ * @param[in] match: Pointer to match data.
+ * @param[in] length: Match data length.
+ * @param[in] offset: Actual match data offset position.
+ * @param[in] inverse: Inverse match flag for the atoms.
+ * @param[out] atoms: Atoms array.
+ * @param[in] idx: First free index in atoms array.
+ *
+ * @retval Next free index in atoms array.
+ */
+static nveu32_t frp_match_atoms(const nveu8_t *const match,
+				nveu8_t length,
+				nveu8_t offset,
+				nveu8_t inverse,
+				struct frp_atom *const atoms,
+				nveu32_t idx)
+{
+	nveu32_t n = idx;
+	nveu8_t fo_t = (nveu8_t)(offset / FRP_MD_SIZE);
+	nveu8_t fp_t = (nveu8_t)(offset % FRP_MD_SIZE);
+	nveu8_t md_pos = 0U;
+	nveu8_t j;
+
+	while ((md_pos < length) && (n < FRP_RULE_MAX_ATOMS)) {
+		atoms[n].match_data = OSI_NONE;
+		atoms[n].match_en = OSI_NONE;
+		atoms[n].frame_offset = fo_t;
+		atoms[n].inverse = inverse;
+		for (j = fp_t; (j < FRP_MD_SIZE) && (md_pos < length); j++) {
+			atoms[n].match_data |= ((nveu32_t)match[md_pos])
+						<< (j * FRP_ME_BYTE_SHIFT);
+			atoms[n].match_en |= ((nveu32_t)FRP_ME_BYTE <<
+					      (j * FRP_ME_BYTE_SHIFT));
+			md_pos++;
+		}
+		n++;
+		fo_t++;
+		fp_t = OSI_NONE;
+	}
+
+	return n;
+}
+
+/**
+ * @brief frp_cmd_atoms - Translate FRP command into FRP atoms.
+ *
+ * Algorithm: Add protocol atom for L4 port and VLAN match types followed
+ *	by the command match data atoms.
+ *
+ * @param[in] cmd: OSI FRP command structure.
+ * @param[in] inverse: Inverse match flag for match data atoms.
+ * @param[out] atoms: Atoms array.
+ * @param[in] idx: First free index in atoms array.
+ *
+ * @retval Next free index in atoms array.
+ */
+static nveu32_t frp_cmd_atoms(const struct osi_core_frp_cmd *const cmd,
+			      nveu8_t inverse,
+			      struct frp_atom *const atoms,
+			      nveu32_t idx)
+{
+	nveu8_t proto_match[FRP_PROTO_LENGTH];
+	nveu8_t proto_length = 0U;
+	nveu8_t proto_offset = 0U;
+	nveu32_t n = idx;
+
+	switch (cmd->match_type) {
+	case OSI_FRP_MATCH_L4_S_UPORT:
+	case OSI_FRP_MATCH_L4_D_UPORT:
+		proto_match[0] = FRP_L4_UDP_MD;
+		proto_length = 1U;
+		proto_offset = FRP_L4_IP4_PROTO_OFFSET;
+		break;
+	case OSI_FRP_MATCH_L4_S_TPORT:
+	case OSI_FRP_MATCH_L4_D_TPORT:
+		proto_match[0] = FRP_L4_TCP_MD;
+		proto_length = 1U;
+		proto_offset = FRP_L4_IP4_PROTO_OFFSET;
+		break;
+	case OSI_FRP_MATCH_VLAN:
+		proto_match[0] = FRP_L2_VLAN_MD0;
+		proto_match[1] = FRP_L2_VLAN_MD1;
+		proto_length = 2U;
+		proto_offset = FRP_L2_VLAN_PROTO_OFFSET;
+		break;
+	case OSI_FRP_MATCH_NORMAL:
+	default:
+		/* No protocol atom */
+		break;
+	}
+
+	if (proto_length != 0U) {
+		n = frp_match_atoms(proto_match, proto_length, proto_offset,
+				    OSI_DISABLE, atoms, n);
+	}
+
+	return frp_match_atoms(cmd->match, cmd->match_length, cmd->offset,
+			       inverse, atoms, n);
+}
+
+/**
+ * @brief frp_rule_atoms - Translate FRP rule into FRP atoms.
+ *
+ * Algorithm: Concatenate atoms of all commands of the rule. Only the match
+ *	data of the last command takes the inverse flag of its filter mode.
+ *
+ * @param[in] l_core: OSI local core data structure.
+ * @param[in] start: Index of first command of the rule.
+ * @param[out] atoms: Atoms array of FRP_RULE_MAX_ATOMS.
+ *
+ * @retval Number of atoms.
+ */
+static nveu32_t frp_rule_atoms(const struct core_local *const l_core,
+			       nveu32_t start,
+			       struct frp_atom *const atoms)
+{
+	nveu32_t end = frp_rule_end(l_core, start);
+	nveu32_t n = 0U;
+	nveu32_t i;
+	nveu8_t inverse;
+
+	for (i = start; i < end; i++) {
+		inverse = (i == (end - 1U)) ?
+			  frp_mode_is_inverse(l_core->frp_rules[i].filter_mode) :
+			  (nveu8_t)OSI_DISABLE;
+		n = frp_cmd_atoms(&l_core->frp_rules[i], inverse, atoms, n);
+	}
+
+	return n;
+}
+
+/**
+ * @addtogroup FRP_INFO FRP rule compile flags
+ *
+ * @brief Per rule flags computed once per compile
+ * @{
+ */
+/** First atom of the rule can be shared with following rules */
+#define FRP_INFO_PREFIX		OSI_BIT(0)
+/** Rule is a link rule or link target and keeps its table position */
+#define FRP_INFO_BARRIER	OSI_BIT(1)
+/** Rule is already written into the compiled table */
+#define FRP_INFO_PLACED		OSI_BIT(2)
+/** @} */
+
+/**
+ * @brief frp_atom_exclusive - Check two atoms can't match same frame.
+ *
+ * @param[in] a: First atom.
+ * @param[in] b: Second atom.
+ *
+ * @retval OSI_ENABLE if atoms compare different values of same bytes.
+ * @retval OSI_DISABLE otherwise.
+ */
+static nveu32_t frp_atom_exclusive(const struct frp_atom *const a,
+				   const struct frp_atom *const b)
+{
+	return ((a->inverse == OSI_DISABLE) && (b->inverse == OSI_DISABLE) &&
+		(a->frame_offset == b->frame_offset) &&
+		(((a->match_data ^ b->match_data) & a->match_en & b->match_en)
+		 != OSI_NONE)) ? OSI_ENABLE : OSI_DISABLE;
+}
+
+/**
+ * @brief frp_rule_info - Compute first atom and flags of all FRP rules.
+ *
+ * Algorithm:
+ * - Link rules and link targets depend on the entries following them, so
+ *   they are barriers no rule is moved across.
+ * - First atom of a rule can be shared if it is a normal match followed by
+ *   at least one more atom and the rule is not a barrier.
+ *
+ * @param[in] l_core: OSI local core data structure.
+ * @param[out] first: First atom of each rule, indexed by first command.
+ * @param[out] flags: FRP_INFO_* flags of each rule, indexed by first
+ *		      command.
+ */
+static void frp_rule_info(const struct core_local *const l_core,
+			  struct frp_atom *const first, nveu8_t *const flags)
+{
+	struct frp_atom atoms[FRP_RULE_MAX_ATOMS];
+	const struct osi_core_frp_cmd *last;
+	nveu32_t i, j, end, n;
+
+	(void)osi_memset(flags, 0U, OSI_FRP_MAX_ENTRY);
+	for (i = 0U; i < l_core->frp_rules_cnt; i = end) {
+		end = frp_rule_end(l_core, i);
+		last = &l_core->frp_rules[end - 1U];
+		if (frp_mode_is_link(last->filter_mode) == OSI_DISABLE) {
+			continue;
+		}
+
+		flags[i] |= FRP_INFO_BARRIER;
+		if (frp_rule_find(l_core, last->next_frp_id, &j) == 0) {
+			flags[j] |= FRP_INFO_BARRIER;
+		}
+	}
+
+	for (i = 0U; i < l_core->frp_rules_cnt; i = frp_rule_end(l_core, i)) {
+		n = frp_rule_atoms(l_core, i, atoms);
+		first[i] = atoms[0];
+		if ((n > 1U) && (atoms[0].inverse == OSI_DISABLE) &&
+		    ((flags[i] & FRP_INFO_BARRIER) == OSI_NONE)) {
+			flags[i] |= FRP_INFO_PREFIX;
+		}
+	}
+}
+
+/**
+ * @brief frp_group_next - Find next rule sharing the prefix atom.
+ *
+ * Algorithm: Scan not yet placed rules from given index. A rule with the
+ *	same prefix is returned. Rules with a prefix exclusive to the shared
+ *	one are skipped since moving a rule across them keeps the match
+ *	result. Any other rule ends the scan.
+ *
+ * @param[in] l_core: OSI local core data structure.
+ * @param[in] first: First atom of each rule from frp_rule_info().
+ * @param[in] flags: Flags of each rule from frp_rule_info().
+ * @param[in] shared: Shared prefix atom.
+ * @param[in] from: Command index to start scan.
+ *
+ * @retval Index of next group rule, frp_rules_cnt if none.
+ */
+static nveu32_t frp_group_next(const struct core_local *const l_core,
+			       const struct frp_atom *const first,
+			       const nveu8_t *const flags,
+			       const struct frp_atom *const shared,
+			       nveu32_t from)
+{
+	const struct frp_atom *atom;
+	nveu32_t j = from;
+
+	while (j < l_core->frp_rules_cnt) {
+		if ((flags[j] & FRP_INFO_PLACED) == OSI_NONE) {
+			atom = &first[j];
+			if ((flags[j] & FRP_INFO_PREFIX) != OSI_NONE) {
+				if ((atom->match_data == shared->match_data) &&
+				    (atom->match_en == shared->match_en) &&
+				    (atom->frame_offset == shared->frame_offset)) {
+					/* group member found */
+					break;
+				}
+			} else if ((flags[j] & FRP_INFO_BARRIER) != OSI_NONE) {
+				j = l_core->frp_rules_cnt;
+				break;
+			} else {
+				/* Not shareable, check exclusiveness below */
+			}
 
-		/* Fill FRP ID */
-		entry->frp_id = frp_id;
-
-		/* Fill MD and ME */
-		data->match_data = OSI_NONE;
-		data->match_en = OSI_NONE;
-		for (j = fp_t; j < FRP_MD_SIZE; j++) {
-			data->match_data |= ((nveu32_t)match[md_pos])
-					     << (j * FRP_ME_BYTE_SHIFT);
-			data->match_en |= ((nveu32_t)FRP_ME_BYTE <<
-					   (j * FRP_ME_BYTE_SHIFT));
-			md_pos++;
-			if (md_pos >= length) {
-				/* data fill completed */
+			if (frp_atom_exclusive(shared, atom) == OSI_DISABLE) {
+				j = l_core->frp_rules_cnt;
 				break;
 			}
 		}
+		j = frp_rule_end(l_core, j);
+	}
 
-		/* Fill FO */
-		data->frame_offset = fo_t;
+	return j;
+}
 
-		/* Fill AF, RF, and IM flags */
-		frp_entry_mode_parse(filter_mode, data);
+/**
+ * @brief frp_emit_rule - Write FRP rule entries into FRP table.
+ *
+ * Algorithm: Every normal match atom except the last one is written as
+ *	inverse match entry which jumps past the rule when the data doesn't
+ *	match, so a frame walks only until the first mismatch. Last atom and
+ *	inverse match atoms take the rule filter mode.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] start: Index of first command of the rule.
+ * @param[in] skip: Number of leading atoms covered by a shared prefix.
+ * @param[in, out] pos: FRP table position.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+static nve32_t frp_emit_rule(struct osi_core_priv_data *const osi_core,
+			     nveu32_t start, nveu32_t skip, nveu32_t *pos)
+{
+	const struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	const struct osi_core_frp_cmd *last =
+		&l_core->frp_rules[frp_rule_end(l_core, start) - 1U];
+	struct frp_atom atoms[FRP_RULE_MAX_ATOMS];
+	struct osi_core_frp_entry *entry;
+	struct osi_core_frp_data *data;
+	nveu32_t n, k, rule_end;
+	nve32_t ret = 0;
 
-		/* Fill DCH */
-		data->dma_chsel = dma_sel;
+	n = frp_rule_atoms(l_core, start, atoms);
+	rule_end = *pos + n - skip;
+	/* Keep space for root and BYPASS rules */
+	if ((rule_end + FRP_HW_RSVD_ENTRIES) > OSI_FRP_MAX_ENTRY) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
+			     "No space for rules\n", rule_end);
+		ret = -1;
+		goto done;
+	}
 
-		/* Check for the remain data and update FRP flags */
-		if (md_pos < length) {
-			/* Reset AF, RF and set NIC, OKI */
-			data->accept_frame = OSI_DISABLE;
-			data->reject_frame = OSI_DISABLE;
+	for (k = skip; k < n; k++) {
+		entry = &osi_core->frp_table[*pos];
+		data = &entry->data;
+		(void)osi_memset(entry, 0U, sizeof(struct osi_core_frp_entry));
+		entry->frp_id = l_core->frp_rules[start].frp_id;
+		data->match_data = atoms[k].match_data;
+		data->match_en = atoms[k].match_en;
+		data->frame_offset = atoms[k].frame_offset;
+		data->dma_chsel = last->dma_sel;
+
+		if ((atoms[k].inverse == OSI_DISABLE) && (k != (n - 1U))) {
+			/* Skip rest of the rule on mismatch */
+			data->inverse_match = OSI_ENABLE;
 			data->next_ins_ctrl = OSI_ENABLE;
-
-			/* Init next FRP entry */
-			temp_pos++;
-			fo_t++;
-			fp_t = OSI_NONE;
-			data->ok_index = temp_pos;
+			data->ok_index = (nveu8_t)rule_end;
 		} else {
-			data->next_ins_ctrl = OSI_DISABLE;
-			data->ok_index = OSI_DISABLE;
+			frp_entry_mode_parse(last->filter_mode, data);
+			if (frp_mode_is_link(last->filter_mode) == OSI_ENABLE) {
+				/* OKI updated by frp_resolve_links() */
+				data->next_ins_ctrl = OSI_ENABLE;
+			}
 		}
+		*pos = *pos + 1U;
 	}
 
-	/* Check and fill final OKI */
-	if ((filter_mode == OSI_FRP_MODE_LINK) ||
-	    (filter_mode == OSI_FRP_MODE_IM_LINK)) {
-		/* Update NIC and OKI in final entry */
-		data->next_ins_ctrl = OSI_ENABLE;
-		data->ok_index = ok_index;
-	}
-
-	ret = 0;
 done:
 	return ret;
 }
 
 /**
- * @brief frp_hw_write - Update HW FRP table.
+ * @brief frp_resolve_links - Update OKI of link rules.
  *
- * Algorithm: Update FRP table into HW.
+ * Algorithm: Point last entry of each link rule to the first entry of the
+ *	next_frp_id rule in compiled table.
  *
  * @param[in] osi_core: OSI core private data structure.
- * @param[in] ops_p: Core operations data structure.
- *
- * @retval 0 on success.
- * @retval -1 on failure.
  */
-nve32_t frp_hw_write(struct osi_core_priv_data *const osi_core,
-		     struct core_ops *const ops_p)
+static void frp_resolve_links(struct osi_core_priv_data *const osi_core)
 {
-	nve32_t ret = 0;
-	nve32_t tmp = 0;
-	struct osi_core_frp_entry *entry;
-	struct osi_core_frp_data bypass_entry = {};
-	nveu32_t frp_cnt = osi_core->frp_cnt, i = OSI_NONE;
-
-	/* Disable the FRP in HW */
-	ret = ops_p->config_frp(osi_core, OSI_DISABLE);
-	if (ret < 0) {
-		/* Fail to disable try to enable it back */
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"HW Fail on FRP update\n",
-			OSI_NONE);
-		goto hw_write_enable_frp;
-	}
-
-	/* Check space for XCS BYPASS rule */
-	if ((frp_cnt + 1U) > OSI_FRP_MAX_ENTRY) {
-		ret = -1;
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			     "No space for rules\n", OSI_NONE);
-		goto error;
-	}
+	const struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	const struct osi_core_frp_cmd *last;
+	nveu32_t i, p, tail, target;
+
+	for (i = 0U; i < l_core->frp_rules_cnt; i = frp_rule_end(l_core, i)) {
+		last = &l_core->frp_rules[frp_rule_end(l_core, i) - 1U];
+		if (frp_mode_is_link(last->filter_mode) == OSI_DISABLE) {
+			continue;
+		}
 
-	/* Check HW table size for non-zero */
-	if (frp_cnt != 0U) {
-		/* Write FRP entries into HW  */
-		for (i = 0; i < frp_cnt; i++) {
-			entry = &osi_core->frp_table[i];
-			ret = ops_p->update_frp_entry(osi_core, i,
-						      &entry->data);
-			if (ret < 0) {
-				OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-					"Fail to update FRP entry\n",
-					OSI_NONE);
-				goto hw_write_enable_frp;
+		tail = OSI_FRP_MAX_ENTRY;
+		target = OSI_FRP_MAX_ENTRY;
+		for (p = 0U; p < osi_core->frp_cnt; p++) {
+			if (osi_core->frp_table[p].frp_id == last->frp_id) {
+				tail = p;
+			}
+			if ((target == OSI_FRP_MAX_ENTRY) &&
+			    (osi_core->frp_table[p].frp_id == last->next_frp_id)) {
+				target = p;
 			}
 		}
 
-		/* Write BYPASS rule for XDCS */
-		bypass_entry.match_en = 0x0U;
-		bypass_entry.accept_frame = 1;
-		bypass_entry.reject_frame = 1;
-		ret = ops_p->update_frp_entry(osi_core, frp_cnt, &bypass_entry);
-		if (ret < 0) {
+		if (target == OSI_FRP_MAX_ENTRY) {
 			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				"Fail to update BYPASS entry\n",
-				OSI_NONE);
-			goto hw_write_enable_frp;
+				     "No Link FRP ID index found\n", OSI_NONE);
+			target = (nveu32_t)last->next_frp_id;
 		}
 
-		/* Update the NVE */
-		ret = ops_p->update_frp_nve(osi_core, frp_cnt);
-		if (ret < 0) {
-			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				"Fail to update FRP NVE\n",
-				OSI_NONE);
+		if (tail != OSI_FRP_MAX_ENTRY) {
+			osi_core->frp_table[tail].data.ok_index = (nveu8_t)target;
 		}
-
-		/* Enable the FRP in HW */
-hw_write_enable_frp:
-		tmp = ops_p->config_frp(osi_core, OSI_ENABLE);
 	}
-
-error:
-	return (ret < 0) ? ret : tmp;
 }
 
 /**
- * @brief frp_add_proto - Process and update FRP Command Protocal Entry.
+ * @brief frp_compile - Compile FRP rule set into FRP table.
  *
- * Algorithm: Parse give FRP command and update Protocal Entry.
+ * Algorithm:
+ * - Compute first atom and flags of every rule once.
+ * - Walk rules in order. Following rules with the same first atom are
+ *   pulled into a group when only rules exclusive to that atom are in
+ *   between. A group shares one inverse match entry for the prefix which
+ *   jumps past the whole group, members skip their own first atom.
+ * - Resolve the link rules OKI in the compiled table.
  *
  * @param[in] osi_core: OSI core private data structure.
- * @param[in] cmd: OSI FRP command structure.
- * @param[in] pos: Pointer to the FRP entry position.
  *
  * @retval 0 on success.
  * @retval -1 on failure.
  */
-static nve32_t frp_add_proto(struct osi_core_priv_data *const osi_core,
-			     struct osi_core_frp_cmd *const cmd,
-			     nveu8_t *pos)
+static nve32_t frp_compile(struct osi_core_priv_data *const osi_core)
 {
-	nve32_t ret, proto_oki;
-	nveu8_t proto_entry = OSI_DISABLE;
-	nveu8_t req = 0U;
-	nveu8_t proto_match[FRP_PROTO_LENGTH];
-	nveu8_t proto_lendth;
-	nveu8_t proto_offset;
-	nveu8_t match_type = cmd->match_type;
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct frp_atom *first = l_core->frp_first;
+	nveu8_t *flags = l_core->frp_flags;
+	struct osi_core_frp_entry *entry;
+	nveu32_t pos = 0U, guard, i, m;
+	nve32_t ret = 0;
 
-	switch (match_type) {
-	case OSI_FRP_MATCH_L4_S_UPORT:
-		proto_entry = OSI_ENABLE;
-		proto_match[0] = FRP_L4_UDP_MD;
-		proto_lendth = 1U;
-		proto_offset = FRP_L4_IP4_PROTO_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_D_UPORT:
-		proto_entry = OSI_ENABLE;
-		proto_match[0] = FRP_L4_UDP_MD;
-		proto_lendth = 1U;
-		proto_offset = FRP_L4_IP4_PROTO_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_S_TPORT:
-		proto_entry = OSI_ENABLE;
-		proto_match[0] = FRP_L4_TCP_MD;
-		proto_lendth = 1U;
-		proto_offset = FRP_L4_IP4_PROTO_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_D_TPORT:
-		proto_entry = OSI_ENABLE;
-		proto_match[0] = FRP_L4_TCP_MD;
-		proto_lendth = 1U;
-		proto_offset = FRP_L4_IP4_PROTO_OFFSET;
-		break;
-	case OSI_FRP_MATCH_VLAN:
-		proto_entry = OSI_ENABLE;
-		proto_match[0] = FRP_L2_VLAN_MD0;
-		proto_match[1] = FRP_L2_VLAN_MD1;
-		proto_lendth = 2U;
-		proto_offset = FRP_L2_VLAN_PROTO_OFFSET;
-		break;
-	case OSI_FRP_MATCH_NORMAL:
-	default:
-		proto_entry = OSI_DISABLE;
-		break;
-	}
+	frp_rule_info(l_core, first, flags);
+	for (i = 0U; i < l_core->frp_rules_cnt; i = frp_rule_end(l_core, i)) {
+		if ((flags[i] & FRP_INFO_PLACED) != OSI_NONE) {
+			continue;
+		}
+		flags[i] |= FRP_INFO_PLACED;
 
-	/* Check and Add protocol FRP entire */
-	if (proto_entry == OSI_ENABLE) {
-		/* Check for space */
-		req = (nveu8_t)(frp_req_entries(cmd->offset, cmd->match_length) + 1U);
-		if (*pos > (OSI_FRP_MAX_ENTRY - req)) {
-			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				"Fail add FRP protocol entry\n",
-				OSI_NONE);
-			ret = -1;
-			goto done;
+		m = l_core->frp_rules_cnt;
+		if ((flags[i] & FRP_INFO_PREFIX) != OSI_NONE) {
+			m = frp_group_next(l_core, first, flags, &first[i],
+					   frp_rule_end(l_core, i));
+		}
+
+		if (m >= l_core->frp_rules_cnt) {
+			ret = frp_emit_rule(osi_core, i, 0U, &pos);
+			if (ret < 0) {
+				goto done;
+			}
+			continue;
 		}
 
-		/* Add protocol FRP entire */
-		proto_oki = (nve32_t)*pos;
-		proto_oki += 1;
-		ret = frp_entry_add(osi_core, cmd->frp_id, *pos,
-				    proto_match, proto_lendth,
-				    proto_offset, OSI_FRP_MODE_LINK,
-				    proto_oki, cmd->dma_sel);
+		/* Shared prefix entry, skip the group on mismatch */
+		guard = pos;
+		entry = &osi_core->frp_table[guard];
+		(void)osi_memset(entry, 0U, sizeof(struct osi_core_frp_entry));
+		entry->frp_id = l_core->frp_rules[i].frp_id;
+		entry->data.match_data = first[i].match_data;
+		entry->data.match_en = first[i].match_en;
+		entry->data.frame_offset = first[i].frame_offset;
+		entry->data.inverse_match = OSI_ENABLE;
+		entry->data.next_ins_ctrl = OSI_ENABLE;
+		pos++;
+
+		ret = frp_emit_rule(osi_core, i, 1U, &pos);
+		while ((ret == 0) && (m < l_core->frp_rules_cnt)) {
+			flags[m] |= FRP_INFO_PLACED;
+			ret = frp_emit_rule(osi_core, m, 1U, &pos);
+			m = frp_group_next(l_core, first, flags, &first[i],
+					   frp_rule_end(l_core, m));
+		}
 		if (ret < 0) {
-			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				"Fail add FRP protocol entry\n",
-				OSI_NONE);
 			goto done;
 		}
-
-		/* Increment pos value */
-		*pos = (nveu8_t)(*pos + (nveu8_t)1);
+		entry->data.ok_index = (nveu8_t)pos;
 	}
 
-	ret = 0;
+	osi_core->frp_cnt = pos;
+	frp_resolve_links(osi_core);
+
 done:
 	return ret;
 }
 
 /**
- * @brief frp_parse_offset - Process and update FRP Command offset.
- *
- * Algorithm: Parse give FRP command match type and update it's offset.
+ * @brief frp_cmd_validate - Validate FRP command.
  *
- * @param[in] cmd: OSI FRP command structure.
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] cmd: OSI FRP command structure with parsed offset.
  *
+ * @retval 0 on success.
+ * @retval -1 on failure.
  */
-static void frp_parse_mtype(struct osi_core_frp_cmd *const cmd)
+static nve32_t frp_cmd_validate(struct osi_core_priv_data *const osi_core,
+				const struct osi_core_frp_cmd *const cmd)
 {
-	nveu8_t offset;
-	nveu8_t match_type = cmd->match_type;
+	const nveu32_t dma_sel_val[MAX_MAC_IP_TYPES] = {0xFFU, 0x3FF};
+	nve32_t ret = -1;
 
-	switch (match_type) {
-	case OSI_FRP_MATCH_L2_DA:
-		offset = FRP_L2_DA_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L2_SA:
-		offset = FRP_L2_SA_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L3_SIP:
-		offset = FRP_L3_IP4_SIP_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L3_DIP:
-		offset = FRP_L3_IP4_DIP_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_S_UPORT:
-		offset = FRP_L4_IP4_SPORT_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_D_UPORT:
-		offset = FRP_L4_IP4_DPORT_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_S_TPORT:
-		offset = FRP_L4_IP4_SPORT_OFFSET;
-		break;
-	case OSI_FRP_MATCH_L4_D_TPORT:
-		offset = FRP_L4_IP4_DPORT_OFFSET;
-		break;
-	case OSI_FRP_MATCH_VLAN:
-		offset = FRP_L2_VLAN_TAG_OFFSET;
-		break;
-	case OSI_FRP_MATCH_NORMAL:
-	default:
-		offset = cmd->offset;
-		break;
+	/* Validate length */
+	if ((cmd->match_length == 0U) ||
+	    (cmd->match_length > OSI_FRP_MATCH_DATA_MAX)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
+			     "Invalid match length\n",
+			     cmd->match_length);
+		goto done;
 	}
 
-	/* Update command offset */
-	cmd->offset = offset;
+	/* Validate filter_mode */
+	if (cmd->filter_mode >= OSI_FRP_MODE_MAX) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Invalid filter mode argment\n",
+			     cmd->filter_mode);
+		goto done;
+	}
+
+	/* Validate offset */
+	if (cmd->offset >= OSI_FRP_OFFSET_MAX) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Invalid offset value\n",
+			     cmd->offset);
+		goto done;
+	}
+
+	/* Validate channel selection */
+	if (cmd->dma_sel > dma_sel_val[osi_core->mac]) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Invalid DMA selection\n",
+			     (nveu64_t)cmd->dma_sel);
+		goto done;
+	}
+
+	ret = 0;
+done:
+	return ret;
 }
 
 /**
  * @brief frp_delete - Process FRP Delete Command.
  *
- * Algorithm: Parse give FRP delete command and update it on OSI data and HW.
+ * Algorithm: Remove the rule from FRP rule set, compile the rule set and
+ *	update it on HW.
  *
  * @param[in] osi_core: OSI core private data structure.
  * @param[in] ops_p: Core operations data structure.
@@ -614,58 +1052,48 @@ static nve32_t frp_delete(struct osi_core_priv_data *const osi_core,
 			  struct core_ops *ops_p,
 			  struct osi_core_frp_cmd *const cmd)
 {
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu32_t start = 0U, end, i;
 	nve32_t ret;
-	nveu8_t i = 0U, pos = 0U, count = 0U;
-	nve32_t frp_id = cmd->frp_id;
-	nveu32_t frp_cnt = osi_core->frp_cnt;
 
-	/* Check for FRP entries  */
-	if (frp_cnt == 0U) {
+	/* Check for FRP rules */
+	if (l_core->frp_rules_cnt == 0U) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"No FRP entries in the table\n",
-			OSI_NONE);
+			     "No FRP entries in the table\n",
+			     OSI_NONE);
 		ret = -1;
 		goto done;
 	}
 
-	/* Find the FRP entry */
-	if (frp_entry_find(osi_core, frp_id, &pos, &count) < 0) {
+	/* Find the FRP rule */
+	ret = frp_rule_find(l_core, cmd->frp_id, &start);
+	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"No FRP entry found to delete\n",
-			OSI_NONE);
-		ret = -1;
+			     "No FRP entry found to delete\n",
+			     OSI_NONE);
 		goto done;
 	}
 
-	/* Validate pos and count */
-	if (((nveu32_t)pos + count) > frp_cnt) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Invalid FRP entry index\n",
-			OSI_NONE);
-		ret = -1;
-		goto done;
+	/* Move rule set commands by rule length */
+	end = frp_rule_end(l_core, start);
+	for (i = end; i < l_core->frp_rules_cnt; i++) {
+		l_core->frp_rules[start] = l_core->frp_rules[i];
+		start++;
 	}
+	l_core->frp_rules_cnt = start;
 
-	/* Update the frp_table entry */
-	osi_memset(&osi_core->frp_table[pos], 0U,
-		   (sizeof(struct osi_core_frp_entry) * count));
-
-	/* Move in FRP table entries by count */
-	for (i = (nveu8_t)(pos + count); i <= frp_cnt; i++) {
-		frp_entry_copy(&osi_core->frp_table[pos],
-			       &osi_core->frp_table[i]);
-		pos++;
+	/* Rule set only shrinks, compile can't run out of space */
+	ret = frp_compile(osi_core);
+	if (ret < 0) {
+		goto done;
 	}
 
-	/* Update the frp_cnt entry */
-	osi_core->frp_cnt = (frp_cnt - count);
-
 	/* Write FRP Table into HW */
 	ret = frp_hw_write(osi_core, ops_p);
 	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to update FRP NVE\n",
-			OSI_NONE);
+			     "Fail to update FRP NVE\n",
+			     OSI_NONE);
 	}
 
 done:
@@ -675,7 +1103,8 @@ done:
 /**
  * @brief frp_update - Process FRP Update Command.
  *
- * Algorithm: Parse give FRP update command and update it on OSI data and HW.
+ * Algorithm: Replace the single command rule in FRP rule set, compile the
+ *	rule set and update it on HW. The old rule is restored on failure.
  *
  * @param[in] osi_core: OSI core private data structure.
  * @param[in] ops_p: Core operations data structure.
@@ -688,64 +1117,45 @@ static nve32_t frp_update(struct osi_core_priv_data *const osi_core,
 			  struct core_ops *ops_p,
 			  struct osi_core_frp_cmd *const cmd)
 {
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_core_frp_cmd old;
+	nveu32_t start = 0U;
 	nve32_t ret;
-	nveu8_t pos = 0U, count = 0U, req = 0U;
-	nve32_t frp_id = cmd->frp_id;
 
 	/* Validate given frp_id */
-	if (frp_entry_find(osi_core, frp_id, &pos, &count) < 0) {
+	ret = frp_rule_find(l_core, cmd->frp_id, &start);
+	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			"No FRP entry found\n",
-			OSI_NONE);
-		ret = -1;
+			     "No FRP entry found\n",
+			     OSI_NONE);
 		goto done;
 	}
 
-	/* Parse match type and update command offset */
-	frp_parse_mtype(cmd);
-
-	/* Calculate the required FRP entries for Update Command. */
-	req = frp_req_entries(cmd->offset, cmd->match_length);
-	switch (cmd->match_type) {
-	case OSI_FRP_MATCH_L4_S_UPORT:
-	case OSI_FRP_MATCH_L4_D_UPORT:
-	case OSI_FRP_MATCH_L4_S_TPORT:
-	case OSI_FRP_MATCH_L4_D_TPORT:
-	case OSI_FRP_MATCH_VLAN:
-		req++;
-		break;
-	default:
-		/* No need of Protocal Entry */
-		break;
-	}
-
-	/* Reject update on old and new required FRP entries mismatch */
-	if (count != req) {
+	/* Chained rules are replaced by delete and add */
+	if (frp_rule_end(l_core, start) != (start + 1U)) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			"Old and New required FRP entries mismatch\n",
-			OSI_NONE);
+			     "Update of FRP chain not supported\n",
+			     OSI_NONE);
 		ret = -1;
 		goto done;
 	}
 
-	/* Process and update FRP Command Protocal Entry */
-	ret = frp_add_proto(osi_core, cmd, &pos);
+	/* Parse match type and update command offset */
+	frp_parse_mtype(cmd);
+	ret = frp_cmd_validate(osi_core, cmd);
 	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to parse match type\n",
-			OSI_NONE);
 		goto done;
 	}
 
-	/* Update FRP entries */
-	ret = frp_entry_add(osi_core, frp_id, pos,
-			    cmd->match, cmd->match_length,
-			    cmd->offset, cmd->filter_mode,
-			    cmd->next_frp_id, cmd->dma_sel);
+	old = l_core->frp_rules[start];
+	l_core->frp_rules[start] = *cmd;
+	ret = frp_compile(osi_core);
 	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to update FRP entry\n",
-			OSI_NONE);
+			     "Fail to update FRP entry\n",
+			     OSI_NONE);
+		l_core->frp_rules[start] = old;
+		(void)frp_compile(osi_core);
 		goto done;
 	}
 
@@ -753,8 +1163,8 @@ static nve32_t frp_update(struct osi_core_priv_data *const osi_core,
 	ret = frp_hw_write(osi_core, ops_p);
 	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to update FRP NVE\n",
-			OSI_NONE);
+			     "Fail to update FRP NVE\n",
+			     OSI_NONE);
 	}
 
 done:
@@ -764,7 +1174,7 @@ done:
 /**
  * @brief frp_add - Process FRP Add Command.
  *
- * Algorithm: Parse give FRP Add command and update it on OSI data and HW.
+ * Algorithm: Add the command as single command rule.
  *
  * @param[in] osi_core: OSI core private data structure.
  * @param[in] ops_p: Core operations data structure.
@@ -777,68 +1187,113 @@ static nve32_t frp_add(struct osi_core_priv_data *const osi_core,
 		       struct core_ops *ops_p,
 		       struct osi_core_frp_cmd *const cmd)
 {
-	nve32_t ret;
-	nveu8_t pos = 0U, count = 0U;
-	nve32_t frp_id = cmd->frp_id;
-	nveu32_t nve = osi_core->frp_cnt;
+	return frp_add_chain(osi_core, ops_p, cmd->frp_id, cmd, 1U);
+}
+
+/**
+ * @brief frp_add_chain - Add a chain of FRP commands as one rule.
+ *
+ * Algorithm: Append all commands to the FRP rule set under a single
+ *	FRP ID. A frame hits the rule only when all the commands match,
+ *	the last command provides the filter mode. The rule set is compiled
+ *	and the HW table is written once, the rule is removed again if it
+ *	doesn't fit into the FRP table.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] ops_p: Core operations data structure.
+ * @param[in] frp_id: FRP ID used for all the commands of the chain.
+ * @param[in] cmds: Array of OSI FRP command structures.
+ * @param[in] num_cmds: Number of commands in cmds array.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+nve32_t frp_add_chain(struct osi_core_priv_data *const osi_core,
+		      struct core_ops *ops_p,
+		      nve32_t frp_id,
+		      struct osi_core_frp_cmd *const cmds,
+		      nveu32_t num_cmds)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_core_frp_cmd *rule;
+	nveu32_t cnt = l_core->frp_rules_cnt;
+	nveu32_t start = 0U;
+	nveu32_t i;
+	nve32_t ret = -1;
 
-	/* Check for MAX FRP entries */
-	if (nve >= OSI_FRP_MAX_ENTRY) {
+	if ((num_cmds == 0U) || (num_cmds > FRP_RULE_MAX_CMDS) ||
+	    ((cnt + num_cmds) > OSI_FRP_MAX_ENTRY)) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
-			"FRP etries are full\n",
-			nve);
-		ret = -1;
+			     "FRP etries are full\n",
+			     cnt);
 		goto done;
 	}
 
-	/* Check the FRP entry already exists */
-	ret = frp_entry_find(osi_core, frp_id, &pos, &count);
-	if (ret >= 0) {
+	/* Check the FRP rule already exists */
+	if (frp_rule_find(l_core, frp_id, &start) == 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
-			"FRP entry already exists\n",
-			OSI_NONE);
-		ret = -1;
+			     "FRP entry already exists\n",
+			     OSI_NONE);
 		goto done;
 	}
 
-	/* Parse match type and update command offset */
-	frp_parse_mtype(cmd);
-
-	/* Process and add FRP Command Protocal Entry */
-	ret = frp_add_proto(osi_core, cmd, (nveu8_t *)&nve);
-	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to parse match type\n",
-			OSI_NONE);
-		goto done;
+	for (i = 0U; i < num_cmds; i++) {
+		rule = &l_core->frp_rules[cnt + i];
+		*rule = cmds[i];
+		rule->frp_id = frp_id;
+		/* Parse match type and update command offset */
+		frp_parse_mtype(rule);
+		ret = frp_cmd_validate(osi_core, rule);
+		if (ret < 0) {
+			goto done;
+		}
 	}
+	l_core->frp_rules_cnt = cnt + num_cmds;
 
-	/* Add Match data FRP Entry */
-	ret = frp_entry_add(osi_core, frp_id, (nveu8_t)nve,
-			    cmd->match, cmd->match_length,
-			    cmd->offset, cmd->filter_mode,
-			    cmd->next_frp_id, cmd->dma_sel);
+	ret = frp_compile(osi_core);
 	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to add FRP entry\n",
-			nve);
+			     "Fail to add FRP entry\n",
+			     cnt);
+		l_core->frp_rules_cnt = cnt;
+		(void)frp_compile(osi_core);
 		goto done;
 	}
-	osi_core->frp_cnt = nve + frp_req_entries(cmd->offset,
-						  cmd->match_length);
 
 	/* Write FRP Table into HW */
 	ret = frp_hw_write(osi_core, ops_p);
 	if (ret < 0) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to update FRP NVE\n",
-			OSI_NONE);
+			     "Fail to update FRP NVE\n",
+			     OSI_NONE);
 	}
 
 done:
 	return ret;
 }
 
+/**
+ * @brief frp_supported - Check FRP is usable on the MAC.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval OSI_ENABLE if FRP is supported
+ * @retval OSI_DISABLE otherwise
+ */
+nveu32_t frp_supported(const struct osi_core_priv_data *const osi_core)
+{
+	nveu32_t ret = OSI_DISABLE;
+
+	if ((osi_core->hw_feature != OSI_NULL) &&
+	    (osi_core->hw_feature->frp_sel == OSI_ENABLE) &&
+	    !((osi_core->mac == OSI_MAC_HW_EQOS) &&
+	      (osi_core->mac_ver < OSI_EQOS_MAC_5_30))) {
+		ret = OSI_ENABLE;
+	}
+
+	return ret;
+}
+
 /**
  * @brief setup_frp - Process OSD FRP Command.
  *
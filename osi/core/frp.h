@@ -39,6 +39,11 @@
 #define FRP_L3_IP4_DIP_OFFSET		30U
 #define FRP_L4_IP4_SPORT_OFFSET		34U
 #define FRP_L4_IP4_DPORT_OFFSET		36U
+#define FRP_L2_ETHTYPE_OFFSET		12U
+#define FRP_L3_IP6_SIP_OFFSET		22U
+#define FRP_L3_IP6_DIP_OFFSET		38U
+#define FRP_L4_IP6_SPORT_OFFSET		54U
+#define FRP_L4_IP6_DPORT_OFFSET		56U
 
 /* Protocols Match data define values  */
 #define FRP_PROTO_LENGTH		2U
@@ -46,9 +51,18 @@
 #define FRP_L2_VLAN_MD0			0x81U
 #define FRP_L2_VLAN_MD1			0x00U
 #define FRP_L4_IP4_PROTO_OFFSET		23U
+#define FRP_L4_IP6_PROTO_OFFSET		20U
 #define FRP_L4_UDP_MD			17U
 #define FRP_L4_TCP_MD			6U
 
+/* HW FRP table root entry location and entries reserved outside table */
+#define FRP_HW_ROOT_ENTRY		0U
+#define FRP_HW_RSVD_ENTRIES		2U
+
+/* FRP rule set limits */
+#define FRP_RULE_MAX_CMDS		6U
+#define FRP_RULE_MAX_ATOMS		32U
+
 /* Define for FRP Entries offsets and lengths */
 #define FRP_OFFSET_BYTES(offset) \
 	(FRP_MD_SIZE - ((offset) % FRP_MD_SIZE))
@@ -71,7 +85,8 @@ nve32_t setup_frp(struct osi_core_priv_data *const osi_core,
 /**
  * @brief frp_hw_write - Update HW FRP table.
  *
- * Algorithm: Update FRP table into HW.
+ * Algorithm: Write FRP table into unused HW entries and switch the root
+ *	entry to it without disabling the FRP. Fallback to full rewrite.
  *
  * @param[in] osi_core: OSI core private data structure.
  *
@@ -80,4 +95,36 @@ nve32_t setup_frp(struct osi_core_priv_data *const osi_core,
  */
 nve32_t frp_hw_write(struct osi_core_priv_data *const osi_core,
 		     struct core_ops *const ops_p);
+
+/**
+ * @brief frp_add_chain - Add a chain of FRP commands as one rule.
+ *
+ * Algorithm: Append all commands to FRP rule set under one FRP ID, a frame
+ *	hits the rule only when all commands match. Compile the rule set and
+ *	write the FRP table into HW once.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] ops_p: Core operations data structure.
+ * @param[in] frp_id: FRP ID used for all the commands of the chain.
+ * @param[in] cmds: Array of OSI FRP command structures.
+ * @param[in] num_cmds: Number of commands in cmds array.
+ *
+ * @retval 0 on success.
+ * @retval -1 on failure.
+ */
+nve32_t frp_add_chain(struct osi_core_priv_data *const osi_core,
+		      struct core_ops *ops_p,
+		      nve32_t frp_id,
+		      struct osi_core_frp_cmd *const cmds,
+		      nveu32_t num_cmds);
+
+/**
+ * @brief frp_supported - Check FRP is usable on the MAC.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval OSI_ENABLE if FRP is supported
+ * @retval OSI_DISABLE otherwise
+ */
+nveu32_t frp_supported(const struct osi_core_priv_data *const osi_core);
 #endif /* FRP_H */
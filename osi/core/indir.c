@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "../osi/common/common.h"
+#include "core_local.h"
+#include "indir.h"
+
+/** Saturation value of indirect access counters */
+#define INDIR_CNT_MAX	(~0ULL)
+
+/**
+ * @brief indir_stats_add - Saturating add to indirect access counter.
+ *
+ * @param[in, out] cnt: Counter to be updated.
+ * @param[in] val: Value to be added.
+ */
+static inline void indir_stats_add(nveu64_t *cnt, const nveu64_t val)
+{
+	if (*cnt <= (INDIR_CNT_MAX - val)) {
+		*cnt += val;
+	} else {
+		*cnt = INDIR_CNT_MAX;
+	}
+}
+
+nve32_t indir_poll(struct osi_core_priv_data *const osi_core,
+		   const struct indir_proto *const proto,
+		   nveu8_t *ctrl_reg, nveu32_t *ctrl)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct indir_stats *st = &l_core->indir_stats[proto->id];
+	nveu32_t val = 0U;
+	nveu32_t count = 0U;
+	nveu64_t waited = 0U;
+	nve32_t ret = -1;
+
+	if (st->spin == 0U) {
+		st->spin = INDIR_SPIN_MAX;
+	}
+
+	/* Most accesses complete within a few register reads */
+	while (count < st->spin) {
+		val = osi_readla(osi_core, ctrl_reg);
+		if ((val & proto->busy) == OSI_NONE) {
+			ret = 0;
+			break;
+		}
+		count++;
+	}
+
+	if (ret == 0) {
+		indir_stats_add(&st->spin_done, 1U);
+		/* Keep spin budget just above what this access needed */
+		if (((count + 1U) * 2U) < st->spin) {
+			st->spin = ((count + 1U) * 2U);
+		}
+	} else {
+		/* Slow access, spinning was wasted. Back off with delay */
+		count = 0U;
+		while (count < proto->retry) {
+			osi_core->osd_ops.udelay(proto->delay_us);
+			waited += proto->delay_us;
+			count++;
+			val = osi_readla(osi_core, ctrl_reg);
+			if ((val & proto->busy) == OSI_NONE) {
+				ret = 0;
+				break;
+			}
+		}
+		if ((ret == 0) && (count == 1U)) {
+			/* Access just missed the spin budget, spin longer */
+			st->spin = ((st->spin * 2U) < INDIR_SPIN_MAX) ?
+				   (st->spin * 2U) : INDIR_SPIN_MAX;
+		} else {
+			st->spin = ((st->spin / 2U) > INDIR_SPIN_MIN) ?
+				   (st->spin / 2U) : INDIR_SPIN_MIN;
+		}
+	}
+
+	if ((ret == 0) && ((val & proto->err) != OSI_NONE)) {
+		ret = -1;
+	}
+
+	indir_stats_add(&st->ops, 1U);
+	indir_stats_add(&st->wait_us, waited);
+	if (waited > st->max_wait_us) {
+		st->max_wait_us = waited;
+	}
+
+	if (ret < 0) {
+		indir_stats_add(&st->errors, 1U);
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			     "Indirect access failed, protocol:\n",
+			     (nveul64_t)proto->id);
+	}
+
+	if (ctrl != OSI_NULL) {
+		*ctrl = val;
+	}
+
+	return ret;
+}
+
+nve32_t indir_write(struct osi_core_priv_data *const osi_core,
+		    const struct indir_proto *const proto,
+		    nveu8_t *data_reg, nveu8_t *ctrl_reg,
+		    nveu32_t data, nveu32_t ctrl)
+{
+	osi_writela(osi_core, data, data_reg);
+	osi_writela(osi_core, ctrl, ctrl_reg);
+
+	return indir_poll(osi_core, proto, ctrl_reg, OSI_NULL);
+}
+
+nve32_t indir_write_batch(struct osi_core_priv_data *const osi_core,
+			  const struct indir_proto *const proto,
+			  nveu8_t *data_reg, nveu8_t *ctrl_reg,
+			  const struct indir_entry *const ent,
+			  const nveu32_t num)
+{
+	nveu32_t i;
+	nve32_t ret = 0;
+
+	for (i = 0U; i < num; i++) {
+		ret = indir_write(osi_core, proto, data_reg, ctrl_reg,
+				  ent[i].data, ent[i].ctrl);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
+nve32_t indir_read(struct osi_core_priv_data *const osi_core,
+		   const struct indir_proto *const proto,
+		   nveu8_t *data_reg, nveu8_t *ctrl_reg,
+		   nveu32_t ctrl, nveu32_t *data)
+{
+	nve32_t ret;
+
+	*data = 0U;
+	osi_writela(osi_core, ctrl, ctrl_reg);
+
+	ret = indir_poll(osi_core, proto, ctrl_reg, OSI_NULL);
+	if (ret == 0) {
+		*data = osi_readla(osi_core, data_reg);
+	}
+
+	return ret;
+}
+
+#ifndef OSI_STRIPPED_LIB
+void indir_job_reset(struct indir_job *const job)
+{
+	job->proto = OSI_NULL;
+	job->data_reg = OSI_NULL;
+	job->ctrl_reg = OSI_NULL;
+	job->num = 0U;
+	job->issued = 0U;
+	job->polls = 0U;
+	job->start_ns = 0U;
+	job->state = OSI_ASYNC_IDLE;
+	job->cmd = 0U;
+	job->hw_done = OSI_NULL;
+	job->sw_done = OSI_NULL;
+}
+
+nve32_t indir_job_add(struct osi_core_priv_data *const osi_core,
+		      struct indir_job *const job,
+		      const struct indir_proto *const proto,
+		      nveu8_t *data_reg, nveu8_t *ctrl_reg,
+		      nveu32_t data, nveu32_t ctrl)
+{
+	nve32_t ret = -1;
+
+	if (job->num == 0U) {
+		job->proto = proto;
+		job->data_reg = data_reg;
+		job->ctrl_reg = ctrl_reg;
+	}
+
+	if ((job->num >= INDIR_JOB_MAX_ENT) || (job->proto != proto) ||
+	    (job->data_reg != data_reg) || (job->ctrl_reg != ctrl_reg)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Indirect access job can't queue entry\n",
+			     (nveul64_t)job->num);
+		goto exit_func;
+	}
+
+	job->ent[job->num].data = data;
+	job->ent[job->num].ctrl = ctrl;
+	job->num++;
+	ret = 0;
+exit_func:
+	return ret;
+}
+
+/**
+ * @brief indir_job_finish - Run completion steps of a job and retire it.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Asynchronous indirect access job.
+ * @param[in] status: Status of queued writes.
+ *
+ * @retval Final job status.
+ */
+static nve32_t indir_job_finish(struct osi_core_priv_data *const osi_core,
+				struct indir_job *const job, nve32_t status)
+{
+	nve32_t ret = status;
+
+	if ((ret == 0) && (job->hw_done != OSI_NULL)) {
+		ret = job->hw_done(osi_core);
+	}
+
+	if (job->sw_done != OSI_NULL) {
+		job->sw_done(osi_core, ret);
+	}
+
+	job->state = OSI_ASYNC_IDLE;
+
+	return ret;
+}
+
+/**
+ * @brief indir_job_now - Current time for job timeouts.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval osd_ops.get_time_ns, 0 without clock.
+ */
+static inline nveu64_t indir_job_now(struct osi_core_priv_data *const osi_core)
+{
+	nveu64_t now = 0U;
+
+	if (osi_core->osd_ops.get_time_ns != OSI_NULL) {
+		now = osi_core->osd_ops.get_time_ns(osi_core->osd);
+	}
+
+	return now;
+}
+
+/**
+ * @brief indir_job_expired - Check if HW was busy for too long.
+ *
+ * Algorithm: With osd_ops.get_time_ns compare time since the last issued
+ * write against protocol retry * delay_us. Without it count busy polls
+ * against protocol retry, each one standing for one protocol delay.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Asynchronous indirect access job, HW found busy.
+ *
+ * @retval OSI_ENABLE if job timed out, OSI_NONE otherwise.
+ */
+static nveu32_t indir_job_expired(struct osi_core_priv_data *const osi_core,
+				  struct indir_job *const job)
+{
+	const struct indir_proto *proto = job->proto;
+	nveu64_t limit_ns;
+	nveu64_t now;
+	nveu32_t ret = OSI_NONE;
+
+	if (osi_core->osd_ops.get_time_ns == OSI_NULL) {
+		if (job->polls > proto->retry) {
+			ret = OSI_ENABLE;
+		}
+		goto exit_func;
+	}
+
+	now = indir_job_now(osi_core);
+	if ((job->issued == 0U) && (job->polls == 1U)) {
+		/* HW busy before the first write, time it from here */
+		job->start_ns = now;
+	}
+
+	limit_ns = (nveu64_t)proto->retry * proto->delay_us * 1000ULL;
+	if ((now - job->start_ns) > limit_ns) {
+		ret = OSI_ENABLE;
+	}
+
+exit_func:
+	return ret;
+}
+
+nve32_t indir_job_poll(struct osi_core_priv_data *const osi_core,
+		       struct indir_job *const job)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct indir_stats *st;
+	nveu32_t val;
+	nve32_t ret = 0;
+
+	if (job->num == 0U) {
+		/* Nothing queued, only completion steps are left */
+		ret = indir_job_finish(osi_core, job, 0);
+		goto exit_func;
+	}
+
+	st = &l_core->indir_stats[job->proto->id];
+	while (job->state == OSI_ASYNC_PENDING) {
+		val = osi_readla(osi_core, job->ctrl_reg);
+		if ((val & job->proto->busy) != OSI_NONE) {
+			job->polls++;
+			if (indir_job_expired(osi_core, job) == OSI_NONE) {
+				/* Still busy, come back on next poll */
+				break;
+			}
+			ret = -1;
+		} else if ((job->issued > 0U) &&
+			   ((val & job->proto->err) != OSI_NONE)) {
+			ret = -1;
+		} else {
+			/* Previous write, if any, completed */
+			if (job->issued > 0U) {
+				indir_stats_add(&st->ops, 1U);
+				indir_stats_add(&st->spin_done, 1U);
+			}
+		}
+
+		if (ret < 0) {
+			indir_stats_add(&st->ops, 1U);
+			indir_stats_add(&st->errors, 1U);
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+				     "Indirect access job failed, entry:\n",
+				     (nveul64_t)job->issued);
+			ret = indir_job_finish(osi_core, job, ret);
+			break;
+		}
+
+		if (job->issued == job->num) {
+			ret = indir_job_finish(osi_core, job, 0);
+			break;
+		}
+
+		osi_writela(osi_core, job->ent[job->issued].data,
+			    job->data_reg);
+		osi_writela(osi_core, job->ent[job->issued].ctrl,
+			    job->ctrl_reg);
+		job->issued++;
+		job->polls = 0U;
+		job->start_ns = indir_job_now(osi_core);
+	}
+
+exit_func:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
+
+void indir_stats_reset(struct osi_core_priv_data *const osi_core)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+
+	osi_memset(l_core->indir_stats, 0U,
+		   sizeof(l_core->indir_stats));
+}
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef INDIR_H
+#define INDIR_H
+
+#include <osi_core.h>
+
+/**
+ * @addtogroup INDIR_PROTO Indirect access protocols
+ *
+ * @brief Index of each indirect register access protocol into
+ * indirect access statistics
+ * @{
+ */
+#define INDIR_PROTO_MAC_AC	0U
+#define INDIR_PROTO_L3L4	1U
+#define INDIR_PROTO_RSS		2U
+#define INDIR_PROTO_FRP		3U
+#define INDIR_PROTO_EST		4U
+#define INDIR_PROTO_VLAN	5U
+#define INDIR_PROTO_MACSEC_LUT	6U
+#define INDIR_PROTO_MACSEC_KT	7U
+#define INDIR_PROTO_MAX		8U
+/** @} */
+
+/**
+ * @addtogroup INDIR_SPIN Indirect access spin budget
+ *
+ * @brief Bounds of number of busy polls done without delay before
+ * backing off with the protocol delay
+ * @{
+ */
+#define INDIR_SPIN_MIN		1U
+#define INDIR_SPIN_MAX		16U
+/** @} */
+
+/**
+ * @brief Indirect access protocol description
+ */
+struct indir_proto {
+	/** Protocol index, one of INDIR_PROTO_* */
+	nveu32_t id;
+	/** Busy bits of control register, cleared by HW on completion */
+	nveu32_t busy;
+	/** Error bits of control register valid on completion, 0 if none */
+	nveu32_t err;
+	/** Back-off delay in usec once spin budget is exhausted */
+	nveu32_t delay_us;
+	/** Maximum number of back-off delays before timeout */
+	nveu32_t retry;
+};
+
+/**
+ * @brief Indirect access statistics of one protocol
+ */
+struct indir_stats {
+	/** Number of completed or failed accesses */
+	nveu64_t ops;
+	/** Number of accesses completed without back-off delay */
+	nveu64_t spin_done;
+	/** Total back-off delay in usec */
+	nveu64_t wait_us;
+	/** Maximum back-off delay of one access in usec */
+	nveu64_t max_wait_us;
+	/** Number of accesses timed out or completed with error */
+	nveu64_t errors;
+	/** Current spin budget, adapted from previous accesses */
+	nveu32_t spin;
+};
+
+/**
+ * @brief One entry of a queued indirect write
+ */
+struct indir_entry {
+	/** Value for data register */
+	nveu32_t data;
+	/** Value for control register, including busy bit */
+	nveu32_t ctrl;
+};
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief Maximum number of entries of one asynchronous indirect access job,
+ * sized for complete RSS hash key and indirection table
+ */
+#define INDIR_JOB_MAX_ENT	((OSI_RSS_HASH_KEY_SIZE / 4U) + \
+				 OSI_RSS_MAX_TABLE_SIZE)
+
+/**
+ * @brief Asynchronous indirect access job
+ */
+struct indir_job {
+	/** Indirect access protocol of all entries */
+	const struct indir_proto *proto;
+	/** Address of data register */
+	nveu8_t *data_reg;
+	/** Address of control register */
+	nveu8_t *ctrl_reg;
+	/** Queued writes */
+	struct indir_entry ent[INDIR_JOB_MAX_ENT];
+	/** Number of queued writes */
+	nveu32_t num;
+	/** Number of writes issued to HW */
+	nveu32_t issued;
+	/** Number of polls which found HW busy since the last issued write */
+	nveu32_t polls;
+	/** osd_ops.get_time_ns of the last issued write, or of the first
+	 * busy poll before any write */
+	nveu64_t start_ns;
+	/** Job state OSI_ASYNC_IDLE or OSI_ASYNC_PENDING */
+	nveu32_t state;
+	/** Ioctl command which queued the job */
+	nveu32_t cmd;
+	/** HW step run after the last write completed, can be OSI_NULL */
+	nve32_t (*hw_done)(struct osi_core_priv_data *const osi_core);
+	/** SW bookkeeping run with final job status, can be OSI_NULL */
+	void (*sw_done)(struct osi_core_priv_data *const osi_core,
+			const nve32_t status);
+};
+#endif /* !OSI_STRIPPED_LIB */
+
+/**
+ * @brief indir_poll - Wait for an indirect access to complete.
+ *
+ * Algorithm:
+ * - Poll control register without delay up to the protocol spin budget.
+ * - Then poll with protocol delay up to protocol retry count.
+ * - Adapt spin budget: trim it to twice the polls needed when access
+ *   completes while spinning, double it up to INDIR_SPIN_MAX when access
+ *   completes on first delayed retry, halve it down to INDIR_SPIN_MIN when
+ *   more back-off was needed.
+ * - Update protocol statistics, check error bits and report failure.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] proto: Indirect access protocol.
+ * @param[in] ctrl_reg: Address of control register.
+ * @param[out] ctrl: Last read control register value, can be OSI_NULL.
+ *
+ * @retval 0 on success
+ * @retval -1 on timeout or HW reported error.
+ */
+nve32_t indir_poll(struct osi_core_priv_data *const osi_core,
+		   const struct indir_proto *const proto,
+		   nveu8_t *ctrl_reg, nveu32_t *ctrl);
+
+/**
+ * @brief indir_write - Single indirect register write.
+ *
+ * Algorithm: Write data register, then control register and wait for
+ * completion with indir_poll().
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] proto: Indirect access protocol.
+ * @param[in] data_reg: Address of data register.
+ * @param[in] ctrl_reg: Address of control register.
+ * @param[in] data: Value for data register.
+ * @param[in] ctrl: Value for control register, including busy bit.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t indir_write(struct osi_core_priv_data *const osi_core,
+		    const struct indir_proto *const proto,
+		    nveu8_t *data_reg, nveu8_t *ctrl_reg,
+		    nveu32_t data, nveu32_t ctrl);
+
+/**
+ * @brief indir_write_batch - Queued indirect register writes.
+ *
+ * Algorithm: Issue the writes back to back, each one started as soon as
+ * the previous one completed. Stop on first failure.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] proto: Indirect access protocol.
+ * @param[in] data_reg: Address of data register.
+ * @param[in] ctrl_reg: Address of control register.
+ * @param[in] ent: Array of entries to write.
+ * @param[in] num: Number of entries in ent.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t indir_write_batch(struct osi_core_priv_data *const osi_core,
+			  const struct indir_proto *const proto,
+			  nveu8_t *data_reg, nveu8_t *ctrl_reg,
+			  const struct indir_entry *const ent,
+			  const nveu32_t num);
+
+/**
+ * @brief indir_read - Single indirect register read.
+ *
+ * Algorithm: Write control register, wait for completion with
+ * indir_poll() and read data register.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] proto: Indirect access protocol.
+ * @param[in] data_reg: Address of data register.
+ * @param[in] ctrl_reg: Address of control register.
+ * @param[in] ctrl: Value for control register, including busy bit.
+ * @param[out] data: Value read from data register, 0 on failure.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t indir_read(struct osi_core_priv_data *const osi_core,
+		   const struct indir_proto *const proto,
+		   nveu8_t *data_reg, nveu8_t *ctrl_reg,
+		   nveu32_t ctrl, nveu32_t *data);
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief indir_job_reset - Drop all queued writes and callbacks of a job.
+ *
+ * @param[in] job: Asynchronous indirect access job.
+ */
+void indir_job_reset(struct indir_job *const job);
+
+/**
+ * @brief indir_job_add - Queue one indirect write into a job.
+ *
+ * Algorithm: The first entry selects protocol and registers of the job,
+ * later entries must use the same ones.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Asynchronous indirect access job.
+ * @param[in] proto: Indirect access protocol.
+ * @param[in] data_reg: Address of data register.
+ * @param[in] ctrl_reg: Address of control register.
+ * @param[in] data: Value for data register.
+ * @param[in] ctrl: Value for control register, including busy bit.
+ *
+ * @retval 0 on success
+ * @retval -1 when job is full or protocol differs.
+ */
+nve32_t indir_job_add(struct osi_core_priv_data *const osi_core,
+		      struct indir_job *const job,
+		      const struct indir_proto *const proto,
+		      nveu8_t *data_reg, nveu8_t *ctrl_reg,
+		      nveu32_t data, nveu32_t ctrl);
+
+/**
+ * @brief indir_job_poll - Advance an asynchronous indirect access job.
+ *
+ * Algorithm:
+ * - Read control register once. If HW is still busy, fail the job once
+ *   more than protocol retry * delay_us passed since the last issued
+ *   write, measured with osd_ops.get_time_ns. Without a clock each busy
+ *   poll counts as one protocol delay, so the OSD must not poll faster
+ *   than once per delay_us or the job times out early.
+ * - Otherwise issue next queued writes for as long as HW completes them
+ *   by the next read, never delaying.
+ * - After the last write completed run hw_done and sw_done and move the
+ *   job to OSI_ASYNC_IDLE. Failed jobs also end in OSI_ASYNC_IDLE.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Asynchronous indirect access job in OSI_ASYNC_PENDING.
+ *
+ * @retval 0 on success, job->state tells if job is still pending
+ * @retval -1 on job failure.
+ */
+nve32_t indir_job_poll(struct osi_core_priv_data *const osi_core,
+		       struct indir_job *const job);
+#endif /* !OSI_STRIPPED_LIB */
+
+/**
+ * @brief indir_stats_reset - Reset indirect access statistics.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ */
+void indir_stats_reset(struct osi_core_priv_data *const osi_core);
+#endif /* INDIR_H */
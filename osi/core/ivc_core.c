@@ -31,62 +31,636 @@
 #include "macsec.h"
 
 /**
- * @brief ivc_handle_ioctl - marshell input argument to handle runtime command
+ * @brief ivc_send_msg - Send IVC message sized to its payload.
  *
  * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] msg: IVC message, response is written back into it.
+ * @param[in] data_len: Number of valid bytes of msg->data.
+ *
+ * @retval ivc status
+ * @retval -1 on failure
+ */
+static nve32_t ivc_send_msg(struct osi_core_priv_data *const osi_core,
+			    ivc_msg_common_t *msg, const nveu32_t data_len)
+{
+	msg->data_len = data_len;
+
+	return osi_core->osd_ops.ivc_send(osi_core, msg,
+					  IVC_MSG_HDR_LEN + data_len);
+}
+
+/**
+ * @brief ivc_ioctl_member - Find the osi_ioctl member used by a command.
+ *
  * @param[in] data: OSI IOCTL data structure.
+ * @param[out] len: Size of the member, 0 if command uses none.
  *
- * @note MAC should be init and started. see osi_start_mac()
+ * @retval Member of data, OSI_NULL if command uses none.
+ */
+static void *ivc_ioctl_member(struct osi_ioctl *data, nveu32_t *len)
+{
+	void *m = OSI_NULL;
+	nveu32_t cmd = data->cmd;
+
+	*len = 0U;
+#ifndef OSI_STRIPPED_LIB
+	if (cmd == OSI_CMD_ASYNC_START) {
+		cmd = data->arg1_u32;
+	}
+#endif /* !OSI_STRIPPED_LIB */
+
+	switch (cmd) {
+	case OSI_CMD_L3L4_FILTER:
+#ifndef OSI_STRIPPED_LIB
+	case OSI_CMD_L3L4_FILTER_HIT:
+#endif /* !OSI_STRIPPED_LIB */
+		m = &data->l3l4_filter;
+		*len = (nveu32_t)sizeof(data->l3l4_filter);
+		break;
+	case OSI_CMD_L2_FILTER:
+		m = &data->l2_filter;
+		*len = (nveu32_t)sizeof(data->l2_filter);
+		break;
+	case OSI_CMD_GET_HW_FEAT:
+		m = &data->hw_feat;
+		*len = (nveu32_t)sizeof(data->hw_feat);
+		break;
+	case OSI_CMD_GET_AVB:
+	case OSI_CMD_SET_AVB:
+		m = &data->avb;
+		*len = (nveu32_t)sizeof(data->avb);
+		break;
+#ifndef OSI_STRIPPED_LIB
+	case OSI_CMD_VLAN_FILTER:
+		m = &data->vlan_filter;
+		*len = (nveu32_t)sizeof(data->vlan_filter);
+		break;
+	case OSI_CMD_CONFIG_PTP_OFFLOAD:
+		m = &data->pto_config;
+		*len = (nveu32_t)sizeof(data->pto_config);
+		break;
+	case OSI_CMD_PTP_RXQ_ROUTE:
+		m = &data->rxq_route;
+		*len = (nveu32_t)sizeof(data->rxq_route);
+		break;
+	case OSI_CMD_FLOW_STEER:
+		m = &data->flow_rule;
+		*len = (nveu32_t)sizeof(data->flow_rule);
+		break;
+	case OSI_CMD_RSS_REBALANCE:
+		m = &data->rss_rebalance;
+		*len = (nveu32_t)sizeof(data->rss_rebalance);
+		break;
+	case OSI_CMD_RSS_PROFILE:
+		m = &data->rss_profile;
+		*len = (nveu32_t)sizeof(data->rss_profile);
+		break;
+#endif /* !OSI_STRIPPED_LIB */
+	case OSI_CMD_CONFIG_FRP:
+		m = &data->frp_cmd;
+		*len = (nveu32_t)sizeof(data->frp_cmd);
+		break;
+	case OSI_CMD_CONFIG_EST:
+		m = &data->est;
+		*len = (nveu32_t)sizeof(data->est);
+		break;
+	case OSI_CMD_CONFIG_FPE:
+		m = &data->fpe;
+		*len = (nveu32_t)sizeof(data->fpe);
+		break;
+	case OSI_CMD_CONFIG_PTP:
+		m = &data->ptp_config;
+		*len = (nveu32_t)sizeof(data->ptp_config);
+		break;
+	case OSI_CMD_GET_TX_TS:
+		m = &data->tx_ts;
+		*len = (nveu32_t)sizeof(data->tx_ts);
+		break;
+	case OSI_CMD_CAP_TSC_PTP:
+		m = &data->ptp_tsc;
+		*len = (nveu32_t)sizeof(data->ptp_tsc);
+		break;
+	default:
+		/* Command only uses scalar arguments */
+		break;
+	}
+
+	return m;
+}
+
+/**
+ * @brief ivc_args_pack - Copy scalar arguments of an ioctl.
  *
- * @retval data from PHY register on success
- * @retval -1 on failure
+ * @param[in] data: OSI IOCTL data structure.
+ * @param[out] a: Scalar arguments.
  */
-static nve32_t ivc_handle_ioctl(struct osi_core_priv_data *osi_core,
-				struct osi_ioctl *data)
+static void ivc_args_pack(const struct osi_ioctl *data, ivc_ioctl_args *a)
 {
-	nve32_t ret = 0;
-	ivc_msg_common_t msg;
+	a->cmd = data->cmd;
+	a->arg1_u32 = data->arg1_u32;
+	a->arg2_u32 = data->arg2_u32;
+	a->arg3_u32 = data->arg3_u32;
+	a->arg4_u32 = data->arg4_u32;
+	a->arg5_u64 = data->arg5_u64;
+	a->arg6_32 = data->arg6_32;
+	a->arg8_64 = data->arg8_64;
+}
 
-	osi_memset(&msg, 0, sizeof(msg));
+/**
+ * @brief ivc_args_unpack - Copy scalar arguments into an ioctl.
+ *
+ * @param[in] a: Scalar arguments.
+ * @param[out] data: OSI IOCTL data structure.
+ */
+static void ivc_args_unpack(const ivc_ioctl_args *a, struct osi_ioctl *data)
+{
+	data->cmd = a->cmd;
+	data->arg1_u32 = a->arg1_u32;
+	data->arg2_u32 = a->arg2_u32;
+	data->arg3_u32 = a->arg3_u32;
+	data->arg4_u32 = a->arg4_u32;
+	data->arg5_u64 = a->arg5_u64;
+	data->arg6_32 = a->arg6_32;
+	data->arg8_64 = a->arg8_64;
+}
 
-	msg.cmd = handle_ioctl;
-	/* osi_memcpy is treated as void since it is
-	 * an internal functin which will be always success
-	 */
-	(void)osi_memcpy((void *)&msg.data.ioctl_data, (void *)data,
-			 sizeof(struct osi_ioctl));
+nveu32_t ivc_ioctl_pack(struct osi_ioctl *data, ivc_ioctl_compact *c)
+{
+	nveu32_t len = 0U;
+	void *m;
+
+	ivc_args_pack(data, &c->args);
+
+	m = ivc_ioctl_member(data, &len);
+	if (m != OSI_NULL) {
+		(void)osi_memcpy((void *)&c->m, m, len);
+	}
+#ifndef OSI_STRIPPED_LIB
+	if ((data->cmd == OSI_CMD_ARP_OFFLOAD) &&
+	    (data->arg7_u8_p != OSI_NULL)) {
+		/* Guest pointer is useless to the server, pass IP by value */
+		(void)osi_memcpy((void *)c->m.arp_ip, (void *)data->arg7_u8_p,
+				 IVC_ARP_IP_LEN);
+		len = IVC_ARP_IP_LEN;
+	}
+#endif /* !OSI_STRIPPED_LIB */
+
+	return (nveu32_t)sizeof(c->args) + len;
+}
+
+nve32_t ivc_ioctl_unpack(const ivc_ioctl_compact *c, const nveu32_t len,
+			 struct osi_ioctl *data)
+{
+	nveu32_t m_len = 0U;
+	nve32_t ret = -1;
+	void *m;
+
+	if (len < (nveu32_t)sizeof(c->args)) {
+		goto fail;
+	}
+
+	ivc_args_unpack(&c->args, data);
+
+	m = ivc_ioctl_member(data, &m_len);
+	if (m != OSI_NULL) {
+		if ((len - (nveu32_t)sizeof(c->args)) < m_len) {
+			goto fail;
+		}
+		(void)osi_memcpy(m, (const void *)&c->m, m_len);
+	}
+
+	ret = 0;
+fail:
+	return ret;
+}
+
+#ifndef OSI_STRIPPED_LIB
+/** Offset of buf in ivc_ioctl_batch */
+#define IVC_BATCH_HDR_LEN	((nveu32_t)(sizeof(ivc_ioctl_batch) - \
+					    IVC_BATCH_BUF))
+/** Length of scalar arguments in front of the member of a payload */
+#define IVC_BATCH_ARGS_LEN	((nveu32_t)sizeof(ivc_ioctl_args))
+/** Compact payload length rounded up to 8 byte alignment */
+#define IVC_BATCH_ALIGN(x)	(((x) + 7U) & ~7U)
+
+/**
+ * @brief ivc_batch_off - Find a compact payload in a batch payload.
+ *
+ * @param[in] b: Batch payload.
+ * @param[in] idx: Index of the ioctl.
+ * @param[out] off: Offset of the compact payload in buf.
+ *
+ * @retval 0 on success
+ * @retval -1 if idx or lengths of the batch are invalid.
+ */
+static nve32_t ivc_batch_off(const ivc_ioctl_batch *b, const nveu32_t idx,
+			     nveu32_t *off)
+{
+	nveu32_t i;
+	nve32_t ret = -1;
+
+	*off = 0U;
+	if ((b->num > IVC_BATCH_MAX) || (idx >= b->num)) {
+		goto fail;
+	}
+
+	for (i = 0U; i <= idx; i++) {
+		if ((b->len[i] > (nveu32_t)sizeof(ivc_ioctl_compact)) ||
+		    (b->len[i] > (IVC_BATCH_BUF - *off))) {
+			goto fail;
+		}
+
+		if (i < idx) {
+			*off += IVC_BATCH_ALIGN(b->len[i]);
+		}
+	}
+
+	ret = 0;
+fail:
+	return ret;
+}
+
+nve32_t ivc_batch_add(ivc_ioctl_batch *b, struct osi_ioctl *data)
+{
+	ivc_ioctl_args *a;
+	nveu32_t off = 0U;
+	nveu32_t m_len = 0U;
+	nveu32_t i;
+	nve32_t ret = -1;
+	void *m;
+
+	/* ARP offload needs server storage for the IP, see ivc_server_ioctl() */
+	if ((b->num >= IVC_BATCH_MAX) || (data->cmd == OSI_CMD_ARP_OFFLOAD)) {
+		goto fail;
+	}
+
+	for (i = 0U; i < b->num; i++) {
+		off += IVC_BATCH_ALIGN(b->len[i]);
+	}
+
+	m = ivc_ioctl_member(data, &m_len);
+	if ((off > IVC_BATCH_BUF) ||
+	    ((IVC_BATCH_ARGS_LEN + m_len) > (IVC_BATCH_BUF - off))) {
+		goto fail;
+	}
+
+	/* Same layout as ivc_ioctl_pack(), written in place */
+	a = (ivc_ioctl_args *)(void *)&b->buf[off / 8U];
+	ivc_args_pack(data, a);
+	if (m != OSI_NULL) {
+		(void)osi_memcpy((void *)&b->buf[(off + IVC_BATCH_ARGS_LEN) / 8U],
+				 m, m_len);
+	}
+	b->len[b->num] = IVC_BATCH_ARGS_LEN + m_len;
+	b->status[b->num] = 0;
+	b->num++;
+	ret = 0;
+fail:
+	return ret;
+}
+
+nve32_t ivc_batch_get(const ivc_ioctl_batch *b, const nveu32_t idx,
+		      struct osi_ioctl *data)
+{
+	nveu32_t m_len = 0U;
+	nveu32_t off;
+	nve32_t ret = -1;
+	void *m;
+
+	if ((ivc_batch_off(b, idx, &off) < 0) ||
+	    (b->len[idx] < IVC_BATCH_ARGS_LEN)) {
+		goto fail;
+	}
+
+	ivc_args_unpack((const ivc_ioctl_args *)(const void *)
+			&b->buf[off / 8U], data);
+
+	m = ivc_ioctl_member(data, &m_len);
+	if (m != OSI_NULL) {
+		if ((b->len[idx] - IVC_BATCH_ARGS_LEN) < m_len) {
+			goto fail;
+		}
+		(void)osi_memcpy(m, (const void *)
+				 &b->buf[(off + IVC_BATCH_ARGS_LEN) / 8U],
+				 m_len);
+	}
+
+	ret = 0;
+fail:
+	return ret;
+}
+
+nve32_t ivc_batch_put(ivc_ioctl_batch *b, const nveu32_t idx,
+		      struct osi_ioctl *data, const nve32_t status)
+{
+	nveu32_t m_len = 0U;
+	nveu32_t off;
+	nve32_t ret = -1;
+	void *m;
+
+	m = ivc_ioctl_member(data, &m_len);
+	if ((ivc_batch_off(b, idx, &off) < 0) ||
+	    ((IVC_BATCH_ARGS_LEN + m_len) != b->len[idx])) {
+		goto fail;
+	}
+
+	ivc_args_pack(data, (ivc_ioctl_args *)(void *)&b->buf[off / 8U]);
+	if (m != OSI_NULL) {
+		(void)osi_memcpy((void *)&b->buf[(off + IVC_BATCH_ARGS_LEN) / 8U],
+				 m, m_len);
+	}
+	b->status[idx] = status;
+	ret = 0;
+fail:
+	return ret;
+}
+
+nveu32_t ivc_batch_len(const ivc_ioctl_batch *b)
+{
+	nveu32_t off = 0U;
+	nveu32_t i;
+
+	for (i = 0U; (i < b->num) && (i < IVC_BATCH_MAX); i++) {
+		off += IVC_BATCH_ALIGN(b->len[i]);
+	}
+
+	return IVC_BATCH_HDR_LEN + off;
+}
+#endif /* !OSI_STRIPPED_LIB */
+
+/**
+ * @brief ivc_ioctl_msg - Build compact ioctl request.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[out] msg: IVC message.
+ * @param[in] data: OSI IOCTL data structure.
+ *
+ * @retval Number of valid bytes of msg->data.
+ */
+static nveu32_t ivc_ioctl_msg(struct osi_core_priv_data *osi_core,
+			      ivc_msg_common_t *msg, struct osi_ioctl *data)
+{
+	nveu32_t len;
+
+	osi_memset(msg, 0, IVC_MSG_HDR_LEN);
+
+	msg->cmd = handle_ioctl_compact;
+	len = ivc_ioctl_pack(data, &msg->data.ioctl_c);
 
 	if (data->cmd == OSI_CMD_CONFIG_PTP) {
-		(void)osi_memcpy((void *)&msg.data.ioctl_data.ptp_config,
+		(void)osi_memcpy((void *)&msg->data.ioctl_c.m.ptp_config,
 				 (void *)&osi_core->ptp_config,
 				 sizeof(struct osi_ptp_config));
 	}
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return len;
+}
+
+/**
+ * @brief ivc_ioctl_reply - Copy outputs of compact ioctl response.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] msg: IVC response.
+ * @param[out] data: OSI IOCTL data structure.
+ * @param[in] ret: Status of the request.
+ *
+ * @note Counters are only copied from a response of their full size.
+ *
+ * @retval ret, or -1 if response is malformed.
+ */
+static nve32_t ivc_ioctl_reply(struct osi_core_priv_data *osi_core,
+			       ivc_msg_common_t *msg, struct osi_ioctl *data,
+			       nve32_t ret)
+{
+#ifndef OSI_STRIPPED_LIB
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+#endif /* !OSI_STRIPPED_LIB */
+	nve32_t status = ret;
 
 	switch (data->cmd) {
 	case OSI_CMD_READ_MMC:
+	case OSI_CMD_READ_MMC_GRP:
+		if (msg->data_len != (nveu32_t)sizeof(struct osi_mmc_counters)) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "IVC: Bad MMC response length\n",
+				     (nveul64_t)msg->data_len);
+			status = -1;
+			break;
+		}
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		(void)osi_memcpy((void *)&osi_core->mmc,
-				 (void *)&msg.data.mmc_s,
+				 (void *)&msg->data.mmc_s,
 				 sizeof(struct osi_mmc_counters));
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		break;
 
 	case OSI_CMD_READ_STATS:
+		if (msg->data_len != (nveu32_t)sizeof(struct osi_stats)) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "IVC: Bad stats response length\n",
+				     (nveul64_t)msg->data_len);
+			status = -1;
+			break;
+		}
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		(void)osi_memcpy((void *)&osi_core->stats,
-				 (void *)&msg.data.stats_s,
+				 (void *)&msg->data.stats_s,
 				 sizeof(struct osi_stats));
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		break;
 
 	default:
-		(void)osi_memcpy((void *)data,
-				 (void *)&msg.data.ioctl_data,
-				 sizeof(struct osi_ioctl));
+		if ((ivc_ioctl_unpack(&msg->data.ioctl_c, msg->data_len,
+				      data) < 0) && (status >= 0)) {
+			status = -1;
+		}
 		break;
 	}
 
+	return status;
+}
+
+/**
+ * @brief ivc_handle_ioctl - marshell input argument to handle runtime command
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] data: OSI IOCTL data structure.
+ *
+ * @note MAC should be init and started. see osi_start_mac()
+ *
+ * @retval data from PHY register on success
+ * @retval -1 on failure
+ */
+static nve32_t ivc_handle_ioctl(struct osi_core_priv_data *osi_core,
+				struct osi_ioctl *data)
+{
+	nve32_t ret = 0;
+	ivc_msg_common_t msg;
+	nveu32_t len;
+
+	len = ivc_ioctl_msg(osi_core, &msg, data);
+	ret = ivc_send_msg(osi_core, &msg, len);
+
+	return ivc_ioctl_reply(osi_core, &msg, data, ret);
+}
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief ivc_handle_ioctl_batch - Send runtime commands in batch messages.
+ *
+ * Algorithm: Fill each batch message with as many commands as fit, send
+ * it and copy outputs and status of each command from the response.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: Array of ioctl data.
+ * @param[out] status: Array of return values of each command.
+ * @param[in] num: Number of entries in data and status.
+ *
+ * @retval 0 on success
+ * @retval -1 on unsupported command or transport failure
+ */
+static nve32_t ivc_handle_ioctl_batch(struct osi_core_priv_data *osi_core,
+				      struct osi_ioctl *data,
+				      nve32_t *status, const nveu32_t num)
+{
+	ivc_msg_common_t msg;
+	ivc_ioctl_batch *b = &msg.data.ioctl_b;
+	nveu32_t first;
+	nveu32_t i;
+	nveu32_t n;
+	nve32_t ret = -1;
+
+	for (i = 0U; i < num; i++) {
+		/* These responses don't use compact ioctl payload, ARP
+		 * offload IP is only marshalled in compact messages */
+		if ((data[i].cmd == OSI_CMD_READ_MMC) ||
+		    (data[i].cmd == OSI_CMD_READ_MMC_GRP) ||
+		    (data[i].cmd == OSI_CMD_READ_STATS) ||
+		    (data[i].cmd == OSI_CMD_ARP_OFFLOAD)) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "IVC: Command can't be batched\n",
+				     (nveul64_t)data[i].cmd);
+			goto fail;
+		}
+
+		if (data[i].cmd == OSI_CMD_CONFIG_PTP) {
+			(void)osi_memcpy((void *)&data[i].ptp_config,
+					 (void *)&osi_core->ptp_config,
+					 sizeof(struct osi_ptp_config));
+		}
+	}
+
+	i = 0U;
+	while (i < num) {
+		osi_memset(&msg, 0, IVC_MSG_HDR_LEN);
+		msg.cmd = handle_ioctl_batch;
+		b->num = 0U;
+
+		first = i;
+		while ((i < num) && (ivc_batch_add(b, &data[i]) == 0)) {
+			i++;
+		}
+
+		if (i == first) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
+				     "IVC: Command too large for batch\n",
+				     (nveul64_t)data[i].cmd);
+			ret = -1;
+			goto fail;
+		}
+
+		ret = ivc_send_msg(osi_core, &msg, ivc_batch_len(b));
+		if (ret < 0) {
+			goto fail;
+		}
+
+		for (n = 0U; n < (i - first); n++) {
+			status[first + n] = b->status[n];
+			if (ivc_batch_get(b, n, &data[first + n]) < 0) {
+				status[first + n] = -1;
+			}
+		}
+	}
+
+fail:
 	return ret;
 }
 
+/**
+ * @brief ivc_ioctl_submit - Send a runtime command without waiting.
+ *
+ * Algorithm: Post the request with its request ID through osd_ops.ivc_post,
+ * or complete it synchronously when OSD has no non-blocking send.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: OSI IOCTL data structure.
+ * @param[in] req_id: Request ID of the command.
+ *
+ * @retval 0 on success
+ * @retval -1 on send failure
+ */
+static nve32_t ivc_ioctl_submit(struct osi_core_priv_data *osi_core,
+				struct osi_ioctl *data, const nveu32_t req_id)
+{
+	ivc_msg_common_t msg;
+	nveu32_t len;
+	nve32_t ret = 0;
+
+	if (osi_core->osd_ops.ivc_post == OSI_NULL) {
+		ioctl_req_done(osi_core, req_id,
+			       ivc_handle_ioctl(osi_core, data));
+		goto done;
+	}
+
+	len = ivc_ioctl_msg(osi_core, &msg, data);
+	msg.req_id = req_id;
+	msg.data_len = len;
+
+	ret = osi_core->osd_ops.ivc_post(osi_core, &msg,
+					 IVC_MSG_HDR_LEN + len);
+done:
+	return ret;
+}
+
+/**
+ * @brief ivc_ioctl_complete - Complete a posted command from its response.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] reply: IVC response.
+ *
+ * @retval 0 on success
+ * @retval -1 on unknown request ID
+ */
+static nve32_t ivc_ioctl_complete(struct osi_core_priv_data *osi_core,
+				  struct ivc_msg_common *reply)
+{
+	struct osi_ioctl *data;
+	nve32_t ret = -1;
+
+	data = ioctl_req_data(osi_core, reply->req_id);
+	if ((data == OSI_NULL) || (reply->cmd != handle_ioctl_compact)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "IVC: Unexpected response\n",
+			     (nveul64_t)reply->req_id);
+		goto fail;
+	}
+
+	ioctl_req_done(osi_core, reply->req_id,
+		       ivc_ioctl_reply(osi_core, reply, data, reply->status));
+	ret = 0;
+fail:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief ivc_core_init - EQOS MAC, MTL and common DMA Initialization
  *
@@ -103,7 +677,7 @@ static nve32_t ivc_core_init(struct osi_core_priv_data *const osi_core)
 
 	msg.cmd = core_init;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 
 
@@ -123,7 +697,7 @@ static void ivc_core_deinit(struct osi_core_priv_data *const osi_core)
 
 	msg.cmd = core_deinit;
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg, 0U);
 	if (ret < 0) {
 		/* handle Error */
 	}
@@ -159,7 +733,7 @@ static nve32_t ivc_write_phy_reg(struct osi_core_priv_data *const osi_core,
 	msg.args.arguments[index++] = phydata;
 	msg.args.count = index;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 
 
@@ -189,7 +763,7 @@ static nve32_t ivc_read_phy_reg(struct osi_core_priv_data *const osi_core,
 	msg.args.arguments[index++] = phyreg;
 	msg.args.count = index;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 
 #ifdef MACSEC_SUPPORT
@@ -218,7 +792,8 @@ static nve32_t ivc_macsec_dbg_events_config(
 			 (void *)dbg_buf_config,
 			 sizeof(struct osi_macsec_dbg_buf_config));
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg,
+			   (nveu32_t)sizeof(struct osi_macsec_dbg_buf_config));
 	if (ret != 0) {
 		goto done;
 	}
@@ -254,7 +829,8 @@ static nve32_t ivc_macsec_dbg_buf_config(
 			 (void *)dbg_buf_config,
 			 sizeof(struct osi_macsec_dbg_buf_config));
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg,
+			   (nveu32_t)sizeof(struct osi_macsec_dbg_buf_config));
 	if (ret != 0) {
 		goto done;
 	}
@@ -283,11 +859,18 @@ static void ivc_macsec_read_mmc(struct osi_core_priv_data *const osi_core)
 {
 	ivc_msg_common_t msg;
 
+#ifndef OSI_STRIPPED_LIB
+	if ((osi_core->stats_page != OSI_NULL) &&
+	    (stats_page_read(osi_core, OSI_ENABLE) == 0)) {
+		/* Published by the server, no IVC message needed */
+		goto done;
+	}
+#endif /* !OSI_STRIPPED_LIB */
 	osi_memset(&msg, 0, sizeof(msg));
 
 	msg.cmd = read_mmc_macsec;
 
-	msg.status = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	msg.status = ivc_send_msg(osi_core, &msg, 0U);
 
 	(void)osi_memcpy((void *)&osi_core->macsec_mmc,
 			 (void *) &msg.data.macsec_mmc,
@@ -295,6 +878,10 @@ static void ivc_macsec_read_mmc(struct osi_core_priv_data *const osi_core)
 	(void)osi_memcpy((void *)&osi_core->macsec_irq_stats,
 			 (void *) &msg.data.macsec_irq_stats,
 			 sizeof(struct osi_macsec_irq_stats));
+#ifndef OSI_STRIPPED_LIB
+done:
+#endif /* !OSI_STRIPPED_LIB */
+	return;
 }
 
 /**
@@ -323,7 +910,7 @@ static nve32_t ivc_get_sc_lut_key_index(struct osi_core_priv_data *const osi_cor
 			 OSI_SCI_LEN);
 	msg.data.macsec_cfg.ctlr = ctlr;
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg, (nveu32_t)sizeof(macsec_config));
 	if (ret == 0) {
 		*key_index = msg.data.macsec_cfg.key_index;
 	}
@@ -361,7 +948,7 @@ static nve32_t ivc_macsec_config(struct osi_core_priv_data *const osi_core,
 	msg.data.macsec_cfg.ctlr = ctlr;
 	msg.data.macsec_cfg.kt_idx = *kt_idx;
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg, (nveu32_t)sizeof(macsec_config));
 	if (ret != 0) {
 		goto done;
 	}
@@ -393,7 +980,7 @@ static nve32_t ivc_macsec_enable(struct osi_core_priv_data *const osi_core,
 	index++;
 	msg.args.count = index;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 
 #ifdef DEBUG_MACSEC
@@ -419,7 +1006,7 @@ static nve32_t ivc_macsec_loopback_config(struct osi_core_priv_data *const osi_c
 	index++;
 	msg.args.count = index;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 #endif /* DEBUG_MACSEC */
 
@@ -446,7 +1033,8 @@ static nve32_t ivc_macsec_kt_config(struct osi_core_priv_data *const osi_core,
 			 (void *)kt_config,
 			 sizeof(struct osi_macsec_kt_config));
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg,
+			   (nveu32_t)sizeof(struct osi_macsec_kt_config));
 	if (ret != 0) {
 		return ret;
 	}
@@ -480,7 +1068,7 @@ static nve32_t ivc_macsec_cipher_config(struct osi_core_priv_data *const osi_cor
 	index++;
 	msg.args.count = index;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 /**
  * @brief ivc_macsec_lut_config - LUT config.
@@ -504,7 +1092,8 @@ static nve32_t ivc_macsec_lut_config(struct osi_core_priv_data *const osi_core,
 			 (void *)lut_config,
 			 sizeof(struct osi_macsec_lut_config));
 
-	ret = osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	ret = ivc_send_msg(osi_core, &msg,
+			   (nveu32_t)sizeof(struct osi_macsec_lut_config));
 	if (ret != 0) {
 		goto done;
 	}
@@ -546,7 +1135,7 @@ static nve32_t ivc_macsec_deinit(struct osi_core_priv_data *const osi_core)
 
 	msg.cmd = deinit_macsec;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 
 /**
@@ -571,7 +1160,7 @@ static nve32_t ivc_macsec_init(struct osi_core_priv_data *const osi_core,
 	index++;
 	msg.args.count = index;
 
-	return osi_core->osd_ops.ivc_send(osi_core, &msg, sizeof(msg));
+	return ivc_send_msg(osi_core, &msg, 0U);
 }
 
 /**
@@ -646,4 +1235,217 @@ void ivc_interface_init_core_ops(struct if_core_ops *if_ops_p)
 	if_ops_p->if_read_phy_reg = ivc_read_phy_reg;
 	if_ops_p->if_init_core_ops = vir_ivc_init_core_ops;
 	if_ops_p->if_handle_ioctl = ivc_handle_ioctl;
+#ifndef OSI_STRIPPED_LIB
+	if_ops_p->if_handle_ioctl_batch = ivc_handle_ioctl_batch;
+	if_ops_p->if_ioctl_submit = ivc_ioctl_submit;
+	if_ops_p->if_ioctl_complete = ivc_ioctl_complete;
+#endif /* !OSI_STRIPPED_LIB */
+}
+
+#if !defined(OSI_STRIPPED_LIB) && defined(OSI_IVC_TEST_SERVER)
+/**
+ * @brief ivc_server_ioctl - Serve a compact ioctl request.
+ *
+ * @param[in] osi_core: OSI core private data structure of the server.
+ * @param[in, out] msg: IVC request, response is written back into it.
+ *
+ * @retval Return value of the command.
+ */
+static nve32_t ivc_server_ioctl(struct osi_core_priv_data *const osi_core,
+				ivc_msg_common_t *const msg)
+{
+	struct osi_ioctl data;
+	nveu8_t arp_ip[IVC_ARP_IP_LEN];
+	nve32_t ret = -1;
+
+	/* arg7_u8_p stays NULL unless it points to server storage below */
+	osi_memset(&data, 0, sizeof(data));
+	if (ivc_ioctl_unpack(&msg->data.ioctl_c, msg->data_len, &data) < 0) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "IVC server: Malformed ioctl request\n",
+			     (nveul64_t)msg->data_len);
+		msg->data_len = 0U;
+		goto fail;
+	}
+
+	if (data.cmd == OSI_CMD_ARP_OFFLOAD) {
+		if (msg->data_len < ((nveu32_t)sizeof(ivc_ioctl_args) +
+				     IVC_ARP_IP_LEN)) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "IVC server: ARP offload without IP\n",
+				     (nveul64_t)msg->data_len);
+			msg->data_len = 0U;
+			goto fail;
+		}
+		(void)osi_memcpy((void *)arp_ip,
+				 (void *)msg->data.ioctl_c.m.arp_ip,
+				 IVC_ARP_IP_LEN);
+		data.arg7_u8_p = arp_ip;
+	}
+
+	if (data.cmd == OSI_CMD_CONFIG_PTP) {
+		/* Guests send their PTP config along with the command */
+		(void)osi_memcpy((void *)&osi_core->ptp_config,
+				 (void *)&data.ptp_config,
+				 sizeof(struct osi_ptp_config));
+	}
+
+	switch (data.cmd) {
+	case OSI_CMD_READ_MMC:
+	case OSI_CMD_READ_MMC_GRP:
+		ret = osi_handle_ioctl(osi_core, &data);
+		(void)osi_memcpy((void *)&msg->data.mmc_s,
+				 (void *)&osi_core->mmc,
+				 sizeof(struct osi_mmc_counters));
+		msg->data_len = (nveu32_t)sizeof(struct osi_mmc_counters);
+		break;
+	case OSI_CMD_READ_STATS:
+		/* Stats are kept by the server core, no HW access needed */
+		ret = 0;
+		(void)osi_memcpy((void *)&msg->data.stats_s,
+				 (void *)&osi_core->stats,
+				 sizeof(struct osi_stats));
+		msg->data_len = (nveu32_t)sizeof(struct osi_stats);
+		break;
+	default:
+		ret = osi_handle_ioctl(osi_core, &data);
+		msg->data_len = ivc_ioctl_pack(&data, &msg->data.ioctl_c);
+		break;
+	}
+fail:
+	return ret;
+}
+
+/**
+ * @brief ivc_server_ioctl_batch - Serve a batch ioctl request.
+ *
+ * @param[in] osi_core: OSI core private data structure of the server.
+ * @param[in, out] msg: IVC request, response is written back into it.
+ *
+ * @retval 0 on success
+ * @retval -1 on malformed batch.
+ */
+static nve32_t ivc_server_ioctl_batch(struct osi_core_priv_data *const osi_core,
+				      ivc_msg_common_t *const msg)
+{
+	ivc_ioctl_batch *b = &msg->data.ioctl_b;
+	struct osi_ioctl data;
+	nve32_t status;
+	nveu32_t i;
+	nve32_t ret = -1;
+
+	if (b->num > IVC_BATCH_MAX) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
+			     "IVC server: Invalid batch size\n",
+			     (nveul64_t)b->num);
+		msg->data_len = 0U;
+		goto fail;
+	}
+
+	for (i = 0U; i < b->num; i++) {
+		osi_memset(&data, 0, sizeof(data));
+		if (ivc_batch_get(b, i, &data) < 0) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "IVC server: Malformed batch entry\n",
+				     (nveul64_t)i);
+			msg->data_len = 0U;
+			goto fail;
+		}
+
+		if (data.cmd == OSI_CMD_CONFIG_PTP) {
+			(void)osi_memcpy((void *)&osi_core->ptp_config,
+					 (void *)&data.ptp_config,
+					 sizeof(struct osi_ptp_config));
+		}
+
+		if (data.cmd == OSI_CMD_ARP_OFFLOAD) {
+			/* Not batched by guests, see ivc_batch_add() */
+			status = -1;
+		} else {
+			status = osi_handle_ioctl(osi_core, &data);
+		}
+		if (ivc_batch_put(b, i, &data, status) < 0) {
+			b->status[i] = -1;
+		}
+	}
+
+	msg->data_len = ivc_batch_len(b);
+	ret = 0;
+fail:
+	return ret;
+}
+
+nveu32_t osi_ivc_server_handle(struct osi_core_priv_data *const osi_core,
+			       ivc_msg_common_t *const msg)
+{
+	nveu32_t len = 0U;
+	nve32_t ret = -1;
+
+	if (msg == OSI_NULL) {
+		goto done;
+	}
+
+	if (osi_core == OSI_NULL) {
+		msg->data_len = 0U;
+		goto status;
+	}
+
+	if ((osi_core->use_virtualization != OSI_DISABLE) ||
+	    (msg->data_len > (nveu32_t)sizeof(union ivc_msg_data))) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "IVC server: Invalid request\n",
+			     (nveul64_t)msg->cmd);
+		msg->data_len = 0U;
+		goto status;
+	}
+
+	switch (msg->cmd) {
+	case write_phy_reg:
+		ret = osi_write_phy_reg(osi_core, msg->args.arguments[0],
+					msg->args.arguments[1],
+					(nveu16_t)msg->args.arguments[2]);
+		msg->data_len = 0U;
+		break;
+	case read_phy_reg:
+		ret = osi_read_phy_reg(osi_core, msg->args.arguments[0],
+				       msg->args.arguments[1]);
+		msg->data_len = 0U;
+		break;
+	case handle_ioctl:
+		/* Caller buffers are only valid in guest address space */
+		msg->data.ioctl_data.lat_stats = OSI_NULL;
+		msg->data.ioctl_data.stats_snap = OSI_NULL;
+		msg->data.ioctl_data.arg7_u8_p = OSI_NULL;
+		ret = osi_handle_ioctl(osi_core, &msg->data.ioctl_data);
+		msg->data_len = (nveu32_t)sizeof(struct osi_ioctl);
+		break;
+	case handle_ioctl_compact:
+		ret = ivc_server_ioctl(osi_core, msg);
+		break;
+	case handle_ioctl_batch:
+		ret = ivc_server_ioctl_batch(osi_core, msg);
+		break;
+#ifdef MACSEC_SUPPORT
+	case read_mmc_macsec:
+		ret = osi_macsec_read_mmc(osi_core);
+		(void)osi_memcpy((void *)&msg->data.macsec_mmc,
+				 (void *)&osi_core->macsec_mmc,
+				 sizeof(struct osi_macsec_mmc_counters));
+		msg->data_len = (nveu32_t)sizeof(struct osi_macsec_mmc_counters);
+		break;
+#endif /* MACSEC_SUPPORT */
+	default:
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OPNOTSUPP,
+			     "IVC server: Request not served\n",
+			     (nveul64_t)msg->cmd);
+		msg->data_len = 0U;
+		break;
+	}
+
+status:
+	msg->status = ret;
+	len = IVC_MSG_HDR_LEN + msg->data_len;
+done:
+	return len;
 }
+#endif /* !OSI_STRIPPED_LIB && OSI_IVC_TEST_SERVER */
@@ -0,0 +1,758 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OSI_STRIPPED_LIB
+#include "../osi/common/common.h"
+#include "core_common.h"
+#include "l3l4_mgr.h"
+#include "frp.h"
+
+/**
+ * @brief Maximum number of FRP commands used to spill one L3/L4 rule
+ * (EtherType, L4 protocol, two IPv6 address halves and L4 ports).
+ */
+#define L3L4_MGR_FRP_MAX_CMDS		5U
+
+/**
+ * @brief l3l4_mgr_hash - Hash L3/L4 rule match data.
+ *
+ * Algorithm: FNV-1a hash over the filter data, folded into bucket range.
+ *
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ *
+ * @retval hash bucket index
+ */
+static nveu32_t l3l4_mgr_hash(const struct osi_l3_l4_filter *const l3_l4)
+{
+	const nveu8_t *p = (const nveu8_t *)(const void *)&l3_l4->data;
+	nveu32_t hash = 0x811C9DC5U;
+	nveu32_t i;
+
+	for (i = 0U; i < (nveu32_t)sizeof(l3_l4->data); i++) {
+		hash ^= (nveu32_t)p[i];
+		hash *= 0x01000193U;
+	}
+
+	return (hash ^ (hash >> 16U)) & (L3L4_MGR_HASH_SIZE - 1U);
+}
+
+/**
+ * @brief l3l4_mgr_find - Find L3/L4 rule in the software table.
+ *
+ * @param[in] mgr: L3/L4 filter manager context.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ * @param[in] bucket: Hash bucket of l3_l4.
+ *
+ * @retval rule index + 1 on match
+ * @retval 0 if rule not found
+ */
+static nveu32_t l3l4_mgr_find(const struct l3l4_mgr *const mgr,
+			      const struct osi_l3_l4_filter *const l3_l4,
+			      nveu32_t bucket)
+{
+	nveu32_t cur = mgr->bucket[bucket];
+
+	while (cur != 0U) {
+		if (osi_memcmp(&mgr->rules[cur - 1U].filter.data, &l3_l4->data,
+			       (nve32_t)sizeof(l3_l4->data)) == 0) {
+			break;
+		}
+		cur = mgr->rules[cur - 1U].next;
+	}
+
+	return cur;
+}
+
+/**
+ * @brief l3l4_mgr_slot_range - Get HW filter slots owned by the manager.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[out] start: First HW filter index usable by the manager.
+ * @param[out] max: Last HW filter index usable by the manager.
+ */
+static void l3l4_mgr_slot_range(const struct osi_core_priv_data *const osi_core,
+				nveu32_t *start, nveu32_t *max)
+{
+	const nveu32_t max_filter_no[MAX_MAC_IP_TYPES] = {
+		EQOS_MAX_L3_L4_FILTER - 1U,
+		OSI_MGBE_MAX_L3_L4_FILTER - 1U,
+	};
+
+#if defined(L3L4_WILDCARD_FILTER)
+	/* leave first one for TCP wildcard */
+	*start = 1U;
+#else
+	*start = 0U;
+#endif /* L3L4_WILDCARD_FILTER */
+	*max = max_filter_no[osi_core->mac];
+}
+
+/**
+ * @brief l3l4_mgr_free_slot - Find free HW filter slot.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval free HW filter index
+ * @retval UINT_MAX if all HW filter slots are used
+ */
+static nveu32_t l3l4_mgr_free_slot(const struct osi_core_priv_data *const osi_core)
+{
+	const struct core_local *l_core = (const struct core_local *)(const void *)osi_core;
+	nveu32_t start = 0U, max = 0U;
+	nveu32_t slot = UINT_MAX;
+	nveu32_t i;
+
+	l3l4_mgr_slot_range(osi_core, &start, &max);
+	for (i = start; i <= max; i++) {
+		if (l_core->cfg.l3_l4[i].filter_enb_dis == OSI_FALSE) {
+			slot = i;
+			break;
+		}
+	}
+
+	return slot;
+}
+
+/**
+ * @brief l3l4_mgr_frp_cmd - Fill one FRP command for a rule field.
+ *
+ * @param[out] cmd: OSI FRP command structure.
+ * @param[in] offset: Frame offset of the match data.
+ * @param[in] match: Match data in frame byte order.
+ * @param[in] len: Match data length.
+ * @param[in] dma_sel: DMA channel selection for route.
+ */
+static void l3l4_mgr_frp_cmd(struct osi_core_frp_cmd *const cmd,
+			     nveu8_t offset, const nveu8_t *const match,
+			     nveu8_t len, nveu32_t dma_sel)
+{
+	(void)osi_memset(cmd, 0, sizeof(struct osi_core_frp_cmd));
+	cmd->cmd = OSI_FRP_CMD_ADD;
+	cmd->match_type = OSI_FRP_MATCH_NORMAL;
+	(void)osi_memcpy(cmd->match, match, len);
+	cmd->match_length = len;
+	cmd->offset = offset;
+	cmd->filter_mode = OSI_FRP_MODE_ROUTE;
+	cmd->dma_sel = dma_sel;
+}
+
+/**
+ * @brief l3l4_mgr_frp_prepare - Translate an L3/L4 rule to FRP commands.
+ *
+ * Algorithm:
+ * - Rules with inverse match or without DMA routing are not translated.
+ * - Match EtherType, L4 protocol when ports are matched, then L3
+ *   addresses and L4 ports. Adjacent source and destination fields are
+ *   merged into one command.
+ *
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ * @param[out] cmds: FRP commands, L3L4_MGR_FRP_MAX_CMDS entries.
+ *
+ * @retval number of FRP commands, 0 if rule can't be spilled
+ */
+static nveu32_t l3l4_mgr_frp_prepare(const struct osi_l3_l4_filter *const l3_l4,
+				     struct osi_core_frp_cmd *const cmds)
+{
+	nveu8_t md[OSI_FRP_MATCH_DATA_MAX];
+	const nveu16_t *ip6;
+	nveu32_t dma_sel = OSI_BIT(l3_l4->dma_chan);
+	nveu32_t is_ipv6 = l3_l4->data.is_ipv6;
+	nveu32_t n = 0U;
+	nveu32_t i;
+	nveu8_t off;
+
+	if ((l3_l4->dma_routing_enable == OSI_FALSE) ||
+	    ((l3_l4->data.src.addr_match_inv | l3_l4->data.dst.addr_match_inv |
+	      l3_l4->data.src.port_match_inv | l3_l4->data.dst.port_match_inv)
+	     != OSI_FALSE)) {
+		goto done;
+	}
+
+	/* EtherType */
+	md[0] = (is_ipv6 == OSI_TRUE) ? 0x86U : 0x08U;
+	md[1] = (is_ipv6 == OSI_TRUE) ? 0xDDU : 0x00U;
+	l3l4_mgr_frp_cmd(&cmds[n], FRP_L2_ETHTYPE_OFFSET, md, 2U, dma_sel);
+	n++;
+
+	/* L4 protocol */
+	if ((l3_l4->data.src.port_match | l3_l4->data.dst.port_match) ==
+	    OSI_TRUE) {
+		md[0] = (l3_l4->data.is_udp == OSI_TRUE) ? FRP_L4_UDP_MD :
+			FRP_L4_TCP_MD;
+		off = (is_ipv6 == OSI_TRUE) ? FRP_L4_IP6_PROTO_OFFSET :
+		      FRP_L4_IP4_PROTO_OFFSET;
+		l3l4_mgr_frp_cmd(&cmds[n], off, md, 1U, dma_sel);
+		n++;
+	}
+
+	/* L3 addresses */
+	if (is_ipv6 == OSI_TRUE) {
+		if ((l3_l4->data.src.addr_match | l3_l4->data.dst.addr_match) ==
+		    OSI_TRUE) {
+			if (l3_l4->data.src.addr_match == OSI_TRUE) {
+				ip6 = l3_l4->data.src.ip6_addr;
+				off = FRP_L3_IP6_SIP_OFFSET;
+			} else {
+				ip6 = l3_l4->data.dst.ip6_addr;
+				off = FRP_L3_IP6_DIP_OFFSET;
+			}
+			/* 128-bit address doesn't fit in one command */
+			for (i = 0U; i < 8U; i++) {
+				md[(i % 4U) * 2U] = (nveu8_t)(ip6[i] >> 8U);
+				md[((i % 4U) * 2U) + 1U] = (nveu8_t)(ip6[i] & 0xFFU);
+				if ((i % 4U) == 3U) {
+					l3l4_mgr_frp_cmd(&cmds[n], off, md, 8U,
+							 dma_sel);
+					off = (nveu8_t)(off + 8U);
+					n++;
+				}
+			}
+		}
+	} else {
+		if ((l3_l4->data.src.addr_match & l3_l4->data.dst.addr_match) ==
+		    OSI_TRUE) {
+			(void)osi_memcpy(md, l3_l4->data.src.ip4_addr, 4U);
+			(void)osi_memcpy(&md[4], l3_l4->data.dst.ip4_addr, 4U);
+			l3l4_mgr_frp_cmd(&cmds[n], FRP_L3_IP4_SIP_OFFSET, md,
+					 8U, dma_sel);
+			n++;
+		} else if (l3_l4->data.src.addr_match == OSI_TRUE) {
+			l3l4_mgr_frp_cmd(&cmds[n], FRP_L3_IP4_SIP_OFFSET,
+					 l3_l4->data.src.ip4_addr, 4U, dma_sel);
+			n++;
+		} else if (l3_l4->data.dst.addr_match == OSI_TRUE) {
+			l3l4_mgr_frp_cmd(&cmds[n], FRP_L3_IP4_DIP_OFFSET,
+					 l3_l4->data.dst.ip4_addr, 4U, dma_sel);
+			n++;
+		} else {
+			/* No L3 address match */
+		}
+	}
+
+	/* L4 ports */
+	md[0] = (nveu8_t)(l3_l4->data.src.port_no >> 8U);
+	md[1] = (nveu8_t)(l3_l4->data.src.port_no & 0xFFU);
+	md[2] = (nveu8_t)(l3_l4->data.dst.port_no >> 8U);
+	md[3] = (nveu8_t)(l3_l4->data.dst.port_no & 0xFFU);
+	off = (is_ipv6 == OSI_TRUE) ? FRP_L4_IP6_SPORT_OFFSET :
+	      FRP_L4_IP4_SPORT_OFFSET;
+	if ((l3_l4->data.src.port_match & l3_l4->data.dst.port_match) ==
+	    OSI_TRUE) {
+		l3l4_mgr_frp_cmd(&cmds[n], off, md, 4U, dma_sel);
+		n++;
+	} else if (l3_l4->data.src.port_match == OSI_TRUE) {
+		l3l4_mgr_frp_cmd(&cmds[n], off, md, 2U, dma_sel);
+		n++;
+	} else if (l3_l4->data.dst.port_match == OSI_TRUE) {
+		l3l4_mgr_frp_cmd(&cmds[n], (nveu8_t)(off + 2U), &md[2], 2U,
+				 dma_sel);
+		n++;
+	} else {
+		/* No L4 port match */
+	}
+
+done:
+	return n;
+}
+
+/**
+ * @brief l3l4_mgr_place_hw - Program rule into an L3/L4 HW filter slot.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] idx: Rule index.
+ * @param[in] slot: HW filter index.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t l3l4_mgr_place_hw(struct osi_core_priv_data *const osi_core,
+				 nveu32_t idx, nveu32_t slot)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	struct l3l4_mgr_rule *rule = &mgr->rules[idx];
+	nve32_t ret;
+
+	ret = configure_l3l4_filter_helper(osi_core, slot, &rule->filter);
+	if (ret < 0) {
+		goto done;
+	}
+
+	rule->place = L3L4_MGR_PLACE_HW;
+	rule->hw_idx = slot;
+	mgr->hw_owner[slot] = idx + 1U;
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_place_frp - Spill rule into FRP.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] idx: Rule index.
+ *
+ * @retval 0 on success
+ * @retval -1 if rule can't be spilled or on failure.
+ */
+static nve32_t l3l4_mgr_place_frp(struct osi_core_priv_data *const osi_core,
+				  nveu32_t idx)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct l3l4_mgr_rule *rule = &l_core->l3l4_mgr.rules[idx];
+	struct osi_core_frp_cmd cmds[L3L4_MGR_FRP_MAX_CMDS];
+	nveu32_t n;
+	nve32_t ret = -1;
+
+	if (frp_supported(osi_core) != OSI_ENABLE) {
+		goto done;
+	}
+
+	n = l3l4_mgr_frp_prepare(&rule->filter, cmds);
+	if (n == 0U) {
+		goto done;
+	}
+
+	ret = frp_add_chain(osi_core, l_core->ops_p,
+			    L3L4_MGR_FRP_ID_BASE + (nve32_t)idx, cmds, n);
+	if (ret < 0) {
+		goto done;
+	}
+
+	rule->place = L3L4_MGR_PLACE_FRP;
+	l_core->cfg.flags |= DYNAMIC_CFG_FRP;
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_unplace - Remove rule from HW filter slot or FRP.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] idx: Rule index.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t l3l4_mgr_unplace(struct osi_core_priv_data *const osi_core,
+				nveu32_t idx)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	struct l3l4_mgr_rule *rule = &mgr->rules[idx];
+	struct osi_l3_l4_filter del;
+	struct osi_core_frp_cmd cmd;
+	nve32_t ret = 0;
+
+	if (rule->place == L3L4_MGR_PLACE_HW) {
+		(void)osi_memcpy(&del, &rule->filter,
+				 sizeof(struct osi_l3_l4_filter));
+		del.filter_enb_dis = OSI_FALSE;
+		ret = configure_l3l4_filter_helper(osi_core, rule->hw_idx, &del);
+		if (ret == 0) {
+			mgr->hw_owner[rule->hw_idx] = 0U;
+		}
+	} else if (rule->place == L3L4_MGR_PLACE_FRP) {
+		(void)osi_memset(&cmd, 0, sizeof(cmd));
+		cmd.cmd = OSI_FRP_CMD_DEL;
+		cmd.frp_id = L3L4_MGR_FRP_ID_BASE + (nve32_t)idx;
+		ret = setup_frp(osi_core, l_core->ops_p, &cmd);
+	} else {
+		/* Software only rule */
+	}
+
+	if (ret == 0) {
+		rule->place = L3L4_MGR_PLACE_NONE;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_hottest - Find the hottest rule not in a HW slot.
+ *
+ * @param[in] mgr: L3/L4 filter manager context.
+ *
+ * @retval rule index + 1
+ * @retval 0 if all rules are in HW slots
+ */
+static nveu32_t l3l4_mgr_hottest(const struct l3l4_mgr *const mgr)
+{
+	nveu32_t best = 0U;
+	nveu32_t i;
+
+	for (i = 0U; i < L3L4_MGR_MAX_RULES; i++) {
+		if ((mgr->rules[i].in_use == OSI_DISABLE) ||
+		    (mgr->rules[i].place == L3L4_MGR_PLACE_HW)) {
+			continue;
+		}
+
+		if ((best == 0U) ||
+		    (mgr->rules[i].hits > mgr->rules[best - 1U].hits)) {
+			best = i + 1U;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * @brief l3l4_mgr_coldest_slot - Find HW slot with the coldest rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval HW filter index
+ * @retval UINT_MAX if no HW slot is owned by the manager
+ */
+static nveu32_t l3l4_mgr_coldest_slot(const struct osi_core_priv_data *const osi_core)
+{
+	const struct core_local *l_core = (const struct core_local *)(const void *)osi_core;
+	const struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	nveu32_t start = 0U, max = 0U;
+	nveu32_t slot = UINT_MAX;
+	nveu32_t i;
+
+	l3l4_mgr_slot_range(osi_core, &start, &max);
+	for (i = start; i <= max; i++) {
+		if (mgr->hw_owner[i] == 0U) {
+			continue;
+		}
+
+		if ((slot == UINT_MAX) ||
+		    (mgr->rules[mgr->hw_owner[i] - 1U].hits <
+		     mgr->rules[mgr->hw_owner[slot] - 1U].hits)) {
+			slot = i;
+		}
+	}
+
+	return slot;
+}
+
+/**
+ * @brief l3l4_mgr_promote - Move a rule into a free HW filter slot.
+ *
+ * Algorithm: Remove the rule from FRP when spilled and program it into
+ *	the HW slot. On HW failure rule is spilled back into FRP.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] idx: Rule index.
+ * @param[in] slot: Free HW filter index.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t l3l4_mgr_promote(struct osi_core_priv_data *const osi_core,
+				nveu32_t idx, nveu32_t slot)
+{
+	nve32_t ret;
+
+	ret = l3l4_mgr_unplace(osi_core, idx);
+	if (ret < 0) {
+		goto done;
+	}
+
+	ret = l3l4_mgr_place_hw(osi_core, idx, slot);
+	if (ret < 0) {
+		(void)l3l4_mgr_place_frp(osi_core, idx);
+	}
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_add - Add rule into manager and place it.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ * @param[in] bucket: Hash bucket of l3_l4.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t l3l4_mgr_add(struct osi_core_priv_data *const osi_core,
+			    const struct osi_l3_l4_filter *const l3_l4,
+			    nveu32_t bucket)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	struct l3l4_mgr_rule *rule = OSI_NULL;
+	nveu32_t slot;
+	nveu32_t idx;
+	nve32_t ret = -1;
+
+	for (idx = 0U; idx < L3L4_MGR_MAX_RULES; idx++) {
+		if (mgr->rules[idx].in_use == OSI_DISABLE) {
+			rule = &mgr->rules[idx];
+			break;
+		}
+	}
+
+	if (rule == OSI_NULL) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_OUTOFBOUND),
+			("L3L4: Failed: rule table full: "), (mgr->rule_cnt));
+		goto done;
+	}
+
+	(void)osi_memset(rule, 0, sizeof(struct l3l4_mgr_rule));
+	(void)osi_memcpy(&rule->filter, l3_l4, sizeof(struct osi_l3_l4_filter));
+
+	slot = l3l4_mgr_free_slot(osi_core);
+	if (slot != UINT_MAX) {
+		ret = l3l4_mgr_place_hw(osi_core, idx, slot);
+	} else {
+		ret = l3l4_mgr_place_frp(osi_core, idx);
+		if (ret < 0) {
+			/* A rule which steers nothing is a failure */
+			OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_OUTOFBOUND),
+				("L3L4: Failed: no HW slot or FRP room: "),
+				(idx));
+		}
+	}
+
+	if (ret < 0) {
+		(void)osi_memset(rule, 0, sizeof(struct l3l4_mgr_rule));
+		goto done;
+	}
+
+	rule->in_use = OSI_ENABLE;
+	rule->next = mgr->bucket[bucket];
+	mgr->bucket[bucket] = idx + 1U;
+	mgr->rule_cnt++;
+	ret = 0;
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_del - Remove rule from manager.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] cur: Rule index + 1.
+ * @param[in] bucket: Hash bucket of the rule.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t l3l4_mgr_del(struct osi_core_priv_data *const osi_core,
+			    nveu32_t cur, nveu32_t bucket)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	struct l3l4_mgr_rule *rule = &mgr->rules[cur - 1U];
+	nveu32_t place = rule->place;
+	nveu32_t slot = rule->hw_idx;
+	nveu32_t *link = &mgr->bucket[bucket];
+	nveu32_t hot;
+	nve32_t ret;
+
+	ret = l3l4_mgr_unplace(osi_core, cur - 1U);
+	if (ret < 0) {
+		goto done;
+	}
+
+	/* unlink from hash chain */
+	while (*link != cur) {
+		link = &mgr->rules[*link - 1U].next;
+	}
+	*link = rule->next;
+	(void)osi_memset(rule, 0, sizeof(struct l3l4_mgr_rule));
+	mgr->rule_cnt--;
+
+	if (place == L3L4_MGR_PLACE_HW) {
+		/* refill freed HW slot with the hottest remaining rule */
+		hot = l3l4_mgr_hottest(mgr);
+		if (hot != 0U) {
+			(void)l3l4_mgr_promote(osi_core, hot - 1U, slot);
+		}
+	}
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_config - Add or delete an L3/L4 rule.
+ *
+ * Algorithm:
+ * - Look up the rule in the hashed software table.
+ * - On add, store the rule and place it in a free HW filter slot, otherwise
+ *   spill it into FRP when supported, otherwise fail.
+ * - On delete, remove the rule from its placement and promote the hottest
+ *   non HW rule into the freed HW slot.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t l3l4_mgr_config(struct osi_core_priv_data *const osi_core,
+			const struct osi_l3_l4_filter *const l3_l4)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu32_t bucket = l3l4_mgr_hash(l3_l4);
+	nveu32_t cur;
+	nve32_t ret = -1;
+
+	cur = l3l4_mgr_find(&l_core->l3l4_mgr, l3_l4, bucket);
+	if (l3_l4->filter_enb_dis == OSI_TRUE) {
+		if (cur != 0U) {
+			/* duplicate filter request */
+			OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_HW_FAIL),
+				("L3L4: Failed: duplicate filter: "), (cur - 1U));
+			goto done;
+		}
+
+		ret = l3l4_mgr_add(osi_core, l3_l4, bucket);
+	} else {
+		if (cur == 0U) {
+			/* filter already deleted, return success */
+			OSI_CORE_INFO((osi_core->osd), (OSI_LOG_ARG_HW_FAIL),
+				("L3L4: delete: no filter match: "), (0UL));
+			ret = 0;
+			goto done;
+		}
+
+		ret = l3l4_mgr_del(osi_core, cur, bucket);
+	}
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_update_hits - Account hits of an L3/L4 rule.
+ *
+ * Algorithm:
+ * - Add hits to the rule hit counter, halve all counters once the
+ *   counter reaches L3L4_MGR_HITS_AGE_LIMIT so old traffic decays.
+ * - If the rule is not in a HW slot, move it into a free HW slot or swap
+ *   it with the coldest HW rule when it is hotter by L3L4_MGR_SWAP_HYST.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ * @param[in] hits: Number of hits since last update.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t l3l4_mgr_update_hits(struct osi_core_priv_data *const osi_core,
+			     const struct osi_l3_l4_filter *const l3_l4,
+			     nveu32_t hits)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	struct l3l4_mgr_rule *rule;
+	nveu32_t cur;
+	nveu32_t cold;
+	nveu32_t slot;
+	nveu32_t i;
+	nve32_t ret = -1;
+
+	cur = l3l4_mgr_find(mgr, l3_l4, l3l4_mgr_hash(l3_l4));
+	if (cur == 0U) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_INVALID),
+			("L3L4: hits: no filter match: "), (hits));
+		goto done;
+	}
+
+	rule = &mgr->rules[cur - 1U];
+	rule->hits += hits;
+	if (rule->hits >= L3L4_MGR_HITS_AGE_LIMIT) {
+		for (i = 0U; i < L3L4_MGR_MAX_RULES; i++) {
+			mgr->rules[i].hits >>= 1U;
+		}
+	}
+
+	ret = 0;
+	if (rule->place == L3L4_MGR_PLACE_HW) {
+		goto done;
+	}
+
+	slot = l3l4_mgr_free_slot(osi_core);
+	if (slot != UINT_MAX) {
+		ret = l3l4_mgr_promote(osi_core, cur - 1U, slot);
+		goto done;
+	}
+
+	slot = l3l4_mgr_coldest_slot(osi_core);
+	if (slot == UINT_MAX) {
+		goto done;
+	}
+
+	cold = mgr->hw_owner[slot] - 1U;
+	if (rule->hits <= (mgr->rules[cold].hits + L3L4_MGR_SWAP_HYST)) {
+		goto done;
+	}
+
+	/* Demote coldest HW rule, promote hot rule and spill the cold one */
+	ret = l3l4_mgr_unplace(osi_core, cold);
+	if (ret < 0) {
+		goto done;
+	}
+
+	ret = l3l4_mgr_promote(osi_core, cur - 1U, slot);
+	if (ret < 0) {
+		/* restore cold rule into its slot */
+		(void)l3l4_mgr_place_hw(osi_core, cold, slot);
+		goto done;
+	}
+
+	ret = l3l4_mgr_place_frp(osi_core, cold);
+	if (ret < 0) {
+		/* Cold rule fits nowhere else, undo the swap */
+		OSI_CORE_INFO((osi_core->osd), (OSI_LOG_ARG_HW_FAIL),
+			("L3L4: demoted rule can't be spilled: "), (cold));
+		ret = l3l4_mgr_unplace(osi_core, cur - 1U);
+		if (ret == 0) {
+			ret = l3l4_mgr_place_hw(osi_core, cold, slot);
+		}
+		if (ret == 0) {
+			ret = l3l4_mgr_place_frp(osi_core, cur - 1U);
+		}
+	}
+done:
+	return ret;
+}
+
+/**
+ * @brief l3l4_mgr_place - Get placement of an L3/L4 rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ *
+ * @retval L3L4_MGR_PLACE_HW or L3L4_MGR_PLACE_FRP for managed rule
+ * @retval L3L4_MGR_PLACE_NONE if rule is not found.
+ */
+nveu32_t l3l4_mgr_place(const struct osi_core_priv_data *const osi_core,
+			const struct osi_l3_l4_filter *const l3_l4)
+{
+	const struct core_local *l_core = (const struct core_local *)(const void *)osi_core;
+	const struct l3l4_mgr *mgr = &l_core->l3l4_mgr;
+	nveu32_t place = L3L4_MGR_PLACE_NONE;
+	nveu32_t cur;
+
+	cur = l3l4_mgr_find(mgr, l3_l4, l3l4_mgr_hash(l3_l4));
+	if (cur != 0U) {
+		place = mgr->rules[cur - 1U].place;
+	}
+
+	return place;
+}
+#endif /* !OSI_STRIPPED_LIB */
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef L3L4_MGR_H
+#define L3L4_MGR_H
+
+#include <osi_core.h>
+#include "core_local.h"
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief l3l4_mgr_config - Add or delete an L3/L4 rule.
+ *
+ * Algorithm:
+ * - Look up the rule in the hashed software table.
+ * - On add, store the rule and place it in a free HW filter slot, otherwise
+ *   spill it into FRP when supported, otherwise fail.
+ * - On delete, remove the rule from its placement and promote the hottest
+ *   non HW rule into the freed HW slot.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t l3l4_mgr_config(struct osi_core_priv_data *const osi_core,
+			const struct osi_l3_l4_filter *const l3_l4);
+
+/**
+ * @brief l3l4_mgr_update_hits - Account hits of an L3/L4 rule.
+ *
+ * Algorithm:
+ * - Add hits to the rule hit counter.
+ * - If the rule is not in a HW slot and it is hotter than the coldest HW
+ *   rule by L3L4_MGR_SWAP_HYST, swap both rules.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ * @param[in] hits: Number of hits since last update.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t l3l4_mgr_update_hits(struct osi_core_priv_data *const osi_core,
+			     const struct osi_l3_l4_filter *const l3_l4,
+			     nveu32_t hits);
+
+/**
+ * @brief l3l4_mgr_place - Get placement of an L3/L4 rule.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] l3_l4: Pointer to l3 l4 filter structure (#osi_l3_l4_filter)
+ *
+ * @retval L3L4_MGR_PLACE_HW or L3L4_MGR_PLACE_FRP for managed rule
+ * @retval L3L4_MGR_PLACE_NONE if rule is not found.
+ */
+nveu32_t l3l4_mgr_place(const struct osi_core_priv_data *const osi_core,
+			const struct osi_l3_l4_filter *const l3_l4);
+#endif /* !OSI_STRIPPED_LIB */
+#endif /* L3L4_MGR_H */
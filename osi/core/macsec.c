@@ -849,36 +849,14 @@ exit:
 static inline nve32_t poll_for_kt_update(struct osi_core_priv_data *osi_core)
 {
 	/* half sec timeout */
-	nveu32_t retry = RETRY_COUNT;
-	nveu32_t kt_config;
-	nveu32_t count;
-	nve32_t cond = 1;
-
-	count = 0;
-	while (cond == 1) {
-		if (count > retry) {
-			OSI_CORE_ERR(osi_core->osd,
-				OSI_LOG_ARG_HW_FAIL,
-				"KT update timed out\n",
-				0ULL);
-			return -1;
-		}
-
-		count++;
-
-		kt_config = osi_readla(osi_core,
-				       (nveu8_t *)osi_core->tz_base +
-				       MACSEC_GCM_KEYTABLE_CONFIG);
-		if ((kt_config & MACSEC_KT_CONFIG_UPDATE) == OSI_NONE) {
-			/* exit loop */
-			cond = 0;
-		} else {
-			/* wait on UPDATE bit to reset */
-			osi_core->osd_ops.udelay(RETRY_DELAY);
-		}
-	}
+	static const struct indir_proto kt_proto = {
+		INDIR_PROTO_MACSEC_KT, MACSEC_KT_CONFIG_UPDATE, OSI_NONE,
+		RETRY_DELAY, RETRY_COUNT
+	};
 
-	return 0;
+	return indir_poll(osi_core, &kt_proto,
+			  (nveu8_t *)osi_core->tz_base +
+			  MACSEC_GCM_KEYTABLE_CONFIG, OSI_NULL);
 }
 
 static nve32_t kt_key_read(struct osi_core_priv_data *const osi_core,
@@ -1028,8 +1006,8 @@ err:
  *
  * @note
  * Algorithm:
- *  - Check if MACSEC_LUT_CONFIG_UPDATE is reset by waiting for 1 micro second
- *    for 1000 iterations
+ *  - Wait for MACSEC_LUT_CONFIG_UPDATE reset with indir_poll(), backing
+ *    off 1 micro second for up to 1000 iterations
  *  - Return -1 if maximum iterations are reached
  *  - Refer to MACSEC column of <<******, (sequence diagram)>> for API details.
  *  - TraceID: ***********
@@ -1050,38 +1028,14 @@ err:
 static inline nve32_t poll_for_lut_update(struct osi_core_priv_data *osi_core)
 {
 	/* half sec timeout */
-	nveu32_t retry = RETRY_COUNT;
-	nveu32_t lut_config;
-	nveu32_t count;
-	nve32_t cond = 1;
-	nve32_t ret = 0;
-
-	count = 0;
-	while (cond == 1) {
-		if (count > retry) {
-			OSI_CORE_ERR(osi_core->osd,
-				OSI_LOG_ARG_HW_FAIL,
-				"LUT update timed out\n",
-				0ULL);
-			ret = -1;
-			goto exit;
-		}
-
-		count++;
+	static const struct indir_proto lut_proto = {
+		INDIR_PROTO_MACSEC_LUT, MACSEC_LUT_CONFIG_UPDATE, OSI_NONE,
+		RETRY_DELAY, RETRY_COUNT
+	};
 
-		lut_config = osi_readla(osi_core,
-					(nveu8_t *)osi_core->macsec_base +
-					MACSEC_LUT_CONFIG);
-		if ((lut_config & MACSEC_LUT_CONFIG_UPDATE) == OSI_NONE) {
-			/* exit loop */
-			cond = 0;
-		} else {
-			/* wait on UPDATE bit to reset */
-			osi_core->osd_ops.udelay(RETRY_DELAY);
-		}
-	}
-exit:
-	return ret;
+	return indir_poll(osi_core, &lut_proto,
+			  (nveu8_t *)osi_core->macsec_base + MACSEC_LUT_CONFIG,
+			  OSI_NULL);
 }
 
 /**
@@ -5541,12 +5495,18 @@ nve32_t osi_macsec_init(struct osi_core_priv_data *const osi_core,
 			nveu32_t mtu)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->init != OSI_NULL)) {
 		ret = osi_core->macsec_ops->init(osi_core, mtu);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_INIT, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5576,11 +5536,17 @@ nve32_t osi_macsec_init(struct osi_core_priv_data *const osi_core,
 nve32_t osi_macsec_deinit(struct osi_core_priv_data *const osi_core)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->deinit != OSI_NULL)) {
 		ret = osi_core->macsec_ops->deinit(osi_core);
 	}
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_DEINIT, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5640,12 +5606,18 @@ nve32_t osi_macsec_config_lut(struct osi_core_priv_data *const osi_core,
 			  struct osi_macsec_lut_config *const lut_config)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->lut_config != OSI_NULL)) {
 		ret = osi_core->macsec_ops->lut_config(osi_core, lut_config);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_LUT, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5680,6 +5652,9 @@ nve32_t osi_macsec_get_sc_lut_key_index(struct osi_core_priv_data *const osi_cor
 					nveu16_t ctlr)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->get_sc_lut_key_index != OSI_NULL)) {
@@ -5687,6 +5662,9 @@ nve32_t osi_macsec_get_sc_lut_key_index(struct osi_core_priv_data *const osi_cor
 								  ctlr);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_KEY_INDEX, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5718,12 +5696,18 @@ nve32_t osi_macsec_update_mtu(struct osi_core_priv_data *const osi_core,
 			      nveu32_t mtu)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->update_mtu != OSI_NULL)) {
 		ret = osi_core->macsec_ops->update_mtu(osi_core, mtu);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_MTU, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5756,6 +5740,9 @@ nve32_t osi_macsec_config_kt(struct osi_core_priv_data *const osi_core,
 			 struct osi_macsec_kt_config *const kt_config)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->kt_config != OSI_NULL) &&
@@ -5763,6 +5750,9 @@ nve32_t osi_macsec_config_kt(struct osi_core_priv_data *const osi_core,
 		ret = osi_core->macsec_ops->kt_config(osi_core, kt_config);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_KT, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 #endif /* MACSEC_KEY_PROGRAM */
@@ -5795,12 +5785,18 @@ nve32_t osi_macsec_cipher_config(struct osi_core_priv_data *const osi_core,
 			      nveu32_t cipher)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->cipher_config != OSI_NULL)) {
 		ret = osi_core->macsec_ops->cipher_config(osi_core, cipher);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_CIPHER, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5833,12 +5829,18 @@ nve32_t osi_macsec_loopback(struct osi_core_priv_data *const osi_core,
 			nveu32_t enable)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->loopback_config != OSI_NULL)) {
 		ret = osi_core->macsec_ops->loopback_config(osi_core, enable);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_LOOPBACK, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 #endif /* DEBUG_MACSEC */
@@ -5872,6 +5874,9 @@ nve32_t osi_macsec_en(struct osi_core_priv_data *const osi_core,
 		  nveu32_t enable)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if (((enable & OSI_MACSEC_TX_EN) != OSI_MACSEC_TX_EN) &&
 	    ((enable & OSI_MACSEC_RX_EN) != OSI_MACSEC_RX_EN) &&
@@ -5884,6 +5889,9 @@ nve32_t osi_macsec_en(struct osi_core_priv_data *const osi_core,
 		ret = osi_core->macsec_ops->macsec_en(osi_core, enable);
 	}
 exit:
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_EN, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5921,6 +5929,9 @@ nve32_t osi_macsec_config(struct osi_core_priv_data *const osi_core,
 		      nveu16_t *kt_idx)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if (((enable != OSI_ENABLE) && (enable != OSI_DISABLE)) ||
 	    (ctlr > OSI_CTLR_SEL_MAX) || (kt_idx == OSI_NULL)) {
@@ -5933,6 +5944,9 @@ nve32_t osi_macsec_config(struct osi_core_priv_data *const osi_core,
 						    enable, ctlr, kt_idx);
 	}
 exit:
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_CONFIG, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -5962,12 +5976,21 @@ exit:
 nve32_t osi_macsec_read_mmc(struct osi_core_priv_data *const osi_core)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->read_mmc != OSI_NULL)) {
 		osi_core->macsec_ops->read_mmc(osi_core);
 		ret = 0;
 	}
+#ifndef OSI_STRIPPED_LIB
+	if (ret == 0) {
+		stats_page_publish(osi_core);
+	}
+	lat_end(osi_core, OSI_LAT_MACSEC_MMC, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -6001,6 +6024,9 @@ nve32_t osi_macsec_config_dbg_buf(
 		struct osi_macsec_dbg_buf_config *const dbg_buf_config)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->dbg_buf_config != OSI_NULL)) {
@@ -6008,6 +6034,9 @@ nve32_t osi_macsec_config_dbg_buf(
 							dbg_buf_config);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_DBG_BUF, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -6040,6 +6069,9 @@ nve32_t osi_macsec_dbg_events_config(
 		struct osi_macsec_dbg_buf_config *const dbg_buf_config)
 {
 	nve32_t ret = -1;
+#ifndef OSI_STRIPPED_LIB
+	nveu64_t start = lat_start(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
 
 	if ((osi_core != OSI_NULL) && (osi_core->macsec_ops != OSI_NULL) &&
 	    (osi_core->macsec_ops->dbg_events_config != OSI_NULL)) {
@@ -6047,6 +6079,9 @@ nve32_t osi_macsec_dbg_events_config(
 							dbg_buf_config);
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	lat_end(osi_core, OSI_LAT_MACSEC_DBG_EVENTS, start, ret);
+#endif /* !OSI_STRIPPED_LIB */
 	return ret;
 }
 
@@ -32,43 +32,38 @@
 #include "macsec.h"
 
 /**
- * @brief mgbe_poll_for_mac_accrtl - Poll for Indirect Access control and status
- * register operations complete.
- *
- * Algorithm: Waits for waits for transfer busy bit to be cleared in
- * MAC Indirect address control register to complete operations.
- *
- * @param[in] osi_core: osi core priv data structure
- *
- * @note MAC needs to be out of reset and proper clock configured.
- *
- * @retval 0 on success
- * @retval -1 on failure.
+ * @brief MAC_Indir_Access_Ctrl indirect access protocol
  */
-static nve32_t mgbe_poll_for_mac_acrtl(struct osi_core_priv_data *osi_core)
-{
-	nveu32_t count = 0U;
-	nveu32_t mac_indir_addr_ctrl = 0U;
-	nve32_t ret = -1;
+static const struct indir_proto mgbe_mac_ac_proto = {
+	INDIR_PROTO_MAC_AC, MGBE_MAC_INDIR_AC_OB, OSI_NONE,
+	MGBE_MAC_INDIR_AC_OB_WAIT, MGBE_MAC_INDIR_AC_OB_RETRY
+};
 
-	/* Poll Until MAC_Indir_Access_Ctrl OB is clear */
-	while (count < MGBE_MAC_INDIR_AC_OB_RETRY) {
-		mac_indir_addr_ctrl = osi_readla(osi_core,
-						 (nveu8_t *)osi_core->base +
-						 MGBE_MAC_INDIR_AC);
-		if ((mac_indir_addr_ctrl & MGBE_MAC_INDIR_AC_OB) == OSI_NONE) {
-			/* OB is clear exit the loop */
-			ret = 0;
-			break;
-		}
+/**
+ * @brief MAC_L3_L4_Address_Control indirect access protocol
+ */
+static const struct indir_proto mgbe_l3l4_proto = {
+	INDIR_PROTO_L3L4, MGBE_MAC_L3L4_ADDR_CTR_XB, OSI_NONE,
+	MGBE_MAC_XB_WAIT, MGBE_MAC_XB_RETRY
+};
 
-		/* wait for 10 usec for OB clear and retry */
-		osi_core->osd_ops.udelay(MGBE_MAC_INDIR_AC_OB_WAIT);
-		count++;
-	}
+/**
+ * @brief MTL_RXP_Indirect_Acc_Control_Status indirect access protocol
+ */
+static const struct indir_proto mgbe_frp_proto = {
+	INDIR_PROTO_FRP, MGBE_MTL_RXP_IND_CS_BUSY, OSI_NONE,
+	MGBE_MTL_FRP_READ_UDELAY, MGBE_MTL_FRP_READ_RETRY
+};
 
-	return ret;
-}
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief MAC_RSS_Address indirect access protocol
+ */
+static const struct indir_proto mgbe_rss_proto = {
+	INDIR_PROTO_RSS, MGBE_MAC_RSS_ADDR_OB, OSI_NONE,
+	MGBE_MAC_RSS_OB_WAIT, MGBE_MAC_RSS_OB_RETRY
+};
+#endif /* !OSI_STRIPPED_LIB */
 
 /**
  * @brief mgbe_mac_indir_addr_write - MAC Indirect AC register write.
@@ -90,15 +85,11 @@ static nve32_t mgbe_mac_indir_addr_write(struct osi_core_priv_data *osi_core,
 					 nveu32_t addr_offset,
 					 nveu32_t value)
 {
-	void *base = osi_core->base;
+	nveu8_t *base = (nveu8_t *)osi_core->base;
 	nveu32_t addr = 0;
-	nve32_t ret = 0;
-
-	/* Write MAC_Indir_Access_Data register value */
-	osi_writela(osi_core, value, (nveu8_t *)base + MGBE_MAC_INDIR_DATA);
 
 	/* Program MAC_Indir_Access_Ctrl */
-	addr = osi_readla(osi_core, (nveu8_t *)base + MGBE_MAC_INDIR_AC);
+	addr = osi_readla(osi_core, base + MGBE_MAC_INDIR_AC);
 
 	/* update Mode Select */
 	addr &= ~(MGBE_MAC_INDIR_AC_MSEL);
@@ -116,17 +107,10 @@ static nve32_t mgbe_mac_indir_addr_write(struct osi_core_priv_data *osi_core,
 	/* Set OB bit to initiate write */
 	addr |= MGBE_MAC_INDIR_AC_OB;
 
-	/* Write MGBE_MAC_L3L4_ADDR_CTR */
-	osi_writela(osi_core, addr, (nveu8_t *)base + MGBE_MAC_INDIR_AC);
-
-	/* Wait until OB bit reset */
-	if (mgbe_poll_for_mac_acrtl(osi_core) < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			     "Fail to write MAC_Indir_Access_Ctrl\n", mc_no);
-		ret = -1;
-	}
-
-	return ret;
+	/* Write data, then MAC_Indir_Access_Ctrl and wait for OB reset */
+	return indir_write(osi_core, &mgbe_mac_ac_proto,
+			   base + MGBE_MAC_INDIR_DATA, base + MGBE_MAC_INDIR_AC,
+			   value, addr);
 }
 
 /**
@@ -149,12 +133,11 @@ static nve32_t mgbe_mac_indir_addr_read(struct osi_core_priv_data *osi_core,
 					nveu32_t addr_offset,
 					nveu32_t *value)
 {
-	void *base = osi_core->base;
+	nveu8_t *base = (nveu8_t *)osi_core->base;
 	nveu32_t addr = 0;
-	nve32_t ret = 0;
 
 	/* Program MAC_Indir_Access_Ctrl */
-	addr = osi_readla(osi_core, (nveu8_t *)base + MGBE_MAC_INDIR_AC);
+	addr = osi_readla(osi_core, base + MGBE_MAC_INDIR_AC);
 
 	/* update Mode Select */
 	addr &= ~(MGBE_MAC_INDIR_AC_MSEL);
@@ -169,24 +152,13 @@ static nve32_t mgbe_mac_indir_addr_read(struct osi_core_priv_data *osi_core,
 	/* Set CMD filed bit to 1 for read */
 	addr |= MGBE_MAC_INDIR_AC_CMD;
 
-	/* Set OB bit to initiate write */
+	/* Set OB bit to initiate read */
 	addr |= MGBE_MAC_INDIR_AC_OB;
 
-	/* Write MGBE_MAC_L3L4_ADDR_CTR */
-	osi_writela(osi_core, addr, (nveu8_t *)base + MGBE_MAC_INDIR_AC);
-
-	/* Wait until OB bit reset */
-	if (mgbe_poll_for_mac_acrtl(osi_core) < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			     "Fail to write MAC_Indir_Access_Ctrl\n", mc_no);
-		ret = -1;
-		goto fail;
-	}
-
-	/* Read MAC_Indir_Access_Data register value */
-	*value = osi_readla(osi_core, (nveu8_t *)base + MGBE_MAC_INDIR_DATA);
-fail:
-	return ret;
+	/* Write MAC_Indir_Access_Ctrl, wait for OB reset and read data */
+	return indir_read(osi_core, &mgbe_mac_ac_proto,
+			  base + MGBE_MAC_INDIR_DATA, base + MGBE_MAC_INDIR_AC,
+			  addr, value);
 }
 
 /**
@@ -381,53 +353,6 @@ fail:
 	return ret;
 }
 
-/**
- * @brief mgbe_poll_for_l3l4crtl - Poll for L3_L4 filter register operations.
- *
- * Algorithm: Waits for waits for transfer busy bit to be cleared in
- * L3_L4 address control register to complete filter register operations.
- *
- * @param[in] osi_core: osi core priv data structure
- *
- * @note MAC needs to be out of reset and proper clock configured.
- *
- * @retval 0 on success
- * @retval -1 on failure.
- */
-static nve32_t mgbe_poll_for_l3l4crtl(struct osi_core_priv_data *osi_core)
-{
-	nveu32_t retry = 10;
-	nveu32_t count;
-	nveu32_t l3l4_addr_ctrl = 0;
-	nve32_t cond = 1;
-	nve32_t ret = 0;
-
-	/* Poll Until L3_L4_Address_Control XB is clear */
-	count = 0;
-	while (cond == 1) {
-		if (count > retry) {
-			/* Return error after max retries */
-			ret = -1;
-			goto fail;
-		}
-
-		count++;
-
-		l3l4_addr_ctrl = osi_readla(osi_core,
-					    (nveu8_t *)osi_core->base +
-					    MGBE_MAC_L3L4_ADDR_CTR);
-		if ((l3l4_addr_ctrl & MGBE_MAC_L3L4_ADDR_CTR_XB) == OSI_NONE) {
-			/* Set cond to 0 to exit loop */
-			cond = 0;
-		} else {
-			/* wait for 10 usec for XB clear */
-			osi_core->osd_ops.udelay(MGBE_MAC_XB_WAIT);
-		}
-	}
-fail:
-	return ret;
-}
-
 /**
  * @brief mgbe_l3l4_filter_write - L3_L4 filter register write.
  *
@@ -448,17 +373,11 @@ static nve32_t mgbe_l3l4_filter_write(struct osi_core_priv_data *osi_core,
 				      nveu32_t filter_type,
 				      nveu32_t value)
 {
-	void *base = osi_core->base;
+	nveu8_t *base = (nveu8_t *)osi_core->base;
 	nveu32_t addr = 0;
-	nve32_t ret = 0;
-
-	/* Write MAC_L3_L4_Data register value */
-	osi_writela(osi_core, value,
-		    (nveu8_t *)base + MGBE_MAC_L3L4_DATA);
 
 	/* Program MAC_L3_L4_Address_Control */
-	addr = osi_readla(osi_core,
-			  (nveu8_t *)base + MGBE_MAC_L3L4_ADDR_CTR);
+	addr = osi_readla(osi_core, base + MGBE_MAC_L3L4_ADDR_CTR);
 
 	/* update filter number */
 	addr &= ~(MGBE_MAC_L3L4_ADDR_CTR_IDDR_FNUM);
@@ -476,19 +395,10 @@ static nve32_t mgbe_l3l4_filter_write(struct osi_core_priv_data *osi_core,
 	/* Set XB bit to initiate write */
 	addr |= MGBE_MAC_L3L4_ADDR_CTR_XB;
 
-	/* Write MGBE_MAC_L3L4_ADDR_CTR */
-	osi_writela(osi_core, addr,
-		    (nveu8_t *)base + MGBE_MAC_L3L4_ADDR_CTR);
-
-	/* Wait untile XB bit reset */
-	if (mgbe_poll_for_l3l4crtl(osi_core) < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			     "Fail to write L3_L4_Address_Control\n",
-			     filter_type);
-		ret = -1;
-	}
-
-	return ret;
+	/* Write data, then MAC_L3_L4_Address_Control and wait for XB reset */
+	return indir_write(osi_core, &mgbe_l3l4_proto,
+			   base + MGBE_MAC_L3L4_DATA,
+			   base + MGBE_MAC_L3L4_ADDR_CTR, value, addr);
 }
 
 /**
@@ -933,16 +843,18 @@ done:
 }
 
 /**
- * @brief mgbe_frp_write - Write FRP entry into HW
+ * @brief mgbe_frp_write - Write FRP entry registers into HW
  *
- * Algorithm: This function will write FRP entry registers into HW.
+ * Algorithm: This function waits for FRP indirect access to be ready and
+ * writes the queued FRP registers back to back.
  *
  * @param[in] osi_core: OSI core private data structure.
  * @param[in] acc_sel: FRP Indirect Access Selection.
  *		       0x0 : Access FRP Instruction Table.
  *		       0x1 : Access Indirect FRP Register block.
- * @param[in] addr: FRP register address.
- * @param[in] data: FRP register data.
+ * @param[in, out] ent: FRP register data and address in ctrl field,
+ *		   ctrl is updated with complete control register value.
+ * @param[in] num: Number of registers in ent.
  *
  * @note MAC should be init and started. see osi_start_mac()
  *
@@ -951,12 +863,13 @@ done:
  */
 static nve32_t mgbe_frp_write(struct osi_core_priv_data *osi_core,
 			      nveu32_t acc_sel,
-			      nveu32_t addr,
-			      nveu32_t data)
+			      struct indir_entry *const ent,
+			      const nveu32_t num)
 {
 	nve32_t ret = 0;
 	nveu8_t *base = osi_core->base;
 	nveu32_t val = 0U;
+	nveu32_t i;
 
 	if ((acc_sel != OSI_ENABLE) && (acc_sel != OSI_DISABLE)) {
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
@@ -967,26 +880,13 @@ static nve32_t mgbe_frp_write(struct osi_core_priv_data *osi_core,
 	}
 
 	/* Wait for ready */
-	ret = osi_readl_poll_timeout((base + MGBE_MTL_RXP_IND_CS),
-				     (osi_core->osd_ops.udelay),
-				     (val),
-				     ((val & MGBE_MTL_RXP_IND_CS_BUSY) ==
-				      OSI_NONE),
-				     (MGBE_MTL_FRP_READ_UDELAY),
-				     (MGBE_MTL_FRP_READ_RETRY));
+	ret = indir_poll(osi_core, &mgbe_frp_proto, base + MGBE_MTL_RXP_IND_CS,
+			 &val);
 	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to write\n",
-			val);
-		ret = -1;
 		goto done;
 	}
 
-	/* Write data into MTL_RXP_Indirect_Acc_Data */
-	osi_writela(osi_core, data, base + MGBE_MTL_RXP_IND_DATA);
-
 	/* Program MTL_RXP_Indirect_Acc_Control_Status */
-	val = osi_readla(osi_core, base + MGBE_MTL_RXP_IND_CS);
 	/* Set/Reset ACCSEL for FRP Register block/Instruction Table */
 	if (acc_sel == OSI_ENABLE) {
 		/* Set ACCSEL bit */
@@ -997,28 +897,19 @@ static nve32_t mgbe_frp_write(struct osi_core_priv_data *osi_core,
 	}
 	/* Set WRRDN for write */
 	val |= MGBE_MTL_RXP_IND_CS_WRRDN;
-	/* Clear and add ADDR */
+	/* Clear ADDR */
 	val &= ~MGBE_MTL_RXP_IND_CS_ADDR;
-	val |= (addr & MGBE_MTL_RXP_IND_CS_ADDR);
 	/* Start write */
 	val |= MGBE_MTL_RXP_IND_CS_BUSY;
-	osi_writela(osi_core, val, base + MGBE_MTL_RXP_IND_CS);
-
-	/* Wait for complete */
-	ret = osi_readl_poll_timeout((base + MGBE_MTL_RXP_IND_CS),
-				     (osi_core->osd_ops.udelay),
-				     (val),
-				     ((val & MGBE_MTL_RXP_IND_CS_BUSY) ==
-				      OSI_NONE),
-				     (MGBE_MTL_FRP_READ_UDELAY),
-				     (MGBE_MTL_FRP_READ_RETRY));
-	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			"Fail to write\n",
-			val);
-		ret = -1;
+	for (i = 0U; i < num; i++) {
+		ent[i].ctrl = val | (ent[i].ctrl & MGBE_MTL_RXP_IND_CS_ADDR);
 	}
 
+	/* Each write starts as soon as the previous one completed */
+	ret = indir_write_batch(osi_core, &mgbe_frp_proto,
+				base + MGBE_MTL_RXP_IND_DATA,
+				base + MGBE_MTL_RXP_IND_CS, ent, num);
+
 done:
 	return ret;
 }
@@ -1041,6 +932,7 @@ static nve32_t mgbe_update_frp_entry(struct osi_core_priv_data *const osi_core,
 				     const nveu32_t pos,
 				     struct osi_core_frp_data *const data)
 {
+	struct indir_entry ent[MGBE_MTL_FRP_IE_CNT];
 	nveu32_t val = 0U, tmp = 0U;
 	nve32_t ret = -1;
 
@@ -1053,25 +945,15 @@ static nve32_t mgbe_update_frp_entry(struct osi_core_priv_data *const osi_core,
 		goto done;
 	}
 
-	/** Write Match Data into IE0 **/
-	val = data->match_data;
-	ret = mgbe_frp_write(osi_core, OSI_DISABLE, MGBE_MTL_FRP_IE0(pos), val);
-	if (ret < 0) {
-		/* Match Data Write fail */
-		ret = -1;
-		goto done;
-	}
+	/** Match Data into IE0 **/
+	ent[0].data = data->match_data;
+	ent[0].ctrl = MGBE_MTL_FRP_IE0(pos);
 
-	/** Write Match Enable into IE1 **/
-	val = data->match_en;
-	ret = mgbe_frp_write(osi_core, OSI_DISABLE, MGBE_MTL_FRP_IE1(pos), val);
-	if (ret < 0) {
-		/* Match Enable Write fail */
-		ret = -1;
-		goto done;
-	}
+	/** Match Enable into IE1 **/
+	ent[1].data = data->match_en;
+	ent[1].ctrl = MGBE_MTL_FRP_IE1(pos);
 
-	/** Write AF, RF, IM, NIC, FO and OKI into IE2 **/
+	/** AF, RF, IM, NIC, FO and OKI into IE2 **/
 	val = 0;
 	if (data->accept_frame == OSI_ENABLE) {
 		/* Set AF Bit */
@@ -1095,20 +977,15 @@ static nve32_t mgbe_update_frp_entry(struct osi_core_priv_data *const osi_core,
 	val |= ((tmp << MGBE_MTL_FRP_IE2_OKI_SHIFT) & MGBE_MTL_FRP_IE2_OKI);
 	tmp = data->dma_chsel;
 	val |= ((tmp << MGBE_MTL_FRP_IE2_DCH_SHIFT) & MGBE_MTL_FRP_IE2_DCH);
-	ret = mgbe_frp_write(osi_core, OSI_DISABLE, MGBE_MTL_FRP_IE2(pos), val);
-	if (ret < 0) {
-		/* FRP IE2 Write fail */
-		ret = -1;
-		goto done;
-	}
+	ent[2].data = val;
+	ent[2].ctrl = MGBE_MTL_FRP_IE2(pos);
 
-	/** Write DCH into IE3 **/
-	val = (data->dma_chsel & MGBE_MTL_FRP_IE3_DCH_MASK);
-	ret = mgbe_frp_write(osi_core, OSI_DISABLE, MGBE_MTL_FRP_IE3(pos), val);
-	if (ret < 0) {
-		/* DCH Write fail */
-		ret = -1;
-	}
+	/** DCH into IE3 **/
+	ent[3].data = (data->dma_chsel & MGBE_MTL_FRP_IE3_DCH_MASK);
+	ent[3].ctrl = MGBE_MTL_FRP_IE3(pos);
+
+	/* Write IE0-IE3 */
+	ret = mgbe_frp_write(osi_core, OSI_DISABLE, ent, MGBE_MTL_FRP_IE_CNT);
 
 done:
 	return ret;
@@ -1332,13 +1209,7 @@ static nve32_t mgbe_rss_write_reg(struct osi_core_priv_data *osi_core,
 				  nveu32_t is_key)
 {
 	nveu8_t *addr = (nveu8_t *)osi_core->base;
-	nveu32_t retry = 100;
 	nveu32_t ctrl = 0;
-	nveu32_t count = 0;
-	nve32_t cond = 1;
-
-	/* data into RSS Lookup Table or RSS Hash Key */
-	osi_writela(osi_core, value, addr + MGBE_MAC_RSS_DATA);
 
 	if (is_key == OSI_ENABLE) {
 		ctrl |= MGBE_MAC_RSS_ADDR_ADDRT;
@@ -1347,26 +1218,53 @@ static nve32_t mgbe_rss_write_reg(struct osi_core_priv_data *osi_core,
 	ctrl |= idx << MGBE_MAC_RSS_ADDR_RSSIA_SHIFT;
 	ctrl |= MGBE_MAC_RSS_ADDR_OB;
 	ctrl &= ~MGBE_MAC_RSS_ADDR_CT;
-	osi_writela(osi_core, ctrl, addr + MGBE_MAC_RSS_ADDR);
 
-	/* poll for write operation to complete */
-	while (cond == 1) {
-		if (count > retry) {
-			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				     "Failed to update RSS Hash key or table\n",
-				     0ULL);
-			return -1;
-		}
+	/* data into RSS Lookup Table or RSS Hash Key */
+	return indir_write(osi_core, &mgbe_rss_proto, addr + MGBE_MAC_RSS_DATA,
+			   addr + MGBE_MAC_RSS_ADDR, value, ctrl);
+}
 
-		count++;
+/**
+ * @brief mgbe_rss_enable - Enable RSS with configured hash types
+ *
+ * Algorithm: Programs hashed packet types recorded by mgbe_config_rss()
+ * and enables RSS in MAC_RSS_Control.
+ *
+ * @param[in] osi_core: OSI core private data.
+ *
+ * @note MAC has to be out of reset.
+ *
+ * @retval 0 always
+ */
+static nve32_t mgbe_rss_enable(struct osi_core_priv_data *const osi_core)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu8_t *addr = (nveu8_t *)osi_core->base;
+	nveu32_t hash_types = l_core->rss_hw_hash_types;
+	nveu32_t value = 0;
 
-		value = osi_readla(osi_core, addr + MGBE_MAC_RSS_ADDR);
-		if ((value & MGBE_MAC_RSS_ADDR_OB) == OSI_NONE) {
-			cond = 0;
-		} else {
-			osi_core->osd_ops.udelay(100);
-		}
+	/* TCP/UDP 4-tuple hashing covers both IPv4 and IPv6 packets */
+	if (hash_types == 0U) {
+		hash_types = OSI_RSS_HASH_ALL;
+	}
+
+	/* Enable RSS */
+	value = osi_shadow_readl(&l_core->reg_shadow, OSI_SHADOW_MAC_RSS_CTRL,
+				 addr, MGBE_MAC_RSS_CTRL);
+	value &= ~(MGBE_MAC_RSS_CTRL_UDP4TE | MGBE_MAC_RSS_CTRL_TCP4TE |
+		   MGBE_MAC_RSS_CTRL_IP2TE);
+	if ((hash_types & OSI_RSS_HASH_IP) != 0U) {
+		value |= MGBE_MAC_RSS_CTRL_IP2TE;
+	}
+	if ((hash_types & OSI_RSS_HASH_TCP) != 0U) {
+		value |= MGBE_MAC_RSS_CTRL_TCP4TE;
+	}
+	if ((hash_types & OSI_RSS_HASH_UDP) != 0U) {
+		value |= MGBE_MAC_RSS_CTRL_UDP4TE;
 	}
+	value |= MGBE_MAC_RSS_CTRL_RSSE;
+	osi_shadow_writel(&l_core->reg_shadow, OSI_SHADOW_MAC_RSS_CTRL, value,
+			  addr, MGBE_MAC_RSS_CTRL);
 
 	return 0;
 }
@@ -1374,19 +1272,28 @@ static nve32_t mgbe_rss_write_reg(struct osi_core_priv_data *osi_core,
 /**
  * @brief mgbe_config_rss - Configure RSS
  *
- * Algorithm: Programes RSS hash table or RSS hash key.
+ * Algorithm: Programes RSS hash table from osi_core->rss and the given
+ * RSS hash key and hash types. With a job, the key and table writes are
+ * only queued and RSS is enabled once the job completed.
  *
  * @param[in] osi_core: OSI core private data.
+ * @param[in] key: RSS hash key, OSI_RSS_HASH_KEY_SIZE bytes.
+ * @param[in] hash_types: Hashed packet types, 0 for OSI_RSS_HASH_ALL.
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
  *
  * @note MAC has to be out of reset.
  *
  * @retval 0 on success
  * @retval -1 on failure.
  */
-static nve32_t mgbe_config_rss(struct osi_core_priv_data *osi_core)
+static nve32_t mgbe_config_rss(struct osi_core_priv_data *osi_core,
+			       const nveu8_t *const key,
+			       const nveu32_t hash_types,
+			       struct indir_job *const job)
 {
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
 	nveu8_t *addr = (nveu8_t *)osi_core->base;
-	nveu32_t value = 0;
+	struct indir_entry ent[MGBE_RSS_BATCH];
 	nveu32_t i = 0, j = 0;
 	nve32_t ret = 0;
 
@@ -1400,35 +1307,109 @@ static nve32_t mgbe_config_rss(struct osi_core_priv_data *osi_core)
 		return 0;
 	}
 
+	/* Hash types for mgbe_rss_enable(), run now or once job completed */
+	l_core->rss_hw_hash_types = hash_types;
+
 	/* Program the hash key */
 	for (i = 0; i < OSI_RSS_HASH_KEY_SIZE; i += 4U) {
-		value = ((nveu32_t)osi_core->rss.key[i] |
-			 ((nveu32_t)osi_core->rss.key[i + 1U] << 8U) |
-			 ((nveu32_t)osi_core->rss.key[i + 2U] << 16U) |
-			 ((nveu32_t)osi_core->rss.key[i + 3U] << 24U));
-		ret = mgbe_rss_write_reg(osi_core, j, value, OSI_ENABLE);
-		if (ret < 0) {
-			return ret;
-		}
+		ent[j].data = ((nveu32_t)key[i] |
+			       ((nveu32_t)key[i + 1U] << 8U) |
+			       ((nveu32_t)key[i + 2U] << 16U) |
+			       ((nveu32_t)key[i + 3U] << 24U));
+		ent[j].ctrl = MGBE_MAC_RSS_ADDR_ADDRT |
+			      (j << MGBE_MAC_RSS_ADDR_RSSIA_SHIFT) |
+			      MGBE_MAC_RSS_ADDR_OB;
 		j++;
 	}
 
-	/* Program Hash table */
+	if (job != OSI_NULL) {
+		for (i = 0; i < j; i++) {
+			ret = indir_job_add(osi_core, job, &mgbe_rss_proto,
+					    addr + MGBE_MAC_RSS_DATA,
+					    addr + MGBE_MAC_RSS_ADDR,
+					    ent[i].data, ent[i].ctrl);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		for (i = 0; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
+			ret = indir_job_add(osi_core, job, &mgbe_rss_proto,
+					    addr + MGBE_MAC_RSS_DATA,
+					    addr + MGBE_MAC_RSS_ADDR,
+					    osi_core->rss.table[i],
+					    (i << MGBE_MAC_RSS_ADDR_RSSIA_SHIFT) |
+					    MGBE_MAC_RSS_ADDR_OB);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		job->hw_done = mgbe_rss_enable;
+		return 0;
+	}
+
+	ret = indir_write_batch(osi_core, &mgbe_rss_proto,
+				addr + MGBE_MAC_RSS_DATA,
+				addr + MGBE_MAC_RSS_ADDR, ent, j);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Program Hash table, MGBE_RSS_BATCH entries at a time */
 	for (i = 0; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
-		ret = mgbe_rss_write_reg(osi_core, i, osi_core->rss.table[i],
-					 OSI_NONE);
-		if (ret < 0) {
-			return ret;
+		j = i % MGBE_RSS_BATCH;
+		ent[j].data = osi_core->rss.table[i];
+		ent[j].ctrl = (i << MGBE_MAC_RSS_ADDR_RSSIA_SHIFT) |
+			      MGBE_MAC_RSS_ADDR_OB;
+		if ((j + 1U) == MGBE_RSS_BATCH) {
+			ret = indir_write_batch(osi_core, &mgbe_rss_proto,
+						addr + MGBE_MAC_RSS_DATA,
+						addr + MGBE_MAC_RSS_ADDR,
+						ent, MGBE_RSS_BATCH);
+			if (ret < 0) {
+				return ret;
+			}
 		}
 	}
 
-	/* Enable RSS */
-	value = osi_readla(osi_core, addr + MGBE_MAC_RSS_CTRL);
-	value |= MGBE_MAC_RSS_CTRL_UDP4TE | MGBE_MAC_RSS_CTRL_TCP4TE |
-		 MGBE_MAC_RSS_CTRL_IP2TE | MGBE_MAC_RSS_CTRL_RSSE;
-	osi_writela(osi_core, value, addr + MGBE_MAC_RSS_CTRL);
+	return mgbe_rss_enable(osi_core);
+}
 
-	return 0;
+/**
+ * @brief mgbe_write_rss_entry - Program one RSS indirection table entry
+ *
+ * Algorithm: Programs DMA channel of one RSS hash table entry without
+ * touching the hash key or the rest of the table.
+ *
+ * @param[in] osi_core: OSI core private data.
+ * @param[in] idx: Hash table index, less than OSI_RSS_MAX_TABLE_SIZE
+ * @param[in] chan: DMA channel for the entry
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @note MAC has to be out of reset.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t mgbe_write_rss_entry(struct osi_core_priv_data *const osi_core,
+				    const nveu32_t idx, const nveu32_t chan,
+				    struct indir_job *const job)
+{
+	nveu8_t *addr = (nveu8_t *)osi_core->base;
+	nve32_t ret;
+
+	if (job != OSI_NULL) {
+		ret = indir_job_add(osi_core, job, &mgbe_rss_proto,
+				    addr + MGBE_MAC_RSS_DATA,
+				    addr + MGBE_MAC_RSS_ADDR, chan,
+				    (idx << MGBE_MAC_RSS_ADDR_RSSIA_SHIFT) |
+				    MGBE_MAC_RSS_ADDR_OB);
+	} else {
+		ret = mgbe_rss_write_reg(osi_core, idx, chan, OSI_NONE);
+	}
+
+	return ret;
 }
 
 /**
@@ -1807,19 +1788,22 @@ static nve32_t mgbe_configure_mac(struct osi_core_priv_data *osi_core)
 	osi_writela(osi_core, value,
 		    (nveu8_t *)osi_core->base + MGBE_MAC_RQC1R);
 
-	/* Disable all MMC nve32_terrupts */
-	/* Disable all MMC Tx nve32_terrupts */
-	osi_writela(osi_core, OSI_NONE, (nveu8_t *)osi_core->base +
+	/* Enable MMC interrupts of counters harvested on half or max value */
+	/* MMC Tx interrupts */
+	osi_writela(osi_core, MGBE_MMC_TX_INTR_CNT, (nveu8_t *)osi_core->base +
 		   MGBE_MMC_TX_INTR_EN);
-	/* Disable all MMC RX nve32_terrupts */
-	osi_writela(osi_core, OSI_NONE, (nveu8_t *)osi_core->base +
+	/* MMC RX interrupts */
+	osi_writela(osi_core, MGBE_MMC_RX_INTR_CNT, (nveu8_t *)osi_core->base +
 		   MGBE_MMC_RX_INTR_EN);
 
-	/* Configure MMC counters */
+	/* Configure MMC counters. Counters are not preset, a preset close to
+	 * maximum value would be accounted as rollover.
+	 */
 	value = osi_readla(osi_core,
 			   (nveu8_t *)osi_core->base + MGBE_MMC_CNTRL);
+	value &= ~MGBE_MMC_CNTRL_CNTPRST;
 	value |= MGBE_MMC_CNTRL_CNTRST | MGBE_MMC_CNTRL_RSTONRD |
-		 MGBE_MMC_CNTRL_CNTMCT | MGBE_MMC_CNTRL_CNTPRST;
+		 MGBE_MMC_CNTRL_CNTMCT;
 	osi_writela(osi_core, value,
 		    (nveu8_t *)osi_core->base + MGBE_MMC_CNTRL);
 
@@ -1879,7 +1863,8 @@ static nve32_t mgbe_configure_mac(struct osi_core_priv_data *osi_core)
 	/* TODO: USP (user Priority) to RxQ Mapping */
 
 	/* RSS cofiguration */
-	mgbe_config_rss(osi_core);
+	mgbe_config_rss(osi_core, osi_core->rss.key, osi_core->rss.hash_types,
+			OSI_NULL);
 #endif /* !OSI_STRIPPED_LIB */
 
 	return 0;
@@ -2187,6 +2172,12 @@ static void mgbe_handle_mac_intrs(struct osi_core_priv_data *osi_core)
 
 	mac_isr = osi_readla(osi_core, base + MGBE_MAC_ISR);
 
+	/* Harvest MMC counters which reached half or max value */
+	if ((mac_isr & (MGBE_MAC_ISR_MMCRXIS | MGBE_MAC_ISR_MMCTXIS)) !=
+	    OSI_NONE) {
+		mgbe_mmc_harvest(osi_core);
+	}
+
 	/* Check for Link status change interrupt */
 	if ((mac_isr & MGBE_MAC_ISR_LSI) == OSI_ENABLE) {
 		/* For Local fault need to stop network data and restart the LANE bringup */
@@ -4050,6 +4041,7 @@ void mgbe_init_core_ops(struct core_ops *ops)
 	ops->set_mdc_clk_rate = mgbe_set_mdc_clk_rate;
 	ops->config_mac_loopback = mgbe_config_mac_loopback;
 	ops->config_rss = mgbe_config_rss;
+	ops->write_rss_entry = mgbe_write_rss_entry;
 	ops->config_ptp_rxq = mgbe_config_ptp_rxq;
 #endif /* !OSI_STRIPPED_LIB */
 #ifdef HSI_SUPPORT
@@ -97,6 +97,10 @@
 #define MGBE_MAC_RSS_ADDR_RSSIA_SHIFT		8U
 #define MGBE_MAC_RSS_ADDR_OB			OSI_BIT(0)
 #define MGBE_MAC_RSS_ADDR_CT			OSI_BIT(1)
+#define MGBE_MAC_RSS_OB_WAIT			100U
+#define MGBE_MAC_RSS_OB_RETRY			100U
+/* Number of RSS hash key or table writes queued at once */
+#define MGBE_RSS_BATCH				16U
 /**
  * @addtogroup - MGBE-LPI LPI configuration macros
  *
@@ -283,6 +287,7 @@
 #define MGBE_MTL_FRP_IE1(x)			(((x) * 0x4U) + 0x1U)
 #define MGBE_MTL_FRP_IE2(x)			(((x) * 0x4U) + 0x2U)
 #define MGBE_MTL_FRP_IE3(x)			(((x) * 0x4U) + 0x3U)
+#define MGBE_MTL_FRP_IE_CNT			4U
 #define MGBE_MTL_FRP_IE2_DCH			(OSI_BIT(31) | OSI_BIT(30) | \
 						 OSI_BIT(29) | OSI_BIT(28) | \
 						 OSI_BIT(27) | OSI_BIT(26) | \
@@ -423,6 +428,7 @@
  * @{
  */
 #define MGBE_MAC_XB_WAIT		10U
+#define MGBE_MAC_XB_RETRY		10U
 #define MGBE_MAC_L3L4_CTR		0x0
 #define MGBE_MAC_L3_AD1R		0x5
 #ifndef OSI_STRIPPED_LIB
@@ -544,6 +550,11 @@
 #define MGBE_MAC_VLANTIR_VLTI			OSI_BIT(20)
 #define MGBE_MAC_VLANTIRR_CSVL			OSI_BIT(19)
 #define MGBE_MAC_ISR_LSI			OSI_BIT(0)
+#define MGBE_MAC_ISR_MMCRXIS			OSI_BIT(9)
+#define MGBE_MAC_ISR_MMCTXIS			OSI_BIT(10)
+/* MMC counters harvested from MMC interrupt */
+#define MGBE_MMC_TX_INTR_CNT			0x000FFFFFU
+#define MGBE_MMC_RX_INTR_CNT			0x09FFFFFFU
 #define MGBE_MAC_ISR_LS_MASK			(OSI_BIT(25) | OSI_BIT(24))
 #define MGBE_MAC_ISR_LS_LOCAL_FAULT		OSI_BIT(25)
 #define MGBE_MAC_ISR_LS_LINK_OK			0U
@@ -25,533 +25,408 @@
 #include <osi_core.h>
 #include "mgbe_mmc.h"
 #include "mgbe_core.h"
+#include "core_common.h"
 
 /**
- * @brief mgbe_update_mmc_val - function to read register and return value to callee
- *
- * Algorithm: Read the registers, check for boundary, if more, reset
- *	  counters else return same to caller.
+ * @brief mgbe_reset_mmc - To reset MMC registers and ether_mmc_counter
+ *	structure variable
  *
  * @param[in] osi_core: OSI core private data structure.
- * @param[in] last_value: previous value of stats variable.
- * @param[in] offset: HW register offset
  *
  * @note
  *	1) MAC should be init and started. see osi_start_mac()
  *	2) osi_core->osd should be populated
+ */
+void mgbe_reset_mmc(struct osi_core_priv_data *const osi_core)
+{
+	nveu32_t value;
+
+	value = osi_readl((nveu8_t *)osi_core->base + MGBE_MMC_CNTRL);
+	/* self-clear bit in one clock cycle */
+	value |= MGBE_MMC_CNTRL_CNTRST;
+	osi_writel(value, (nveu8_t *)osi_core->base + MGBE_MMC_CNTRL);
+	osi_memset(&osi_core->mmc, 0U, sizeof(struct osi_mmc_counters));
+}
+
+/**
+ * @brief MMC interrupt status registers indexed by MMC_STS_*
+ */
+static const nveu32_t mgbe_mmc_sts_reg[MMC_STS_MAX] = {
+	MMC_TX_INTR,
+	MMC_RX_INTR,
+	/* Checksum offload counters are 64 bit, no rollover tracking */
+	0U,
+	MMC_FPE_TX_INTR,
+	MMC_FPE_RX_INTR,
+};
+
+/**
+ * @brief mgbe_read_mmc_tx - Read Tx packet and octet counters
  *
- * @retval 0 on MMC counters overflow
- * @retval value on current MMC counter value.
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
  */
-static inline nveu64_t mgbe_update_mmc_val(struct osi_core_priv_data *osi_core,
-					   nveu64_t last_value,
-					   nveu64_t offset)
+static void mgbe_read_mmc_tx(struct osi_core_priv_data *const osi_core,
+			     struct mmc_sts *const sts)
 {
-	nveu64_t temp = 0;
-	nveu32_t value = osi_readl((nveu8_t *)osi_core->base +
-				       offset);
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TXOCTETCOUNT_GB_L, MMC_TXOCTETCOUNT_GB_H, MMC_STS_TX, 0U,
+		  &mmc->mmc_tx_octetcount_gb },
+		{ MMC_TXPACKETCOUNT_GB_L, MMC_TXPACKETCOUNT_GB_H, MMC_STS_TX, 1U,
+		  &mmc->mmc_tx_framecount_gb },
+		{ MMC_TXBROADCASTPACKETS_G_L, MMC_TXBROADCASTPACKETS_G_H, MMC_STS_TX, 2U,
+		  &mmc->mmc_tx_broadcastframe_g },
+		{ MMC_TXMULTICASTPACKETS_G_L, MMC_TXMULTICASTPACKETS_G_H, MMC_STS_TX, 3U,
+		  &mmc->mmc_tx_multicastframe_g },
+		{ MMC_TXUNICASTPACKETS_GB_L, MMC_TXUNICASTPACKETS_GB_H, MMC_STS_TX, 10U,
+		  &mmc->mmc_tx_unicast_gb },
+		{ MMC_TXMULTICASTPACKETS_GB_L, MMC_TXMULTICASTPACKETS_GB_H, MMC_STS_TX, 11U,
+		  &mmc->mmc_tx_multicast_gb },
+		{ MMC_TXBROADCASTPACKETS_GB_L, MMC_TXBROADCASTPACKETS_GB_H, MMC_STS_TX, 12U,
+		  &mmc->mmc_tx_broadcast_gb },
+		{ MMC_TXOCTETCOUNT_G_L, MMC_TXOCTETCOUNT_G_H, MMC_STS_TX, 14U,
+		  &mmc->mmc_tx_octetcount_g },
+		{ MMC_TXPACKETSCOUNT_G_L, MMC_TXPACKETSCOUNT_G_H, MMC_STS_TX, 15U,
+		  &mmc->mmc_tx_framecount_g },
+		{ MMC_TXPAUSEPACKETS_L, MMC_TXPAUSEPACKETS_H, MMC_STS_TX, 16U,
+		  &mmc->mmc_tx_pause_frame },
+		{ MMC_TXVLANPACKETS_G_L, MMC_TXVLANPACKETS_G_H, MMC_STS_TX, 17U,
+		  &mmc->mmc_tx_vlan_frame_g },
+	};
 
-	temp = last_value + value;
-	if (temp < last_value) {
-		OSI_CORE_ERR(osi_core->osd,
-			OSI_LOG_ARG_OUTOFBOUND,
-			"Value overflow resetting  all counters\n",
-			(nveul64_t)offset);
-		mgbe_reset_mmc(osi_core);
-	}
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief mgbe_read_mmc_rx - Read Rx packet and octet counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void mgbe_read_mmc_rx(struct osi_core_priv_data *const osi_core,
+			     struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_RXPACKETCOUNT_GB_L, MMC_RXPACKETCOUNT_GB_H, MMC_STS_RX, 0U,
+		  &mmc->mmc_rx_framecount_gb },
+		{ MMC_RXOCTETCOUNT_GB_L, MMC_RXOCTETCOUNT_GB_H, MMC_STS_RX, 1U,
+		  &mmc->mmc_rx_octetcount_gb },
+		{ MMC_RXOCTETCOUNT_G_L, MMC_RXOCTETCOUNT_G_H, MMC_STS_RX, 2U,
+		  &mmc->mmc_rx_octetcount_g },
+		{ MMC_RXBROADCASTPACKETS_G_L, MMC_RXBROADCASTPACKETS_G_H, MMC_STS_RX, 3U,
+		  &mmc->mmc_rx_broadcastframe_g },
+		{ MMC_RXMULTICASTPACKETS_G_L, MMC_RXMULTICASTPACKETS_G_H, MMC_STS_RX, 4U,
+		  &mmc->mmc_rx_multicastframe_g },
+		{ MMC_RXUNICASTPACKETS_G_L, MMC_RXUNICASTPACKETS_G_H, MMC_STS_RX, 16U,
+		  &mmc->mmc_rx_unicast_g },
+		{ MMC_RXPAUSEPACKETS_L, MMC_RXPAUSEPACKETS_H, MMC_STS_RX, 19U,
+		  &mmc->mmc_rx_pause_frames },
+		{ MMC_RXVLANPACKETS_GB_L, MMC_RXVLANPACKETS_GB_H, MMC_STS_RX, 21U,
+		  &mmc->mmc_rx_vlan_frames_gb },
+	};
 
-	return temp;
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
 }
 
 /**
- * @brief mgbe_reset_mmc - To reset MMC registers and ether_mmc_counter
- *	structure variable
+ * @brief mgbe_read_mmc_size - Read Tx and Rx packet size histogram counters
  *
- * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void mgbe_read_mmc_size(struct osi_core_priv_data *const osi_core,
+			       struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TX64OCTETS_GB_L, MMC_TX64OCTETS_GB_H, MMC_STS_TX, 4U,
+		  &mmc->mmc_tx_64_octets_gb },
+		{ MMC_TX65TO127OCTETS_GB_L, MMC_TX65TO127OCTETS_GB_H, MMC_STS_TX, 5U,
+		  &mmc->mmc_tx_65_to_127_octets_gb },
+		{ MMC_TX128TO255OCTETS_GB_L, MMC_TX128TO255OCTETS_GB_H, MMC_STS_TX, 6U,
+		  &mmc->mmc_tx_128_to_255_octets_gb },
+		{ MMC_TX256TO511OCTETS_GB_L, MMC_TX256TO511OCTETS_GB_H, MMC_STS_TX, 7U,
+		  &mmc->mmc_tx_256_to_511_octets_gb },
+		{ MMC_TX512TO1023OCTETS_GB_L, MMC_TX512TO1023OCTETS_GB_H, MMC_STS_TX, 8U,
+		  &mmc->mmc_tx_512_to_1023_octets_gb },
+		{ MMC_TX1024TOMAXOCTETS_GB_L, MMC_TX1024TOMAXOCTETS_GB_H, MMC_STS_TX, 9U,
+		  &mmc->mmc_tx_1024_to_max_octets_gb },
+		{ MMC_RXUNDERSIZE_G, 0U, MMC_STS_RX, 8U,
+		  &mmc->mmc_rx_undersize_g },
+		{ MMC_RXOVERSIZE_G, 0U, MMC_STS_RX, 9U,
+		  &mmc->mmc_rx_oversize_g },
+		{ MMC_RX64OCTETS_GB_L, MMC_RX64OCTETS_GB_H, MMC_STS_RX, 10U,
+		  &mmc->mmc_rx_64_octets_gb },
+		{ MMC_RX65TO127OCTETS_GB_L, MMC_RX65TO127OCTETS_GB_H, MMC_STS_RX, 11U,
+		  &mmc->mmc_rx_65_to_127_octets_gb },
+		{ MMC_RX128TO255OCTETS_GB_L, MMC_RX128TO255OCTETS_GB_H, MMC_STS_RX, 12U,
+		  &mmc->mmc_rx_128_to_255_octets_gb },
+		{ MMC_RX256TO511OCTETS_GB_L, MMC_RX256TO511OCTETS_GB_H, MMC_STS_RX, 13U,
+		  &mmc->mmc_rx_256_to_511_octets_gb },
+		{ MMC_RX512TO1023OCTETS_GB_L, MMC_RX512TO1023OCTETS_GB_H, MMC_STS_RX, 14U,
+		  &mmc->mmc_rx_512_to_1023_octets_gb },
+		{ MMC_RX1024TOMAXOCTETS_GB_L, MMC_RX1024TOMAXOCTETS_GB_H, MMC_STS_RX, 15U,
+		  &mmc->mmc_rx_1024_to_max_octets_gb },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief mgbe_read_mmc_err - Read Tx and Rx error counters
  *
- * @note
- *	1) MAC should be init and started. see osi_start_mac()
- *	2) osi_core->osd should be populated
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
  */
-void mgbe_reset_mmc(struct osi_core_priv_data *const osi_core)
+static void mgbe_read_mmc_err(struct osi_core_priv_data *const osi_core,
+			      struct mmc_sts *const sts)
 {
-	nveu32_t value;
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TXUNDERFLOWERROR_L, MMC_TXUNDERFLOWERROR_H, MMC_STS_TX, 13U,
+		  &mmc->mmc_tx_underflow_error },
+		{ MMC_TXSINGLECOL_G, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_singlecol_g },
+		{ MMC_TXMULTICOL_G, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_multicol_g },
+		{ MMC_TXDEFERRED, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_deferred },
+		{ MMC_TXLATECOL, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_latecol },
+		{ MMC_TXEXESSCOL, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_exesscol },
+		{ MMC_TXCARRIERERROR, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_carrier_error },
+		{ MMC_TXEXECESS_DEFERRED, 0U, MMC_STS_NONE, 0U,
+		  &mmc->mmc_tx_excessdef },
+		{ MMC_RXCRCERROR_L, MMC_RXCRCERROR_H, MMC_STS_RX, 5U,
+		  &mmc->mmc_rx_crc_error },
+		{ MMC_RXALIGNMENTERROR, 0U, MMC_STS_RX, 27U,
+		  &mmc->mmc_rx_align_error },
+		{ MMC_RXRUNTERROR, 0U, MMC_STS_RX, 6U,
+		  &mmc->mmc_rx_runt_error },
+		{ MMC_RXJABBERERROR, 0U, MMC_STS_RX, 7U,
+		  &mmc->mmc_rx_jabber_error },
+		{ MMC_RXLENGTHERROR_L, MMC_RXLENGTHERROR_H, MMC_STS_RX, 17U,
+		  &mmc->mmc_rx_length_error },
+		{ MMC_RXOUTOFRANGETYPE_L, MMC_RXOUTOFRANGETYPE_H, MMC_STS_RX, 18U,
+		  &mmc->mmc_rx_outofrangetype },
+		{ MMC_RXFIFOOVERFLOW_L, MMC_RXFIFOOVERFLOW_H, MMC_STS_RX, 20U,
+		  &mmc->mmc_rx_fifo_overflow },
+		{ MMC_RXWATCHDOGERROR, 0U, MMC_STS_RX, 22U,
+		  &mmc->mmc_rx_watchdog_error },
+	};
 
-	value = osi_readl((nveu8_t *)osi_core->base + MGBE_MMC_CNTRL);
-	/* self-clear bit in one clock cycle */
-	value |= MGBE_MMC_CNTRL_CNTRST;
-	osi_writel(value, (nveu8_t *)osi_core->base + MGBE_MMC_CNTRL);
-	osi_memset(&osi_core->mmc, 0U, sizeof(struct osi_mmc_counters));
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief mgbe_read_mmc_lpi - Read LPI counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void mgbe_read_mmc_lpi(struct osi_core_priv_data *const osi_core,
+			      struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TXLPIUSECCNTR, 0U, MMC_STS_TX, 18U,
+		  &mmc->mmc_tx_lpi_usec_cntr },
+		{ MMC_TXLPITRANCNTR, 0U, MMC_STS_TX, 19U,
+		  &mmc->mmc_tx_lpi_tran_cntr },
+		{ MMC_RXLPIUSECCNTR, 0U, MMC_STS_RX, 23U,
+		  &mmc->mmc_rx_lpi_usec_cntr },
+		{ MMC_RXLPITRANCNTR, 0U, MMC_STS_RX, 24U,
+		  &mmc->mmc_rx_lpi_tran_cntr },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief mgbe_read_mmc_fpe - Read frame preemption counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void mgbe_read_mmc_fpe(struct osi_core_priv_data *const osi_core,
+			      struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_TX_FPE_FRAG_COUNTER, 0U, MMC_STS_FPE_TX, 0U,
+		  &mmc->mmc_tx_fpe_frag_cnt },
+		{ MMC_TX_HOLD_REQ_COUNTER, 0U, MMC_STS_FPE_TX, 1U,
+		  &mmc->mmc_tx_fpe_hold_req_cnt },
+		{ MMC_RX_PKT_ASSEMBLY_ERR_CNTR, 0U, MMC_STS_FPE_RX, 0U,
+		  &mmc->mmc_rx_packet_reass_err_cnt },
+		{ MMC_RX_PKT_SMD_ERR_CNTR, 0U, MMC_STS_FPE_RX, 1U,
+		  &mmc->mmc_rx_packet_smd_err_cnt },
+		{ MMC_RX_PKT_ASSEMBLY_OK_CNTR, 0U, MMC_STS_FPE_RX, 2U,
+		  &mmc->mmc_rx_packet_asm_ok_cnt },
+		{ MMC_RX_FPE_FRAG_CNTR, 0U, MMC_STS_FPE_RX, 3U,
+		  &mmc->mmc_rx_fpe_fragment_cnt },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief mgbe_read_mmc_csum - Read Rx checksum offload counters
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in, out] sts: MMC interrupt status.
+ */
+static void mgbe_read_mmc_csum(struct osi_core_priv_data *const osi_core,
+			       struct mmc_sts *const sts)
+{
+	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	const struct mmc_cnt cnt[] = {
+		{ MMC_RXIPV4_GD_PKTS_L, MMC_RXIPV4_GD_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_gd },
+		{ MMC_RXIPV4_HDRERR_PKTS_L, MMC_RXIPV4_HDRERR_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_hderr },
+		{ MMC_RXIPV4_NOPAY_PKTS_L, MMC_RXIPV4_NOPAY_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_nopay },
+		{ MMC_RXIPV4_FRAG_PKTS_L, MMC_RXIPV4_FRAG_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_frag },
+		{ MMC_RXIPV4_UBSBL_PKTS_L, MMC_RXIPV4_UBSBL_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_udsbl },
+		{ MMC_RXIPV6_GD_PKTS_L, MMC_RXIPV6_GD_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv6_gd },
+		{ MMC_RXIPV6_HDRERR_PKTS_L, MMC_RXIPV6_HDRERR_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv6_hderr },
+		{ MMC_RXIPV6_NOPAY_PKTS_L, MMC_RXIPV6_NOPAY_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv6_nopay },
+		{ MMC_RXUDP_GD_PKTS_L, MMC_RXUDP_GD_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_udp_gd },
+		{ MMC_RXUDP_ERR_PKTS_L, MMC_RXUDP_ERR_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_udp_err },
+		{ MMC_RXTCP_GD_PKTS_L, MMC_RXTCP_GD_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_tcp_gd },
+		{ MMC_RXTCP_ERR_PKTS_L, MMC_RXTCP_ERR_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_tcp_err },
+		{ MMC_RXICMP_GD_PKTS_L, MMC_RXICMP_GD_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_icmp_gd },
+		{ MMC_RXICMP_ERR_PKTS_L, MMC_RXICMP_ERR_PKTS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_icmp_err },
+		{ MMC_RXIPV4_GD_OCTETS_L, MMC_RXIPV4_GD_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_gd_octets },
+		{ MMC_RXIPV4_HDRERR_OCTETS_L, MMC_RXIPV4_HDRERR_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_hderr_octets },
+		{ MMC_RXIPV4_NOPAY_OCTETS_L, MMC_RXIPV4_NOPAY_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_nopay_octets },
+		{ MMC_RXIPV4_FRAG_OCTETS_L, MMC_RXIPV4_FRAG_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_frag_octets },
+		{ MMC_RXIPV4_UDP_CHKSM_DIS_OCT_L, MMC_RXIPV4_UDP_CHKSM_DIS_OCT_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv4_udsbl_octets },
+		{ MMC_RXUDP_GD_OCTETS_L, MMC_RXUDP_GD_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_udp_gd_octets },
+		{ MMC_RXIPV6_GD_OCTETS_L, MMC_RXIPV6_GD_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv6_gd_octets },
+		{ MMC_RXIPV6_HDRERR_OCTETS_L, MMC_RXIPV6_HDRERR_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv6_hderr_octets },
+		{ MMC_RXIPV6_NOPAY_OCTETS_L, MMC_RXIPV6_NOPAY_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_ipv6_nopay_octets },
+		{ MMC_RXUDP_ERR_OCTETS_L, MMC_RXUDP_ERR_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_udp_err_octets },
+		{ MMC_RXTCP_GD_OCTETS_L, MMC_RXTCP_GD_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_tcp_gd_octets },
+		{ MMC_RXTCP_ERR_OCTETS_L, MMC_RXTCP_ERR_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_tcp_err_octets },
+		{ MMC_RXICMP_GD_OCTETS_L, MMC_RXICMP_GD_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_icmp_gd_octets },
+		{ MMC_RXICMP_ERR_OCTETS_L, MMC_RXICMP_ERR_OCTETS_H, MMC_STS_NONE, 0U,
+		  &mmc->mmc_rx_icmp_err_octets },
+	};
+
+	mmc_read_cnt(osi_core, cnt, (nveu32_t)(sizeof(cnt) / sizeof(cnt[0])),
+		     sts);
+}
+
+/**
+ * @brief mgbe_mmc_accumulate - Accumulate MMC counter groups
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ * @param[in] groups: Bitmap of OSI_MMC_GRP_* counter groups to read.
+ * @param[in] harvest: OSI_ENABLE to only read counters flagged in MMC
+ *	      interrupt status.
+ */
+static void mgbe_mmc_accumulate(struct osi_core_priv_data *const osi_core,
+				const nveu32_t groups,
+				const nveu32_t harvest)
+{
+	struct mmc_sts sts;
+
+	sts.reg = mgbe_mmc_sts_reg;
+	sts.read = 0U;
+	sts.harvest = harvest;
+
+	if ((groups & OSI_MMC_GRP_TX) != OSI_NONE) {
+		mgbe_read_mmc_tx(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_RX) != OSI_NONE) {
+		mgbe_read_mmc_rx(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_SIZE) != OSI_NONE) {
+		mgbe_read_mmc_size(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_ERR) != OSI_NONE) {
+		mgbe_read_mmc_err(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_LPI) != OSI_NONE) {
+		mgbe_read_mmc_lpi(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_FPE) != OSI_NONE) {
+		mgbe_read_mmc_fpe(osi_core, &sts);
+	}
+	if ((groups & OSI_MMC_GRP_CSUM) != OSI_NONE) {
+		mgbe_read_mmc_csum(osi_core, &sts);
+	}
 }
 
 /**
  * @brief mgbe_read_mmc - To read MMC registers and ether_mmc_counter structure
  *	   variable
  *
- * Algorithm: Pass register offset and old value to helper function and
- *	   update structure.
+ * Algorithm: For each counter group selected in groups, accumulate the
+ *	   lower and upper 32 bit registers of each counter into its 64 bit
+ *	   SW counter, see mmc_read_cnt().
  *
  * @param[in] osi_core: OSI core private data structure.
+ * @param[in] groups: Bitmap of OSI_MMC_GRP_* counter groups to read.
  *
  * @note
  *	1) MAC should be init and started. see osi_start_mac()
  *	2) osi_core->osd should be populated
  */
-void mgbe_read_mmc(struct osi_core_priv_data *const osi_core)
+void mgbe_read_mmc(struct osi_core_priv_data *const osi_core,
+		   const nveu32_t groups)
 {
-	struct osi_mmc_counters *mmc = &osi_core->mmc;
+	mgbe_mmc_accumulate(osi_core, groups, OSI_DISABLE);
+}
 
-	mmc->mmc_tx_octetcount_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_octetcount_gb,
-			       MMC_TXOCTETCOUNT_GB_L);
-	mmc->mmc_tx_octetcount_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_octetcount_gb_h,
-			       MMC_TXOCTETCOUNT_GB_H);
-	mmc->mmc_tx_framecount_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_framecount_gb,
-			       MMC_TXPACKETCOUNT_GB_L);
-	mmc->mmc_tx_framecount_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_framecount_gb_h,
-			       MMC_TXPACKETCOUNT_GB_H);
-	mmc->mmc_tx_broadcastframe_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_broadcastframe_g,
-			       MMC_TXBROADCASTPACKETS_G_L);
-	mmc->mmc_tx_broadcastframe_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_broadcastframe_g_h,
-			       MMC_TXBROADCASTPACKETS_G_H);
-	mmc->mmc_tx_multicastframe_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_multicastframe_g,
-			       MMC_TXMULTICASTPACKETS_G_L);
-	mmc->mmc_tx_multicastframe_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_multicastframe_g_h,
-			       MMC_TXMULTICASTPACKETS_G_H);
-	mmc->mmc_tx_64_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_64_octets_gb,
-			       MMC_TX64OCTETS_GB_L);
-	mmc->mmc_tx_64_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_64_octets_gb_h,
-			       MMC_TX64OCTETS_GB_H);
-	mmc->mmc_tx_65_to_127_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_65_to_127_octets_gb,
-			       MMC_TX65TO127OCTETS_GB_L);
-	mmc->mmc_tx_65_to_127_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_65_to_127_octets_gb_h,
-			       MMC_TX65TO127OCTETS_GB_H);
-	mmc->mmc_tx_128_to_255_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_128_to_255_octets_gb,
-			       MMC_TX128TO255OCTETS_GB_L);
-	mmc->mmc_tx_128_to_255_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_128_to_255_octets_gb_h,
-			       MMC_TX128TO255OCTETS_GB_H);
-	mmc->mmc_tx_256_to_511_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_256_to_511_octets_gb,
-			       MMC_TX256TO511OCTETS_GB_L);
-	mmc->mmc_tx_256_to_511_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_256_to_511_octets_gb_h,
-			       MMC_TX256TO511OCTETS_GB_H);
-	mmc->mmc_tx_512_to_1023_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_512_to_1023_octets_gb,
-			       MMC_TX512TO1023OCTETS_GB_L);
-	mmc->mmc_tx_512_to_1023_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_512_to_1023_octets_gb_h,
-			       MMC_TX512TO1023OCTETS_GB_H);
-	mmc->mmc_tx_1024_to_max_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_1024_to_max_octets_gb,
-			       MMC_TX1024TOMAXOCTETS_GB_L);
-	mmc->mmc_tx_1024_to_max_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_1024_to_max_octets_gb_h,
-			       MMC_TX1024TOMAXOCTETS_GB_H);
-	mmc->mmc_tx_unicast_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_unicast_gb,
-			       MMC_TXUNICASTPACKETS_GB_L);
-	mmc->mmc_tx_unicast_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_unicast_gb_h,
-			       MMC_TXUNICASTPACKETS_GB_H);
-	mmc->mmc_tx_multicast_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_multicast_gb,
-			       MMC_TXMULTICASTPACKETS_GB_L);
-	mmc->mmc_tx_multicast_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_multicast_gb_h,
-			       MMC_TXMULTICASTPACKETS_GB_H);
-	mmc->mmc_tx_broadcast_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_broadcast_gb,
-			       MMC_TXBROADCASTPACKETS_GB_L);
-	mmc->mmc_tx_broadcast_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_broadcast_gb_h,
-			       MMC_TXBROADCASTPACKETS_GB_H);
-	mmc->mmc_tx_underflow_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_underflow_error,
-			       MMC_TXUNDERFLOWERROR_L);
-	mmc->mmc_tx_underflow_error_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_underflow_error_h,
-			       MMC_TXUNDERFLOWERROR_H);
-	mmc->mmc_tx_singlecol_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_singlecol_g,
-			       MMC_TXSINGLECOL_G);
-	mmc->mmc_tx_multicol_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_multicol_g,
-			       MMC_TXMULTICOL_G);
-	mmc->mmc_tx_deferred =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_deferred,
-			       MMC_TXDEFERRED);
-	mmc->mmc_tx_latecol =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_latecol,
-			       MMC_TXLATECOL);
-	mmc->mmc_tx_exesscol =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_exesscol,
-			       MMC_TXEXESSCOL);
-	mmc->mmc_tx_carrier_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_carrier_error,
-			       MMC_TXCARRIERERROR);
-	mmc->mmc_tx_octetcount_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_octetcount_g,
-			       MMC_TXOCTETCOUNT_G_L);
-	mmc->mmc_tx_octetcount_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_octetcount_g_h,
-			       MMC_TXOCTETCOUNT_G_H);
-	mmc->mmc_tx_framecount_g =
-		 mgbe_update_mmc_val(osi_core, mmc->mmc_tx_framecount_g,
-				MMC_TXPACKETSCOUNT_G_L);
-	mmc->mmc_tx_framecount_g_h =
-		 mgbe_update_mmc_val(osi_core, mmc->mmc_tx_framecount_g_h,
-				MMC_TXPACKETSCOUNT_G_H);
-	mmc->mmc_tx_excessdef =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_excessdef,
-			       MMC_TXEXECESS_DEFERRED);
-	mmc->mmc_tx_pause_frame =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_pause_frame,
-			       MMC_TXPAUSEPACKETS_L);
-	mmc->mmc_tx_pause_frame_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_pause_frame_h,
-			       MMC_TXPAUSEPACKETS_H);
-	mmc->mmc_tx_vlan_frame_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_vlan_frame_g,
-			       MMC_TXVLANPACKETS_G_L);
-	mmc->mmc_tx_vlan_frame_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_vlan_frame_g_h,
-			       MMC_TXVLANPACKETS_G_H);
-	mmc->mmc_rx_framecount_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_framecount_gb,
-			       MMC_RXPACKETCOUNT_GB_L);
-	mmc->mmc_rx_framecount_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_framecount_gb_h,
-			       MMC_RXPACKETCOUNT_GB_H);
-	mmc->mmc_rx_octetcount_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_octetcount_gb,
-			       MMC_RXOCTETCOUNT_GB_L);
-	mmc->mmc_rx_octetcount_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_octetcount_gb_h,
-			       MMC_RXOCTETCOUNT_GB_H);
-	mmc->mmc_rx_octetcount_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_octetcount_g,
-			       MMC_RXOCTETCOUNT_G_L);
-	mmc->mmc_rx_octetcount_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_octetcount_g_h,
-			       MMC_RXOCTETCOUNT_G_H);
-	mmc->mmc_rx_broadcastframe_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_broadcastframe_g,
-			       MMC_RXBROADCASTPACKETS_G_L);
-	mmc->mmc_rx_broadcastframe_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_broadcastframe_g_h,
-			       MMC_RXBROADCASTPACKETS_G_H);
-	mmc->mmc_rx_multicastframe_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_multicastframe_g,
-			       MMC_RXMULTICASTPACKETS_G_L);
-	mmc->mmc_rx_multicastframe_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_multicastframe_g_h,
-			       MMC_RXMULTICASTPACKETS_G_H);
-	mmc->mmc_rx_crc_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_crc_error,
-			       MMC_RXCRCERROR_L);
-	mmc->mmc_rx_crc_error_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_crc_error_h,
-			       MMC_RXCRCERROR_H);
-	mmc->mmc_rx_align_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_align_error,
-			       MMC_RXALIGNMENTERROR);
-	mmc->mmc_rx_runt_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_runt_error,
-			       MMC_RXRUNTERROR);
-	mmc->mmc_rx_jabber_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_jabber_error,
-			       MMC_RXJABBERERROR);
-	mmc->mmc_rx_undersize_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_undersize_g,
-			       MMC_RXUNDERSIZE_G);
-	mmc->mmc_rx_oversize_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_oversize_g,
-			       MMC_RXOVERSIZE_G);
-	mmc->mmc_rx_64_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_64_octets_gb,
-			       MMC_RX64OCTETS_GB_L);
-	mmc->mmc_rx_64_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_64_octets_gb_h,
-			       MMC_RX64OCTETS_GB_H);
-	mmc->mmc_rx_65_to_127_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_65_to_127_octets_gb,
-			       MMC_RX65TO127OCTETS_GB_L);
-	mmc->mmc_rx_65_to_127_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_65_to_127_octets_gb_h,
-			       MMC_RX65TO127OCTETS_GB_H);
-	mmc->mmc_rx_128_to_255_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_128_to_255_octets_gb,
-			       MMC_RX128TO255OCTETS_GB_L);
-	mmc->mmc_rx_128_to_255_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_128_to_255_octets_gb_h,
-			       MMC_RX128TO255OCTETS_GB_H);
-	mmc->mmc_rx_256_to_511_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_256_to_511_octets_gb,
-			       MMC_RX256TO511OCTETS_GB_L);
-	mmc->mmc_rx_256_to_511_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_256_to_511_octets_gb_h,
-			       MMC_RX256TO511OCTETS_GB_H);
-	mmc->mmc_rx_512_to_1023_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_512_to_1023_octets_gb,
-			       MMC_RX512TO1023OCTETS_GB_L);
-	mmc->mmc_rx_512_to_1023_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_512_to_1023_octets_gb_h,
-			       MMC_RX512TO1023OCTETS_GB_H);
-	mmc->mmc_rx_1024_to_max_octets_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_1024_to_max_octets_gb,
-			       MMC_RX1024TOMAXOCTETS_GB_L);
-	mmc->mmc_rx_1024_to_max_octets_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_1024_to_max_octets_gb_h,
-			       MMC_RX1024TOMAXOCTETS_GB_H);
-	mmc->mmc_rx_unicast_g =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_unicast_g,
-			       MMC_RXUNICASTPACKETS_G_L);
-	mmc->mmc_rx_unicast_g_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_unicast_g_h,
-			       MMC_RXUNICASTPACKETS_G_H);
-	mmc->mmc_rx_length_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_length_error,
-			       MMC_RXLENGTHERROR_L);
-	mmc->mmc_rx_length_error_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_length_error_h,
-			       MMC_RXLENGTHERROR_H);
-	mmc->mmc_rx_outofrangetype =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_outofrangetype,
-			       MMC_RXOUTOFRANGETYPE_L);
-	mmc->mmc_rx_outofrangetype_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_outofrangetype_h,
-			       MMC_RXOUTOFRANGETYPE_H);
-	mmc->mmc_rx_pause_frames =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_pause_frames,
-			       MMC_RXPAUSEPACKETS_L);
-	mmc->mmc_rx_pause_frames_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_pause_frames_h,
-			       MMC_RXPAUSEPACKETS_H);
-	mmc->mmc_rx_fifo_overflow =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_fifo_overflow,
-			       MMC_RXFIFOOVERFLOW_L);
-	mmc->mmc_rx_fifo_overflow_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_fifo_overflow_h,
-			       MMC_RXFIFOOVERFLOW_H);
-	mmc->mmc_rx_vlan_frames_gb =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_vlan_frames_gb,
-			       MMC_RXVLANPACKETS_GB_L);
-	mmc->mmc_rx_vlan_frames_gb_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_vlan_frames_gb_h,
-			       MMC_RXVLANPACKETS_GB_H);
-	mmc->mmc_rx_watchdog_error =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_watchdog_error,
-			       MMC_RXWATCHDOGERROR);
-	mmc->mmc_tx_lpi_usec_cntr =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_lpi_usec_cntr,
-			       MMC_TXLPIUSECCNTR);
-	mmc->mmc_tx_lpi_tran_cntr =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_lpi_tran_cntr,
-			       MMC_TXLPITRANCNTR);
-	mmc->mmc_rx_lpi_usec_cntr =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_lpi_usec_cntr,
-			       MMC_RXLPIUSECCNTR);
-	mmc->mmc_rx_lpi_tran_cntr =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_lpi_tran_cntr,
-			       MMC_RXLPITRANCNTR);
-	mmc->mmc_rx_ipv4_gd =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_gd,
-			       MMC_RXIPV4_GD_PKTS_L);
-	mmc->mmc_rx_ipv4_gd_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_gd_h,
-			       MMC_RXIPV4_GD_PKTS_H);
-	mmc->mmc_rx_ipv4_hderr =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_hderr,
-			       MMC_RXIPV4_HDRERR_PKTS_L);
-	mmc->mmc_rx_ipv4_hderr_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_hderr_h,
-			       MMC_RXIPV4_HDRERR_PKTS_H);
-	mmc->mmc_rx_ipv4_nopay =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_nopay,
-			       MMC_RXIPV4_NOPAY_PKTS_L);
-	mmc->mmc_rx_ipv4_nopay_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_nopay_h,
-			       MMC_RXIPV4_NOPAY_PKTS_H);
-	mmc->mmc_rx_ipv4_frag =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_frag,
-			       MMC_RXIPV4_FRAG_PKTS_L);
-	mmc->mmc_rx_ipv4_frag_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_frag_h,
-			       MMC_RXIPV4_FRAG_PKTS_H);
-	mmc->mmc_rx_ipv4_udsbl =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_udsbl,
-			       MMC_RXIPV4_UBSBL_PKTS_L);
-	mmc->mmc_rx_ipv4_udsbl_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_udsbl_h,
-			       MMC_RXIPV4_UBSBL_PKTS_H);
-	mmc->mmc_rx_ipv6_gd =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_gd,
-			       MMC_RXIPV6_GD_PKTS_L);
-	mmc->mmc_rx_ipv6_gd_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_gd_h,
-			       MMC_RXIPV6_GD_PKTS_H);
-	mmc->mmc_rx_ipv6_hderr =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_hderr,
-			       MMC_RXIPV6_HDRERR_PKTS_L);
-	mmc->mmc_rx_ipv6_hderr_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_hderr_h,
-			       MMC_RXIPV6_HDRERR_PKTS_H);
-	mmc->mmc_rx_ipv6_nopay =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_nopay,
-			       MMC_RXIPV6_NOPAY_PKTS_L);
-	mmc->mmc_rx_ipv6_nopay_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_nopay_h,
-			       MMC_RXIPV6_NOPAY_PKTS_H);
-	mmc->mmc_rx_udp_gd =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_gd,
-			       MMC_RXUDP_GD_PKTS_L);
-	mmc->mmc_rx_udp_gd_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_gd_h,
-			       MMC_RXUDP_GD_PKTS_H);
-	mmc->mmc_rx_udp_err =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_err,
-			       MMC_RXUDP_ERR_PKTS_L);
-	mmc->mmc_rx_udp_err_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_err_h,
-			       MMC_RXUDP_ERR_PKTS_H);
-	mmc->mmc_rx_tcp_gd =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_gd,
-			       MMC_RXTCP_GD_PKTS_L);
-	mmc->mmc_rx_tcp_gd_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_gd_h,
-			       MMC_RXTCP_GD_PKTS_H);
-	mmc->mmc_rx_tcp_err =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_err,
-			       MMC_RXTCP_ERR_PKTS_L);
-	mmc->mmc_rx_tcp_err_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_err_h,
-			       MMC_RXTCP_ERR_PKTS_H);
-	mmc->mmc_rx_icmp_gd =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_gd,
-			       MMC_RXICMP_GD_PKTS_L);
-	mmc->mmc_rx_icmp_gd_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_gd_h,
-			       MMC_RXICMP_GD_PKTS_H);
-	mmc->mmc_rx_icmp_err =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_err,
-			       MMC_RXICMP_ERR_PKTS_L);
-	mmc->mmc_rx_icmp_err_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_err_h,
-			       MMC_RXICMP_ERR_PKTS_H);
-	mmc->mmc_rx_ipv4_gd_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_gd_octets,
-			       MMC_RXIPV4_GD_OCTETS_L);
-	mmc->mmc_rx_ipv4_gd_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_gd_octets_h,
-			       MMC_RXIPV4_GD_OCTETS_H);
-	mmc->mmc_rx_ipv4_hderr_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_hderr_octets,
-			       MMC_RXIPV4_HDRERR_OCTETS_L);
-	mmc->mmc_rx_ipv4_hderr_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_hderr_octets_h,
-			       MMC_RXIPV4_HDRERR_OCTETS_H);
-	mmc->mmc_rx_ipv4_nopay_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_nopay_octets,
-			       MMC_RXIPV4_NOPAY_OCTETS_L);
-	mmc->mmc_rx_ipv4_nopay_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_nopay_octets_h,
-			       MMC_RXIPV4_NOPAY_OCTETS_H);
-	mmc->mmc_rx_ipv4_frag_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_frag_octets,
-			       MMC_RXIPV4_FRAG_OCTETS_L);
-	mmc->mmc_rx_ipv4_frag_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_frag_octets_h,
-			       MMC_RXIPV4_FRAG_OCTETS_H);
-	mmc->mmc_rx_ipv4_udsbl_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_udsbl_octets,
-			       MMC_RXIPV4_UDP_CHKSM_DIS_OCT_L);
-	mmc->mmc_rx_ipv4_udsbl_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv4_udsbl_octets_h,
-			       MMC_RXIPV4_UDP_CHKSM_DIS_OCT_H);
-	mmc->mmc_rx_udp_gd_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_gd_octets,
-			       MMC_RXUDP_GD_OCTETS_L);
-	mmc->mmc_rx_udp_gd_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_gd_octets_h,
-			       MMC_RXUDP_GD_OCTETS_H);
-	mmc->mmc_rx_ipv6_gd_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_gd_octets,
-			       MMC_RXIPV6_GD_OCTETS_L);
-	mmc->mmc_rx_ipv6_gd_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_gd_octets_h,
-			       MMC_RXIPV6_GD_OCTETS_H);
-	mmc->mmc_rx_ipv6_hderr_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_hderr_octets,
-			       MMC_RXIPV6_HDRERR_OCTETS_L);
-	mmc->mmc_rx_ipv6_hderr_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_hderr_octets_h,
-			       MMC_RXIPV6_HDRERR_OCTETS_H);
-	mmc->mmc_rx_ipv6_nopay_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_nopay_octets,
-			       MMC_RXIPV6_NOPAY_OCTETS_L);
-	mmc->mmc_rx_ipv6_nopay_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_ipv6_nopay_octets_h,
-			       MMC_RXIPV6_NOPAY_OCTETS_H);
-	mmc->mmc_rx_udp_err_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_err_octets,
-			       MMC_RXUDP_ERR_OCTETS_L);
-	mmc->mmc_rx_udp_err_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_udp_err_octets_h,
-			       MMC_RXUDP_ERR_OCTETS_H);
-	mmc->mmc_rx_tcp_gd_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_gd_octets,
-			       MMC_RXTCP_GD_OCTETS_L);
-	mmc->mmc_rx_tcp_gd_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_gd_octets_h,
-			       MMC_RXTCP_GD_OCTETS_H);
-	mmc->mmc_rx_tcp_err_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_err_octets,
-			       MMC_RXTCP_ERR_OCTETS_L);
-	mmc->mmc_rx_tcp_err_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_tcp_err_octets_h,
-			       MMC_RXTCP_ERR_OCTETS_H);
-	mmc->mmc_rx_icmp_gd_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_gd_octets,
-			       MMC_RXICMP_GD_OCTETS_L);
-	mmc->mmc_rx_icmp_gd_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_gd_octets_h,
-			       MMC_RXICMP_GD_OCTETS_H);
-	mmc->mmc_rx_icmp_err_octets =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_err_octets,
-			       MMC_RXICMP_ERR_OCTETS_L);
-	mmc->mmc_rx_icmp_err_octets_h =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_icmp_err_octets_h,
-			       MMC_RXICMP_ERR_OCTETS_H);
-	mmc->mmc_tx_fpe_frag_cnt =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_fpe_frag_cnt,
-			       MMC_TX_FPE_FRAG_COUNTER);
-	mmc->mmc_tx_fpe_hold_req_cnt =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_tx_fpe_hold_req_cnt,
-			       MMC_TX_HOLD_REQ_COUNTER);
-	mmc->mmc_rx_packet_reass_err_cnt =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_packet_reass_err_cnt,
-			       MMC_RX_PKT_ASSEMBLY_ERR_CNTR);
-	mmc->mmc_rx_packet_smd_err_cnt =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_packet_smd_err_cnt,
-			       MMC_RX_PKT_SMD_ERR_CNTR);
-	mmc->mmc_rx_packet_asm_ok_cnt =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_packet_asm_ok_cnt,
-			       MMC_RX_PKT_ASSEMBLY_OK_CNTR);
-	mmc->mmc_rx_fpe_fragment_cnt =
-		mgbe_update_mmc_val(osi_core, mmc->mmc_rx_fpe_fragment_cnt,
-			       MMC_RX_FPE_FRAG_CNTR);
+/**
+ * @brief mgbe_mmc_harvest - Harvest MMC counters from MMC interrupt
+ *
+ * Algorithm: Read the MMC interrupt status registers and accumulate only
+ *	the counters whose half or maximum value status bit is set. Reading
+ *	a counter clears its status bit.
+ *
+ * @param[in, out] osi_core: OSI core private data structure.
+ *
+ * @note MMC interrupts need to be enabled
+ */
+void mgbe_mmc_harvest(struct osi_core_priv_data *const osi_core)
+{
+	mgbe_mmc_accumulate(osi_core, OSI_MMC_GRP_ALL, OSI_ENABLE);
 }
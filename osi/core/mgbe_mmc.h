@@ -29,6 +29,10 @@
  * @brief MMC HW register offsets
  * @{
  */
+#define MMC_RX_INTR			0x00804
+#define MMC_TX_INTR			0x00808
+#define MMC_FPE_TX_INTR			0x00A00
+#define MMC_FPE_RX_INTR			0x00A20
 #define MMC_TXOCTETCOUNT_GB_L		0x00814
 #define MMC_TXOCTETCOUNT_GB_H		0x00818
 #define MMC_TXPACKETCOUNT_GB_L		0x0081C
@@ -187,16 +191,19 @@
  * @brief mgbe_read_mmc - To read MMC registers and ether_mmc_counter structure
  *	   variable
  *
- * Algorithm: Pass register offset and old value to helper function and
- *	   update structure.
+ * Algorithm: For each counter group selected in groups, accumulate the
+ *	   lower and upper 32 bit registers of each counter into its 64 bit
+ *	   SW counter, see mmc_read_cnt().
  *
  * @param[in] osi_core: OSI core private data structure.
+ * @param[in] groups: Bitmap of OSI_MMC_GRP_* counter groups to read.
  *
  * @note
  *	1) MAC should be init and started. see osi_start_mac()
  *	2) osi_core->osd should be populated
  */
-void mgbe_read_mmc(struct osi_core_priv_data *const osi_core);
+void mgbe_read_mmc(struct osi_core_priv_data *const osi_core,
+		   const nveu32_t groups);
 
 /**
  * @brief mgbe_reset_mmc - To reset MMC registers and ether_mmc_counter
@@ -209,4 +216,16 @@ void mgbe_read_mmc(struct osi_core_priv_data *const osi_core);
  *	2) osi_core->osd should be populated
  */
 void mgbe_reset_mmc(struct osi_core_priv_data *const osi_core);
+
+/**
+ * @brief mgbe_mmc_harvest - Harvest MMC counters from MMC interrupt
+ *
+ * Algorithm: Accumulate only the counters whose half or maximum value
+ *	  bit is set in MMC interrupt status.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @note MMC interrupts need to be enabled
+ */
+void mgbe_mmc_harvest(struct osi_core_priv_data *const osi_core);
 #endif
@@ -288,10 +288,283 @@ fail:
 	return ret;
 }
 
+#ifndef OSI_STRIPPED_LIB
+nveu64_t lat_start(struct osi_core_priv_data *const osi_core)
+{
+	nveu64_t now = 0U;
+
+	if ((osi_core != OSI_NULL) &&
+	    (osi_core->osd_ops.get_time_ns != OSI_NULL)) {
+		now = osi_core->osd_ops.get_time_ns(osi_core->osd);
+	}
+
+	return now;
+}
+
+void lat_end(struct osi_core_priv_data *const osi_core, const nveu32_t idx,
+	     const nveu64_t start, const nve32_t ret)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_lat_stats *st;
+	nveu64_t lat;
+	nveu32_t b = 0U;
+
+	if ((osi_core != OSI_NULL) && (idx < OSI_LAT_MAX)) {
+		st = &l_core->lat_stats[idx];
+		st->calls = osi_update_stats_counter(st->calls, 1UL);
+		if (ret < 0) {
+			st->fails = osi_update_stats_counter(st->fails, 1UL);
+		}
+
+		if (osi_core->osd_ops.get_time_ns != OSI_NULL) {
+			lat = osi_core->osd_ops.get_time_ns(osi_core->osd);
+			lat = (lat > start) ? (lat - start) : 0U;
+			/* Bucket n holds [2^n, 2^(n+1)) nsec */
+			while ((lat > 1U) && (b < (OSI_LAT_HIST_CNT - 1U))) {
+				lat >>= 1U;
+				b++;
+			}
+
+			st->hist[b] = osi_update_stats_counter(st->hist[b],
+							       1UL);
+		}
+	}
+}
+
+/**
+ * @brief lat_stats_read - Copy out call statistics of one command.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: Ioctl data, arg1_u32 selects the statistics,
+ *		   arg2_u32 clears them after read.
+ *
+ * @retval 0 on success
+ * @retval -1 on invalid arguments.
+ */
+static nve32_t lat_stats_read(struct osi_core_priv_data *const osi_core,
+			      struct osi_ioctl *data)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nve32_t ret = -1;
+
+	if ((data->arg1_u32 >= OSI_LAT_MAX) || (data->lat_stats == OSI_NULL)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Invalid latency stats arguments\n",
+			     (nveul64_t)data->arg1_u32);
+		goto fail;
+	}
+
+	(void)osi_memcpy(data->lat_stats, &l_core->lat_stats[data->arg1_u32],
+			 sizeof(struct osi_lat_stats));
+	if (data->arg2_u32 == OSI_ENABLE) {
+		osi_memset(&l_core->lat_stats[data->arg1_u32], 0U,
+			   sizeof(struct osi_lat_stats));
+	}
+
+	ret = 0;
+fail:
+	return ret;
+}
+
+/**
+ * @brief stats_snap_read - Copy out a coherent snapshot of statistics.
+ *
+ * Algorithm: Copy stats and mmc while no update is in progress and retry
+ * the copy if an update started meanwhile. Updates are never blocked.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: Ioctl data with stats_snap output buffer.
+ *
+ * @retval 0 on success
+ * @retval -1 on invalid arguments or if updates never paused.
+ */
+static nve32_t stats_snap_read(struct osi_core_priv_data *const osi_core,
+			       struct osi_ioctl *data)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_core_stats_snap *snap = data->stats_snap;
+	nveu32_t retry;
+	nveu32_t gen = 0U;
+	nve32_t ret = -1;
+
+	if (snap == OSI_NULL) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Invalid stats snapshot buffer\n", 0ULL);
+		goto fail;
+	}
+
+	for (retry = 0U; retry < OSI_STATS_SNAP_RETRY; retry++) {
+		if (osi_stats_read_begin(&l_core->stats_seq, &gen) !=
+		    OSI_ENABLE) {
+			continue;
+		}
+
+		(void)osi_memcpy(&snap->stats, &osi_core->stats,
+				 sizeof(struct osi_stats));
+		(void)osi_memcpy(&snap->mmc, &osi_core->mmc,
+				 sizeof(struct osi_mmc_counters));
+
+		if (osi_stats_read_done(&l_core->stats_seq, gen) ==
+		    OSI_ENABLE) {
+			snap->gen = gen;
+			ret = 0;
+			break;
+		}
+	}
+
+	if (ret < 0) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			     "Stats snapshot raced with updates\n",
+			     (nveul64_t)OSI_STATS_SNAP_RETRY);
+	}
+fail:
+	return ret;
+}
+
+void stats_page_publish(struct osi_core_priv_data *const osi_core)
+{
+	struct osi_stats_page *page = osi_core->stats_page;
+	volatile nveu32_t *seq;
+
+	if ((page == OSI_NULL) ||
+	    (osi_core->use_virtualization != OSI_DISABLE)) {
+		goto done;
+	}
+
+	seq = &page->seq;
+	*seq = ((*seq + 1U) | 1U);
+	__sync_synchronize();
+
+	(void)osi_memcpy(&page->mmc, &osi_core->mmc,
+			 sizeof(struct osi_mmc_counters));
+	(void)osi_memcpy(&page->stats, &osi_core->stats,
+			 sizeof(struct osi_stats));
+#ifdef MACSEC_SUPPORT
+	(void)osi_memcpy(&page->macsec_mmc, &osi_core->macsec_mmc,
+			 sizeof(struct osi_macsec_mmc_counters));
+	(void)osi_memcpy(&page->macsec_irq_stats, &osi_core->macsec_irq_stats,
+			 sizeof(struct osi_macsec_irq_stats));
+#endif /* MACSEC_SUPPORT */
+
+	__sync_synchronize();
+	*seq = (*seq + 1U);
+done:
+	return;
+}
+
+nve32_t stats_page_read(struct osi_core_priv_data *const osi_core,
+			const nveu32_t macsec)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct osi_stats_page *page = osi_core->stats_page;
+	/* Page is mapped read-only, so only plain loads are done on it */
+	const volatile nveu32_t *seq = &page->seq;
+	nveu32_t *last = (macsec == OSI_DISABLE) ? &l_core->stats_page_gen :
+			 &l_core->stats_page_gen_macsec;
+	nveu32_t retry;
+	nveu32_t gen;
+	nve32_t ret = -1;
+
+	gen = *seq;
+	if (gen == *last) {
+		/* Not published since last read, counters may be stale */
+		goto done;
+	}
+
+	osi_stats_write_begin(&l_core->stats_seq);
+	for (retry = 0U; retry < OSI_STATS_SNAP_RETRY; retry++) {
+		gen = *seq;
+		if ((gen & 1U) != 0U) {
+			continue;
+		}
+		__sync_synchronize();
+
+		if (macsec == OSI_DISABLE) {
+			(void)osi_memcpy(&osi_core->mmc, &page->mmc,
+					 sizeof(struct osi_mmc_counters));
+			(void)osi_memcpy(&osi_core->stats, &page->stats,
+					 sizeof(struct osi_stats));
+		} else {
+#ifdef MACSEC_SUPPORT
+			(void)osi_memcpy(&osi_core->macsec_mmc,
+					 &page->macsec_mmc,
+					 sizeof(struct osi_macsec_mmc_counters));
+			(void)osi_memcpy(&osi_core->macsec_irq_stats,
+					 &page->macsec_irq_stats,
+					 sizeof(struct osi_macsec_irq_stats));
+#endif /* MACSEC_SUPPORT */
+		}
+
+		__sync_synchronize();
+		if (*seq == gen) {
+			*last = gen;
+			ret = 0;
+			break;
+		}
+	}
+	osi_stats_write_end(&l_core->stats_seq);
+
+	if (ret < 0) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			     "Stats page raced with server updates\n",
+			     (nveul64_t)OSI_STATS_SNAP_RETRY);
+	}
+done:
+	return ret;
+}
+
+/**
+ * @brief stats_page_cmd - Check if a command uses the stats page.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] cmd: OSI_CMD_* command.
+ *
+ * @retval OSI_ENABLE if a server has to publish after the command or a
+ *	   guest serves the command from the page
+ * @retval OSI_DISABLE otherwise
+ */
+static nveu32_t stats_page_cmd(struct osi_core_priv_data *const osi_core,
+			       const nveu32_t cmd)
+{
+	nveu32_t ret = OSI_DISABLE;
+
+	if (osi_core->stats_page == OSI_NULL) {
+		goto done;
+	}
+
+	switch (cmd) {
+	case OSI_CMD_READ_MMC:
+	case OSI_CMD_READ_MMC_GRP:
+		ret = OSI_ENABLE;
+		break;
+	case OSI_CMD_READ_STATS:
+		/* Server keeps stats locally, only guests read them */
+		ret = (osi_core->use_virtualization != OSI_DISABLE) ?
+		      OSI_ENABLE : OSI_DISABLE;
+		break;
+	case OSI_CMD_COMMON_ISR:
+	case OSI_CMD_RESET_MMC:
+		/* Guests still forward these to the server */
+		ret = (osi_core->use_virtualization == OSI_DISABLE) ?
+		      OSI_ENABLE : OSI_DISABLE;
+		break;
+	default:
+		/* Command doesn't touch published statistics */
+		break;
+	}
+done:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
+
 nve32_t osi_handle_ioctl(struct osi_core_priv_data *osi_core,
 			 struct osi_ioctl *data)
 {
 	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+#ifndef OSI_STRIPPED_LIB
+	nveu32_t cmd;
+	nveu64_t start;
+#endif /* !OSI_STRIPPED_LIB */
 	nve32_t ret = -1;
 
 	if (validate_if_args(osi_core, l_core) < 0) {
@@ -304,7 +577,303 @@ nve32_t osi_handle_ioctl(struct osi_core_priv_data *osi_core,
 		goto fail;
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	/* Statistics are kept locally, also with virtualization */
+	if (data->cmd == OSI_CMD_LAT_STATS) {
+		ret = lat_stats_read(osi_core, data);
+		goto fail;
+	}
+
+	if (data->cmd == OSI_CMD_STATS_SNAPSHOT) {
+		ret = stats_snap_read(osi_core, data);
+		goto fail;
+	}
+
+	cmd = data->cmd;
+	start = lat_start(osi_core);
+	if (stats_page_cmd(osi_core, cmd) == OSI_DISABLE) {
+		ret = l_core->if_ops_p->if_handle_ioctl(osi_core, data);
+	} else if (osi_core->use_virtualization != OSI_DISABLE) {
+		/* Published by the server, no IVC message needed unless the
+		 * page wasn't updated since the last read */
+		ret = stats_page_read(osi_core, OSI_DISABLE);
+		if (ret < 0) {
+			ret = l_core->if_ops_p->if_handle_ioctl(osi_core, data);
+		}
+	} else {
+		ret = l_core->if_ops_p->if_handle_ioctl(osi_core, data);
+		if (ret == 0) {
+			stats_page_publish(osi_core);
+		}
+	}
+	if (cmd < OSI_LAT_CMD_CNT) {
+		lat_end(osi_core, cmd, start, ret);
+	}
+#else
 	ret = l_core->if_ops_p->if_handle_ioctl(osi_core, data);
+#endif /* !OSI_STRIPPED_LIB */
+fail:
+	return ret;
+}
+
+#ifndef OSI_STRIPPED_LIB
+nve32_t osi_handle_ioctl_batch(struct osi_core_priv_data *osi_core,
+			       struct osi_ioctl *data, nve32_t *status,
+			       const nveu32_t num)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nve32_t ret = -1;
+
+	if (validate_if_args(osi_core, l_core) < 0) {
+		goto fail;
+	}
+
+	if ((data == OSI_NULL) || (status == OSI_NULL) || (num == 0U)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "CORE: Invalid batch argument\n", (nveul64_t)num);
+		goto fail;
+	}
+
+	ret = l_core->if_ops_p->if_handle_ioctl_batch(osi_core, data, status,
+						      num);
+fail:
+	return ret;
+}
+
+/**
+ * @brief ioctl_req_find - Find entry of a submitted command.
+ *
+ * @param[in] l_core: Core local private data structure.
+ * @param[in] req_id: Request ID, 0 to find a free entry.
+ *
+ * @return Entry, OSI_NULL if not found.
+ */
+static struct ioctl_req *ioctl_req_find(struct core_local *const l_core,
+					const nveu32_t req_id)
+{
+	struct ioctl_req *req = OSI_NULL;
+	nveu32_t i;
+
+	for (i = 0U; i < OSI_IOCTL_MAX_PENDING; i++) {
+		if (l_core->ioctl_req[i].id == req_id) {
+			req = &l_core->ioctl_req[i];
+			break;
+		}
+	}
+
+	return req;
+}
+
+struct osi_ioctl *ioctl_req_data(struct osi_core_priv_data *const osi_core,
+				 const nveu32_t req_id)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct ioctl_req *req = OSI_NULL;
+	struct osi_ioctl *data = OSI_NULL;
+
+	if (req_id != 0U) {
+		req = ioctl_req_find(l_core, req_id);
+	}
+
+	if ((req != OSI_NULL) && (req->state == OSI_ASYNC_PENDING)) {
+		data = req->data;
+	}
+
+	return data;
+}
+
+void ioctl_req_done(struct osi_core_priv_data *const osi_core,
+		    const nveu32_t req_id, const nve32_t status)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct ioctl_req *req = OSI_NULL;
+
+	if (req_id != 0U) {
+		req = ioctl_req_find(l_core, req_id);
+	}
+
+	if ((req != OSI_NULL) && (req->state == OSI_ASYNC_PENDING)) {
+		req->status = status;
+		req->state = OSI_ASYNC_DONE;
+	}
+}
+
+nve32_t osi_ioctl_submit(struct osi_core_priv_data *osi_core,
+			 struct osi_ioctl *data, nveu32_t *req_id)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct ioctl_req *req;
+	nve32_t ret = -1;
+
+	if (validate_if_args(osi_core, l_core) < 0) {
+		goto fail;
+	}
+
+	if ((data == OSI_NULL) || (req_id == OSI_NULL)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "CORE: Invalid argument\n", 0ULL);
+		goto fail;
+	}
+
+	req = ioctl_req_find(l_core, 0U);
+	if (req == OSI_NULL) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OUTOFBOUND,
+			     "CORE: Too many pending ioctls\n",
+			     (nveul64_t)OSI_IOCTL_MAX_PENDING);
+		goto fail;
+	}
+
+	/* Request ID 0 marks free entries, skip it on wrap around */
+	l_core->ioctl_req_id++;
+	if (l_core->ioctl_req_id == 0U) {
+		l_core->ioctl_req_id++;
+	}
+
+	req->id = l_core->ioctl_req_id;
+	req->state = OSI_ASYNC_PENDING;
+	req->data = data;
+	req->status = -1;
+
+	ret = l_core->if_ops_p->if_ioctl_submit(osi_core, data, req->id);
+	if (ret < 0) {
+		req->id = 0U;
+		req->state = OSI_ASYNC_IDLE;
+		goto fail;
+	}
+
+	*req_id = req->id;
+fail:
+	return ret;
+}
+
+nve32_t osi_ioctl_complete(struct osi_core_priv_data *osi_core,
+			   struct ivc_msg_common *reply)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nve32_t ret = -1;
+
+	if (validate_if_args(osi_core, l_core) < 0) {
+		goto fail;
+	}
+
+	if (reply == OSI_NULL) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "CORE: Invalid argument\n", 0ULL);
+		goto fail;
+	}
+
+	ret = l_core->if_ops_p->if_ioctl_complete(osi_core, reply);
+fail:
+	return ret;
+}
+
+nve32_t osi_ioctl_result(struct osi_core_priv_data *osi_core,
+			 const nveu32_t req_id, nveu32_t *state,
+			 nve32_t *status)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct ioctl_req *req = OSI_NULL;
+	nve32_t ret = -1;
+
+	if ((validate_if_args(osi_core, l_core) < 0) || (state == OSI_NULL) ||
+	    (status == OSI_NULL)) {
+		goto fail;
+	}
+
+	if (req_id != 0U) {
+		req = ioctl_req_find(l_core, req_id);
+	}
+
+	if (req == OSI_NULL) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "CORE: Unknown ioctl request ID\n",
+			     (nveul64_t)req_id);
+		goto fail;
+	}
+
+	*state = req->state;
+	if (req->state == OSI_ASYNC_DONE) {
+		*status = req->status;
+		req->id = 0U;
+		req->state = OSI_ASYNC_IDLE;
+	}
+
+	ret = 0;
+fail:
+	return ret;
+}
+
+nve32_t osi_vm_irq_remap_hint(struct osi_core_priv_data *const osi_core,
+			      const nveu64_t *const irq_cnt, nveu32_t *chan,
+			      nveu32_t *irq_idx)
+{
+	nveu64_t load[OSI_MAX_VM_IRQS];
+	const struct osi_vm_irq_data *irq;
+	nveu64_t diff, cnt, gain;
+	nveu64_t best_gain = 0U;
+	nveu32_t hi = 0U, lo = 0U;
+	nveu32_t i, j, c;
+	nve32_t ret = -1;
+
+	if ((osi_core == OSI_NULL) || (irq_cnt == OSI_NULL) ||
+	    (chan == OSI_NULL) || (irq_idx == OSI_NULL) ||
+	    (osi_core->num_vm_irqs > OSI_MAX_VM_IRQS)) {
+		goto fail;
+	}
+
+	for (i = 0U; i < osi_core->num_vm_irqs; i++) {
+		irq = &osi_core->irq_data[i];
+		load[i] = 0U;
+		for (j = 0U; (j < irq->num_vm_chans) &&
+		     (j < OSI_MGBE_MAX_NUM_CHANS); j++) {
+			c = irq->vm_chans[j];
+			if (c < OSI_MGBE_MAX_NUM_CHANS) {
+				load[i] += irq_cnt[c];
+			}
+		}
+
+		if (load[i] > load[hi]) {
+			hi = i;
+		}
+		if (load[i] < load[lo]) {
+			lo = i;
+		}
+	}
+
+	if (osi_core->num_vm_irqs < 2U) {
+		goto fail;
+	}
+
+	diff = load[hi] - load[lo];
+	if ((diff == 0U) || (diff < (load[hi] / OSI_VM_IRQ_IMBAL_DIV))) {
+		/* Balanced enough, avoid moving channels back and forth */
+		goto fail;
+	}
+
+	irq = &osi_core->irq_data[hi];
+	for (j = 0U; (j < irq->num_vm_chans) && (j < OSI_MGBE_MAX_NUM_CHANS);
+	     j++) {
+		c = irq->vm_chans[j];
+		if (c >= OSI_MGBE_MAX_NUM_CHANS) {
+			continue;
+		}
+
+		/* Moving cnt lowers the busiest load only if cnt < diff,
+		 * the best move splits diff evenly */
+		cnt = irq_cnt[c];
+		if ((cnt == 0U) || (cnt >= diff)) {
+			continue;
+		}
+
+		gain = (cnt < (diff - cnt)) ? cnt : (diff - cnt);
+		if (gain > best_gain) {
+			best_gain = gain;
+			*chan = c;
+			*irq_idx = lo;
+			ret = 0;
+		}
+	}
 fail:
 	return ret;
 }
+#endif /* !OSI_STRIPPED_LIB */
@@ -28,6 +28,9 @@
 #include "eqos_core.h"
 #include "mgbe_core.h"
 #include "frp.h"
+#include "l3l4_mgr.h"
+#include "flow_steer.h"
+#include "rss.h"
 #ifdef OSI_DEBUG
 #include "debug.h"
 #endif /* OSI_DEBUG */
@@ -70,6 +73,8 @@ static inline nve32_t validate_args(struct osi_core_priv_data *const osi_core,
 /**
  * @brief Function to validate function pointers.
  *
+ * @note config_rxq_prio is optional, all other ops must be set.
+ *
  * @param[in] osi_core: OSI Core private data structure.
  * @param[in] ops_p: OSI Core operations structure.
  *
@@ -88,6 +93,8 @@ static nve32_t validate_func_ptrs(struct osi_core_priv_data *const osi_core,
 	nveu32_t i = 0;
 	nve32_t ret = 0;
 	void *temp_ops = (void *)ops_p;
+	/* Op which can be NULL if HW doesn't support it */
+	const void *opt_op = OSI_NULL;
 #if __SIZEOF_POINTER__ == 8
 	nveu64_t *l_ops = (nveu64_t *)temp_ops;
 #elif __SIZEOF_POINTER__ == 4
@@ -99,9 +106,12 @@ static nve32_t validate_func_ptrs(struct osi_core_priv_data *const osi_core,
 	goto fail;
 #endif
 	(void) osi_core;
+#ifndef OSI_STRIPPED_LIB
+	opt_op = (const void *)&ops_p->config_rxq_prio;
+#endif /* !OSI_STRIPPED_LIB */
 
 	for (i = 0; i < (sizeof(*ops_p) / (nveu64_t)__SIZEOF_POINTER__); i++) {
-		if (*l_ops == 0U) {
+		if ((*l_ops == 0U) && ((const void *)l_ops != opt_op)) {
 			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
 				     "core: fn ptr validation failed at\n",
 				     (nveu64_t)i);
@@ -295,6 +305,147 @@ static inline void init_vlan_filters(struct osi_core_priv_data *const osi_core)
 }
 #endif
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief async_finish_notify - Report asynchronous ioctl completion to OSD.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] cmd: Started ioctl command.
+ * @param[in] status: Final status of the command.
+ */
+static void async_finish_notify(struct osi_core_priv_data *const osi_core,
+				const nveu32_t cmd, const nve32_t status)
+{
+	if (osi_core->osd_ops.async_done != OSI_NULL) {
+		osi_core->osd_ops.async_done(osi_core->osd, cmd, status);
+	}
+}
+
+/**
+ * @brief async_abort - Drop pending asynchronous ioctl.
+ *
+ * Algorithm: HW state of a pending job is lost on MAC reset or
+ * deinit. Fail the job and report it to OSD.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ */
+static void async_abort(struct osi_core_priv_data *const osi_core)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct indir_job *job = &l_core->async_job;
+
+	if (job->state == OSI_ASYNC_PENDING) {
+		if (job->sw_done != OSI_NULL) {
+			job->sw_done(osi_core, -1);
+		}
+		async_finish_notify(osi_core, job->cmd, -1);
+	}
+
+	indir_job_reset(job);
+}
+
+/**
+ * @brief async_start - Start an ioctl command asynchronously.
+ *
+ * Algorithm: Queue the HW writes of the command in arg1_u32 into the
+ * asynchronous job without touching HW. They are issued by
+ * OSI_CMD_ASYNC_POLL.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] data: ioctl data with command in arg1_u32.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t async_start(struct osi_core_priv_data *const osi_core,
+			   struct osi_ioctl *data)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct indir_job *job = &l_core->async_job;
+	nve32_t ret = -1;
+
+	if (job->state == OSI_ASYNC_PENDING) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Asynchronous command already pending\n",
+			     (nveul64_t)job->cmd);
+		goto exit_func;
+	}
+
+	indir_job_reset(job);
+	switch (data->arg1_u32) {
+	case OSI_CMD_CONFIG_RSS:
+		ret = rss_config(osi_core, job);
+		break;
+	case OSI_CMD_RSS_TABLE_UPDATE:
+		ret = rss_table_update(osi_core, job);
+		break;
+	case OSI_CMD_RSS_REBALANCE:
+		ret = rss_rebalance(osi_core, &data->rss_rebalance, job);
+		break;
+	case OSI_CMD_RSS_PROFILE:
+		ret = rss_profile_config(osi_core, &data->rss_profile, job);
+		break;
+	default:
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "Command can't be started asynchronously\n",
+			     (nveul64_t)data->arg1_u32);
+		break;
+	}
+
+	if (ret == 0) {
+		job->cmd = data->arg1_u32;
+		job->state = OSI_ASYNC_PENDING;
+	} else {
+		indir_job_reset(job);
+	}
+
+exit_func:
+	return ret;
+}
+
+/**
+ * @brief async_poll - Advance pending asynchronous ioctl.
+ *
+ * Algorithm: Issue queued HW writes with indir_job_poll() and report the
+ * state in arg1_u32. The OSD is notified once the command is finished.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[out] data: ioctl data, arg1_u32 state, arg2_u32 command and
+ *	arg3_u32 entries moved by a completed RSS rebalance.
+ *
+ * @retval 0 on success
+ * @retval -1 when the started command failed.
+ */
+static nve32_t async_poll(struct osi_core_priv_data *const osi_core,
+			  struct osi_ioctl *data)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct indir_job *job = &l_core->async_job;
+	nve32_t ret = 0;
+
+	data->arg2_u32 = job->cmd;
+	data->arg3_u32 = 0U;
+	if (job->state != OSI_ASYNC_PENDING) {
+		data->arg1_u32 = OSI_ASYNC_IDLE;
+		goto exit_func;
+	}
+
+	ret = indir_job_poll(osi_core, job);
+	if (job->state == OSI_ASYNC_PENDING) {
+		data->arg1_u32 = OSI_ASYNC_PENDING;
+	} else {
+		data->arg1_u32 = OSI_ASYNC_DONE;
+		if (job->cmd == OSI_CMD_RSS_REBALANCE) {
+			data->arg3_u32 = l_core->rss_stage_moved;
+		}
+		async_finish_notify(osi_core, job->cmd, ret);
+	}
+
+exit_func:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief osi_hal_hw_core_deinit - HW API for MAC deinitialization.
  *
@@ -329,6 +480,10 @@ static nve32_t osi_hal_hw_core_deinit(struct osi_core_priv_data *const osi_core)
 {
 	struct core_local *l_core = (struct core_local *)(void *)osi_core;
 
+#ifndef OSI_STRIPPED_LIB
+	async_abort(osi_core);
+#endif /* !OSI_STRIPPED_LIB */
+
 	/* Stop the MAC */
 	hw_stop_mac(osi_core);
 
@@ -341,7 +496,13 @@ static nve32_t osi_hal_hw_core_deinit(struct osi_core_priv_data *const osi_core)
 	}
 
 	/* Handle the common interrupt if any status bits set */
+#ifndef OSI_STRIPPED_LIB
+	osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 	l_core->ops_p->handle_common_intr(osi_core);
+#ifndef OSI_STRIPPED_LIB
+	osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 
 	l_core->hw_init_successful = OSI_DISABLE;
 
@@ -537,7 +698,15 @@ static nve32_t osi_hal_hw_core_init(struct osi_core_priv_data *const osi_core)
 		goto fail;
 	}
 
+	/* FRP table in HW is lost on reset */
+	l_core->frp_hw_start = OSI_NONE;
+	osi_shadow_reset(&l_core->reg_shadow);
+	indir_stats_reset(osi_core);
+
 #ifndef OSI_STRIPPED_LIB
+	/* RSS indirection table in HW is lost on reset */
+	l_core->rss_hw_valid = OSI_DISABLE;
+	async_abort(osi_core);
 	init_vlan_filters(osi_core);
 
 #endif /* !OSI_STRIPPED_LIB */
@@ -583,6 +752,14 @@ static nve32_t osi_hal_hw_core_init(struct osi_core_priv_data *const osi_core)
 	l_core->lane_status = OSI_ENABLE;
 	l_core->hw_init_successful = OSI_ENABLE;
 
+#ifdef OSI_REG_SHADOW_CHECK
+	if (l_core->reg_shadow.mismatch != 0U) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
+			     "Core register shadow mismatch\n",
+			     (nveul64_t)l_core->reg_shadow.mismatch);
+	}
+#endif /* OSI_REG_SHADOW_CHECK */
+
 fail:
 	return ret;
 }
@@ -737,6 +914,7 @@ fail:
 	return ret;
 }
 
+#ifdef OSI_STRIPPED_LIB
 /**
  * @brief l3l4_find_match - function to find filter match
  *
@@ -804,6 +982,7 @@ static nve32_t l3l4_find_match(const struct core_local *const l_core,
 
 	return ret;
 }
+#endif /* OSI_STRIPPED_LIB */
 
 /**
  * @brief configure_l3l4_filter_valid_params - parameter validation function for l3l4 configuration
@@ -909,9 +1088,9 @@ exit_func:
  * @retval 0 on success
  * @retval -1 on failure.
  */
-static nve32_t configure_l3l4_filter_helper(struct osi_core_priv_data *const osi_core,
-					    nveu32_t filter_no,
-					    const struct osi_l3_l4_filter *const l3_l4)
+nve32_t configure_l3l4_filter_helper(struct osi_core_priv_data *const osi_core,
+				     nveu32_t filter_no,
+				     const struct osi_l3_l4_filter *const l3_l4)
 {
 	struct osi_l3_l4_filter *cfg_l3_l4;
 	struct core_local *const l_core = (struct core_local *)(void *)osi_core;
@@ -1028,7 +1207,9 @@ static void l3l4_add_wildcard_filter(struct osi_core_priv_data *const osi_core,
  * Algorithm:
  *  - Validate all the l3_l4 structure parameter using configure_l3l4_filter_valid_params().
  *    Return -1 if parameter validation fails.
- *  - For filter enable case,
+ *  - For full library, add/delete the rule using l3l4_mgr_config() which
+ *    places it in HW filter slot, FRP or keeps it in SW only.
+ *  - For stripped library, for filter enable case,
  *    -> If filter already enabled, return -1 to report error.
  *    -> Otherwise find free index and configure filter using configure_l3l4_filter_helper().
  *  - For filter disable case,
@@ -1049,14 +1230,18 @@ static void l3l4_add_wildcard_filter(struct osi_core_priv_data *const osi_core,
 static nve32_t configure_l3l4_filter(struct osi_core_priv_data *const osi_core,
 				     const struct osi_l3_l4_filter *const l3_l4)
 {
+#ifdef OSI_STRIPPED_LIB
 	nve32_t err;
 	nveu32_t filter_no = 0;
 	nveu32_t free_filter_no = UINT_MAX;
+#endif /* OSI_STRIPPED_LIB */
+#if defined(OSI_STRIPPED_LIB) || defined(L3L4_WILDCARD_FILTER)
 	const struct core_local *l_core = (struct core_local *)(void *)osi_core;
 	const nveu32_t max_filter_no[2] = {
 		EQOS_MAX_L3_L4_FILTER - 1U,
 		OSI_MGBE_MAX_L3_L4_FILTER - 1U,
 	};
+#endif /* OSI_STRIPPED_LIB || L3L4_WILDCARD_FILTER */
 	nve32_t ret = -1;
 
 	if (configure_l3l4_filter_valid_params(osi_core, l3_l4) < 0) {
@@ -1064,6 +1249,20 @@ static nve32_t configure_l3l4_filter(struct osi_core_priv_data *const osi_core,
 		goto exit_func;
 	}
 
+#ifndef OSI_STRIPPED_LIB
+#if defined(L3L4_WILDCARD_FILTER)
+	/* setup l3l4 wildcard filter for l3l4 */
+	l3l4_add_wildcard_filter(osi_core, max_filter_no[osi_core->mac]);
+	if (l_core->l3l4_wildcard_filter_configured != OSI_ENABLE) {
+		OSI_CORE_ERR((osi_core->osd), (OSI_LOG_ARG_HW_FAIL),
+			("L3L4: Rejected: wildcard is not enabled: "), (0UL));
+		goto exit_func;
+	}
+#endif /* L3L4_WILDCARD_FILTER */
+
+	/* HW slot, FRP or SW only placement is owned by filter manager */
+	ret = l3l4_mgr_config(osi_core, l3_l4);
+#else
 	/* search for a duplicate filter request or find for free index */
 	err = l3l4_find_match(l_core, l3_l4, &filter_no, &free_filter_no,
 				  max_filter_no[osi_core->mac]);
@@ -1116,6 +1315,7 @@ static nve32_t configure_l3l4_filter(struct osi_core_priv_data *const osi_core,
 
 	/* success */
 	ret = 0;
+#endif /* !OSI_STRIPPED_LIB */
 
 exit_func:
 
@@ -1572,6 +1772,17 @@ static nve32_t configure_frp(struct osi_core_priv_data *const osi_core,
 		goto done;
 	}
 
+#ifndef OSI_STRIPPED_LIB
+	if ((cmd->frp_id >= OSI_FRP_ID_RSVD_BASE) &&
+	    (cmd->frp_id < (OSI_FRP_ID_RSVD_BASE + OSI_FRP_ID_RSVD_CNT))) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "FRP ID reserved for OSI rules\n",
+			     (nveul64_t)cmd->frp_id);
+		ret = -1;
+		goto done;
+	}
+#endif /* !OSI_STRIPPED_LIB */
+
 	ret = setup_frp(osi_core, l_core->ops_p, cmd);
 done:
 	return ret;
@@ -1782,9 +1993,11 @@ static inline nve32_t get_tx_ts(struct osi_core_priv_data *osi_core,
 		/* mask return as initial value is returned always */
 		(void)__sync_fetch_and_sub(&l_core->ts_lock, 1);
 #ifndef OSI_STRIPPED_LIB
+		osi_stats_write_begin(&l_core->stats_seq);
 		osi_core->stats.ts_lock_del_fail =
 				osi_update_stats_counter(
 				osi_core->stats.ts_lock_del_fail, 1U);
+		osi_stats_write_end(&l_core->stats_seq);
 #endif
 		goto done;
 	}
@@ -2096,7 +2309,7 @@ static void cfg_l3_l4_filter(struct core_local *l_core)
 	nveu32_t i = 0U;
 
 	for (i = 0U; i < OSI_MGBE_MAX_L3_L4_FILTER; i++) {
-		if (l_core->cfg.l3_l4[i].filter_enb_dis == OSI_FALSE) {
+		if ((l_core->resume_snap.l3l4_map & OSI_BIT(i)) == OSI_NONE) {
 			/* filter not enabled */
 			continue;
 		}
@@ -2104,6 +2317,7 @@ static void cfg_l3_l4_filter(struct core_local *l_core)
 		(void)configure_l3l4_filter_helper(
 			(struct osi_core_priv_data *)(void *)l_core,
 			i, &l_core->cfg.l3_l4[i]);
+		update_counter_u(&l_core->resume_snap.entries, 1U);
 
 #if defined(L3L4_WILDCARD_FILTER)
 		if (i == 0U) {
@@ -2120,6 +2334,7 @@ static void cfg_l2_filter(struct core_local *l_core)
 
 	(void)osi_l2_filter((struct osi_core_priv_data *)(void *)l_core,
 			    &l_core->cfg.l2_filter);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 
 	for (i = 0U; i < EQOS_MAX_MAC_ADDRESS_FILTER; i++) {
 		if (l_core->cfg.l2[i].used == OSI_DISABLE) {
@@ -2128,6 +2343,7 @@ static void cfg_l2_filter(struct core_local *l_core)
 
 		(void)osi_l2_filter((struct osi_core_priv_data *)(void *)l_core,
 				    &l_core->cfg.l2[i].filter);
+		update_counter_u(&l_core->resume_snap.entries, 1U);
 	}
 }
 
@@ -2135,20 +2351,28 @@ static void cfg_rxcsum(struct core_local *l_core)
 {
 	(void)hw_config_rxcsum_offload((struct osi_core_priv_data *)(void *)l_core,
 						    l_core->cfg.rxcsum);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 }
 
 #ifndef OSI_STRIPPED_LIB
 static void cfg_vlan(struct core_local *l_core)
 {
-	nveu32_t i;
+	nveu32_t i, j;
+	nveu32_t map;
+
+	for (i = 0U; i < RESUME_VID_WORDS; i++) {
+		map = l_core->resume_snap.vid_map[i];
+		j = 0U;
+		while (map != OSI_NONE) {
+			if ((map & OSI_BIT(0)) == OSI_BIT(0)) {
+				(void)vlan_id_update((struct osi_core_priv_data *)(void *)l_core,
+						     (((i * 32U) + j) | OSI_VLAN_ACTION_ADD));
+				update_counter_u(&l_core->resume_snap.entries, 1U);
+			}
 
-	for (i = 0U; i < VLAN_NUM_VID; i++) {
-		if (l_core->cfg.vlan[i].used == OSI_DISABLE) {
-			continue;
+			map = map >> 1U;
+			j++;
 		}
-
-		(void)vlan_id_update((struct osi_core_priv_data *)(void *)l_core,
-				     (l_core->cfg.vlan[i].vid | OSI_VLAN_ACTION_ADD));
 	}
 }
 
@@ -2156,6 +2380,7 @@ static void cfg_fc(struct core_local *l_core)
 {
 	(void)l_core->ops_p->config_flow_control((struct osi_core_priv_data *)(void *)l_core,
 						  l_core->cfg.flow_ctrl);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 }
 
 static void cfg_eee(struct core_local *l_core)
@@ -2163,6 +2388,7 @@ static void cfg_eee(struct core_local *l_core)
 	(void)conf_eee((struct osi_core_priv_data *)(void *)l_core,
 		       l_core->cfg.tx_lpi_enabled,
 		       l_core->cfg.tx_lpi_timer);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 }
 #endif /* !OSI_STRIPPED_LIB */
 
@@ -2171,12 +2397,13 @@ static void cfg_avb(struct core_local *l_core)
 	nveu32_t i;
 
 	for (i = 0U; i < OSI_MGBE_MAX_NUM_QUEUES; i++) {
-		if (l_core->cfg.avb[i].used == OSI_DISABLE) {
+		if ((l_core->resume_snap.avb_map & OSI_BIT(i)) == OSI_NONE) {
 			continue;
 		}
 
 		(void)l_core->ops_p->set_avb_algorithm((struct osi_core_priv_data *)(void *)l_core,
 						       &l_core->cfg.avb[i].avb_info);
+		update_counter_u(&l_core->resume_snap.entries, 1U);
 	}
 }
 
@@ -2184,12 +2411,14 @@ static void cfg_est(struct core_local *l_core)
 {
 	(void)config_est((struct osi_core_priv_data *)(void *)l_core,
 			 &l_core->cfg.est);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 }
 
 static void cfg_fpe(struct core_local *l_core)
 {
 	(void)config_fpe((struct osi_core_priv_data *)(void *)l_core,
 			 &l_core->cfg.fpe);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 }
 
 static void cfg_ptp(struct core_local *l_core)
@@ -2201,6 +2430,7 @@ static void cfg_ptp(struct core_local *l_core)
 	ioctl_data.cmd = OSI_CMD_CONFIG_PTP;
 
 	(void)osi_handle_ioctl(osi_core, &ioctl_data);
+	update_counter_u(&l_core->resume_snap.entries, 1U);
 }
 
 static void cfg_frp(struct core_local *l_core)
@@ -2208,6 +2438,144 @@ static void cfg_frp(struct core_local *l_core)
 	struct osi_core_priv_data *osi_core = (struct osi_core_priv_data *)(void *)l_core;
 
 	(void)frp_hw_write(osi_core, l_core->ops_p);
+	update_counter_u(&l_core->resume_snap.entries, osi_core->frp_cnt);
+}
+
+/**
+ * @brief resume_snap_take - Record dynamic configuration to be restored.
+ *
+ * @note
+ * Algorithm:
+ *  - Drop categories whose stored configuration equals HW reset defaults,
+ *    i.e. no L3/L4 filter, AVB queue or VLAN ID left, EEE, EST and FPE
+ *    disabled and empty FRP table.
+ *  - Compact per entry storage into bitmaps so that resume only walks
+ *    programmed entries.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ */
+static void resume_snap_take(struct osi_core_priv_data *const osi_core)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	struct core_resume_snap *snap = &l_core->resume_snap;
+	nveu32_t flags = l_core->cfg.flags;
+	nveu32_t i;
+#ifndef OSI_STRIPPED_LIB
+	nveu32_t vid_cnt = 0U;
+#endif /* !OSI_STRIPPED_LIB */
+
+	osi_memset(snap, 0U, sizeof(struct core_resume_snap));
+
+	for (i = 0U; i < OSI_MGBE_MAX_L3_L4_FILTER; i++) {
+		if (l_core->cfg.l3_l4[i].filter_enb_dis == OSI_TRUE) {
+			snap->l3l4_map |= OSI_BIT(i);
+		}
+	}
+
+	for (i = 0U; i < OSI_MGBE_MAX_NUM_QUEUES; i++) {
+		if (l_core->cfg.avb[i].used == OSI_ENABLE) {
+			snap->avb_map |= OSI_BIT(i);
+		}
+	}
+
+	if (snap->l3l4_map == OSI_NONE) {
+		flags &= ~DYNAMIC_CFG_L3_L4;
+	}
+
+	if (snap->avb_map == OSI_NONE) {
+		flags &= ~DYNAMIC_CFG_AVB;
+	}
+
+	if (l_core->cfg.est.en_dis == OSI_DISABLE) {
+		flags &= ~DYNAMIC_CFG_EST;
+	}
+
+	if (l_core->cfg.fpe.tx_queue_preemption_enable == OSI_NONE) {
+		flags &= ~DYNAMIC_CFG_FPE;
+	}
+
+	if (osi_core->frp_cnt == OSI_NONE) {
+		flags &= ~DYNAMIC_CFG_FRP;
+	}
+
+#ifndef OSI_STRIPPED_LIB
+	if ((flags & DYNAMIC_CFG_VLAN) == DYNAMIC_CFG_VLAN) {
+		for (i = 0U; i < VLAN_NUM_VID; i++) {
+			if (l_core->cfg.vlan[i].used == OSI_ENABLE) {
+				snap->vid_map[i / 32U] |= OSI_BIT(i % 32U);
+				vid_cnt++;
+			}
+		}
+	}
+
+	if (vid_cnt == OSI_NONE) {
+		flags &= ~DYNAMIC_CFG_VLAN;
+	}
+
+	if (l_core->cfg.tx_lpi_enabled == OSI_DISABLE) {
+		flags &= ~DYNAMIC_CFG_EEE;
+	}
+#endif /* !OSI_STRIPPED_LIB */
+
+	snap->flags = flags;
+}
+
+/**
+ * @brief resume_time_ns - Read OSD monotonic clock for resume timing.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval Time in nsec, 0 if OSD provides no clock.
+ */
+static nveu64_t resume_time_ns(const struct osi_core_priv_data *const osi_core)
+{
+	nveu64_t now = 0U;
+
+#ifndef OSI_STRIPPED_LIB
+	if (osi_core->osd_ops.get_time_ns != OSI_NULL) {
+		now = osi_core->osd_ops.get_time_ns(osi_core->osd);
+	}
+#else
+	(void)osi_core;
+#endif /* !OSI_STRIPPED_LIB */
+
+	return now;
+}
+
+/**
+ * @brief resume_report - Report work done by last resume.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] start_ns: resume_time_ns() at start of resume.
+ * @param[out] data: Ioctl data for resume outputs.
+ */
+static void resume_report(struct osi_core_priv_data *const osi_core,
+			  nveu64_t start_ns, struct osi_ioctl *data)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu64_t end_ns = resume_time_ns(osi_core);
+	nveu64_t ops = 0U;
+	nveu64_t wait_us = 0U;
+	nveu64_t restore_us = 0U;
+	nveu32_t i;
+
+	/* Indirect access statistics were reset by core init, so they only
+	 * account for the restore done since then.
+	 */
+	for (i = 0U; i < INDIR_PROTO_MAX; i++) {
+		ops += l_core->indir_stats[i].ops;
+		wait_us += l_core->indir_stats[i].wait_us;
+	}
+
+	data->arg1_u32 = l_core->resume_snap.flags;
+	data->arg2_u32 = l_core->resume_snap.entries;
+	data->arg3_u32 = (wait_us > UINT_MAX) ? UINT_MAX : (nveu32_t)wait_us;
+	if ((start_ns != 0U) && (end_ns > start_ns)) {
+		restore_us = (end_ns - start_ns) / 1000U;
+	}
+	data->arg4_u32 = (restore_us > UINT_MAX) ? UINT_MAX :
+			 (nveu32_t)restore_us;
+	data->arg5_u64 = ops;
 }
 
 static void apply_dynamic_cfg(struct osi_core_priv_data *osi_core)
@@ -2229,9 +2597,11 @@ static void apply_dynamic_cfg(struct osi_core_priv_data *osi_core)
 		[DYNAMIC_CFG_PTP_IDX] = cfg_ptp,
 		[DYNAMIC_CFG_FRP_IDX] = cfg_frp
 	};
-	nveu32_t flags = l_core->cfg.flags;
+	nveu32_t flags = l_core->resume_snap.flags;
 	nveu32_t i = 0U;
 
+	l_core->resume_snap.entries = 0U;
+
 	while (flags > 0U) {
 		if ((flags & OSI_ENABLE) == OSI_ENABLE) {
 			fn[i](l_core);
@@ -2279,6 +2649,13 @@ static void store_l2_filter(struct osi_core_priv_data *osi_core,
  *  - OSI_CMD_READ_MMC
  *	invoke function to read actual registers and update
  *     structure variable mmc
+ *  - OSI_CMD_READ_MMC_GRP
+ *	invoke function to read registers of selected counter groups
+ *     only and update structure variable mmc
+ *	arg1_u32 - bitmap of OSI_MMC_GRP_* counter groups
+ *	With virtualization and stats_page mapped, OSI_CMD_READ_MMC,
+ *	OSI_CMD_READ_MMC_GRP and OSI_CMD_READ_STATS copy mmc and stats
+ *	published by the server from stats_page, without IVC messages
  *  - OSI_CMD_GET_MAC_VER
  *	Reading MAC version
  *	arg1_u32 - holds mac version
@@ -2359,6 +2736,14 @@ static void store_l2_filter(struct osi_core_priv_data *osi_core,
  *	arg3_u32 - dma channel for routing based on filter.
  *		   Max OSI_EQOS_MAX_NUM_CHANS.
  *	arg4_u32 - API call for L3 filter(0) or L4 filter(1)
+ *  - OSI_CMD_L3L4_FILTER_HIT
+ *	Report hits of an L3/L4 rule to rebalance HW filter slots
+ *	l3l4_filter - l3_l4 filter structure of the rule
+ *	arg1_u32 - Number of hits since last report
+ *  - OSI_CMD_FLOW_STEER
+ *	Add, delete, report hits of or read stats of a flow steering rule.
+ *	OSI selects L3/L4 filter, FRP or VLAN priority to back the rule.
+ *	flow_rule - flow steering rule structure
  *  - OSI_CMD_SET_SYSTOHW_TIME
  *	set system to MAC hardware
  *	arg1_u32 - sec
@@ -2371,9 +2756,69 @@ static void store_l2_filter(struct osi_core_priv_data *osi_core,
  *	rxq_route - rxq routing information in structure
  *  - OSI_CMD_CONFIG_FRP
  *	Issue FRP command to HW
- *	frp_cmd - FRP command parameter
+ *	frp_cmd - FRP command parameter, IDs from OSI_FRP_ID_RSVD_BASE on
+ *	are used by OSI itself and rejected
  *  - OSI_CMD_CONFIG_RSS
  *	Configure RSS
+ *  - OSI_CMD_RSS_TABLE_UPDATE
+ *	Program only RSS indirection table entries from rss.table which
+ *	differ from what is in HW. RSS hash key is not reprogrammed.
+ *  - OSI_CMD_RSS_REBALANCE
+ *	Move RSS indirection table entries from most loaded to least loaded
+ *	Rx channel in the table based on Rx packets since last successful
+ *	call, and program only changed entries.
+ *	rss_rebalance - RSS rebalance structure
+ *  - OSI_CMD_RSS_PROFILE
+ *	Select hashed packet types and optionally generate a symmetric RSS
+ *	hash key, then program RSS.
+ *	rss_profile - RSS profile structure
+ *  - OSI_CMD_ASYNC_START
+ *	Queue the HW writes of a command without waiting for HW. Supported
+ *	for OSI_CMD_CONFIG_RSS, OSI_CMD_RSS_TABLE_UPDATE,
+ *	OSI_CMD_RSS_REBALANCE and OSI_CMD_RSS_PROFILE. Only one command can
+ *	be pending at a time.
+ *	arg1_u32 - command to be started, with its usual arguments
+ *  - OSI_CMD_ASYNC_POLL
+ *	Issue queued HW writes as far as HW accepts them without delay and
+ *	run completion steps after the last one. osd_ops.async_done is
+ *	called when a started command completes or fails. HW busy for
+ *	longer than the indirect access timeout fails the command, timed
+ *	with osd_ops.get_time_ns. Without it each poll finding HW busy
+ *	counts as one back-off delay, poll no faster than that delay.
+ *	arg1_u32 - output OSI_ASYNC_PENDING, OSI_ASYNC_DONE or OSI_ASYNC_IDLE
+ *	arg2_u32 - output command which was started
+ *	arg3_u32 - output entries moved by OSI_CMD_RSS_REBALANCE once it is
+ *	done, its rss_rebalance.moved stays 0 when started asynchronously
+ *  - OSI_CMD_SUSPEND
+ *	Record configuration which differs from HW reset defaults and
+ *	deinitialize MAC.
+ *  - OSI_CMD_RESUME
+ *	Initialize MAC and restore only the configuration recorded on suspend.
+ *	arg1_u32 - output bitmap of restored configuration categories
+ *	arg2_u32 - output number of restored entries
+ *	arg3_u32 - output indirect access back-off delay in usec
+ *	arg4_u32 - output wall clock restore time in usec, 0 without
+ *	osd_ops.get_time_ns
+ *	arg5_u64 - output number of indirect register accesses
+ *  - OSI_CMD_LAT_STATS
+ *	Read call statistics of an ioctl command or MACsec entry point
+ *	arg1_u32 - OSI_CMD_* command or OSI_LAT_MACSEC_* index
+ *	arg2_u32 - clear statistics after read (1) or keep them (0)
+ *	lat_stats - buffer for output call statistics
+ *  - OSI_CMD_STATS_SNAPSHOT
+ *	Copy stats and mmc as they were between two updates, without
+ *	locking out updates from other contexts
+ *	stats_snap - buffer for output statistics and their generation
+ *  - OSI_CMD_REMAP_VM_IRQ
+ *	Move a DMA channel to another VM IRQ at runtime. Only the VM
+ *	routing of the channel changes, its interrupt enables are kept. An
+ *	interrupt raised during the switch may be signalled on the old VM
+ *	IRQ only, so the channel virtual interrupt status is read after the
+ *	switch and returned. If it is not 0 the OSD must run the channel
+ *	interrupt handling as if the new VM IRQ had fired
+ *	arg1_u32 - DMA channel
+ *	arg2_u32 - index of target VM IRQ in irq_data
+ *	arg3_u32 - output VIRT_INTR_CHX_STATUS bits pending after switch
  *  - OSI_CMD_CONFIG_EST
  *	Configure EST registers and GCL to hw
  *	est - EST configuration structure
@@ -2434,6 +2879,7 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 	nve32_t freq_adj_value = 0x0;
 	nvel64_t secondary_time = 0x0;
 	nvel64_t primary_time = 0x0;
+	nveu64_t resume_start = 0U;
 
 	ops_p = l_core->ops_p;
 
@@ -2446,13 +2892,28 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 		break;
 
 #ifndef OSI_STRIPPED_LIB
+	case OSI_CMD_L3L4_FILTER_HIT:
+		ret = l3l4_mgr_update_hits(osi_core, &data->l3l4_filter,
+					   data->arg1_u32);
+		break;
+
+	case OSI_CMD_FLOW_STEER:
+		ret = flow_steer_config(osi_core, &data->flow_rule);
+		break;
+
 	case OSI_CMD_MDC_CONFIG:
 		ops_p->set_mdc_clk_rate(osi_core, data->arg5_u64);
 		ret = 0;
 		break;
 
 	case OSI_CMD_RESET_MMC:
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		ops_p->reset_mmc(osi_core);
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		ret = 0;
 		break;
 
@@ -2554,7 +3015,14 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 		break;
 
 	case OSI_CMD_COMMON_ISR:
+#ifndef OSI_STRIPPED_LIB
+		/* ISR updates stats and harvests MMC */
+		osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		ops_p->handle_common_intr(osi_core);
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		ret = 0;
 		break;
 
@@ -2563,10 +3031,34 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 		break;
 
 	case OSI_CMD_READ_MMC:
-		ops_p->read_mmc(osi_core);
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
+		ops_p->read_mmc(osi_core, OSI_MMC_GRP_ALL);
+#ifndef OSI_STRIPPED_LIB
+		osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
 		ret = 0;
 		break;
 
+	case OSI_CMD_READ_MMC_GRP:
+		if ((data->arg1_u32 & ~OSI_MMC_GRP_ALL) != OSI_NONE) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "Invalid MMC counter groups\n",
+				     (nveul64_t)data->arg1_u32);
+			ret = -1;
+		} else {
+#ifndef OSI_STRIPPED_LIB
+			osi_stats_write_begin(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
+			ops_p->read_mmc(osi_core, data->arg1_u32);
+#ifndef OSI_STRIPPED_LIB
+			osi_stats_write_end(&l_core->stats_seq);
+#endif /* !OSI_STRIPPED_LIB */
+			ret = 0;
+		}
+		break;
+
 	case OSI_CMD_SET_SPEED:
 		ret = hw_set_speed(osi_core, data->arg6_32);
 		break;
@@ -2783,7 +3275,33 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 		break;
 
 	case OSI_CMD_CONFIG_RSS:
-		ret = ops_p->config_rss(osi_core);
+		ret = rss_config(osi_core, OSI_NULL);
+		break;
+
+	case OSI_CMD_RSS_TABLE_UPDATE:
+		ret = rss_table_update(osi_core, OSI_NULL);
+		break;
+
+	case OSI_CMD_RSS_REBALANCE:
+		ret = rss_rebalance(osi_core, &data->rss_rebalance, OSI_NULL);
+		break;
+
+	case OSI_CMD_RSS_PROFILE:
+		ret = rss_profile_config(osi_core, &data->rss_profile,
+					 OSI_NULL);
+		break;
+
+	case OSI_CMD_REMAP_VM_IRQ:
+		ret = hw_remap_vm_irq(osi_core, data->arg1_u32,
+				      data->arg2_u32, &data->arg3_u32);
+		break;
+
+	case OSI_CMD_ASYNC_START:
+		ret = async_start(osi_core, data);
+		break;
+
+	case OSI_CMD_ASYNC_POLL:
+		ret = async_poll(osi_core, data);
 		break;
 
 #endif /* !OSI_STRIPPED_LIB */
@@ -2887,16 +3405,19 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 		break;
 #endif
 	case OSI_CMD_SUSPEND:
+		resume_snap_take(osi_core);
 		l_core->state = OSI_SUSPENDED;
 		ret = osi_hal_hw_core_deinit(osi_core);
 		break;
 	case OSI_CMD_RESUME:
+		resume_start = resume_time_ns(osi_core);
 		ret = osi_hal_hw_core_init(osi_core);
 		if (ret < 0) {
 			break;
 		}
 
 		apply_dynamic_cfg(osi_core);
+		resume_report(osi_core, resume_start, data);
 		break;
 	default:
 		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
@@ -2908,6 +3429,68 @@ static nve32_t osi_hal_handle_ioctl(struct osi_core_priv_data *osi_core,
 	return ret;
 }
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief osi_hal_handle_ioctl_batch - Handle several runtime commands.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: Array of ioctl data.
+ * @param[out] status: Array of return values of each command.
+ * @param[in] num: Number of entries in data and status.
+ *
+ * @retval 0 always, see status for results
+ */
+static nve32_t osi_hal_handle_ioctl_batch(struct osi_core_priv_data *osi_core,
+					  struct osi_ioctl *data,
+					  nve32_t *status, const nveu32_t num)
+{
+	nveu32_t i;
+
+	for (i = 0U; i < num; i++) {
+		status[i] = osi_hal_handle_ioctl(osi_core, &data[i]);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief osi_hal_ioctl_submit - Handle a submitted runtime command.
+ *
+ * Algorithm: HW access is local, so the command completes right away.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] data: ioctl data.
+ * @param[in] req_id: Request ID of the command.
+ *
+ * @retval 0 always, status is reported through osi_ioctl_result()
+ */
+static nve32_t osi_hal_ioctl_submit(struct osi_core_priv_data *osi_core,
+				    struct osi_ioctl *data,
+				    const nveu32_t req_id)
+{
+	ioctl_req_done(osi_core, req_id, osi_hal_handle_ioctl(osi_core, data));
+
+	return 0;
+}
+
+/**
+ * @brief osi_hal_ioctl_complete - Response of a submitted command.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] reply: IVC response.
+ *
+ * @retval -1 always, there are no IVC responses without virtualization
+ */
+static nve32_t osi_hal_ioctl_complete(struct osi_core_priv_data *osi_core,
+				      OSI_UNUSED struct ivc_msg_common *reply)
+{
+	OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_OPNOTSUPP,
+		     "CORE: No IVC response without virtualization\n", 0ULL);
+
+	return -1;
+}
+#endif /* !OSI_STRIPPED_LIB */
+
 void hw_interface_init_core_ops(struct if_core_ops *if_ops_p)
 {
 	if_ops_p->if_core_init = osi_hal_hw_core_init;
@@ -2916,4 +3499,9 @@ void hw_interface_init_core_ops(struct if_core_ops *if_ops_p)
 	if_ops_p->if_read_phy_reg = osi_hal_read_phy_reg;
 	if_ops_p->if_init_core_ops = osi_hal_init_core_ops;
 	if_ops_p->if_handle_ioctl = osi_hal_handle_ioctl;
+#ifndef OSI_STRIPPED_LIB
+	if_ops_p->if_handle_ioctl_batch = osi_hal_handle_ioctl_batch;
+	if_ops_p->if_ioctl_submit = osi_hal_ioctl_submit;
+	if_ops_p->if_ioctl_complete = osi_hal_ioctl_complete;
+#endif /* !OSI_STRIPPED_LIB */
 }
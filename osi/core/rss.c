@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OSI_STRIPPED_LIB
+#include "../osi/common/common.h"
+#include "core_common.h"
+#include "mgbe_core.h"
+#include "rss.h"
+
+/**
+ * @brief rss_is_active - Check RSS is programmed in HW.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ *
+ * @retval OSI_ENABLE if RSS is enabled with more than one queue
+ * @retval OSI_DISABLE otherwise
+ */
+static nveu32_t rss_is_active(const struct osi_core_priv_data *const osi_core)
+{
+	nveu32_t ret = OSI_DISABLE;
+
+	if ((osi_core->rss.enable == OSI_ENABLE) &&
+	    (osi_core->num_mtl_queues > 1U)) {
+		ret = OSI_ENABLE;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief rss_job_busy - Check an asynchronous RSS update is pending.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Job of the caller or OSI_NULL for synchronous update.
+ *
+ * @retval OSI_ENABLE if a synchronous update would race a pending job
+ * @retval OSI_DISABLE otherwise
+ */
+static nveu32_t rss_job_busy(struct osi_core_priv_data *const osi_core,
+			     const struct indir_job *const job)
+{
+	const struct core_local *l_core =
+				(struct core_local *)(void *)osi_core;
+	nveu32_t ret = OSI_DISABLE;
+
+	if ((job == OSI_NULL) &&
+	    (l_core->async_job.state == OSI_ASYNC_PENDING)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "RSS: asynchronous update pending\n", 0ULL);
+		ret = OSI_ENABLE;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief rss_job_done - Mark RSS HW table shadow valid after async update.
+ *
+ * Algorithm: rss_hw_table already holds the queued entries. It is marked
+ * valid only when all of them reached HW.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] status: Final status of the job.
+ */
+static void rss_job_done(struct osi_core_priv_data *const osi_core,
+			 const nve32_t status)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+
+	if (status == 0) {
+		l_core->rss_hw_valid = OSI_ENABLE;
+	}
+}
+
+/**
+ * @brief rss_program - Program complete RSS configuration.
+ *
+ * Algorithm: Same as rss_config() with the given hash key and hash types
+ *	instead of the ones in osi_core->rss.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] key: RSS hash key, OSI_RSS_HASH_KEY_SIZE bytes.
+ * @param[in] hash_types: Hashed packet types, 0 for OSI_RSS_HASH_ALL.
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t rss_program(struct osi_core_priv_data *const osi_core,
+			   const nveu8_t *const key,
+			   const nveu32_t hash_types,
+			   struct indir_job *const job)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nve32_t ret = -1;
+
+	if (rss_job_busy(osi_core, job) == OSI_ENABLE) {
+		goto exit_func;
+	}
+
+	l_core->rss_hw_valid = OSI_DISABLE;
+	ret = l_core->ops_p->config_rss(osi_core, key, hash_types, job);
+	if ((ret == 0) && (rss_is_active(osi_core) == OSI_ENABLE)) {
+		(void)osi_memcpy(l_core->rss_hw_table, osi_core->rss.table,
+				 sizeof(l_core->rss_hw_table));
+		if (job == OSI_NULL) {
+			l_core->rss_hw_valid = OSI_ENABLE;
+		} else {
+			job->sw_done = rss_job_done;
+		}
+	}
+
+exit_func:
+	return ret;
+}
+
+nve32_t rss_config(struct osi_core_priv_data *const osi_core,
+		   struct indir_job *const job)
+{
+	return rss_program(osi_core, osi_core->rss.key,
+			   osi_core->rss.hash_types, job);
+}
+
+/**
+ * @brief rss_profile_done - Store RSS profile once its job completed.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] status: Final status of the job.
+ */
+static void rss_profile_done(struct osi_core_priv_data *const osi_core,
+			     const nve32_t status)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+
+	if (status == 0) {
+		if (rss_is_active(osi_core) == OSI_ENABLE) {
+			l_core->rss_hw_valid = OSI_ENABLE;
+		}
+		(void)osi_memcpy(osi_core->rss.key, l_core->rss_stage_key,
+				 sizeof(osi_core->rss.key));
+		osi_core->rss.hash_types = l_core->rss_stage_hash_types;
+	}
+}
+
+/**
+ * @brief rss_table_write - Program changed entries of an indirection table.
+ *
+ * Algorithm: Same as rss_table_update() for a caller provided table, which
+ *	lets a caller commit a new table into osi_core->rss only once HW
+ *	accepted it.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] table: Indirection table, OSI_RSS_MAX_TABLE_SIZE entries.
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+static nve32_t rss_table_write(struct osi_core_priv_data *const osi_core,
+			       const nveu32_t *const table,
+			       struct indir_job *const job)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu32_t i;
+	nve32_t ret = -1;
+
+	if (rss_job_busy(osi_core, job) == OSI_ENABLE) {
+		goto exit_func;
+	}
+
+	if (rss_is_active(osi_core) == OSI_DISABLE) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "RSS: not enabled\n", 0ULL);
+		goto exit_func;
+	}
+
+	for (i = 0U; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
+		if (table[i] >= OSI_MGBE_MAX_NUM_CHANS) {
+			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+				     "RSS: invalid DMA channel\n",
+				     (nveul64_t)table[i]);
+			goto exit_func;
+		}
+	}
+
+	for (i = 0U; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
+		if ((l_core->rss_hw_valid == OSI_ENABLE) &&
+		    (l_core->rss_hw_table[i] == table[i])) {
+			continue;
+		}
+
+		ret = l_core->ops_p->write_rss_entry(osi_core, i, table[i],
+						     job);
+		if (ret < 0) {
+			/* entries after a failed write are not known */
+			l_core->rss_hw_valid = OSI_DISABLE;
+			goto exit_func;
+		}
+		l_core->rss_hw_table[i] = table[i];
+	}
+
+	if (job == OSI_NULL) {
+		l_core->rss_hw_valid = OSI_ENABLE;
+	} else {
+		/* HW matches rss_hw_table only once the job completed */
+		l_core->rss_hw_valid = OSI_DISABLE;
+		job->sw_done = rss_job_done;
+	}
+	ret = 0;
+exit_func:
+	return ret;
+}
+
+nve32_t rss_table_update(struct osi_core_priv_data *const osi_core,
+			 struct indir_job *const job)
+{
+	return rss_table_write(osi_core, osi_core->rss.table, job);
+}
+
+/**
+ * @brief rss_rxq_dma_chan - Get DMA channel serving an MTL Rx queue.
+ *
+ * Algorithm: Decode the static MTL Rx queue to DMA channel map programmed
+ *	by mgbe_core_init(), one byte per queue, four queues per register.
+ *
+ * @param[in] qinx: MTL Rx queue index.
+ *
+ * @retval DMA channel, OSI_MGBE_MAX_NUM_CHANS if queue has no channel.
+ */
+static nveu32_t rss_rxq_dma_chan(nveu32_t qinx)
+{
+	const nveu32_t map[3] = {
+		MGBE_RXQ_TO_DMA_CHAN_MAP0,
+		MGBE_RXQ_TO_DMA_CHAN_MAP1,
+		MGBE_RXQ_TO_DMA_CHAN_MAP2,
+	};
+	nveu32_t chan = OSI_MGBE_MAX_NUM_CHANS;
+
+	if (qinx < (3U * 4U)) {
+		chan = (map[qinx / 4U] >> ((qinx % 4U) * 8U)) & 0xFU;
+	}
+
+	return chan;
+}
+
+/**
+ * @brief rss_rebal_moves - Number of entries to move between channels.
+ *
+ * Algorithm: Move half of the load difference, using channel load over
+ *	its entries as load of one entry. Keep at least one entry on the
+ *	hot channel.
+ *
+ * @param[in] hot_load: Rx packets of the most loaded channel
+ * @param[in] cold_load: Rx packets of the least loaded channel
+ * @param[in] hot_cnt: Number of entries pointing to the hot channel
+ *
+ * @retval Number of entries to move
+ */
+static nveu32_t rss_rebal_moves(nveu64_t hot_load, nveu64_t cold_load,
+				nveu32_t hot_cnt)
+{
+	nveu64_t per_entry = hot_load / (nveu64_t)hot_cnt;
+	nveu64_t moves;
+
+	if (per_entry == 0ULL) {
+		per_entry = 1ULL;
+	}
+
+	moves = ((hot_load - cold_load) / 2ULL) / per_entry;
+	if (moves == 0ULL) {
+		moves = 1ULL;
+	}
+	if (moves > (nveu64_t)(hot_cnt - 1U)) {
+		moves = (nveu64_t)(hot_cnt - 1U);
+	}
+	if (moves > (nveu64_t)RSS_REBAL_MAX_MOVES) {
+		moves = (nveu64_t)RSS_REBAL_MAX_MOVES;
+	}
+
+	return (nveu32_t)moves;
+}
+
+/**
+ * @brief rss_rebal_done - Store rebalanced RSS table once its job completed.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] status: Final status of the job.
+ */
+static void rss_rebal_done(struct osi_core_priv_data *const osi_core,
+			   const nve32_t status)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+
+	rss_job_done(osi_core, status);
+	if (status == 0) {
+		(void)osi_memcpy(osi_core->rss.table, l_core->rss_stage_table,
+				 sizeof(osi_core->rss.table));
+		(void)osi_memcpy(l_core->rss_rx_pkt_n,
+				 l_core->rss_stage_rx_pkt_n,
+				 sizeof(l_core->rss_rx_pkt_n));
+	} else {
+		l_core->rss_stage_moved = 0U;
+	}
+}
+
+nve32_t rss_rebalance(struct osi_core_priv_data *const osi_core,
+		      struct osi_rss_rebalance *const rb,
+		      struct indir_job *const job)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu32_t table[OSI_RSS_MAX_TABLE_SIZE];
+	nveu64_t load[OSI_MGBE_MAX_NUM_CHANS];
+	nveu32_t cnt[OSI_MGBE_MAX_NUM_CHANS];
+	nveu32_t rx_chan[OSI_MGBE_MAX_NUM_CHANS];
+	nveu32_t thr = rb->threshold;
+	nveu64_t total = 0ULL;
+	nveu64_t limit;
+	nveu32_t hot = OSI_MGBE_MAX_NUM_CHANS;
+	nveu32_t cold = OSI_MGBE_MAX_NUM_CHANS;
+	nveu32_t moves, moved = 0U, chan, i;
+	nve32_t ret = -1;
+
+	rb->moved = 0U;
+	if (job != OSI_NULL) {
+		l_core->rss_stage_moved = 0U;
+	}
+	if (rss_job_busy(osi_core, job) == OSI_ENABLE) {
+		goto exit_func;
+	}
+
+	if ((rss_is_active(osi_core) == OSI_DISABLE) ||
+	    (osi_core->num_mtl_queues > OSI_MGBE_MAX_NUM_CHANS)) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "RSS: not enabled\n", 0ULL);
+		goto exit_func;
+	}
+
+	if (thr == 0U) {
+		thr = RSS_REBAL_DEF_THRESHOLD;
+	}
+
+	(void)osi_memset(cnt, 0, sizeof(cnt));
+	(void)osi_memset(rx_chan, 0, sizeof(rx_chan));
+	for (i = 0U; i < OSI_MGBE_MAX_NUM_CHANS; i++) {
+		/* counters restart from 0 when DMA is reinitialized */
+		if (rb->q_rx_pkt_n[i] >= l_core->rss_rx_pkt_n[i]) {
+			load[i] = rb->q_rx_pkt_n[i] - l_core->rss_rx_pkt_n[i];
+		} else {
+			load[i] = rb->q_rx_pkt_n[i];
+		}
+	}
+
+	/* Rebalance works on a copy, osi_core->rss is only updated once the
+	 * new table is accepted by HW */
+	(void)osi_memcpy(table, osi_core->rss.table, sizeof(table));
+	for (i = 0U; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
+		if (table[i] < OSI_MGBE_MAX_NUM_CHANS) {
+			cnt[table[i]]++;
+		}
+	}
+
+	/* Loads are per DMA channel, map enabled Rx queues to the DMA
+	 * channels serving them */
+	for (i = 0U; i < osi_core->num_mtl_queues; i++) {
+		chan = rss_rxq_dma_chan(osi_core->mtl_queues[i]);
+		if (chan < OSI_MGBE_MAX_NUM_CHANS) {
+			rx_chan[chan] = OSI_ENABLE;
+		}
+	}
+
+	for (chan = 0U; chan < OSI_MGBE_MAX_NUM_CHANS; chan++) {
+		if (rx_chan[chan] == OSI_DISABLE) {
+			continue;
+		}
+		total += load[chan];
+		if ((cnt[chan] > 1U) &&
+		    ((hot == OSI_MGBE_MAX_NUM_CHANS) ||
+		     (load[chan] > load[hot]))) {
+			hot = chan;
+		}
+		/* Channels left out of the table by OSD are never added */
+		if ((cnt[chan] > 0U) &&
+		    ((cold == OSI_MGBE_MAX_NUM_CHANS) ||
+		     (load[chan] < load[cold]))) {
+			cold = chan;
+		}
+	}
+
+	if ((total < RSS_REBAL_MIN_PKTS) || (hot == OSI_MGBE_MAX_NUM_CHANS) ||
+	    (cold == OSI_MGBE_MAX_NUM_CHANS) || (hot == cold) ||
+	    (load[hot] <= load[cold])) {
+		goto balanced;
+	}
+
+	limit = ((load[cold] / 100ULL) * (nveu64_t)thr) +
+		(((load[cold] % 100ULL) * (nveu64_t)thr) / 100ULL);
+	if ((load[hot] - load[cold]) <= limit) {
+		goto balanced;
+	}
+
+	moves = rss_rebal_moves(load[hot], load[cold], cnt[hot]);
+	for (i = OSI_RSS_MAX_TABLE_SIZE; (i > 0U) && (moved < moves); i--) {
+		if (table[i - 1U] == hot) {
+			table[i - 1U] = cold;
+			moved++;
+		}
+	}
+
+	ret = rss_table_write(osi_core, table, job);
+	if (ret < 0) {
+		goto exit_func;
+	}
+
+	if (job != OSI_NULL) {
+		/* Table, moves and samples are taken once HW accepted it */
+		(void)osi_memcpy(l_core->rss_stage_table, table,
+				 sizeof(table));
+		(void)osi_memcpy(l_core->rss_stage_rx_pkt_n, rb->q_rx_pkt_n,
+				 sizeof(l_core->rss_stage_rx_pkt_n));
+		l_core->rss_stage_moved = moved;
+		job->sw_done = rss_rebal_done;
+		goto exit_func;
+	}
+
+	(void)osi_memcpy(osi_core->rss.table, table, sizeof(table));
+	rb->moved = moved;
+balanced:
+	/* Samples are used up only when the call succeeds */
+	(void)osi_memcpy(l_core->rss_rx_pkt_n, rb->q_rx_pkt_n,
+			 sizeof(l_core->rss_rx_pkt_n));
+	ret = 0;
+exit_func:
+	return ret;
+}
+
+nve32_t rss_profile_config(struct osi_core_priv_data *const osi_core,
+			   const struct osi_rss_profile *const profile,
+			   struct indir_job *const job)
+{
+	struct core_local *l_core = (struct core_local *)(void *)osi_core;
+	nveu8_t key[OSI_RSS_HASH_KEY_SIZE];
+	nveu16_t seed = profile->sym_seed;
+	nveu32_t i;
+	nve32_t ret = -1;
+
+	if ((profile->hash_types == 0U) ||
+	    ((profile->hash_types & ~OSI_RSS_HASH_ALL) != 0U) ||
+	    ((profile->symmetric != OSI_ENABLE) &&
+	     (profile->symmetric != OSI_DISABLE))) {
+		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_INVALID,
+			     "RSS: invalid profile\n",
+			     (nveul64_t)profile->hash_types);
+		goto exit_func;
+	}
+
+	(void)osi_memcpy(key, osi_core->rss.key, sizeof(key));
+	if (profile->symmetric == OSI_ENABLE) {
+		if (seed == 0U) {
+			seed = (nveu16_t)RSS_SYM_DEF_SEED;
+		}
+		for (i = 0U; i < OSI_RSS_HASH_KEY_SIZE; i += 2U) {
+			key[i] = (nveu8_t)(seed >> 8U);
+			key[i + 1U] = (nveu8_t)(seed & 0xFFU);
+		}
+	}
+
+	/* osi_core->rss keeps the old profile until HW took the new one */
+	ret = rss_program(osi_core, key, profile->hash_types, job);
+	if (ret < 0) {
+		goto exit_func;
+	}
+
+	if (job == OSI_NULL) {
+		(void)osi_memcpy(osi_core->rss.key, key, sizeof(key));
+		osi_core->rss.hash_types = profile->hash_types;
+	} else {
+		(void)osi_memcpy(l_core->rss_stage_key, key, sizeof(key));
+		l_core->rss_stage_hash_types = profile->hash_types;
+		job->sw_done = rss_profile_done;
+	}
+exit_func:
+	return ret;
+}
+#endif /* !OSI_STRIPPED_LIB */
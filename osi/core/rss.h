@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RSS_H
+#define RSS_H
+
+#include <osi_core.h>
+#include "core_local.h"
+
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @addtogroup RSS rebalance defines
+ *
+ * @brief Default imbalance threshold and limits of one rebalance pass
+ * @{
+ */
+#define RSS_REBAL_DEF_THRESHOLD		25U
+#define RSS_REBAL_MIN_PKTS		1024ULL
+#define RSS_REBAL_MAX_MOVES		8U
+/** @} */
+
+/**
+ * @brief Default 16-bit pattern of symmetric RSS hash key
+ */
+#define RSS_SYM_DEF_SEED		0x6D5AU
+
+/**
+ * @brief rss_config - Program RSS hash key and indirection table.
+ *
+ * Algorithm: Program complete RSS configuration from osi_core->rss and
+ *	record the programmed indirection table for later incremental
+ *	updates. With a job, HW writes are only queued into it.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t rss_config(struct osi_core_priv_data *const osi_core,
+		   struct indir_job *const job);
+
+/**
+ * @brief rss_table_update - Program changed RSS indirection table entries.
+ *
+ * Algorithm: Compare osi_core->rss.table against the entries last written
+ *	into HW and program only the differing ones. All entries are written
+ *	when HW content is unknown, e.g. after MAC reset. Hash key is not
+ *	touched. With a job, HW writes are only queued into it.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t rss_table_update(struct osi_core_priv_data *const osi_core,
+			 struct indir_job *const job);
+
+/**
+ * @brief rss_rebalance - Move RSS indirection entries off a hot channel.
+ *
+ * Algorithm:
+ * - Compute per channel Rx packets since the last successful call from
+ *   the OSD provided counters. Candidate channels are the DMA channels
+ *   serving the enabled MTL Rx queues which are in the indirection
+ *   table, a channel left out of it by OSD never gets entries.
+ * - If the most loaded channel exceeds the least loaded Rx channel by
+ *   more than the threshold, move a share of its indirection entries,
+ *   bounded by RSS_REBAL_MAX_MOVES, to the least loaded channel. The
+ *   load of one entry is estimated as channel load over its entries.
+ * - Program only the changed entries of the new table. The table, moved
+ *   count and counter samples are stored once HW writes succeeded, with
+ *   a job only once it completed.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in, out] rb: RSS rebalance parameters (#osi_rss_rebalance)
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t rss_rebalance(struct osi_core_priv_data *const osi_core,
+		      struct osi_rss_rebalance *const rb,
+		      struct indir_job *const job);
+
+/**
+ * @brief rss_profile_config - Configure RSS hash key kind and hash types.
+ *
+ * Algorithm:
+ * - Validate hashed packet types.
+ * - For symmetric profile, fill the hash key with a repeating 16-bit
+ *   pattern. Toeplitz key windows then only depend on the input bit
+ *   offset modulo 16, and since addresses and ports of both directions
+ *   are swapped in 16-bit aligned fields, both directions of a flow hash
+ *   the same.
+ * - Program complete RSS configuration with the new key and hash types.
+ *   Store them in osi_core->rss only once HW took them, for a job in its
+ *   sw_done.
+ *
+ * @param[in] osi_core: OSI core private data structure.
+ * @param[in] profile: RSS profile (#osi_rss_profile)
+ * @param[in] job: Asynchronous job or OSI_NULL to program right away.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure.
+ */
+nve32_t rss_profile_config(struct osi_core_priv_data *const osi_core,
+			   const struct osi_rss_profile *const profile,
+			   struct indir_job *const job);
+#endif /* !OSI_STRIPPED_LIB */
+#endif /* RSS_H */
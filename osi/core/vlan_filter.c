@@ -168,47 +168,12 @@ static inline nve32_t enqueue_vlan_id(struct osi_core_priv_data *osi_core,
 }
 
 /**
- * @brief poll_for_vlan_filter_reg_rw - Poll for VLAN filter register update
- *
- * Algorithm: Program VLAN filter registers through indirect address
- * mechanism.
- *
- * @param[in] addr: MAC base address
- *
- * @return 0 on success.
- * @return -1 on failure.
+ * @brief MAC_VLAN_Tag_Ctrl indirect access protocol
  */
-static inline nve32_t poll_for_vlan_filter_reg_rw(
-					struct osi_core_priv_data *osi_core)
-{
-	nveu32_t retry = 10;
-	nveu32_t count;
-	nveu32_t val = 0;
-	nve32_t cond = 1;
-
-	count = 0;
-	while (cond == 1) {
-		if (count > retry) {
-			OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-				     "VLAN filter update timedout\n", 0ULL);
-			return -1;
-		}
-
-		count++;
-
-		val = osi_readl((nveu8_t *)osi_core->base +
-				MAC_VLAN_TAG_CTRL);
-		if ((val & MAC_VLAN_TAG_CTRL_OB) == OSI_NONE) {
-			/* Set cond to 0 to exit loop */
-			cond = 0;
-		} else {
-			/* wait for 10 usec for XB clear */
-			osi_core->osd_ops.udelay(10U);
-		}
-	}
-
-	return 0;
-}
+static const struct indir_proto vlan_filter_proto = {
+	INDIR_PROTO_VLAN, MAC_VLAN_TAG_CTRL_OB, OSI_NONE,
+	MAC_VLAN_TAG_CTRL_OB_WAIT, MAC_VLAN_TAG_CTRL_OB_RETRY
+};
 
 /**
  * @brief update_vlan_filters - Update HW filter registers
@@ -228,25 +193,17 @@ static inline nve32_t update_vlan_filters(struct osi_core_priv_data *osi_core,
 				      nveu32_t val)
 {
 	nveu8_t *base = (nveu8_t *)osi_core->base;
-	nve32_t ret = 0;
+	nveu32_t ctrl;
 
-	osi_writel(val, base + MAC_VLAN_TAG_DATA);
+	ctrl = osi_readl(base + MAC_VLAN_TAG_CTRL);
+	ctrl &= (nveu32_t) ~MAC_VLAN_TAG_CTRL_OFS_MASK;
+	ctrl |= vid_idx << MAC_VLAN_TAG_CTRL_OFS_SHIFT;
+	ctrl &= ~MAC_VLAN_TAG_CTRL_CT;
+	ctrl |= MAC_VLAN_TAG_CTRL_OB;
 
-	val = osi_readl(base + MAC_VLAN_TAG_CTRL);
-	val &= (nveu32_t) ~MAC_VLAN_TAG_CTRL_OFS_MASK;
-	val |= vid_idx << MAC_VLAN_TAG_CTRL_OFS_SHIFT;
-	val &= ~MAC_VLAN_TAG_CTRL_CT;
-	val |= MAC_VLAN_TAG_CTRL_OB;
-	osi_writel(val, base + MAC_VLAN_TAG_CTRL);
-
-	ret = poll_for_vlan_filter_reg_rw(osi_core);
-	if (ret < 0) {
-		OSI_CORE_ERR(osi_core->osd, OSI_LOG_ARG_HW_FAIL,
-			     "Failed to update VLAN filters\n", 0ULL);
-		return -1;
-	}
-
-	return 0;
+	return indir_write(osi_core, &vlan_filter_proto,
+			   base + MAC_VLAN_TAG_DATA, base + MAC_VLAN_TAG_CTRL,
+			   val, ctrl);
 }
 
 /**
@@ -41,6 +41,8 @@
 #define MAC_VLAN_TAG_CTRL_OFS_SHIFT	2U
 #define MAC_VLAN_TAG_CTRL_CT	OSI_BIT(1)
 #define MAC_VLAN_TAG_CTRL_OB	OSI_BIT(0)
+#define MAC_VLAN_TAG_CTRL_OB_WAIT	10U
+#define MAC_VLAN_TAG_CTRL_OB_RETRY	10U
 #define MAC_VLAN_TAG_CTRL_VHTM	OSI_BIT(25)
 #define MAC_VLAN_TAG_DATA_ETV	OSI_BIT(16)
 #define MAC_VLAN_TAG_DATA_VEN	OSI_BIT(17)
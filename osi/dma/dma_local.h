@@ -44,6 +44,23 @@
 #define MGBE_MAX_RING_SZ	16384U
 #define HW_MIN_RING_SZ		4U
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief Software RSS Toeplitz input size and lookup table geometry.
+ * Largest input is IPv6 source/destination address and L4 ports.
+ */
+#define SW_RSS_MAX_INPUT	36U
+#define SW_RSS_LUT_ROWS		(SW_RSS_MAX_INPUT * 2U)
+#define SW_RSS_LUT_COLS		16U
+
+/**
+ * @brief Statistics update sequences of dma_local. Data path updates of
+ * a channel use the sequence of the channel, clears use DMA_STATS_SEQ_CTRL.
+ */
+#define DMA_STATS_SEQ_CTRL	OSI_MGBE_MAX_NUM_CHANS
+#define DMA_STATS_SEQ_CNT	(OSI_MGBE_MAX_NUM_CHANS + 1U)
+#endif /* !OSI_STRIPPED_LIB */
+
 /**
  * @brief MAC DMA Channel operations
  */
@@ -110,8 +127,67 @@ struct dma_local {
 	nveu32_t num_max_chans;
 	/** Exact MAC used across SOCs 0:Legacy EQOS, 1:Orin EQOS, 2:Orin MGBE */
 	nveu32_t l_mac_ver;
+	/** Shadow of DMA channel configuration registers, one row per
+	 * channel indexed by channel number */
+	struct osi_reg_shadow reg_shadow[OSI_MGBE_MAX_NUM_CHANS];
+#ifndef OSI_STRIPPED_LIB
+	/** Software RSS active (OSI_ENABLE) with sw_rss_lut built from key */
+	nveu32_t sw_rss_enabled;
+	/** Toeplitz hash contribution of every value of every input nibble */
+	nveu32_t sw_rss_lut[SW_RSS_LUT_ROWS][SW_RSS_LUT_COLS];
+	/** Update sequences of osi_dma pkt_err_stats and dstats, one per
+	 * DMA channel for the data path and DMA_STATS_SEQ_CTRL for clears */
+	struct osi_stats_seq stats_seq[DMA_STATS_SEQ_CNT];
+#endif /* !OSI_STRIPPED_LIB */
 };
 
+#ifndef OSI_STRIPPED_LIB
+/**
+ * @brief sw_rss_build_lut - Build software RSS Toeplitz lookup table
+ *
+ * @note
+ * Algorithm:
+ *  - For every input nibble position and nibble value, XOR the 32-bit
+ *    key windows of the set bits, so that hashing takes one lookup per
+ *    input nibble instead of one key shift per input bit.
+ *
+ * @param[in, out] l_dma: OSI DMA local data structure.
+ *
+ * @note
+ * API Group:
+ * - Initialization: Yes
+ * - Run time: Yes
+ * - De-initialization: No
+ */
+void sw_rss_build_lut(struct dma_local *l_dma);
+
+/**
+ * @brief sw_rss_hash - Compute software RSS hash of a received packet
+ *
+ * @note
+ * Algorithm:
+ *  - Parse Ethernet (with up to two VLAN tags), IPv4/IPv6 and TCP/UDP
+ *    headers and hash the same tuple MGBE HW RSS hashes for the
+ *    configured hash types.
+ *  - Fill rx_hash, rx_hash_type and rss_hint and set OSI_PKT_CX_RSS.
+ *    Non IP packets and packet types not hashed are left without hash.
+ *
+ * @param[in] osi_dma: OSI DMA private data structure.
+ * @param[in] pkt: Start of received packet.
+ * @param[in] len: Number of valid bytes at pkt.
+ * @param[in, out] rx_pkt_cx: Per-Rx packet context structure
+ *
+ * @note
+ * API Group:
+ * - Initialization: No
+ * - Run time: Yes
+ * - De-initialization: No
+ */
+void sw_rss_hash(const struct osi_dma_priv_data *const osi_dma,
+		 const nveu8_t *const pkt, const nveu32_t len,
+		 struct osi_rx_pkt_cx *rx_pkt_cx);
+#endif /* !OSI_STRIPPED_LIB */
+
 #ifndef OSI_STRIPPED_LIB
 /**
  * @brief eqos_init_dma_chan_ops - Initialize eqos DMA operations.
@@ -227,6 +303,78 @@ static inline void update_rx_tail_ptr(const struct osi_dma_priv_data *const osi_
 	osi_writel(L32(tailptr), (nveu8_t *)osi_dma->base + tail_ptr_reg[osi_dma->mac]);
 }
 
+#ifdef OSI_DMA_PROFILE
+/**
+ * @brief dma_prof_start - Sample cycle counter at hot path entry.
+ *
+ * @param[in] osi_dma: OSI DMA private data structure.
+ *
+ * @return Cycle counter, 0 when profiling is not enabled by OSD.
+ */
+static inline nveu64_t dma_prof_start(const struct osi_dma_priv_data *const osi_dma)
+{
+	nveu64_t cycles = 0U;
+
+	if (osi_dma->osd_ops.get_cycles != OSI_NULL) {
+		cycles = osi_dma->osd_ops.get_cycles();
+	}
+
+	return cycles;
+}
+
+/**
+ * @brief dma_prof_end - Account one hot path call.
+ *
+ * @param[in, out] osi_dma: OSI DMA private data structure.
+ * @param[in] path: Hot path, one of OSI_DMA_PROF_*.
+ * @param[in] start: Cycle counter returned by dma_prof_start().
+ * @param[in] pkts: Packets handled by the call, negative on failure.
+ */
+static inline void dma_prof_end(struct osi_dma_priv_data *const osi_dma,
+				const nveu32_t path, const nveu64_t start,
+				const nve32_t pkts)
+{
+	struct osi_dma_prof *prof = &osi_dma->prof[path];
+	nveu64_t cycles;
+
+	if (osi_dma->osd_ops.get_cycles != OSI_NULL) {
+		cycles = osi_dma->osd_ops.get_cycles() - start;
+		prof->calls = osi_update_stats_counter(prof->calls, 1UL);
+		if (pkts > 0) {
+			prof->pkts = osi_update_stats_counter(prof->pkts,
+							      (nveu64_t)pkts);
+		}
+		prof->cycles = osi_update_stats_counter(prof->cycles, cycles);
+		if (cycles > prof->max_cycles) {
+			prof->max_cycles = cycles;
+		}
+	}
+}
+#endif /* OSI_DMA_PROFILE */
+
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+/**
+ * @brief dma_hist_log2 - Count a value into its log2 histogram bucket.
+ *
+ * @param[in, out] hist: Histogram of OSI_DMA_HIST_CNT buckets.
+ * @param[in] val: Value to be counted.
+ */
+static inline void dma_hist_log2(nveu64_t *const hist, const nveu32_t val)
+{
+	nveu32_t idx = 0U;
+
+	if (val > 1U) {
+		idx = 31U - (nveu32_t)__builtin_clz(val);
+	}
+
+	if (idx > (OSI_DMA_HIST_CNT - 1U)) {
+		idx = OSI_DMA_HIST_CNT - 1U;
+	}
+
+	hist[idx] = osi_update_stats_counter(hist[idx], 1UL);
+}
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
+
 /** @} */
 
 #endif /* INCLUDED_DMA_LOCAL_H */
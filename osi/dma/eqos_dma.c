@@ -93,6 +93,7 @@ static void eqos_config_slot(struct osi_dma_priv_data *osi_dma,
  */
 static void eqos_debug_intr_config(struct osi_dma_priv_data *osi_dma)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chinx;
 	nveu32_t chan;
 	nveu32_t val;
@@ -101,30 +102,38 @@ static void eqos_debug_intr_config(struct osi_dma_priv_data *osi_dma)
 	if (enable == OSI_ENABLE) {
 		for (chinx = 0; chinx < osi_dma->num_dma_chans; chinx++) {
 			chan = osi_dma->dma_chans[chinx];
-			val = osi_readl((nveu8_t *)osi_dma->base +
-					EQOS_DMA_CHX_INTR_ENA(chan));
+			val = osi_shadow_readl(&l_dma->reg_shadow[chan],
+					       OSI_SHADOW_DMA_INTR_ENA,
+					       osi_dma->base,
+					       EQOS_DMA_CHX_INTR_ENA(chan));
 
 			val |= (EQOS_DMA_CHX_INTR_AIE |
 				EQOS_DMA_CHX_INTR_FBEE |
 				EQOS_DMA_CHX_INTR_RBUE |
 				EQOS_DMA_CHX_INTR_TBUE |
 				EQOS_DMA_CHX_INTR_NIE);
-			osi_writel(val, (nveu8_t *)osi_dma->base +
-				   EQOS_DMA_CHX_INTR_ENA(chan));
+			osi_shadow_writel(&l_dma->reg_shadow[chan],
+					  OSI_SHADOW_DMA_INTR_ENA, val,
+					  osi_dma->base,
+					  EQOS_DMA_CHX_INTR_ENA(chan));
 		}
 
 	} else {
 		for (chinx = 0; chinx < osi_dma->num_dma_chans; chinx++) {
 			chan = osi_dma->dma_chans[chinx];
-			val = osi_readl((nveu8_t *)osi_dma->base +
-					EQOS_DMA_CHX_INTR_ENA(chan));
+			val = osi_shadow_readl(&l_dma->reg_shadow[chan],
+					       OSI_SHADOW_DMA_INTR_ENA,
+					       osi_dma->base,
+					       EQOS_DMA_CHX_INTR_ENA(chan));
 			val &= (~EQOS_DMA_CHX_INTR_AIE &
 				~EQOS_DMA_CHX_INTR_FBEE &
 				~EQOS_DMA_CHX_INTR_RBUE &
 				~EQOS_DMA_CHX_INTR_TBUE &
 				~EQOS_DMA_CHX_INTR_NIE);
-			osi_writel(val, (nveu8_t *)osi_dma->base +
-				   EQOS_DMA_CHX_INTR_ENA(chan));
+			osi_shadow_writel(&l_dma->reg_shadow[chan],
+					  OSI_SHADOW_DMA_INTR_ENA, val,
+					  osi_dma->base,
+					  EQOS_DMA_CHX_INTR_ENA(chan));
 		}
 	}
 }
@@ -80,6 +80,7 @@ static void mgbe_config_slot(struct osi_dma_priv_data *osi_dma,
  */
 static void mgbe_debug_intr_config(struct osi_dma_priv_data *osi_dma)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chinx;
 	nveu32_t chan;
 	nveu32_t val;
@@ -88,30 +89,38 @@ static void mgbe_debug_intr_config(struct osi_dma_priv_data *osi_dma)
 	if (enable == OSI_ENABLE) {
 		for (chinx = 0; chinx < osi_dma->num_dma_chans; chinx++) {
 			chan = osi_dma->dma_chans[chinx];
-			val = osi_readl((nveu8_t *)osi_dma->base +
-					MGBE_DMA_CHX_INTR_ENA(chan));
+			val = osi_shadow_readl(&l_dma->reg_shadow[chan],
+					       OSI_SHADOW_DMA_INTR_ENA,
+					       osi_dma->base,
+					       MGBE_DMA_CHX_INTR_ENA(chan));
 
 			val |= (MGBE_DMA_CHX_INTR_AIE |
 				MGBE_DMA_CHX_INTR_FBEE |
 				MGBE_DMA_CHX_INTR_RBUE |
 				MGBE_DMA_CHX_INTR_TBUE |
 				MGBE_DMA_CHX_INTR_NIE);
-			osi_writel(val, (nveu8_t *)osi_dma->base +
-				   MGBE_DMA_CHX_INTR_ENA(chan));
+			osi_shadow_writel(&l_dma->reg_shadow[chan],
+					  OSI_SHADOW_DMA_INTR_ENA, val,
+					  osi_dma->base,
+					  MGBE_DMA_CHX_INTR_ENA(chan));
 		}
 
 	} else {
 		for (chinx = 0; chinx < osi_dma->num_dma_chans; chinx++) {
 			chan = osi_dma->dma_chans[chinx];
-			val = osi_readl((nveu8_t *)osi_dma->base +
-					MGBE_DMA_CHX_INTR_ENA(chan));
+			val = osi_shadow_readl(&l_dma->reg_shadow[chan],
+					       OSI_SHADOW_DMA_INTR_ENA,
+					       osi_dma->base,
+					       MGBE_DMA_CHX_INTR_ENA(chan));
 			val &= (~MGBE_DMA_CHX_INTR_AIE &
 				~MGBE_DMA_CHX_INTR_FBEE &
 				~MGBE_DMA_CHX_INTR_RBUE &
 				~MGBE_DMA_CHX_INTR_TBUE &
 				~MGBE_DMA_CHX_INTR_NIE);
-			osi_writel(val, (nveu8_t *)osi_dma->base +
-				   MGBE_DMA_CHX_INTR_ENA(chan));
+			osi_shadow_writel(&l_dma->reg_shadow[chan],
+					  OSI_SHADOW_DMA_INTR_ENA, val,
+					  osi_dma->base,
+					  MGBE_DMA_CHX_INTR_ENA(chan));
 		}
 	}
 }
@@ -368,9 +368,12 @@ fail:
 	return ret;
 }
 
-static inline void start_dma(const struct osi_dma_priv_data *const osi_dma, nveu32_t dma_chan)
+static inline void start_dma(struct osi_dma_priv_data *const osi_dma,
+			     nveu32_t dma_chan)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chan = dma_chan & 0xFU;
+	struct osi_reg_shadow *const sh = &l_dma->reg_shadow[chan];
 	const nveu32_t tx_dma_reg[2] = {
 		EQOS_DMA_CHX_TX_CTRL(chan),
 		MGBE_DMA_CHX_TX_CTRL(chan)
@@ -382,21 +385,27 @@ static inline void start_dma(const struct osi_dma_priv_data *const osi_dma, nveu
 	nveu32_t val;
 
 	/* Start Tx DMA */
-	val = osi_readl((nveu8_t *)osi_dma->base + tx_dma_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_TX_CTRL, osi_dma->base,
+			       tx_dma_reg[osi_dma->mac]);
 	val |= OSI_BIT(0);
-	osi_writel(val, (nveu8_t *)osi_dma->base + tx_dma_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_TX_CTRL, val, osi_dma->base,
+			  tx_dma_reg[osi_dma->mac]);
 
 	/* Start Rx DMA */
-	val = osi_readl((nveu8_t *)osi_dma->base + rx_dma_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_CTRL, osi_dma->base,
+			       rx_dma_reg[osi_dma->mac]);
 	val |= OSI_BIT(0);
 	val &= ~OSI_BIT(31);
-	osi_writel(val, (nveu8_t *)osi_dma->base + rx_dma_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_CTRL, val, osi_dma->base,
+			  rx_dma_reg[osi_dma->mac]);
 }
 
-static void init_dma_channel(const struct osi_dma_priv_data *const osi_dma,
+static void init_dma_channel(struct osi_dma_priv_data *const osi_dma,
 			     nveu32_t dma_chan)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chan = dma_chan & 0xFU;
+	struct osi_reg_shadow *const sh = &l_dma->reg_shadow[chan];
 	nveu32_t riwt = osi_dma->rx_riwt & 0xFFFU;
 	const nveu32_t intr_en_reg[2] = {
 		EQOS_DMA_CHX_INTR_ENA(chan),
@@ -449,17 +458,22 @@ static void init_dma_channel(const struct osi_dma_priv_data *const osi_dma,
 	nveu32_t val;
 
 	/* Enable Transmit/Receive interrupts */
-	val = osi_readl((nveu8_t *)osi_dma->base + intr_en_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_INTR_ENA, osi_dma->base,
+			       intr_en_reg[osi_dma->mac]);
 	val |= (DMA_CHX_INTR_TIE | DMA_CHX_INTR_RIE);
-	osi_writel(val, (nveu8_t *)osi_dma->base + intr_en_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_INTR_ENA, val, osi_dma->base,
+			  intr_en_reg[osi_dma->mac]);
 
 	/* Enable PBLx8 */
-	val = osi_readl((nveu8_t *)osi_dma->base + chx_ctrl_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_CTRL, osi_dma->base,
+			       chx_ctrl_reg[osi_dma->mac]);
 	val |= DMA_CHX_CTRL_PBLX8;
-	osi_writel(val, (nveu8_t *)osi_dma->base + chx_ctrl_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_CTRL, val, osi_dma->base,
+			  chx_ctrl_reg[osi_dma->mac]);
 
 	/* Program OSP, TSO enable and TXPBL */
-	val = osi_readl((nveu8_t *)osi_dma->base + tx_ctrl_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_TX_CTRL, osi_dma->base,
+			       tx_ctrl_reg[osi_dma->mac]);
 	val |= (DMA_CHX_TX_CTRL_OSP | DMA_CHX_TX_CTRL_TSE);
 
 	if (osi_dma->mac == OSI_MAC_HW_EQOS) {
@@ -478,9 +492,11 @@ static void init_dma_channel(const struct osi_dma_priv_data *const osi_dma,
 			val |= ((tx_pbl[osi_dma->mac] / 8U) << MGBE_DMA_CHX_CTRL_PBL_SHIFT);
 		}
 	}
-	osi_writel(val, (nveu8_t *)osi_dma->base + tx_ctrl_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_TX_CTRL, val, osi_dma->base,
+			  tx_ctrl_reg[osi_dma->mac]);
 
-	val = osi_readl((nveu8_t *)osi_dma->base + rx_ctrl_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_CTRL, osi_dma->base,
+			       rx_ctrl_reg[osi_dma->mac]);
 	val &= ~DMA_CHX_RBSZ_MASK;
 	/** Subtract 30 bytes again which were added for buffer address alignment
 	 * HW don't need those extra 30 bytes. If data length received more than
@@ -498,32 +514,43 @@ static void init_dma_channel(const struct osi_dma_priv_data *const osi_dma,
 			val |= ((rx_pbl[osi_dma->mac] / 8U) << MGBE_DMA_CHX_CTRL_PBL_SHIFT);
 		}
 	}
-	osi_writel(val, (nveu8_t *)osi_dma->base + rx_ctrl_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_CTRL, val, osi_dma->base,
+			  rx_ctrl_reg[osi_dma->mac]);
 
 	if ((osi_dma->use_riwt == OSI_ENABLE) &&
 	    (osi_dma->rx_riwt < UINT_MAX)) {
-		val = osi_readl((nveu8_t *)osi_dma->base + rx_wdt_reg[osi_dma->mac]);
+		val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_WDT, osi_dma->base,
+				       rx_wdt_reg[osi_dma->mac]);
 		val &= ~DMA_CHX_RX_WDT_RWT_MASK;
 		val |= rwt_val[osi_dma->mac];
-		osi_writel(val, (nveu8_t *)osi_dma->base + rx_wdt_reg[osi_dma->mac]);
+		osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_WDT, val, osi_dma->base,
+				  rx_wdt_reg[osi_dma->mac]);
 
-		val = osi_readl((nveu8_t *)osi_dma->base + rx_wdt_reg[osi_dma->mac]);
+		val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_WDT, osi_dma->base,
+				       rx_wdt_reg[osi_dma->mac]);
 		val &= ~rwtu_mask[osi_dma->mac];
 		val |= rwtu_val[osi_dma->mac];
-		osi_writel(val, (nveu8_t *)osi_dma->base + rx_wdt_reg[osi_dma->mac]);
+		osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_WDT, val, osi_dma->base,
+				  rx_wdt_reg[osi_dma->mac]);
 	}
 
 	if (osi_dma->mac == OSI_MAC_HW_MGBE) {
 		/* Update ORRQ in DMA_CH(#i)_Tx_Control2 register */
-		val = osi_readl((nveu8_t *)osi_dma->base + MGBE_DMA_CHX_TX_CNTRL2(chan));
+		val = osi_shadow_readl(sh, OSI_SHADOW_DMA_TX_CTRL2,
+				       osi_dma->base,
+				       MGBE_DMA_CHX_TX_CNTRL2(chan));
 		val |= (((MGBE_DMA_CHX_TX_CNTRL2_ORRQ_RECOMMENDED / osi_dma->num_dma_chans)) <<
 			MGBE_DMA_CHX_TX_CNTRL2_ORRQ_SHIFT);
-		osi_writel(val, (nveu8_t *)osi_dma->base + MGBE_DMA_CHX_TX_CNTRL2(chan));
+		osi_shadow_writel(sh, OSI_SHADOW_DMA_TX_CTRL2, val,
+				  osi_dma->base, MGBE_DMA_CHX_TX_CNTRL2(chan));
 
 		/* Update OWRQ in DMA_CH(#i)_Rx_Control2 register */
-		val = osi_readl((nveu8_t *)osi_dma->base + MGBE_DMA_CHX_RX_CNTRL2(chan));
+		val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_CTRL2,
+				       osi_dma->base,
+				       MGBE_DMA_CHX_RX_CNTRL2(chan));
 		val |= (owrq_arr[osi_dma->num_dma_chans - 1U] << MGBE_DMA_CHX_RX_CNTRL2_OWRQ_SHIFT);
-		osi_writel(val, (nveu8_t *)osi_dma->base + MGBE_DMA_CHX_RX_CNTRL2(chan));
+		osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_CTRL2, val,
+				  osi_dma->base, MGBE_DMA_CHX_RX_CNTRL2(chan));
 	}
 }
 
@@ -564,6 +591,11 @@ nve32_t osi_hw_dma_init(struct osi_dma_priv_data *osi_dma)
 		goto fail;
 	}
 
+	/* DMA registers are at reset values after MAC reset */
+	for (i = 0; i < OSI_MGBE_MAX_NUM_CHANS; i++) {
+		osi_shadow_reset(&l_dma->reg_shadow[i]);
+	}
+
 	ret = dma_desc_init(osi_dma);
 	if (ret != 0) {
 		goto fail;
@@ -608,14 +640,26 @@ nve32_t osi_hw_dma_init(struct osi_dma_priv_data *osi_dma)
 		osi_dma->ptp_flag = (OSI_PTP_SYNC_SLAVE | OSI_PTP_SYNC_TWOSTEP);
 	}
 
+#ifdef OSI_REG_SHADOW_CHECK
+	for (i = 0; i < OSI_MGBE_MAX_NUM_CHANS; i++) {
+		if (l_dma->reg_shadow[i].mismatch != 0U) {
+			OSI_DMA_ERR(osi_dma->osd, OSI_LOG_ARG_HW_FAIL,
+				    "DMA register shadow mismatch\n",
+				    (nveu64_t)l_dma->reg_shadow[i].mismatch);
+		}
+	}
+#endif /* OSI_REG_SHADOW_CHECK */
+
 fail:
 	return ret;
 }
 
-static inline void stop_dma(const struct osi_dma_priv_data *const osi_dma,
+static inline void stop_dma(struct osi_dma_priv_data *const osi_dma,
 			    nveu32_t dma_chan)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chan = dma_chan & 0xFU;
+	struct osi_reg_shadow *const sh = &l_dma->reg_shadow[chan];
 	const nveu32_t dma_tx_reg[2] = {
 		EQOS_DMA_CHX_TX_CTRL(chan),
 		MGBE_DMA_CHX_TX_CTRL(chan)
@@ -627,15 +671,19 @@ static inline void stop_dma(const struct osi_dma_priv_data *const osi_dma,
 	nveu32_t val;
 
 	/* Stop Tx DMA */
-	val = osi_readl((nveu8_t *)osi_dma->base + dma_tx_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_TX_CTRL, osi_dma->base,
+			       dma_tx_reg[osi_dma->mac]);
 	val &= ~OSI_BIT(0);
-	osi_writel(val, (nveu8_t *)osi_dma->base + dma_tx_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_TX_CTRL, val, osi_dma->base,
+			  dma_tx_reg[osi_dma->mac]);
 
 	/* Stop Rx DMA */
-	val = osi_readl((nveu8_t *)osi_dma->base + dma_rx_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_CTRL, osi_dma->base,
+			       dma_rx_reg[osi_dma->mac]);
 	val &= ~OSI_BIT(0);
 	val |= OSI_BIT(31);
-	osi_writel(val, (nveu8_t *)osi_dma->base + dma_rx_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_CTRL, val, osi_dma->base,
+			  dma_rx_reg[osi_dma->mac]);
 }
 
 nve32_t osi_hw_dma_deinit(struct osi_dma_priv_data *osi_dma)
@@ -957,6 +1005,9 @@ fail:
 nve32_t osi_hw_transmit(struct osi_dma_priv_data *osi_dma, nveu32_t chan)
 {
 	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
+#ifdef OSI_DMA_PROFILE
+	nveu64_t start;
+#endif /* OSI_DMA_PROFILE */
 	nve32_t ret = 0;
 
 	if (osi_unlikely(dma_validate_args(osi_dma, l_dma) < 0)) {
@@ -976,7 +1027,14 @@ nve32_t osi_hw_transmit(struct osi_dma_priv_data *osi_dma, nveu32_t chan)
 		goto fail;
 	}
 
+#ifdef OSI_DMA_PROFILE
+	start = dma_prof_start(osi_dma);
 	ret = hw_transmit(osi_dma, osi_dma->tx_ring[chan], chan);
+	dma_prof_end(osi_dma, OSI_DMA_PROF_XMIT, start,
+		     (ret == 0) ? 1 : -1);
+#else
+	ret = hw_transmit(osi_dma, osi_dma->tx_ring[chan], chan);
+#endif /* OSI_DMA_PROFILE */
 fail:
 	return ret;
 }
@@ -1109,4 +1167,154 @@ nve32_t osi_txring_empty(struct osi_dma_priv_data *osi_dma, nveu32_t chan)
 
 	return (tx_ring->clean_idx == tx_ring->cur_tx_idx) ? 1 : 0;
 }
+
+nve32_t osi_config_sw_rss(struct osi_dma_priv_data *osi_dma)
+{
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
+
+	if (dma_validate_args(osi_dma, l_dma) < 0) {
+		return -1;
+	}
+
+	if ((osi_dma->sw_rss.enable != OSI_ENABLE) &&
+	    (osi_dma->sw_rss.enable != OSI_DISABLE)) {
+		OSI_DMA_ERR(osi_dma->osd, OSI_LOG_ARG_INVALID,
+			    "dma: Invalid sw RSS enable\n",
+			    osi_dma->sw_rss.enable);
+		return -1;
+	}
+
+	l_dma->sw_rss_enabled = OSI_DISABLE;
+	if (osi_dma->sw_rss.enable == OSI_ENABLE) {
+		sw_rss_build_lut(l_dma);
+		l_dma->sw_rss_enabled = OSI_ENABLE;
+	}
+
+	return 0;
+}
+
+nve32_t osi_sw_rss_hash(struct osi_dma_priv_data *osi_dma,
+			const nveu8_t *pkt, nveu32_t len,
+			struct osi_rx_pkt_cx *rx_pkt_cx)
+{
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
+
+	if ((dma_validate_args(osi_dma, l_dma) < 0) || (pkt == OSI_NULL) ||
+	    (rx_pkt_cx == OSI_NULL)) {
+		return -1;
+	}
+
+	if (l_dma->sw_rss_enabled != OSI_ENABLE) {
+		OSI_DMA_ERR(osi_dma->osd, OSI_LOG_ARG_INVALID,
+			    "dma: sw RSS not enabled\n", 0ULL);
+		return -1;
+	}
+
+	if (len > rx_pkt_cx->pkt_len) {
+		OSI_DMA_ERR(osi_dma->osd, OSI_LOG_ARG_INVALID,
+			    "dma: Invalid sw RSS length\n", len);
+		return -1;
+	}
+
+	/* Software RSS only for packets HW didn't hash */
+	if ((rx_pkt_cx->flags & OSI_PKT_CX_RSS) == 0U) {
+		sw_rss_hash(osi_dma, pkt, len, rx_pkt_cx);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief dma_stats_read_begin - Start a snapshot copy of DMA statistics.
+ *
+ * @param[in] l_dma: DMA local data.
+ * @param[out] gen: Generation of each update sequence.
+ *
+ * @retval OSI_ENABLE if no channel is updating and copy can start
+ * @retval OSI_DISABLE otherwise
+ */
+static nveu32_t dma_stats_read_begin(struct dma_local *l_dma, nveu32_t *gen)
+{
+	nveu32_t ret = OSI_ENABLE;
+	nveu32_t i;
+
+	for (i = 0U; i < DMA_STATS_SEQ_CNT; i++) {
+		if (osi_stats_read_begin(&l_dma->stats_seq[i], &gen[i]) !=
+		    OSI_ENABLE) {
+			ret = OSI_DISABLE;
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief dma_stats_read_done - Check a snapshot copy of DMA statistics.
+ *
+ * @param[in] l_dma: DMA local data.
+ * @param[in] gen: Generations from dma_stats_read_begin().
+ * @param[out] sum: Sum of the generations, i.e. number of updates.
+ *
+ * @retval OSI_ENABLE if no update started during the copy
+ * @retval OSI_DISABLE if the copy has to be retried
+ */
+static nveu32_t dma_stats_read_done(struct dma_local *l_dma,
+				    const nveu32_t *gen, nveu32_t *sum)
+{
+	nveu32_t ret = OSI_ENABLE;
+	nveu32_t i;
+
+	*sum = 0U;
+	for (i = 0U; i < DMA_STATS_SEQ_CNT; i++) {
+		if (osi_stats_read_done(&l_dma->stats_seq[i], gen[i]) !=
+		    OSI_ENABLE) {
+			ret = OSI_DISABLE;
+			break;
+		}
+		/* Generation wraps like the sequence counts */
+		*sum += gen[i];
+	}
+
+	return ret;
+}
+
+nve32_t osi_dma_stats_snapshot(struct osi_dma_priv_data *osi_dma,
+			       struct osi_dma_stats_snap *snap)
+{
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
+	nveu32_t gen[DMA_STATS_SEQ_CNT];
+	nveu32_t retry;
+	nveu32_t sum = 0U;
+	nve32_t ret = -1;
+
+	if ((dma_validate_args(osi_dma, l_dma) < 0) || (snap == OSI_NULL)) {
+		goto fail;
+	}
+
+	for (retry = 0U; retry < OSI_STATS_SNAP_RETRY; retry++) {
+		if (dma_stats_read_begin(l_dma, gen) != OSI_ENABLE) {
+			continue;
+		}
+
+		(void)osi_memcpy(&snap->pkt_err_stats, &osi_dma->pkt_err_stats,
+				 sizeof(struct osi_pkt_err_stats));
+		(void)osi_memcpy(&snap->dstats, &osi_dma->dstats,
+				 sizeof(struct osi_xtra_dma_stat_counters));
+
+		if (dma_stats_read_done(l_dma, gen, &sum) == OSI_ENABLE) {
+			snap->gen = sum;
+			ret = 0;
+			break;
+		}
+	}
+
+	if (ret < 0) {
+		OSI_DMA_ERR(osi_dma->osd, OSI_LOG_ARG_HW_FAIL,
+			    "dma: Stats snapshot raced with updates\n",
+			    (nveul64_t)OSI_STATS_SNAP_RETRY);
+	}
+fail:
+	return ret;
+}
 #endif /* !OSI_STRIPPED_LIB */
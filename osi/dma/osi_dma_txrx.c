@@ -106,8 +106,19 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 	nveu32_t ip_type = osi_dma->mac;
 	nve32_t received = 0;
 #ifndef OSI_STRIPPED_LIB
+	struct dma_local *const l_dma = (struct dma_local *)(void *)osi_dma;
+	struct osi_stats_seq *seq = OSI_NULL;
 	nve32_t received_resv = 0;
+	nveu32_t pkt_n = 0U;
 #endif /* !OSI_STRIPPED_LIB */
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	struct osi_dma_hist *hist;
+	nveu32_t start_idx;
+	nveu32_t util = OSI_DMA_HIST_UTIL_CNT - 1U;
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
+#ifdef OSI_DMA_PROFILE
+	nveu64_t prof_start;
+#endif /* OSI_DMA_PROFILE */
 	nve32_t ret = 0;
 
 	ret = validate_rx_completions_arg(osi_dma, chan, more_data_avail,
@@ -117,6 +128,13 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 		goto fail;
 	}
 
+#ifdef OSI_DMA_PROFILE
+	prof_start = dma_prof_start(osi_dma);
+#endif /* OSI_DMA_PROFILE */
+#ifndef OSI_STRIPPED_LIB
+	seq = &l_dma->stats_seq[chan];
+#endif /* !OSI_STRIPPED_LIB */
+
 	if (rx_ring->cur_rx_idx >= osi_dma->rx_ring_sz) {
 		OSI_DMA_ERR(osi_dma->osd, OSI_LOG_ARG_INVALID,
 			    "dma_txrx: Invalid cur_rx_idx\n", 0ULL);
@@ -126,6 +144,10 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 
 	/* Reset flag to indicate if more Rx frames available to OSD layer */
 	*more_data_avail = OSI_NONE;
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	hist = &osi_dma->hist[chan];
+	start_idx = rx_ring->cur_rx_idx;
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 
 	while ((received < budget)
 #ifndef OSI_STRIPPED_LIB
@@ -191,6 +213,9 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 
 		/* get the length of the packet */
 		rx_pkt_cx->pkt_len = rx_desc->rdes3 & RDES3_PKT_LEN;
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+		dma_hist_log2(hist->rx_len, rx_pkt_cx->pkt_len);
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 
 		/* Mark pkt as valid by default */
 		rx_pkt_cx->flags |= OSI_PKT_CX_VALID;
@@ -204,8 +229,10 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 				 */
 				rx_pkt_cx->flags &= ~OSI_PKT_CX_VALID;
 #ifndef OSI_STRIPPED_LIB
+				osi_stats_write_begin(seq);
 				d_ops[ip_type].update_rx_err_stats(rx_desc,
 						&osi_dma->pkt_err_stats);
+				osi_stats_write_end(seq);
 #endif /* !OSI_STRIPPED_LIB */
 			}
 
@@ -260,12 +287,7 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 			}
 		}
 #ifndef OSI_STRIPPED_LIB
-		osi_dma->dstats.q_rx_pkt_n[chan] =
-			osi_update_stats_counter(
-					osi_dma->dstats.q_rx_pkt_n[chan],
-					1UL);
-		osi_dma->dstats.rx_pkt_n =
-			osi_update_stats_counter(osi_dma->dstats.rx_pkt_n, 1UL);
+		pkt_n++;
 #endif /* !OSI_STRIPPED_LIB */
 		received++;
 	}
@@ -289,7 +311,33 @@ nve32_t osi_process_rx_completions(struct osi_dma_priv_data *osi_dma,
 	}
 #endif /* !OSI_STRIPPED_LIB */
 
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	dma_hist_log2(hist->rx_desc, (rx_ring->cur_rx_idx - start_idx) &
+		      (osi_dma->rx_ring_sz - 1U));
+	if (received < budget) {
+		util = ((nveu32_t)received * (OSI_DMA_HIST_UTIL_CNT - 1U)) /
+		       (nveu32_t)budget;
+	}
+	hist->rx_budget[util] = osi_update_stats_counter(hist->rx_budget[util],
+							 1UL);
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
+#ifdef OSI_DMA_PROFILE
+	dma_prof_end(osi_dma, OSI_DMA_PROF_RX_DONE, prof_start, received);
+#endif /* OSI_DMA_PROFILE */
 fail:
+#ifndef OSI_STRIPPED_LIB
+	if (pkt_n != 0U) {
+		osi_stats_write_begin(seq);
+		osi_dma->dstats.q_rx_pkt_n[chan] =
+			osi_update_stats_counter(
+					osi_dma->dstats.q_rx_pkt_n[chan],
+					(nveu64_t)pkt_n);
+		osi_dma->dstats.rx_pkt_n =
+			osi_update_stats_counter(osi_dma->dstats.rx_pkt_n,
+						 (nveu64_t)pkt_n);
+		osi_stats_write_end(seq);
+	}
+#endif /* !OSI_STRIPPED_LIB */
 	return received;
 }
 
@@ -300,7 +348,8 @@ fail:
  * @note
  * Algorithm:
  *  - This routine will be invoked by OSI layer internally to increment
- *    stats for successfully transmitted packets on certain DMA channel.
+ *    stats for successfully transmitted packets on certain DMA channel,
+ *    once per Tx completion call.
  *
  * @note
  * API Group:
@@ -310,14 +359,17 @@ fail:
  *
  * @param[in, out] osi_dma: Pointer to OSI DMA private data structure.
  * @param[in] chan: DMA channel number for which stats should be incremented.
+ * @param[in] pkt_n: Number of transmitted packets.
  */
 static inline void inc_tx_pkt_stats(struct osi_dma_priv_data *osi_dma,
-				    nveu32_t chan)
+				    nveu32_t chan, nveu32_t pkt_n)
 {
 	osi_dma->dstats.q_tx_pkt_n[chan] =
-		osi_update_stats_counter(osi_dma->dstats.q_tx_pkt_n[chan], 1UL);
+		osi_update_stats_counter(osi_dma->dstats.q_tx_pkt_n[chan],
+					 (nveu64_t)pkt_n);
 	osi_dma->dstats.tx_pkt_n =
-		osi_update_stats_counter(osi_dma->dstats.tx_pkt_n, 1UL);
+		osi_update_stats_counter(osi_dma->dstats.tx_pkt_n,
+					 (nveu64_t)pkt_n);
 }
 
 /**
@@ -426,9 +478,11 @@ static inline void get_tx_err_stats(struct osi_tx_desc *tx_desc,
 nve32_t osi_clear_tx_pkt_err_stats(struct osi_dma_priv_data *osi_dma)
 {
 	nve32_t ret = -1;
+	struct dma_local *const l_dma = (struct dma_local *)(void *)osi_dma;
 	struct osi_pkt_err_stats *pkt_err_stats;
 
 	if (osi_dma != OSI_NULL) {
+		osi_stats_write_begin(&l_dma->stats_seq[DMA_STATS_SEQ_CTRL]);
 		pkt_err_stats = &osi_dma->pkt_err_stats;
 		/* Reset tx packet errors */
 		pkt_err_stats->ip_header_error = 0U;
@@ -444,6 +498,7 @@ nve32_t osi_clear_tx_pkt_err_stats(struct osi_dma_priv_data *osi_dma)
 		pkt_err_stats->clear_tx_err =
 			osi_update_stats_counter(pkt_err_stats->clear_tx_err,
 						 1UL);
+		osi_stats_write_end(&l_dma->stats_seq[DMA_STATS_SEQ_CTRL]);
 		ret = 0;
 	}
 
@@ -453,15 +508,18 @@ nve32_t osi_clear_tx_pkt_err_stats(struct osi_dma_priv_data *osi_dma)
 nve32_t osi_clear_rx_pkt_err_stats(struct osi_dma_priv_data *osi_dma)
 {
 	nve32_t ret = -1;
+	struct dma_local *const l_dma = (struct dma_local *)(void *)osi_dma;
 	struct osi_pkt_err_stats *pkt_err_stats;
 
 	if (osi_dma != OSI_NULL) {
+		osi_stats_write_begin(&l_dma->stats_seq[DMA_STATS_SEQ_CTRL]);
 		pkt_err_stats = &osi_dma->pkt_err_stats;
 		/* Reset Rx packet errors */
 		pkt_err_stats->rx_crc_error = 0U;
 		pkt_err_stats->clear_tx_err =
 			osi_update_stats_counter(pkt_err_stats->clear_rx_err,
 						 1UL);
+		osi_stats_write_end(&l_dma->stats_seq[DMA_STATS_SEQ_CTRL]);
 		ret = 0;
 	}
 
@@ -544,6 +602,14 @@ nve32_t osi_process_tx_completions(struct osi_dma_priv_data *osi_dma,
 	nveu64_t vartdes1;
 	nveul64_t ns;
 	nve32_t processed = 0;
+#ifndef OSI_STRIPPED_LIB
+	struct dma_local *const l_dma = (struct dma_local *)(void *)osi_dma;
+	struct osi_stats_seq *seq = OSI_NULL;
+	nveu32_t pkt_n = 0U;
+#endif /* !OSI_STRIPPED_LIB */
+#ifdef OSI_DMA_PROFILE
+	nveu64_t prof_start;
+#endif /* OSI_DMA_PROFILE */
 	nve32_t ret;
 
 	ret = validate_tx_completions_arg(osi_dma, chan, &tx_ring);
@@ -552,13 +618,16 @@ nve32_t osi_process_tx_completions(struct osi_dma_priv_data *osi_dma,
 		goto fail;
 	}
 
+#ifdef OSI_DMA_PROFILE
+	prof_start = dma_prof_start(osi_dma);
+#endif /* OSI_DMA_PROFILE */
+#ifndef OSI_STRIPPED_LIB
+	seq = &l_dma->stats_seq[chan];
+#endif /* !OSI_STRIPPED_LIB */
+
 	txdone_pkt_cx = &tx_ring->txdone_pkt_cx;
 	entry = tx_ring->clean_idx;
 
-#ifndef OSI_STRIPPED_LIB
-	osi_dma->dstats.tx_clean_n[chan] =
-		osi_update_stats_counter(osi_dma->dstats.tx_clean_n[chan], 1U);
-#endif /* !OSI_STRIPPED_LIB */
 	while ((entry != tx_ring->cur_tx_idx) && (entry < osi_dma->tx_ring_sz) &&
 	       (processed < budget)) {
 		osi_memset(txdone_pkt_cx, 0U, sizeof(*txdone_pkt_cx));
@@ -584,12 +653,14 @@ nve32_t osi_process_tx_completions(struct osi_dma_priv_data *osi_dma,
 				txdone_pkt_cx->flags |= OSI_TXDONE_CX_ERROR;
 #ifndef OSI_STRIPPED_LIB
 				/* fill packet error stats */
+				osi_stats_write_begin(seq);
 				get_tx_err_stats(tx_desc,
 						 &osi_dma->pkt_err_stats);
+				osi_stats_write_end(seq);
 #endif /* !OSI_STRIPPED_LIB */
 			} else {
 #ifndef OSI_STRIPPED_LIB
-				inc_tx_pkt_stats(osi_dma, chan);
+				pkt_n++;
 #endif /* !OSI_STRIPPED_LIB */
 			}
 
@@ -680,7 +751,22 @@ nve32_t osi_process_tx_completions(struct osi_dma_priv_data *osi_dma,
 		tx_ring->clean_idx = entry;
 	}
 
+#ifdef OSI_DMA_PROFILE
+	dma_prof_end(osi_dma, OSI_DMA_PROF_TX_DONE, prof_start, processed);
+#endif /* OSI_DMA_PROFILE */
 fail:
+#ifndef OSI_STRIPPED_LIB
+	if (seq != OSI_NULL) {
+		osi_stats_write_begin(seq);
+		osi_dma->dstats.tx_clean_n[chan] =
+			osi_update_stats_counter(
+					osi_dma->dstats.tx_clean_n[chan], 1U);
+		if (pkt_n != 0U) {
+			inc_tx_pkt_stats(osi_dma, chan, pkt_n);
+		}
+		osi_stats_write_end(seq);
+	}
+#endif /* !OSI_STRIPPED_LIB */
 	return processed;
 }
 
@@ -1005,6 +1091,10 @@ nve32_t hw_transmit(struct osi_dma_priv_data *osi_dma,
 	nveu32_t entry = 0U;
 	nve32_t ret = 0;
 	nveu32_t i;
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	struct osi_dma_hist *hist = &osi_dma->hist[chan];
+	nveu32_t tx_len;
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 
 	entry = tx_ring->cur_tx_idx;
 	if (entry >= osi_dma->tx_ring_sz) {
@@ -1035,17 +1125,26 @@ nve32_t hw_transmit(struct osi_dma_priv_data *osi_dma,
 #ifndef OSI_STRIPPED_LIB
 	/* Context descriptor for VLAN/TSO */
 	if ((tx_pkt_cx->flags & OSI_PKT_CX_VLAN) == OSI_PKT_CX_VLAN) {
+		osi_stats_write_begin(&l_dma->stats_seq[chan]);
 		osi_dma->dstats.tx_vlan_pkt_n =
 			osi_update_stats_counter(osi_dma->dstats.tx_vlan_pkt_n,
 						 1UL);
+		osi_stats_write_end(&l_dma->stats_seq[chan]);
 	}
 
 	if ((tx_pkt_cx->flags & OSI_PKT_CX_TSO) == OSI_PKT_CX_TSO) {
+		osi_stats_write_begin(&l_dma->stats_seq[chan]);
 		osi_dma->dstats.tx_tso_pkt_n =
 			osi_update_stats_counter(osi_dma->dstats.tx_tso_pkt_n,
 						 1UL);
+		osi_stats_write_end(&l_dma->stats_seq[chan]);
 	}
 #endif /* !OSI_STRIPPED_LIB */
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	dma_hist_log2(hist->tx_desc, desc_cnt);
+	dma_hist_log2(hist->tx_occ, (entry - tx_ring->clean_idx) &
+		      (osi_dma->tx_ring_sz - 1U));
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 
 	cntx_desc_consumed = need_cntx_desc(tx_pkt_cx, tx_swcx, tx_desc,
 					    osi_dma->ptp_flag, osi_dma->mac);
@@ -1083,6 +1182,9 @@ nve32_t hw_transmit(struct osi_dma_priv_data *osi_dma,
 		 */
 		tx_swcx->pktid = pkt_id;
 	}
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	tx_len = tx_swcx->len;
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 
 	INCR_TX_DESC_INDEX(entry, osi_dma->tx_ring_sz);
 
@@ -1099,6 +1201,9 @@ nve32_t hw_transmit(struct osi_dma_priv_data *osi_dma,
 		tx_desc->tdes2 = tx_swcx->len;
 		/* set HW OWN bit for descriptor*/
 		tx_desc->tdes3 |= TDES3_OWN;
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+		tx_len += tx_swcx->len;
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 
 		INCR_TX_DESC_INDEX(entry, osi_dma->tx_ring_sz);
 		last_desc = tx_desc;
@@ -1108,6 +1213,9 @@ nve32_t hw_transmit(struct osi_dma_priv_data *osi_dma,
 
 	/* Mark it as LAST descriptor */
 	last_desc->tdes3 |= TDES3_LD;
+#if defined OSI_DMA_HIST && !defined OSI_STRIPPED_LIB
+	dma_hist_log2(hist->tx_len, tx_len);
+#endif /* OSI_DMA_HIST && !OSI_STRIPPED_LIB */
 	/* set Interrupt on Completion*/
 	last_desc->tdes2 |= TDES2_IOC;
 
@@ -1205,10 +1313,12 @@ fail:
  * @retval 0 on success
  * @retval -1 on failure.
  */
-static nve32_t rx_dma_desc_initialization(const struct osi_dma_priv_data *const osi_dma,
+static nve32_t rx_dma_desc_initialization(struct osi_dma_priv_data *const osi_dma,
 					  nveu32_t dma_chan)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chan = dma_chan & 0xFU;
+	struct osi_reg_shadow *const sh = &l_dma->reg_shadow[chan];
 	const nveu32_t start_addr_high_reg[2] = {
 		EQOS_DMA_CHX_RDLH(chan),
 		MGBE_DMA_CHX_RDLH(chan)
@@ -1290,9 +1400,11 @@ static nve32_t rx_dma_desc_initialization(const struct osi_dma_priv_data *const
 	}
 
 	/* Update the HW DMA ring length */
-	val = osi_readl((nveu8_t *)osi_dma->base + ring_len_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_RX_CTRL2, osi_dma->base,
+			       ring_len_reg[osi_dma->mac]);
 	val |= (osi_dma->rx_ring_sz - 1U) & mask[osi_dma->mac];
-	osi_writel(val, (nveu8_t *)osi_dma->base + ring_len_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_RX_CTRL2, val, osi_dma->base,
+			  ring_len_reg[osi_dma->mac]);
 
 	update_rx_tail_ptr(osi_dma, chan, tailptr);
 
@@ -1346,12 +1458,14 @@ fail:
 	return ret;
 }
 
-static inline void set_tx_ring_len_and_start_addr(const struct osi_dma_priv_data *const osi_dma,
+static inline void set_tx_ring_len_and_start_addr(struct osi_dma_priv_data *const osi_dma,
 						  nveu64_t tx_desc_phy_addr,
 						  nveu32_t dma_chan,
 						  nveu32_t len)
 {
+	struct dma_local *l_dma = (struct dma_local *)(void *)osi_dma;
 	nveu32_t chan = dma_chan & 0xFU;
+	struct osi_reg_shadow *const sh = &l_dma->reg_shadow[chan];
 	const nveu32_t ring_len_reg[2] = {
 		EQOS_DMA_CHX_TDRL(chan),
 		MGBE_DMA_CHX_TX_CNTRL2(chan)
@@ -1368,9 +1482,11 @@ static inline void set_tx_ring_len_and_start_addr(const struct osi_dma_priv_data
 	nveu32_t val;
 
 	/* Program ring length */
-	val = osi_readl((nveu8_t *)osi_dma->base + ring_len_reg[osi_dma->mac]);
+	val = osi_shadow_readl(sh, OSI_SHADOW_DMA_TX_CTRL2, osi_dma->base,
+			       ring_len_reg[osi_dma->mac]);
 	val |= len & mask[osi_dma->mac];
-	osi_writel(val, (nveu8_t *)osi_dma->base + ring_len_reg[osi_dma->mac]);
+	osi_shadow_writel(sh, OSI_SHADOW_DMA_TX_CTRL2, val, osi_dma->base,
+			  ring_len_reg[osi_dma->mac]);
 
 	/* Program tx ring start address */
 	osi_writel(H32(tx_desc_phy_addr),
@@ -1399,7 +1515,7 @@ static inline void set_tx_ring_len_and_start_addr(const struct osi_dma_priv_data
  * @retval 0 on success
  * @retval -1 on failure.
  */
-static nve32_t tx_dma_desc_init(const struct osi_dma_priv_data *const osi_dma)
+static nve32_t tx_dma_desc_init(struct osi_dma_priv_data *const osi_dma)
 {
 	struct osi_tx_ring *tx_ring = OSI_NULL;
 	struct osi_tx_desc *tx_desc = OSI_NULL;
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OSI_STRIPPED_LIB
+#include "dma_local.h"
+
+/**
+ * @addtogroup SW_RSS Software RSS header parsing defines
+ *
+ * @brief Header lengths, offsets and protocol numbers used to build
+ * Toeplitz input
+ * @{
+ */
+#define SW_RSS_ETH_TYPE_OFF	12U
+#define SW_RSS_VLAN_HLEN	4U
+#define SW_RSS_MAX_VLAN_TAGS	2U
+#define SW_RSS_ETH_P_IPV4	0x0800U
+#define SW_RSS_ETH_P_IPV6	0x86DDU
+#define SW_RSS_ETH_P_8021Q	0x8100U
+#define SW_RSS_ETH_P_8021AD	0x88A8U
+#define SW_RSS_IPV4_HLEN	20U
+#define SW_RSS_IPV4_FRAG_OFF	6U
+#define SW_RSS_IPV4_FRAG_MASK	0x3FFFU
+#define SW_RSS_IPV4_PROTO_OFF	9U
+#define SW_RSS_IPV4_ADDR_OFF	12U
+#define SW_RSS_IPV4_ADDR_LEN	8U
+#define SW_RSS_IPV6_HLEN	40U
+#define SW_RSS_IPV6_NH_OFF	6U
+#define SW_RSS_IPV6_ADDR_OFF	8U
+#define SW_RSS_IPV6_ADDR_LEN	32U
+#define SW_RSS_L4_PORTS_LEN	4U
+#define SW_RSS_PROTO_TCP	6U
+#define SW_RSS_PROTO_UDP	17U
+/** @} */
+
+/**
+ * @brief sw_rss_key_window - 32 bits of RSS key starting at a bit offset
+ *
+ * @param[in] key: RSS hash key, first byte holds the most significant bits
+ * @param[in] bit: Bit offset in key
+ *
+ * @retval Key window, zero padded past end of key
+ */
+static nveu32_t sw_rss_key_window(const nveu8_t *const key, nveu32_t bit)
+{
+	nveu32_t byte = bit / 8U;
+	nveu32_t i;
+	nveu64_t win = 0ULL;
+
+	for (i = 0U; i < 5U; i++) {
+		win <<= 8U;
+		if ((byte + i) < OSI_RSS_HASH_KEY_SIZE) {
+			win |= (nveu64_t)key[byte + i];
+		}
+	}
+
+	return (nveu32_t)((win >> (8U - (bit % 8U))) & 0xFFFFFFFFULL);
+}
+
+void sw_rss_build_lut(struct dma_local *l_dma)
+{
+	const nveu8_t *key = l_dma->osi_dma.sw_rss.key;
+	nveu32_t row, val, b;
+	nveu32_t acc;
+
+	for (row = 0U; row < SW_RSS_LUT_ROWS; row++) {
+		for (val = 0U; val < SW_RSS_LUT_COLS; val++) {
+			acc = 0U;
+			/* nibble bits are consumed MSB first */
+			for (b = 0U; b < 4U; b++) {
+				if ((val & (0x8U >> b)) != 0U) {
+					acc ^= sw_rss_key_window(key,
+								 (row * 4U) + b);
+				}
+			}
+			l_dma->sw_rss_lut[row][val] = acc;
+		}
+	}
+}
+
+/**
+ * @brief sw_rss_be16 - Read big endian 16-bit field
+ *
+ * @param[in] p: Field address
+ *
+ * @retval Field value
+ */
+static inline nveu32_t sw_rss_be16(const nveu8_t *const p)
+{
+	return ((nveu32_t)p[0] << 8U) | (nveu32_t)p[1];
+}
+
+/**
+ * @brief sw_rss_l4_type - Hash type of an IP packet for its L4 protocol
+ *
+ * @param[in] hash_types: Hashed packet types, OSI_RSS_HASH_* bitmap
+ * @param[in] proto: L4 protocol number, 0 if ports aren't available
+ *
+ * @retval OSI_RX_PKT_HASH_TYPE_L4 to hash addresses and ports
+ * @retval OSI_RX_PKT_HASH_TYPE_L3 to hash addresses
+ * @retval 0 to not hash the packet
+ */
+static nveu32_t sw_rss_l4_type(nveu32_t hash_types, nveu32_t proto)
+{
+	nveu32_t type = 0U;
+
+	if (((proto == SW_RSS_PROTO_TCP) &&
+	     ((hash_types & OSI_RSS_HASH_TCP) != 0U)) ||
+	    ((proto == SW_RSS_PROTO_UDP) &&
+	     ((hash_types & OSI_RSS_HASH_UDP) != 0U))) {
+		type = OSI_RX_PKT_HASH_TYPE_L4;
+	} else if ((hash_types & OSI_RSS_HASH_IP) != 0U) {
+		type = OSI_RX_PKT_HASH_TYPE_L3;
+	} else {
+		/* packet type not hashed */
+	}
+
+	return type;
+}
+
+void sw_rss_hash(const struct osi_dma_priv_data *const osi_dma,
+		 const nveu8_t *const pkt, const nveu32_t len,
+		 struct osi_rx_pkt_cx *rx_pkt_cx)
+{
+	const struct dma_local *const l_dma =
+		(const struct dma_local *)(const void *)osi_dma;
+	nveu32_t hash_types = osi_dma->sw_rss.hash_types;
+	const nveu8_t *in = OSI_NULL;
+	nveu32_t off = SW_RSS_ETH_TYPE_OFF;
+	nveu32_t in_len = 0U;
+	nveu32_t hlen = 0U;
+	nveu32_t proto = 0U;
+	nveu32_t etype, type, i;
+	nveu32_t hash = 0U;
+
+	if (hash_types == 0U) {
+		hash_types = OSI_RSS_HASH_ALL;
+	}
+
+	if (len < (off + 2U)) {
+		goto done;
+	}
+
+	etype = sw_rss_be16(&pkt[off]);
+	for (i = 0U; (i < SW_RSS_MAX_VLAN_TAGS) &&
+	     ((etype == SW_RSS_ETH_P_8021Q) || (etype == SW_RSS_ETH_P_8021AD));
+	     i++) {
+		off += SW_RSS_VLAN_HLEN;
+		if (len < (off + 2U)) {
+			goto done;
+		}
+		etype = sw_rss_be16(&pkt[off]);
+	}
+	off += 2U;
+
+	if (etype == SW_RSS_ETH_P_IPV4) {
+		if (len < (off + SW_RSS_IPV4_HLEN)) {
+			goto done;
+		}
+		hlen = ((nveu32_t)pkt[off] & 0xFU) * 4U;
+		in = &pkt[off + SW_RSS_IPV4_ADDR_OFF];
+		in_len = SW_RSS_IPV4_ADDR_LEN;
+		/* L4 ports of non first fragments are not available */
+		if (((sw_rss_be16(&pkt[off + SW_RSS_IPV4_FRAG_OFF]) &
+		      SW_RSS_IPV4_FRAG_MASK) == 0U) &&
+		    (hlen >= SW_RSS_IPV4_HLEN)) {
+			proto = pkt[off + SW_RSS_IPV4_PROTO_OFF];
+		}
+	} else if (etype == SW_RSS_ETH_P_IPV6) {
+		if (len < (off + SW_RSS_IPV6_HLEN)) {
+			goto done;
+		}
+		/* extension headers aren't walked */
+		hlen = SW_RSS_IPV6_HLEN;
+		in = &pkt[off + SW_RSS_IPV6_ADDR_OFF];
+		in_len = SW_RSS_IPV6_ADDR_LEN;
+		proto = pkt[off + SW_RSS_IPV6_NH_OFF];
+	} else {
+		goto done;
+	}
+
+	if (len < (off + hlen + SW_RSS_L4_PORTS_LEN)) {
+		proto = 0U;
+	}
+
+	type = sw_rss_l4_type(hash_types, proto);
+	if (type == 0U) {
+		goto done;
+	}
+
+	for (i = 0U; i < in_len; i++) {
+		hash ^= l_dma->sw_rss_lut[i * 2U][in[i] >> 4U];
+		hash ^= l_dma->sw_rss_lut[(i * 2U) + 1U][in[i] & 0xFU];
+	}
+
+	if (type == OSI_RX_PKT_HASH_TYPE_L4) {
+		/* ports follow the addresses in Toeplitz input */
+		in = &pkt[off + hlen];
+		for (i = 0U; i < SW_RSS_L4_PORTS_LEN; i++) {
+			hash ^= l_dma->sw_rss_lut[(in_len + i) * 2U]
+						 [in[i] >> 4U];
+			hash ^= l_dma->sw_rss_lut[((in_len + i) * 2U) + 1U]
+						 [in[i] & 0xFU];
+		}
+	}
+
+	rx_pkt_cx->rx_hash = hash;
+	rx_pkt_cx->rx_hash_type = type;
+	rx_pkt_cx->rss_hint = osi_dma->sw_rss.table[hash &
+					(OSI_RSS_MAX_TABLE_SIZE - 1U)];
+	rx_pkt_cx->flags |= OSI_PKT_CX_RSS;
+done:
+	return;
+}
+#endif /* !OSI_STRIPPED_LIB */
@@ -0,0 +1,873 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Host model of an MGBE MAC/DMA, see devmodel.h.
+ *
+ * - Register file: plain storage, write one to clear status registers.
+ * - Busy bits: self clearing command bits stay set for busy_reads reads
+ *   and then complete, so that library poll loops run.
+ * - Tx engine: a tail pointer write completes all HW owned descriptors
+ *   up to the tail, optionally looping frames back into Rx.
+ * - Rx engine: devmodel_rx_inject() fills HW owned descriptors.
+ * - MMC: 64 bit packet/octet counters with reset and reset on read.
+ * - Timestamp unit: PTP system time following model time, init/update
+ *   commands and Tx timestamp FIFO.
+ * - FRP: instruction table behind the indirect access, RXPI follows FRPE.
+ * - L3/L4 filter, VLAN filter and EST GCL: registers behind their indirect
+ *   accesses.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <osi_dma.h>
+#include "../core/core_common.h"
+#include "../core/mgbe_core.h"
+#include "../core/mgbe_mmc.h"
+#include "../core/vlan_filter.h"
+#include "../dma/hw_common.h"
+#include "../dma/hw_desc.h"
+#include "../dma/mgbe_dma.h"
+#include "devmodel.h"
+
+/** Default number of reads a busy bit stays set */
+#define DM_BUSY_READS		2U
+/** Word index of a register offset */
+#define DM_W(off)		((off) >> 2U)
+/** Rx buffer size field of DMA_CHX_RX_CTRL */
+#define DM_RBSZ(v)		(((v) & DMA_CHX_RBSZ_MASK) >> DMA_CHX_RBSZ_SHIFT)
+/** Tx buffer 1 length of TDES2 */
+#define DM_TDES2_B1L		0x3FFFU
+/** TDES2 MSS of a context descriptor */
+#define DM_TDES2_MSS		0x3FFFU
+/** TDES0 packet id of a context descriptor */
+#define DM_TDES0_PKTID		0x3FFU
+/** MGBE DMA_CHX_STATUS Tx and Rx interrupt */
+#define DM_DMA_STS_TI		OSI_BIT(0)
+#define DM_DMA_STS_RI		OSI_BIT(6)
+/** Address field of MTL_EST_GCL_CONTROL */
+#define DM_EST_ADDR		0xFFF00U
+
+/**
+ * @brief Self clearing command bit, count registers at stride
+ */
+struct dm_busy {
+	/** Offset of first register */
+	nveu32_t off;
+	/** Distance between registers */
+	nveu32_t stride;
+	/** Number of registers */
+	nveu32_t cnt;
+	/** Command bits */
+	nveu32_t mask;
+};
+
+static const struct dm_busy dm_busy_tbl[] = {
+	{ MGBE_DMA_MODE, 0U, 1U, DMA_MODE_SWR },
+	{ MGBE_MTL_CHX_TX_OP_MODE(0U), 0x80U, OSI_MGBE_MAX_NUM_QUEUES,
+	  MTL_QTOMR_FTQ },
+	{ MGBE_MTL_RXP_IND_CS, 0U, 1U, MGBE_MTL_RXP_IND_CS_BUSY },
+	{ MGBE_MAC_INDIR_AC, 0U, 1U, MGBE_MAC_INDIR_AC_OB },
+	{ MGBE_MAC_L3L4_ADDR_CTR, 0U, 1U, MGBE_MAC_L3L4_ADDR_CTR_XB },
+	{ MGBE_MAC_RSS_ADDR, 0U, 1U, MGBE_MAC_RSS_ADDR_OB },
+	{ MAC_VLAN_TAG_CTRL, 0U, 1U, MAC_VLAN_TAG_CTRL_OB },
+	{ MGBE_MTL_EST_GCL_CONTROL, 0U, 1U, MTL_EST_SRWO },
+	{ MGBE_MDIO_SCCD, 0U, 1U, MGBE_MDIO_SCCD_SBUSY },
+	{ MGBE_MAC_TCR, 0U, 1U, MAC_TCR_TSINIT | MGBE_MAC_TCR_TSUPDT |
+	  MAC_TCR_TSADDREG },
+	{ MGBE_MMC_CNTRL, 0U, 1U, MGBE_MMC_CNTRL_CNTRST },
+};
+
+static struct devmodel dm;
+
+struct devmodel *devmodel_get(void)
+{
+	return &dm;
+}
+
+void *devmodel_mac_base(void)
+{
+	return (void *)dm.mac;
+}
+
+void *devmodel_xpcs_base(void)
+{
+	return (void *)dm.xpcs;
+}
+
+void devmodel_reset(void)
+{
+	memset(&dm, 0, sizeof(dm));
+	dm.busy_reads = DM_BUSY_READS;
+	dm.mac[DM_W(MAC_VERSION)] = OSI_MGBE_MAC_3_10;
+}
+
+void devmodel_advance(nveu64_t ns)
+{
+	dm.now_ns += ns;
+}
+
+/**
+ * @brief dm_busy_mask - Self clearing bits of a register.
+ *
+ * @param[in] off: Register offset.
+ *
+ * @return Command bits, 0 for plain registers.
+ */
+static nveu32_t dm_busy_mask(nveu32_t off)
+{
+	nveu32_t i;
+
+	for (i = 0U; i < (sizeof(dm_busy_tbl) / sizeof(dm_busy_tbl[0])); i++) {
+		const struct dm_busy *b = &dm_busy_tbl[i];
+
+		if ((off >= b->off) &&
+		    (off <= (b->off + (b->stride * (b->cnt - 1U)))) &&
+		    ((b->stride == 0U) || (((off - b->off) % b->stride) == 0U))) {
+			return b->mask;
+		}
+	}
+
+	return 0U;
+}
+
+/**
+ * @brief dm_is_w1c - Write one to clear status registers.
+ *
+ * @param[in] off: Register offset.
+ *
+ * @retval 1 for status registers
+ */
+static nveu32_t dm_is_w1c(nveu32_t off)
+{
+	if ((off >= MGBE_DMA_CHX_STATUS(0U)) &&
+	    (off <= MGBE_DMA_CHX_STATUS(DEVMODEL_MAX_CHANS - 1U)) &&
+	    (((off - MGBE_DMA_CHX_STATUS(0U)) % 0x80U) == 0U)) {
+		return 1U;
+	}
+
+	if ((off >= VIRT_INTR_CHX_STATUS(0U)) &&
+	    (off <= VIRT_INTR_CHX_STATUS(DEVMODEL_MAX_CHANS - 1U)) &&
+	    (((off - VIRT_INTR_CHX_STATUS(0U)) % 8U) == 0U)) {
+		return 1U;
+	}
+
+	return 0U;
+}
+
+/**
+ * @brief dm_is_ro - Read only registers.
+ *
+ * @param[in] off: Register offset.
+ *
+ * @retval 1 if writes are ignored
+ */
+static nveu32_t dm_is_ro(nveu32_t off)
+{
+	switch (off) {
+	case MAC_VERSION:
+	case MGBE_MAC_ISR:
+	case MGBE_DMA_ISR:
+	case MGBE_MAC_STSR:
+	case MGBE_MAC_STNSR:
+	case MGBE_MAC_TSS:
+	case MGBE_MAC_TSNSSEC:
+	case MGBE_MAC_TSPKID:
+	case MGBE_MAC_TSSEC:
+		return 1U;
+	default:
+		return 0U;
+	}
+}
+
+/**
+ * @brief dm_is_mmc - MMC counter registers.
+ *
+ * @param[in] off: Register offset.
+ *
+ * @retval 1 for counters
+ */
+static nveu32_t dm_is_mmc(nveu32_t off)
+{
+	return (((off >= MMC_TXOCTETCOUNT_GB_L) && (off < 0xC00U)) ? 1U : 0U);
+}
+
+nveu64_t devmodel_mmc(nveu32_t reg_l)
+{
+	return (nveu64_t)dm.mac[DM_W(reg_l)] |
+	       ((nveu64_t)dm.mac[DM_W(reg_l) + 1U] << 32U);
+}
+
+/**
+ * @brief dm_mmc_add - Add to a 64 bit MMC counter.
+ *
+ * @param[in] reg_l: Offset of low word.
+ * @param[in] val: Value to add.
+ */
+static void dm_mmc_add(nveu32_t reg_l, nveu64_t val)
+{
+	nveu64_t cnt = devmodel_mmc(reg_l) + val;
+
+	dm.mac[DM_W(reg_l)] = (nveu32_t)cnt;
+	dm.mac[DM_W(reg_l) + 1U] = (nveu32_t)(cnt >> 32U);
+}
+
+/**
+ * @brief dm_ptp_now - Current PTP system time in ns.
+ */
+static nveu64_t dm_ptp_now(void)
+{
+	return dm.ptp_ns + (dm.now_ns - dm.ptp_epoch_ns);
+}
+
+/**
+ * @brief dm_ptp_cmd - Complete a timestamp unit command.
+ *
+ * @param[in] bits: Completed MAC_TCR command bits.
+ */
+static void dm_ptp_cmd(nveu32_t bits)
+{
+	nveu64_t sec = dm.mac[DM_W(MGBE_MAC_STSUR)];
+	nveu32_t nsr = dm.mac[DM_W(MGBE_MAC_STNSUR)];
+	nveu64_t nsec = nsr & ~OSI_BIT(MGBE_MAC_STNSUR_ADDSUB_SHIFT);
+	nveu64_t now = dm_ptp_now();
+
+	if ((bits & MAC_TCR_TSINIT) != 0U) {
+		now = (sec * OSI_NSEC_PER_SEC) + nsec;
+	} else if ((bits & MGBE_MAC_TCR_TSUPDT) != 0U) {
+		if ((nsr & OSI_BIT(MGBE_MAC_STNSUR_ADDSUB_SHIFT)) != 0U) {
+			/* Subtraction is programmed as complement */
+			sec = (TWO_POWER_32 - sec) & 0xFFFFFFFFULL;
+			nsec = (nsec == 0U) ? 0U : (OSI_NSEC_PER_SEC - nsec);
+			now -= (sec * OSI_NSEC_PER_SEC) + nsec;
+		} else {
+			now += (sec * OSI_NSEC_PER_SEC) + nsec;
+		}
+	} else {
+		/* Addend update, rate is not modelled */
+	}
+
+	dm.ptp_ns = now;
+	dm.ptp_epoch_ns = dm.now_ns;
+}
+
+/**
+ * @brief dm_frp_access - Complete an FRP indirect access.
+ *
+ * Algorithm: Instruction table words are written from or read into
+ * MTL_RXP_IND_DATA, the indirect register block is not modelled.
+ */
+static void dm_frp_access(void)
+{
+	nveu32_t cs = dm.mac[DM_W(MGBE_MTL_RXP_IND_CS)];
+	nveu32_t addr = cs & MGBE_MTL_RXP_IND_CS_ADDR;
+
+	if ((cs & MGBE_MTL_RXP_IND_CS_ACCSEL) != 0U) {
+		return;
+	}
+
+	if ((cs & MGBE_MTL_RXP_IND_CS_WRRDN) != 0U) {
+		dm.frp[addr] = dm.mac[DM_W(MGBE_MTL_RXP_IND_DATA)];
+		if (dm.frp_check != NULL) {
+			dm.frp_check();
+		}
+	} else {
+		dm.mac[DM_W(MGBE_MTL_RXP_IND_DATA)] = dm.frp[addr];
+	}
+}
+
+/**
+ * @brief dm_indir_access - Complete a plain indirect register access.
+ *
+ * @param[in, out] tbl: Indirect registers.
+ * @param[in] cnt: Number of indirect registers.
+ * @param[in] idx: Addressed register.
+ * @param[in] data: Offset of data register.
+ * @param[in] rd: Read access.
+ */
+static void dm_indir_access(nveu32_t *tbl, nveu32_t cnt, nveu32_t idx,
+			    nveu32_t data, nveu32_t rd)
+{
+	if (idx >= cnt) {
+		return;
+	}
+
+	if (rd != 0U) {
+		dm.mac[DM_W(data)] = tbl[idx];
+	} else {
+		tbl[idx] = dm.mac[DM_W(data)];
+	}
+}
+
+/**
+ * @brief dm_est_access - Complete an EST GCL indirect access.
+ *
+ * Algorithm: GCRR selects the GCL related registers, otherwise the GCL.
+ * Debug bank selection is ignored, the model keeps one bank.
+ */
+static void dm_est_access(void)
+{
+	nveu32_t ctrl = dm.mac[DM_W(MGBE_MTL_EST_GCL_CONTROL)];
+	nveu32_t idx = (ctrl & DM_EST_ADDR) >> MTL_EST_ADDR_SHIFT;
+	nveu32_t rd = ctrl & MTL_EST_R1W0;
+
+	if ((ctrl & MTL_EST_GCRR) != 0U) {
+		dm_indir_access(dm.gcrr, DEVMODEL_GCRR_WORDS, idx,
+				MGBE_MTL_EST_DATA, rd);
+	} else {
+		dm_indir_access(dm.gcl, DEVMODEL_GCL_WORDS, idx,
+				MGBE_MTL_EST_DATA, rd);
+	}
+}
+
+/**
+ * @brief dm_busy_done - Side effect of a completed command bit.
+ *
+ * @param[in] off: Register offset.
+ * @param[in] bits: Completed command bits.
+ */
+static void dm_busy_done(nveu32_t off, nveu32_t bits)
+{
+	nveu32_t i, v;
+
+	if (off == MGBE_MMC_CNTRL) {
+		for (i = DM_W(MMC_TXOCTETCOUNT_GB_L); i < DM_W(0xC00U); i++) {
+			dm.mac[i] = 0U;
+		}
+	} else if (off == MGBE_MAC_TCR) {
+		dm_ptp_cmd(bits);
+	} else if (off == MGBE_MTL_RXP_IND_CS) {
+		dm_frp_access();
+	} else if (off == MGBE_MAC_L3L4_ADDR_CTR) {
+		v = dm.mac[DM_W(off)];
+		dm_indir_access(dm.l3l4, DEVMODEL_L3L4_WORDS,
+				(v & (MGBE_MAC_L3L4_ADDR_CTR_IDDR_FNUM |
+				      MGBE_MAC_L3L4_ADDR_CTR_IDDR_FTYPE)) >>
+				MGBE_MAC_L3L4_ADDR_CTR_IDDR_FTYPE_SHIFT,
+				MGBE_MAC_L3L4_DATA,
+				v & MGBE_MAC_L3L4_ADDR_CTR_TT);
+	} else if (off == MAC_VLAN_TAG_CTRL) {
+		v = dm.mac[DM_W(off)];
+		dm_indir_access(dm.vlan, DEVMODEL_VLAN_WORDS,
+				(v & MAC_VLAN_TAG_CTRL_OFS_MASK) >>
+				MAC_VLAN_TAG_CTRL_OFS_SHIFT,
+				MAC_VLAN_TAG_DATA,
+				v & MAC_VLAN_TAG_CTRL_CT);
+	} else if (off == MGBE_MTL_EST_GCL_CONTROL) {
+		dm_est_access();
+	} else if (off == MGBE_DMA_MODE) {
+		for (i = 0U; i < DEVMODEL_MAX_CHANS; i++) {
+			dm.tx_head[i] = 0U;
+			dm.rx_head[i] = 0U;
+		}
+		dm.tx_ts_cnt = 0U;
+	} else {
+		/* Command has no modelled side effect */
+	}
+}
+
+/**
+ * @brief dm_read_special - Registers computed on read.
+ *
+ * @param[in] off: Register offset.
+ * @param[out] val: Register value.
+ *
+ * @retval 1 if handled
+ */
+static nveu32_t dm_read_special(nveu32_t off, nveu32_t *val)
+{
+	nveu64_t now = dm_ptp_now();
+	nveu32_t i;
+
+	switch (off) {
+	case MGBE_MAC_STSR:
+		*val = (nveu32_t)(now / OSI_NSEC_PER_SEC);
+		break;
+	case MGBE_MAC_STNSR:
+		*val = (nveu32_t)(now % OSI_NSEC_PER_SEC);
+		break;
+	case MGBE_MAC_TSS:
+		*val = (dm.tx_ts_cnt != 0U) ? MGBE_MAC_TSS_TXTSC : 0U;
+		break;
+	case MGBE_MAC_ISR:
+		*val = (dm.tx_ts_cnt != 0U) ? MGBE_ISR_TSIS : 0U;
+		break;
+	case MGBE_DMA_ISR:
+		*val = 0U;
+		for (i = 0U; i < DEVMODEL_MAX_CHANS; i++) {
+			if (dm.mac[DM_W(MGBE_DMA_CHX_STATUS(i))] != 0U) {
+				*val |= OSI_BIT(i);
+			}
+		}
+		if (dm.tx_ts_cnt != 0U) {
+			*val |= MGBE_DMA_ISR_MACIS;
+		}
+		break;
+	case MGBE_MTL_RXP_CS:
+		/* Parser is idle as soon as FRPE is written */
+		*val = dm.mac[DM_W(off)] & ~MGBE_MTL_RXP_CS_RXPI;
+		if ((dm.mac[DM_W(MGBE_MTL_OP_MODE)] &
+		     MGBE_MTL_OP_MODE_FRPE) != 0U) {
+			*val |= MGBE_MTL_RXP_CS_RXPI;
+		}
+		break;
+	case MGBE_MAC_TSNSSEC:
+		*val = (nveu32_t)(dm.tx_ts[0] % OSI_NSEC_PER_SEC);
+		break;
+	case MGBE_MAC_TSPKID:
+		*val = dm.tx_ts_pktid[0];
+		break;
+	case MGBE_MAC_TSSEC:
+		/* Seconds are read last and pop the FIFO */
+		*val = (nveu32_t)(dm.tx_ts[0] / OSI_NSEC_PER_SEC);
+		if (dm.tx_ts_cnt != 0U) {
+			for (i = 1U; i < dm.tx_ts_cnt; i++) {
+				dm.tx_ts[i - 1U] = dm.tx_ts[i];
+				dm.tx_ts_pktid[i - 1U] = dm.tx_ts_pktid[i];
+			}
+			dm.tx_ts_cnt--;
+		}
+		break;
+	default:
+		return 0U;
+	}
+
+	return 1U;
+}
+
+/**
+ * @brief dm_mac_read - MAC window register read.
+ *
+ * @param[in] off: Register offset.
+ *
+ * @return Register value.
+ */
+static nveu32_t dm_mac_read(nveu32_t off)
+{
+	nveu32_t w = DM_W(off);
+	nveu32_t val = dm.mac[w];
+
+	if (dm_read_special(off, &val) != 0U) {
+		return val;
+	}
+
+	if (dm.busy[w] != 0U) {
+		dm.busy[w]--;
+		if (dm.busy[w] == 0U) {
+			nveu32_t bits = val & dm_busy_mask(off);
+
+			dm.mac[w] &= ~bits;
+			dm_busy_done(off, bits);
+		}
+		return val;
+	}
+
+	if ((dm_is_mmc(off) != 0U) &&
+	    ((dm.mac[DM_W(MGBE_MMC_CNTRL)] & MGBE_MMC_CNTRL_RSTONRD) != 0U)) {
+		dm.mac[w] = 0U;
+	}
+
+	return val;
+}
+
+/**
+ * @brief dm_desc_ptr - Host pointer of a descriptor ring.
+ *
+ * @param[in] high: Ring start address high register.
+ * @param[in] low: Ring start address low register.
+ */
+static void *dm_desc_ptr(nveu32_t high, nveu32_t low)
+{
+	nveu64_t addr = ((nveu64_t)dm.mac[DM_W(high)] << 32U) |
+			dm.mac[DM_W(low)];
+
+	return (void *)(uintptr_t)addr;
+}
+
+/**
+ * @brief dm_buf_ptr - Host pointer of a descriptor buffer.
+ */
+static void *dm_buf_ptr(nveu32_t des0, nveu32_t des1)
+{
+	return (void *)(uintptr_t)(((nveu64_t)des1 << 32U) | des0);
+}
+
+/**
+ * @brief dm_chan_intr - Raise DMA channel interrupt status.
+ *
+ * @param[in] chan: DMA channel.
+ * @param[in] sts: DMA_CHX_STATUS bits.
+ * @param[in] virt: VIRT_INTR_CHX_STATUS bits.
+ */
+static void dm_chan_intr(nveu32_t chan, nveu32_t sts, nveu32_t virt)
+{
+	dm.mac[DM_W(MGBE_DMA_CHX_STATUS(chan))] |= sts;
+	if ((dm.mac[DM_W(VIRT_INTR_CHX_CNTRL(chan))] & virt) != 0U) {
+		dm.mac[DM_W(VIRT_INTR_CHX_STATUS(chan))] |= virt;
+	}
+}
+
+nve32_t devmodel_rx_inject(nveu32_t chan, const struct devmodel_rx_frame *f)
+{
+	struct osi_rx_desc *ring;
+	struct osi_rx_desc *rd;
+	struct osi_rx_desc *cd;
+	nveu32_t sz, rbsz, len, rdes3;
+	nveu64_t ts;
+
+	if ((chan >= DEVMODEL_MAX_CHANS) ||
+	    ((dm.mac[DM_W(MGBE_DMA_CHX_RX_CTRL(chan))] & OSI_BIT(0)) == 0U)) {
+		goto drop;
+	}
+
+	ring = dm_desc_ptr(MGBE_DMA_CHX_RDLH(chan), MGBE_DMA_CHX_RDLA(chan));
+	sz = (dm.mac[DM_W(MGBE_DMA_CHX_RX_CNTRL2(chan))] & 0x3FFFU) + 1U;
+	rd = ring + dm.rx_head[chan];
+	if ((ring == NULL) || ((rd->rdes3 & RDES3_OWN) == 0U)) {
+		goto drop;
+	}
+
+	cd = ring + ((dm.rx_head[chan] + 1U) % sz);
+	if (((f->flags & DEVMODEL_RX_TS) != 0U) &&
+	    ((cd->rdes3 & RDES3_OWN) == 0U)) {
+		goto drop;
+	}
+
+	rbsz = DM_RBSZ(dm.mac[DM_W(MGBE_DMA_CHX_RX_CTRL(chan))]) <<
+	       DMA_CHX_RBSZ_SHIFT;
+	len = (f->len < rbsz) ? f->len : rbsz;
+	if (f->data != NULL) {
+		memcpy(dm_buf_ptr(rd->rdes0, rd->rdes1), f->data, len);
+	}
+
+	rdes3 = RDES3_FD | RDES3_LD | (len & RDES3_PKT_LEN);
+	rd->rdes0 = 0U;
+	rd->rdes1 = 0U;
+	rd->rdes2 = 0U;
+	if ((f->flags & DEVMODEL_RX_CSUM_ERR) != 0U) {
+		rdes3 |= RDES3_ELLT_CSUM_ERR;
+	} else if ((f->flags & DEVMODEL_RX_IPHDR_ERR) != 0U) {
+		rdes3 |= RDES3_ELLT_IPHE;
+	} else if ((f->flags & DEVMODEL_RX_VLAN) != 0U) {
+		rdes3 |= RDES3_ELLT_CVLAN | RDES3_RS0V;
+		rd->rdes0 = f->vlan & RDES0_OVT;
+	} else {
+		/* Good frame */
+	}
+
+	if ((f->flags & DEVMODEL_RX_CRC_ERR) != 0U) {
+		rdes3 |= RDES3_ES_MGBE | RDES3_ERR_MGBE_CRC;
+		dm_mmc_add(MMC_RXCRCERROR_L, 1U);
+	}
+
+	dm.rx_head[chan] = (dm.rx_head[chan] + 1U) % sz;
+	if ((f->flags & DEVMODEL_RX_TS) != 0U) {
+		ts = dm_ptp_now();
+		cd->rdes0 = (nveu32_t)(ts % OSI_NSEC_PER_SEC);
+		cd->rdes1 = (nveu32_t)(ts / OSI_NSEC_PER_SEC);
+		cd->rdes2 = 0U;
+		cd->rdes3 = RDES3_CTXT | RDES3_TSA;
+		rdes3 |= RDES3_CDA;
+		dm.rx_head[chan] = (dm.rx_head[chan] + 1U) % sz;
+	}
+
+	/* OWN is given back last like HW write back */
+	rd->rdes3 = rdes3;
+
+	dm_mmc_add(MMC_RXPACKETCOUNT_GB_L, 1U);
+	dm_mmc_add(MMC_RXOCTETCOUNT_GB_L, len);
+	if ((rdes3 & RDES3_ES_MGBE) == 0U) {
+		dm_mmc_add(MMC_RXOCTETCOUNT_G_L, len);
+		dm_mmc_add(MMC_RXUNICASTPACKETS_G_L, 1U);
+	}
+	if ((f->flags & DEVMODEL_RX_VLAN) != 0U) {
+		dm_mmc_add(MMC_RXVLANPACKETS_GB_L, 1U);
+	}
+	dm.stats.rx_pkts++;
+	dm_chan_intr(chan, DM_DMA_STS_RI, OSI_BIT(OSI_DMA_CH_RX_INTR));
+	return 0;
+
+drop:
+	dm.stats.rx_drops++;
+	return -1;
+}
+
+/**
+ * @brief dm_tx_frame_done - Account a transmitted frame.
+ *
+ * Algorithm: A TSO frame is counted as the segments the MAC puts on the
+ * wire, each carrying a copy of the headers.
+ *
+ * @param[in] chan: DMA channel.
+ * @param[in] len: Frame length staged in dm.frame.
+ * @param[in] vlan: Frame had VLAN tag insertion.
+ * @param[in] ts: Frame requested a Tx timestamp.
+ * @param[in] pktid: Packet id of the timestamp.
+ * @param[in] tpl: TCP payload length of a TSO frame, 0 otherwise.
+ * @param[in] mss: MSS of a TSO frame.
+ */
+static void dm_tx_frame_done(nveu32_t chan, nveu32_t len, nveu32_t vlan,
+			     nveu32_t ts, nveu32_t pktid, nveu32_t tpl,
+			     nveu32_t mss)
+{
+	struct devmodel_rx_frame f;
+	nveu64_t segs = 1U;
+	nveu64_t octets = len;
+
+	if ((tpl != 0U) && (mss != 0U) && (tpl <= len)) {
+		segs = ((nveu64_t)tpl + mss - 1U) / mss;
+		octets += (segs - 1U) * (len - tpl);
+	}
+
+	dm_mmc_add(MMC_TXPACKETCOUNT_GB_L, segs);
+	dm_mmc_add(MMC_TXOCTETCOUNT_GB_L, octets);
+	dm_mmc_add(MMC_TXPACKETSCOUNT_G_L, segs);
+	dm_mmc_add(MMC_TXOCTETCOUNT_G_L, octets);
+	dm_mmc_add(MMC_TXUNICASTPACKETS_GB_L, segs);
+	if (vlan != 0U) {
+		dm_mmc_add(MMC_TXVLANPACKETS_G_L, segs);
+	}
+
+	if ((ts != 0U) && (dm.tx_ts_cnt < DEVMODEL_TX_TS_CNT)) {
+		dm.tx_ts[dm.tx_ts_cnt] = dm_ptp_now();
+		dm.tx_ts_pktid[dm.tx_ts_cnt] = pktid;
+		dm.tx_ts_cnt++;
+	}
+
+	dm.stats.tx_pkts++;
+	if (dm.loopback != 0U) {
+		f.data = dm.frame;
+		f.len = (len < sizeof(dm.frame)) ? len : sizeof(dm.frame);
+		f.flags = 0U;
+		f.vlan = 0U;
+		(void)devmodel_rx_inject(chan, &f);
+	}
+}
+
+/**
+ * @brief dm_tx_kick - Tx tail pointer write, run the Tx engine.
+ *
+ * Algorithm: Completes HW owned descriptors from the engine head up to
+ * the tail pointer. With loopback buffers of each frame are gathered into
+ * dm.frame.
+ *
+ * @param[in] chan: DMA channel.
+ */
+static void dm_tx_kick(nveu32_t chan)
+{
+	struct osi_tx_desc *ring;
+	struct osi_tx_desc *td;
+	nveu32_t sz, tail, blen;
+	nveu32_t len = 0U, vlan = 0U, ts = 0U, pktid = 0U;
+	nveu32_t tpl = 0U, mss = 0U;
+	nveu32_t done = 0U;
+	nveu64_t addr;
+
+	if ((dm.mac[DM_W(MGBE_DMA_CHX_TX_CTRL(chan))] & OSI_BIT(0)) == 0U) {
+		return;
+	}
+
+	ring = dm_desc_ptr(MGBE_DMA_CHX_TDLH(chan), MGBE_DMA_CHX_TDLA(chan));
+	if (ring == NULL) {
+		return;
+	}
+	sz = (dm.mac[DM_W(MGBE_DMA_CHX_TX_CNTRL2(chan))] & 0x3FFFU) + 1U;
+	addr = (nveu64_t)(uintptr_t)ring;
+	tail = (dm.mac[DM_W(MGBE_DMA_CHX_TDTLP(chan))] - (nveu32_t)addr) /
+	       (nveu32_t)sizeof(struct osi_tx_desc);
+	tail %= sz;
+
+	while (dm.tx_head[chan] != tail) {
+		td = ring + dm.tx_head[chan];
+		if ((td->tdes3 & TDES3_OWN) == 0U) {
+			break;
+		}
+
+		if ((td->tdes3 & TDES3_CTXT) == TDES3_CTXT) {
+			if ((td->tdes3 & TDES3_VLTV) == TDES3_VLTV) {
+				vlan = 1U;
+			}
+			if ((td->tdes3 & TDES3_PIDV) == TDES3_PIDV) {
+				pktid = td->tdes0 & DM_TDES0_PKTID;
+			}
+			if ((td->tdes3 & TDES3_TCMSSV) == TDES3_TCMSSV) {
+				mss = td->tdes2 & DM_TDES2_MSS;
+			}
+		} else {
+			if ((td->tdes3 & TDES3_FD) == TDES3_FD) {
+				len = 0U;
+				if ((td->tdes3 & TDES3_TSE) == TDES3_TSE) {
+					tpl = td->tdes3 & TDES3_TPL_MASK;
+				}
+			}
+			if ((td->tdes2 & TDES2_TTSE) == TDES2_TTSE) {
+				ts = 1U;
+			}
+			blen = td->tdes2 & DM_TDES2_B1L;
+			if ((dm.loopback != 0U) &&
+			    ((len + blen) <= sizeof(dm.frame))) {
+				memcpy(dm.frame + len,
+				       dm_buf_ptr(td->tdes0, td->tdes1), blen);
+			}
+			len += blen;
+		}
+
+		/* Write back: OWN cleared, LD/FD/CTXT kept for the driver */
+		td->tdes3 &= ~TDES3_OWN;
+		dm.stats.tx_descs++;
+		done++;
+
+		if (((td->tdes3 & TDES3_CTXT) == 0U) &&
+		    ((td->tdes3 & TDES3_LD) == TDES3_LD)) {
+			dm_tx_frame_done(chan, len, vlan, ts, pktid, tpl, mss);
+			len = 0U;
+			tpl = 0U;
+			vlan = 0U;
+			ts = 0U;
+			pktid = 0U;
+		}
+
+		dm.tx_head[chan] = (dm.tx_head[chan] + 1U) % sz;
+	}
+
+	if (done != 0U) {
+		dm_chan_intr(chan, DM_DMA_STS_TI, OSI_BIT(OSI_DMA_CH_TX_INTR));
+	}
+}
+
+void devmodel_tx_run(nveu32_t chan)
+{
+	if (chan < DEVMODEL_MAX_CHANS) {
+		dm_tx_kick(chan);
+	}
+}
+
+/**
+ * @brief dm_mac_write - MAC window register write.
+ *
+ * @param[in] off: Register offset.
+ * @param[in] val: Value written.
+ */
+static void dm_mac_write(nveu32_t off, nveu32_t val)
+{
+	nveu32_t w = DM_W(off);
+	nveu32_t mask;
+	nveu32_t chan;
+
+	if (dm_is_w1c(off) != 0U) {
+		dm.mac[w] &= ~val;
+		return;
+	}
+
+	if (dm_is_ro(off) != 0U) {
+		return;
+	}
+
+	dm.mac[w] = val;
+	mask = dm_busy_mask(off);
+	if ((val & mask) != 0U) {
+		if (dm.busy_reads == 0U) {
+			dm.mac[w] &= ~mask;
+			dm_busy_done(off, val & mask);
+		} else {
+			dm.busy[w] = (nveu8_t)dm.busy_reads;
+		}
+	}
+
+	if ((off >= MGBE_DMA_CHX_CTRL(0U)) &&
+	    (off < MGBE_DMA_CHX_CTRL(DEVMODEL_MAX_CHANS))) {
+		chan = (off - MGBE_DMA_CHX_CTRL(0U)) / 0x80U;
+		if ((off == MGBE_DMA_CHX_TDTLP(chan)) && (dm.tx_defer == 0U)) {
+			dm_tx_kick(chan);
+		} else if ((off == MGBE_DMA_CHX_TDLA(chan)) ||
+			   (off == MGBE_DMA_CHX_TDLH(chan))) {
+			dm.tx_head[chan] = 0U;
+		} else if ((off == MGBE_DMA_CHX_RDLA(chan)) ||
+			   (off == MGBE_DMA_CHX_RDLH(chan))) {
+			dm.rx_head[chan] = 0U;
+		} else {
+			/* Plain channel register */
+		}
+	}
+
+	if (((off == MGBE_MTL_RXP_CS) || (off == MGBE_MTL_OP_MODE)) &&
+	    (dm.frp_check != NULL)) {
+		dm.frp_check();
+	}
+}
+
+/**
+ * @brief dm_off - Offset of an address in a window.
+ *
+ * @param[in] addr: Accessed address.
+ * @param[in] base: Window base.
+ * @param[in] size: Window size.
+ * @param[out] off: Offset in window.
+ *
+ * @retval 1 if addr is inside the window
+ */
+static nveu32_t dm_off(const void *addr, const void *base, nveu32_t size,
+		       nveu32_t *off)
+{
+	uintptr_t a = (uintptr_t)addr;
+	uintptr_t b = (uintptr_t)base;
+
+	if ((a < b) || ((a - b) >= size)) {
+		return 0U;
+	}
+
+	*off = (nveu32_t)(a - b) & ~3U;
+	return 1U;
+}
+
+nveu32_t osi_mmio_hook_read(void *priv, void *addr)
+{
+	nveu32_t off;
+
+	(void)priv;
+	dm.stats.reads++;
+	if (dm_off(addr, dm.mac, DEVMODEL_MAC_SZ, &off) != 0U) {
+		return dm_mac_read(off);
+	}
+
+	if (dm_off(addr, dm.xpcs, DEVMODEL_XPCS_SZ, &off) != 0U) {
+		return dm.xpcs[DM_W(off)];
+	}
+
+	dm.stats.stray++;
+	return 0U;
+}
+
+void osi_mmio_hook_write(void *priv, nveu32_t val, void *addr)
+{
+	nveu32_t off;
+
+	(void)priv;
+	dm.stats.writes++;
+	if (dm_off(addr, dm.mac, DEVMODEL_MAC_SZ, &off) != 0U) {
+		dm_mac_write(off, val);
+	} else if (dm_off(addr, dm.xpcs, DEVMODEL_XPCS_SZ, &off) != 0U) {
+		dm.xpcs[DM_W(off)] = val;
+	} else {
+		dm.stats.stray++;
+	}
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef INCLUDED_DEVMODEL_H
+#define INCLUDED_DEVMODEL_H
+
+/*
+ * Host model of an MGBE MAC/DMA behind osi_mmio_hook_read() and
+ * osi_mmio_hook_write(), see Makefile in this directory.
+ *
+ * Descriptor and buffer addresses programmed by the library are taken as
+ * host virtual addresses, the OSD stub maps DMA memory 1:1.
+ */
+
+#include <osi_common.h>
+
+/**
+ * @addtogroup DEVMODEL_REGION Register windows of the model
+ *
+ * @brief Size of each window in bytes. MAC and DMA share one window like
+ * on HW, osi_core->dma_base and osi_dma->base point to the MAC window.
+ * @{
+ */
+#define DEVMODEL_MAC_SZ		0x10000U
+#define DEVMODEL_XPCS_SZ	0x10000U
+/** @} */
+
+/** Number of DMA channels modelled */
+#define DEVMODEL_MAX_CHANS	OSI_MGBE_MAX_NUM_CHANS
+/** Depth of MAC Tx timestamp FIFO */
+#define DEVMODEL_TX_TS_CNT	16U
+/** FRP instruction table words, 4 per entry */
+#define DEVMODEL_FRP_WORDS	1024U
+/** L3/L4 filter words, IDDR filter number and type */
+#define DEVMODEL_L3L4_WORDS	256U
+/** VLAN filter words, OFS of MAC_VLAN_TAG_CTRL */
+#define DEVMODEL_VLAN_WORDS	32U
+/** EST GCL entries and GCL related registers */
+#define DEVMODEL_GCL_WORDS	1024U
+#define DEVMODEL_GCRR_WORDS	8U
+
+/**
+ * @addtogroup DEVMODEL_RX Rx frame attributes for devmodel_rx_inject()
+ *
+ * @brief Bits of devmodel_rx_frame.flags
+ * @{
+ */
+/** L4 checksum error, RDES3 ELLT */
+#define DEVMODEL_RX_CSUM_ERR	OSI_BIT(0)
+/** IPv4 header checksum error, RDES3 ELLT */
+#define DEVMODEL_RX_IPHDR_ERR	OSI_BIT(1)
+/** CRC error, RDES3 ES */
+#define DEVMODEL_RX_CRC_ERR	OSI_BIT(2)
+/** Outer VLAN tag stripped to devmodel_rx_frame.vlan */
+#define DEVMODEL_RX_VLAN	OSI_BIT(3)
+/** Rx timestamp in a context descriptor */
+#define DEVMODEL_RX_TS		OSI_BIT(4)
+/** @} */
+
+/**
+ * @brief One frame handed to the Rx engine
+ */
+struct devmodel_rx_frame {
+	/** Frame data, can be NULL to only write back the descriptor */
+	const nveu8_t *data;
+	/** Frame length */
+	nveu32_t len;
+	/** Attributes, see DEVMODEL_RX */
+	nveu32_t flags;
+	/** VLAN tag with DEVMODEL_RX_VLAN */
+	nveu32_t vlan;
+};
+
+/**
+ * @brief Counters of the model itself, independent of MMC reset on read
+ */
+struct devmodel_stats {
+	/** Register reads through osi_mmio_hook_read() */
+	nveu64_t reads;
+	/** Register writes through osi_mmio_hook_write() */
+	nveu64_t writes;
+	/** Accesses outside of all windows */
+	nveu64_t stray;
+	/** Tx frames completed by the Tx engine */
+	nveu64_t tx_pkts;
+	/** Tx descriptors completed by the Tx engine */
+	nveu64_t tx_descs;
+	/** Rx frames written back */
+	nveu64_t rx_pkts;
+	/** Rx frames dropped for lack of descriptors */
+	nveu64_t rx_drops;
+};
+
+/**
+ * @brief Model state, one instance per process
+ */
+struct devmodel {
+	/** MAC, MTL and DMA registers */
+	nveu32_t mac[DEVMODEL_MAC_SZ / 4U];
+	/** XPCS registers */
+	nveu32_t xpcs[DEVMODEL_XPCS_SZ / 4U];
+	/** Pending busy reads of each MAC register word */
+	nveu8_t busy[DEVMODEL_MAC_SZ / 4U];
+	/** Reads a busy bit stays set, 0 completes on the write */
+	nveu32_t busy_reads;
+	/** Model time in ns, advanced by devmodel_advance() */
+	nveu64_t now_ns;
+	/** PTP system time at ptp_epoch_ns */
+	nveu64_t ptp_ns;
+	/** Model time of last PTP system time update */
+	nveu64_t ptp_epoch_ns;
+	/** Next Tx descriptor the engine completes per channel */
+	nveu32_t tx_head[DEVMODEL_MAX_CHANS];
+	/** Next Rx descriptor the engine fills per channel */
+	nveu32_t rx_head[DEVMODEL_MAX_CHANS];
+	/** Tx timestamp FIFO, ns and packet id */
+	nveu64_t tx_ts[DEVMODEL_TX_TS_CNT];
+	nveu32_t tx_ts_pktid[DEVMODEL_TX_TS_CNT];
+	/** Tx timestamp FIFO fill */
+	nveu32_t tx_ts_cnt;
+	/** Loop Tx frames back into Rx of the same channel */
+	nveu32_t loopback;
+	/** Tail pointer writes do not run the Tx engine, see
+	 * devmodel_tx_run() */
+	nveu32_t tx_defer;
+	/** Frame staging buffer of Tx engine, filled for loopback only */
+	nveu8_t frame[OSI_MAX_MTU_SIZE + 64U];
+	/** FRP instruction table, written through MTL_RXP_IND_CS */
+	nveu32_t frp[DEVMODEL_FRP_WORDS];
+	/** Called after each FRP instruction word and each MTL_RXP_CS or
+	 * MTL_OP_MODE write, lets a test check the table the parser sees
+	 */
+	void (*frp_check)(void);
+	/** L3/L4 filter registers, written through MAC_L3L4_ADDR_CTR */
+	nveu32_t l3l4[DEVMODEL_L3L4_WORDS];
+	/** VLAN filter registers, written through MAC_VLAN_TAG_CTRL */
+	nveu32_t vlan[DEVMODEL_VLAN_WORDS];
+	/** EST GCL and GCL related registers, written through
+	 * MTL_EST_GCL_CONTROL, one bank only
+	 */
+	nveu32_t gcl[DEVMODEL_GCL_WORDS];
+	nveu32_t gcrr[DEVMODEL_GCRR_WORDS];
+	/** Model counters */
+	struct devmodel_stats stats;
+};
+
+/**
+ * @brief devmodel_get - Model instance.
+ *
+ * @return Pointer to the model.
+ */
+struct devmodel *devmodel_get(void);
+
+/**
+ * @brief devmodel_reset - Power on reset of the model.
+ *
+ * Algorithm: Clears all registers and engine state and loads reset
+ * values of ID registers (MGBE 3.10).
+ */
+void devmodel_reset(void);
+
+/**
+ * @brief devmodel_mac_base - MAC/DMA register window.
+ *
+ * @return Base to program as osi_core->base, dma_base and osi_dma->base.
+ */
+void *devmodel_mac_base(void);
+
+/**
+ * @brief devmodel_xpcs_base - XPCS register window.
+ *
+ * @return Base to program as osi_core->xpcs_base.
+ */
+void *devmodel_xpcs_base(void);
+
+/**
+ * @brief devmodel_advance - Advance model time.
+ *
+ * Algorithm: Called from OSD delay callbacks. PTP system time runs with
+ * model time.
+ *
+ * @param[in] ns: Time to add in ns.
+ */
+void devmodel_advance(nveu64_t ns);
+
+/**
+ * @brief devmodel_rx_inject - Receive one frame on a DMA channel.
+ *
+ * Algorithm: Copies the frame into the next HW owned Rx descriptor buffer,
+ * writes back RDES3 with FD/LD, length and the requested error, VLAN and
+ * timestamp status and raises the channel Rx interrupt status.
+ *
+ * @param[in] chan: DMA channel.
+ * @param[in] f: Frame to receive.
+ *
+ * @retval 0 on success
+ * @retval -1 if no Rx descriptor is owned by HW
+ */
+nve32_t devmodel_rx_inject(nveu32_t chan, const struct devmodel_rx_frame *f);
+
+/**
+ * @brief devmodel_tx_run - Run the Tx engine of a channel.
+ *
+ * Algorithm: Completes HW owned descriptors up to the last written tail
+ * pointer, like a tail pointer write does without tx_defer.
+ *
+ * @param[in] chan: DMA channel.
+ */
+void devmodel_tx_run(nveu32_t chan);
+
+/**
+ * @brief devmodel_mmc - Current value of a 64 bit MMC counter.
+ *
+ * @param[in] reg_l: Offset of low word of the counter.
+ *
+ * @return Counter value without reset on read side effect.
+ */
+nveu64_t devmodel_mmc(nveu32_t reg_l);
+
+#endif /* INCLUDED_DEVMODEL_H */
@@ -0,0 +1,922 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Bring up and data path test of OSI core and DMA on the device model,
+ * see Makefile in this directory.
+ *
+ * - MAC/DMA init completes through all busy bit polls.
+ * - Tx completion of plain, VLAN, TSO and PTP packets, MMC Tx counters
+ *   and delayed Tx timestamp through the common ISR.
+ * - Rx of good, VLAN, checksum error and timestamped frames, loopback.
+ * - MMC reset on read accumulates in SW counters once.
+ * - PTP system time set and readback.
+ * - VM IRQ remap only changes the VM routing of the channel.
+ * - Asynchronous RSS config times out on elapsed time, not on polls.
+ * - RSS profile is stored only once HW took it.
+ * - RSS rebalance moves entries only to channels in the table and stores
+ *   the table once HW took it.
+ * - FRP compiler output for multi atom, shared prefix and link rules, in
+ *   the compiled table and in the HW instruction table.
+ * - FRP update keeps the parser enabled and on a complete old or new
+ *   table after every register write.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "devmodel.h"
+#include "osd_stub.h"
+#include "../core/mgbe_core.h"
+#include "../core/mgbe_mmc.h"
+
+/** Packets sent or received per test step */
+#define TEST_PKTS	8U
+
+static struct osd_stub stub;
+
+#define CHECK(cond, ...)					\
+	do {							\
+		if (!(cond)) {					\
+			printf("FAIL %s:%d: ", __func__, __LINE__);	\
+			printf(__VA_ARGS__);			\
+			printf("\n");				\
+			fail++;					\
+		}						\
+	} while (0)
+
+/**
+ * @brief test_init - Bring up MAC and DMA.
+ *
+ * @retval Number of failures
+ */
+static int test_init(void)
+{
+	struct devmodel *dm = devmodel_get();
+	int fail = 0;
+	nve32_t ret;
+
+	stub.cfg.nchans = 2U;
+	stub.cfg.ring_sz = 256U;
+	stub.cfg.mtu = 1500U;
+
+	ret = osd_stub_core_init(&stub);
+	CHECK(ret == 0, "core init %d", ret);
+	CHECK(stub.osi_core->mac_ver == OSI_MGBE_MAC_3_10, "mac_ver 0x%x",
+	      stub.osi_core->mac_ver);
+
+	ret = osd_stub_dma_init(&stub);
+	CHECK(ret == 0, "dma init %d", ret);
+	CHECK(stub.cnt.errors == 0U, "%llu library errors",
+	      (unsigned long long)stub.cnt.errors);
+	CHECK(dm->stats.stray == 0U, "%llu accesses outside model",
+	      (unsigned long long)dm->stats.stray);
+	CHECK(dm->now_ns != 0U, "init did not poll any busy bit");
+
+	return fail;
+}
+
+/**
+ * @brief test_tx - Tx engine and completions.
+ *
+ * @retval Number of failures
+ */
+static int test_tx(void)
+{
+	const struct osd_stub_pkt pkts[] = {
+		{ 60U, 0U, 0U, 0U },
+		{ 1514U, OSD_STUB_PKT_CSUM, 0U, 0U },
+		{ 1514U, OSD_STUB_PKT_VLAN, 100U, 0U },
+		{ 9000U, OSD_STUB_PKT_TSO, 0U, 1448U },
+	};
+	struct devmodel *dm = devmodel_get();
+	nveu64_t pkts0 = devmodel_mmc(MMC_TXPACKETCOUNT_GB_L);
+	nveu32_t i;
+	nve32_t done = 0;
+	int fail = 0;
+
+	for (i = 0U; i < (nveu32_t)(sizeof(pkts) / sizeof(pkts[0])); i++) {
+		CHECK(osd_stub_xmit(&stub, 0U, &pkts[i]) == 0, "xmit %u", i);
+	}
+
+	done = osi_process_tx_completions(stub.osi_dma, 0U, 64);
+	CHECK(done == 4, "tx completions %d", done);
+	CHECK(osd_stub_tx_free(&stub, 0U) == (stub.cfg.ring_sz - 1U),
+	      "tx ring not cleaned");
+	/* TSO frame goes out as ceil(8946 / 1448) segments */
+	CHECK(devmodel_mmc(MMC_TXPACKETCOUNT_GB_L) - pkts0 == 3U + 7U,
+	      "MMC tx packets %llu",
+	      (unsigned long long)devmodel_mmc(MMC_TXPACKETCOUNT_GB_L));
+	CHECK(devmodel_mmc(MMC_TXVLANPACKETS_G_L) == 1U, "MMC tx vlan");
+	CHECK(dm->stats.tx_pkts == 4U, "model tx %llu",
+	      (unsigned long long)dm->stats.tx_pkts);
+
+	return fail;
+}
+
+/**
+ * @brief test_tx_ts - Delayed Tx timestamp of a PTP packet.
+ *
+ * @retval Number of failures
+ */
+static int test_tx_ts(void)
+{
+	const struct osd_stub_pkt pkt = { 86U, OSD_STUB_PKT_PTP, 0U, 0U };
+	struct osi_ioctl ioctl;
+	int fail = 0;
+	nve32_t ret;
+
+	stub.cnt.tx_ts = 0U;
+	CHECK(osd_stub_xmit(&stub, 1U, &pkt) == 0, "xmit");
+	CHECK(osi_process_tx_completions(stub.osi_dma, 1U, 64) == 1,
+	      "tx completion");
+	CHECK(stub.cnt.tx_ts == 1U, "no delayed timestamp");
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_COMMON_ISR;
+	CHECK(osi_handle_ioctl(stub.osi_core, &ioctl) == 0, "common isr");
+	CHECK(devmodel_get()->tx_ts_cnt == 0U, "Tx timestamp FIFO not read");
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_GET_TX_TS;
+	ioctl.tx_ts.pkt_id = stub.tx_ring[1].tx_swcx[1].pktid;
+	ret = osi_handle_ioctl(stub.osi_core, &ioctl);
+	CHECK(ret == 0, "get tx ts %d", ret);
+
+	return fail;
+}
+
+/**
+ * @brief test_rx - Rx engine write back and loopback.
+ *
+ * @retval Number of failures
+ */
+static int test_rx(void)
+{
+	static const nveu8_t frame[64] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+	const struct devmodel_rx_frame f[] = {
+		{ frame, 64U, 0U, 0U },
+		{ frame, 64U, DEVMODEL_RX_VLAN, 42U },
+		{ frame, 64U, DEVMODEL_RX_CSUM_ERR, 0U },
+		{ frame, 64U, DEVMODEL_RX_TS, 0U },
+		{ frame, 64U, DEVMODEL_RX_CRC_ERR, 0U },
+	};
+	const struct osd_stub_pkt pkt = { 128U, 0U, 0U, 0U };
+	struct devmodel *dm = devmodel_get();
+	nveu32_t more = 0U;
+	nveu32_t i;
+	nve32_t got;
+	int fail = 0;
+
+	for (i = 0U; i < (nveu32_t)(sizeof(f) / sizeof(f[0])); i++) {
+		CHECK(devmodel_rx_inject(0U, &f[i]) == 0, "inject %u", i);
+	}
+
+	got = osi_process_rx_completions(stub.osi_dma, 0U, 64, &more);
+	CHECK(got == 5, "rx completions %d", got);
+	CHECK(stub.cnt.rx_pkts == 4U, "rx valid %llu",
+	      (unsigned long long)stub.cnt.rx_pkts);
+	CHECK(stub.cnt.rx_invalid == 1U, "rx crc error not flagged");
+	CHECK(stub.cnt.rx_vlan == 1U, "rx vlan");
+	CHECK(stub.last_rx.vlan_tag == 0U, "vlan tag of last frame");
+	CHECK(stub.cnt.rx_csum_err == 1U, "rx csum error");
+	CHECK(stub.cnt.rx_ts == 1U, "rx timestamp");
+	CHECK(osd_stub_rx_refill(&stub, 0U) == 0, "refill");
+
+	dm->loopback = OSI_ENABLE;
+	for (i = 0U; i < TEST_PKTS; i++) {
+		CHECK(osd_stub_xmit(&stub, 0U, &pkt) == 0, "xmit %u", i);
+	}
+	dm->loopback = OSI_DISABLE;
+	CHECK(osi_process_tx_completions(stub.osi_dma, 0U, 64) ==
+	      (nve32_t)TEST_PKTS, "loopback tx");
+	got = osi_process_rx_completions(stub.osi_dma, 0U, 64, &more);
+	CHECK(got == (nve32_t)TEST_PKTS, "loopback rx %d", got);
+	CHECK(stub.last_rx.pkt_len == pkt.len, "loopback len %u",
+	      stub.last_rx.pkt_len);
+	CHECK(osd_stub_rx_refill(&stub, 0U) == 0, "refill");
+
+	return fail;
+}
+
+/**
+ * @brief test_mmc - MMC read accumulates reset on read counters.
+ *
+ * @retval Number of failures
+ */
+static int test_mmc(void)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	struct osi_core_stats_snap snap;
+	struct osi_ioctl ioctl;
+	nveu64_t tx;
+	nveu32_t gen;
+	int fail = 0;
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_READ_MMC;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "read mmc");
+	tx = osi_core->mmc.mmc_tx_framecount_gb;
+	CHECK(tx != 0U, "no Tx frames counted");
+	CHECK(osi_core->mmc.mmc_rx_crc_error == 1U, "rx crc %llu",
+	      (unsigned long long)osi_core->mmc.mmc_rx_crc_error);
+	CHECK(devmodel_mmc(MMC_TXPACKETCOUNT_GB_L) == 0U,
+	      "counter not reset on read");
+
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "read mmc");
+	CHECK(osi_core->mmc.mmc_tx_framecount_gb == tx,
+	      "counted twice %llu",
+	      (unsigned long long)osi_core->mmc.mmc_tx_framecount_gb);
+
+	/* Only commands writing stats or mmc advance snapshot generation */
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_STATS_SNAPSHOT;
+	ioctl.stats_snap = &snap;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "snapshot");
+	gen = snap.gen;
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_GET_MAC_VER;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "get mac ver");
+	ioctl.cmd = OSI_CMD_READ_MMC;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "read mmc");
+	ioctl.cmd = OSI_CMD_STATS_SNAPSHOT;
+	ioctl.stats_snap = &snap;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "snapshot");
+	CHECK(snap.gen == gen + 1U, "generation %u after %u", snap.gen, gen);
+	CHECK(snap.mmc.mmc_tx_framecount_gb == tx, "snapshot mmc");
+
+	return fail;
+}
+
+/**
+ * @brief test_ptp - System time set and running with model time.
+ *
+ * @retval Number of failures
+ */
+static int test_ptp(void)
+{
+	struct osi_ioctl ioctl;
+	nveu32_t sec = 0U, nsec = 0U;
+	int fail = 0;
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_SET_SYSTOHW_TIME;
+	ioctl.arg1_u32 = 1000U;
+	ioctl.arg2_u32 = 500U;
+	CHECK(osi_handle_ioctl(stub.osi_core, &ioctl) == 0, "set time");
+
+	devmodel_advance(2000U);
+	CHECK(osi_dma_get_systime_from_mac(stub.osi_dma, &sec, &nsec) == 0,
+	      "get time");
+	/* Command polls of the library advance model time too */
+	CHECK((sec == 1000U) && (nsec >= 2500U) && (nsec < 10000000U),
+	      "time %u.%09u", sec, nsec);
+
+	return fail;
+}
+
+/**
+ * @brief test_vm_irq - Remap a DMA channel to another VM IRQ.
+ *
+ * @retval Number of failures
+ */
+static int test_vm_irq(void)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	struct devmodel *dm = devmodel_get();
+	/* VIRT_INTR_APB_CHX_CNTRL and VIRT_INTR_CHX_CNTRL of channel 1 */
+	const nveu32_t apb = (0x8200U + 4U) / 4U;
+	const nveu32_t ctrl = (0x8600U + 8U) / 4U;
+	const nveu32_t virt = (0x8604U + 8U) / 4U;
+	struct osi_ioctl ioctl;
+	nveu64_t writes;
+	nveu32_t en;
+	int fail = 0;
+
+	osi_core->num_vm_irqs = 2U;
+	osi_core->irq_data[0].vm_num = 0U;
+	osi_core->irq_data[0].num_vm_chans = 2U;
+	osi_core->irq_data[0].vm_chans[0] = 0U;
+	osi_core->irq_data[0].vm_chans[1] = 1U;
+	osi_core->irq_data[1].vm_num = 3U;
+	osi_core->irq_data[1].num_vm_chans = 0U;
+	en = dm->mac[ctrl];
+	/* Rx interrupt raised while the channel is on the old VM IRQ */
+	dm->mac[virt] = OSI_BIT(1);
+	writes = dm->stats.writes;
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_REMAP_VM_IRQ;
+	ioctl.arg1_u32 = 1U;
+	ioctl.arg2_u32 = 1U;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "remap");
+	CHECK(dm->mac[apb] == OSI_BIT(3), "routing 0x%x", dm->mac[apb]);
+	CHECK(ioctl.arg3_u32 == OSI_BIT(1), "pending 0x%x", ioctl.arg3_u32);
+	CHECK(dm->mac[virt] == OSI_BIT(1), "pending status acked");
+	/* Enables are owned by the DMA instance, not even saved/restored */
+	CHECK(dm->mac[ctrl] == en, "channel interrupt enables changed");
+	CHECK(dm->stats.writes - writes == 1U, "%llu register writes",
+	      (unsigned long long)(dm->stats.writes - writes));
+	CHECK((osi_core->irq_data[0].num_vm_chans == 1U) &&
+	      (osi_core->irq_data[1].num_vm_chans == 1U) &&
+	      (osi_core->irq_data[1].vm_chans[0] == 1U), "irq_data not moved");
+
+	/* Nothing pending */
+	dm->mac[virt] = 0U;
+	ioctl.arg2_u32 = 0U;
+	ioctl.arg3_u32 = 0xFFU;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "remap back");
+	CHECK(ioctl.arg3_u32 == 0U, "pending 0x%x", ioctl.arg3_u32);
+	CHECK(dm->mac[apb] == OSI_BIT(0), "routing 0x%x", dm->mac[apb]);
+
+	return fail;
+}
+
+/**
+ * @brief model_time_ns - osd_ops.get_time_ns on model time.
+ */
+static nveu64_t model_time_ns(void *priv)
+{
+	(void)priv;
+
+	return devmodel_get()->now_ns;
+}
+
+/**
+ * @brief test_async_timeout - HW busy timeout of an asynchronous job.
+ *
+ * @retval Number of failures
+ */
+static int test_async_timeout(void)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	struct devmodel *dm = devmodel_get();
+	nveu32_t busy_reads = dm->busy_reads;
+	struct osi_ioctl ioctl;
+	nveu32_t i;
+	nve32_t ret;
+	int fail = 0;
+
+	/* RSS indirect access stays busy for more polls than its retry count
+	 * of MGBE_MAC_RSS_OB_RETRY
+	 */
+	dm->busy_reads = 200U;
+	osi_core->rss.enable = OSI_ENABLE;
+	osi_core->osd_ops.get_time_ns = model_time_ns;
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_ASYNC_START;
+	ioctl.arg1_u32 = OSI_CMD_CONFIG_RSS;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "async start");
+
+	/* Polls faster than the back-off delay don't time out */
+	for (i = 0U; i < 150U; i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_ASYNC_POLL;
+		ret = osi_handle_ioctl(osi_core, &ioctl);
+		if ((ret != 0) || (ioctl.arg1_u32 != OSI_ASYNC_PENDING)) {
+			break;
+		}
+	}
+	CHECK(i == 150U, "timed out after %u polls, ret %d", i, ret);
+
+	/* Past retry * delay the job fails */
+	devmodel_advance(((nveu64_t)MGBE_MAC_RSS_OB_RETRY *
+			  MGBE_MAC_RSS_OB_WAIT * 1000ULL) + 1U);
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_ASYNC_POLL;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) < 0, "no timeout");
+	CHECK(ioctl.arg1_u32 == OSI_ASYNC_DONE, "state %u", ioctl.arg1_u32);
+	/* The failed job is logged as an error */
+	stub.cnt.errors = 0U;
+
+	osi_core->osd_ops.get_time_ns = NULL;
+	osi_core->rss.enable = OSI_DISABLE;
+	dm->busy_reads = busy_reads;
+
+	return fail;
+}
+
+/**
+ * @brief test_rss_profile - RSS profile is committed on success only.
+ *
+ * @retval Number of failures
+ */
+static int test_rss_profile(void)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	struct devmodel *dm = devmodel_get();
+	nveu32_t busy_reads = dm->busy_reads;
+	struct osi_ioctl ioctl;
+	nveu8_t key[OSI_RSS_HASH_KEY_SIZE];
+	nveu32_t i;
+	int fail = 0;
+
+	osi_core->rss.enable = OSI_ENABLE;
+	osi_core->rss.hash_types = OSI_RSS_HASH_ALL;
+	memcpy(key, osi_core->rss.key, sizeof(key));
+
+	/* HW never completes the key writes */
+	dm->busy_reads = 255U;
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_RSS_PROFILE;
+	ioctl.rss_profile.hash_types = OSI_RSS_HASH_TCP;
+	ioctl.rss_profile.symmetric = OSI_ENABLE;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) < 0, "profile on busy HW");
+	CHECK(osi_core->rss.hash_types == OSI_RSS_HASH_ALL,
+	      "hash types 0x%x after failure", osi_core->rss.hash_types);
+	CHECK(memcmp(key, osi_core->rss.key, sizeof(key)) == 0,
+	      "key changed after failure");
+	/* The timeout is logged as an error */
+	stub.cnt.errors = 0U;
+
+	/* HW completes the stuck write, pending job doesn't change the
+	 * profile yet
+	 */
+	dm->busy_reads = 0U;
+	dm->busy[MGBE_MAC_RSS_ADDR / 4U] = 0U;
+	dm->mac[MGBE_MAC_RSS_ADDR / 4U] &= ~MGBE_MAC_RSS_ADDR_OB;
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_ASYNC_START;
+	ioctl.arg1_u32 = OSI_CMD_RSS_PROFILE;
+	ioctl.rss_profile.hash_types = OSI_RSS_HASH_TCP;
+	ioctl.rss_profile.symmetric = OSI_ENABLE;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "async start");
+	CHECK(osi_core->rss.hash_types == OSI_RSS_HASH_ALL,
+	      "hash types 0x%x while pending", osi_core->rss.hash_types);
+
+	for (i = 0U; i < 8U; i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_ASYNC_POLL;
+		CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "async poll");
+		if (ioctl.arg1_u32 != OSI_ASYNC_PENDING) {
+			break;
+		}
+	}
+	CHECK(ioctl.arg1_u32 == OSI_ASYNC_DONE, "state %u", ioctl.arg1_u32);
+	CHECK(osi_core->rss.hash_types == OSI_RSS_HASH_TCP,
+	      "hash types 0x%x after job", osi_core->rss.hash_types);
+	CHECK((osi_core->rss.key[0] == osi_core->rss.key[2]) &&
+	      (osi_core->rss.key[1] == osi_core->rss.key[3]),
+	      "key not symmetric after job");
+	CHECK((dm->mac[MGBE_MAC_RSS_CTRL / 4U] &
+	       (MGBE_MAC_RSS_CTRL_RSSE | MGBE_MAC_RSS_CTRL_TCP4TE |
+		MGBE_MAC_RSS_CTRL_UDP4TE)) ==
+	      (MGBE_MAC_RSS_CTRL_RSSE | MGBE_MAC_RSS_CTRL_TCP4TE),
+	      "RSS control 0x%x", dm->mac[MGBE_MAC_RSS_CTRL / 4U]);
+
+	osi_core->rss.enable = OSI_DISABLE;
+	dm->busy_reads = busy_reads;
+
+	return fail;
+}
+
+/**
+ * @brief test_rss_rebalance - RSS rebalance is committed on success only.
+ *
+ * @retval Number of failures
+ */
+static int test_rss_rebalance(void)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	/* Channel 3 serves an Rx queue but is left out of the table */
+	const nveu64_t rx_pkts[4] = { 9000U, 3000U, 2000U, 0U };
+	nveu32_t table[OSI_RSS_MAX_TABLE_SIZE];
+	struct osi_ioctl ioctl;
+	nveu32_t i, moved = 0U, was2 = 0U, on2 = 0U, on3 = 0U;
+	int fail = 0;
+
+	osi_core->rss.enable = OSI_ENABLE;
+	for (i = 0U; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
+		osi_core->rss.table[i] = i % 3U;
+	}
+	memcpy(table, osi_core->rss.table, sizeof(table));
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_RSS_TABLE_UPDATE;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "table update");
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_ASYNC_START;
+	ioctl.arg1_u32 = OSI_CMD_RSS_REBALANCE;
+	memcpy(ioctl.rss_rebalance.q_rx_pkt_n, rx_pkts, sizeof(rx_pkts));
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "async start");
+	CHECK(ioctl.rss_rebalance.moved == 0U, "moved %u while pending",
+	      ioctl.rss_rebalance.moved);
+	CHECK(memcmp(table, osi_core->rss.table, sizeof(table)) == 0,
+	      "table changed while pending");
+
+	/* Synchronous rebalance can't race the pending job */
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_RSS_REBALANCE;
+	memcpy(ioctl.rss_rebalance.q_rx_pkt_n, rx_pkts, sizeof(rx_pkts));
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) < 0,
+	      "rebalance while pending");
+	stub.cnt.errors = 0U;
+
+	for (i = 0U; i < 64U; i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_ASYNC_POLL;
+		CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "async poll");
+		if (ioctl.arg1_u32 != OSI_ASYNC_PENDING) {
+			break;
+		}
+	}
+	CHECK(ioctl.arg1_u32 == OSI_ASYNC_DONE, "state %u", ioctl.arg1_u32);
+
+	for (i = 0U; i < OSI_RSS_MAX_TABLE_SIZE; i++) {
+		if (osi_core->rss.table[i] != table[i]) {
+			moved++;
+		}
+		was2 += (table[i] == 2U) ? 1U : 0U;
+		on2 += (osi_core->rss.table[i] == 2U) ? 1U : 0U;
+		on3 += (osi_core->rss.table[i] == 3U) ? 1U : 0U;
+	}
+	CHECK((moved != 0U) && (ioctl.arg3_u32 == moved),
+	      "%u entries changed, %u reported", moved, ioctl.arg3_u32);
+	CHECK(on2 == (was2 + moved), "%u entries on coldest table channel",
+	      on2);
+	CHECK(on3 == 0U, "%u entries on channel outside the table", on3);
+
+	/* Samples of the completed job are used up, no new load */
+	memcpy(table, osi_core->rss.table, sizeof(table));
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_RSS_REBALANCE;
+	memcpy(ioctl.rss_rebalance.q_rx_pkt_n, rx_pkts, sizeof(rx_pkts));
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "rebalance");
+	CHECK((ioctl.rss_rebalance.moved == 0U) &&
+	      (memcmp(table, osi_core->rss.table, sizeof(table)) == 0),
+	      "moved %u without new load", ioctl.rss_rebalance.moved);
+
+	osi_core->rss.enable = OSI_DISABLE;
+
+	return fail;
+}
+
+/**
+ * @brief Expected entry of the compiled FRP table
+ */
+struct frp_exp {
+	/** FRP ID of the rule the entry belongs to */
+	nve32_t frp_id;
+	/** Match data and enable */
+	nveu32_t md;
+	nveu32_t me;
+	/** Frame offset in words */
+	nveu8_t fo;
+	/** MGBE_MTL_FRP_IE2_AF, RF, IM and NC bits */
+	nveu32_t flags;
+	/** OK index in compiled table */
+	nveu8_t oki;
+	/** DMA channel selection */
+	nveu32_t dch;
+};
+
+/** FRP rule set of test_frp_compile(), added in this order */
+static const struct osi_core_frp_cmd frp_rules[] = {
+	/* Two atoms at offset 0 */
+	{ .frp_id = 1, .match_type = OSI_FRP_MATCH_NORMAL,
+	  .match = { 0x00U, 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U },
+	  .match_length = 8U, .filter_mode = OSI_FRP_MODE_ROUTE,
+	  .dma_sel = 0x1U },
+	/* TCP port 80 and 443 share the protocol atom, the UDP rule in
+	 * between can't match a TCP frame
+	 */
+	{ .frp_id = 2, .match_type = OSI_FRP_MATCH_L4_D_TPORT,
+	  .match = { 0x00U, 0x50U }, .match_length = 2U,
+	  .filter_mode = OSI_FRP_MODE_ROUTE, .dma_sel = 0x2U },
+	{ .frp_id = 3, .match_type = OSI_FRP_MATCH_L4_D_UPORT,
+	  .match = { 0x00U, 0x35U }, .match_length = 2U,
+	  .filter_mode = OSI_FRP_MODE_ROUTE, .dma_sel = 0x4U },
+	{ .frp_id = 4, .match_type = OSI_FRP_MATCH_L4_D_TPORT,
+	  .match = { 0x01U, 0xBBU }, .match_length = 2U,
+	  .filter_mode = OSI_FRP_MODE_ROUTE, .dma_sel = 0x8U },
+	/* Link target dropping IPv4 DIP 10.0.0.1 and IPv4 link to it */
+	{ .frp_id = 5, .match_type = OSI_FRP_MATCH_L3_DIP,
+	  .match = { 10U, 0U, 0U, 1U }, .match_length = 4U,
+	  .filter_mode = OSI_FRP_MODE_DROP },
+	{ .frp_id = 6, .match_type = OSI_FRP_MATCH_NORMAL,
+	  .match = { 0x08U, 0x00U }, .match_length = 2U, .offset = 12U,
+	  .filter_mode = OSI_FRP_MODE_LINK, .next_frp_id = 5 },
+};
+
+#define FRP_AF	MGBE_MTL_FRP_IE2_AF
+#define FRP_RF	MGBE_MTL_FRP_IE2_RF
+#define FRP_IM	MGBE_MTL_FRP_IE2_IM
+#define FRP_NC	MGBE_MTL_FRP_IE2_NC
+/** OSI_ENABLE if expected entry has the flag */
+#define FRP_FLAG(e, f)	((((e)->flags & (f)) != 0U) ? OSI_ENABLE : OSI_DISABLE)
+
+/** Compiled table of frp_rules */
+static const struct frp_exp frp_exp_tbl[] = {
+	/* Rule 1, first atom skips the rule on mismatch */
+	{ 1, 0x33221100U, 0xFFFFFFFFU, 0U, FRP_IM | FRP_NC, 2U, 0x1U },
+	{ 1, 0x77665544U, 0xFFFFFFFFU, 1U, FRP_AF, 0U, 0x1U },
+	/* TCP guard skips rules 2 and 4 */
+	{ 2, 0x06000000U, 0xFF000000U, 5U, FRP_IM | FRP_NC, 5U, 0x0U },
+	{ 2, 0x00005000U, 0x0000FFFFU, 9U, FRP_AF, 0U, 0x2U },
+	{ 4, 0x0000BB01U, 0x0000FFFFU, 9U, FRP_AF, 0U, 0x8U },
+	/* Rule 3 alone */
+	{ 3, 0x11000000U, 0xFF000000U, 5U, FRP_IM | FRP_NC, 7U, 0x4U },
+	{ 3, 0x00003500U, 0x0000FFFFU, 9U, FRP_AF, 0U, 0x4U },
+	/* Rule 5 keeps its place as link target */
+	{ 5, 0x000A0000U, 0xFFFF0000U, 7U, FRP_IM | FRP_NC, 9U, 0x0U },
+	{ 5, 0x00000100U, 0x0000FFFFU, 8U, FRP_RF, 0U, 0x0U },
+	/* Rule 6 jumps to first entry of rule 5 */
+	{ 6, 0x00000008U, 0x0000FFFFU, 3U, FRP_NC, 7U, 0x0U },
+};
+
+/**
+ * @brief frp_hw_entry - HW instruction table entry holds FRP entry data.
+ *
+ * @param[in] pos: HW entry location.
+ * @param[in] d: FRP entry data.
+ * @param[in] start: Offset added to OKI of NIC entries.
+ *
+ * @retval 1 if all four instruction words match
+ */
+static int frp_hw_entry(nveu32_t pos, const struct osi_core_frp_data *d,
+			nveu32_t start)
+{
+	const nveu32_t *ie = &devmodel_get()->frp[MGBE_MTL_FRP_IE0(pos)];
+	nveu32_t oki = d->ok_index;
+	nveu32_t ie2;
+
+	ie2 = ((nveu32_t)d->frame_offset << MGBE_MTL_FRP_IE2_FO_SHIFT) &
+	      MGBE_MTL_FRP_IE2_FO;
+	ie2 |= (d->dma_chsel << MGBE_MTL_FRP_IE2_DCH_SHIFT) &
+	       MGBE_MTL_FRP_IE2_DCH;
+	ie2 |= (d->accept_frame == OSI_ENABLE) ? FRP_AF : 0U;
+	ie2 |= (d->reject_frame == OSI_ENABLE) ? FRP_RF : 0U;
+	ie2 |= (d->inverse_match == OSI_ENABLE) ? FRP_IM : 0U;
+	if (d->next_ins_ctrl == OSI_ENABLE) {
+		ie2 |= FRP_NC;
+		oki += start;
+	}
+	ie2 |= (oki << MGBE_MTL_FRP_IE2_OKI_SHIFT) & MGBE_MTL_FRP_IE2_OKI;
+
+	return ((ie[0] == d->match_data) && (ie[1] == d->match_en) &&
+		(ie[2] == ie2) &&
+		(ie[3] == (d->dma_chsel & MGBE_MTL_FRP_IE3_DCH_MASK))) ? 1 : 0;
+}
+
+/**
+ * @brief frp_hw_table - Table the parser walks from the root entry.
+ *
+ * Algorithm: Root entry 0 jumps to the table, which must hold all entries
+ * followed by the BYPASS entry, all within NVE.
+ *
+ * @param[in] tbl: Compiled FRP table.
+ * @param[in] cnt: Number of entries in tbl.
+ *
+ * @retval 1 if the parser sees tbl
+ */
+static int frp_hw_table(const struct osi_core_frp_entry *tbl, nveu32_t cnt)
+{
+	struct devmodel *dm = devmodel_get();
+	nveu32_t nve = dm->mac[MGBE_MTL_RXP_CS / 4U] & MGBE_MTL_RXP_CS_NVE;
+	nveu32_t root = dm->frp[MGBE_MTL_FRP_IE2(0U)];
+	struct osi_core_frp_data d;
+	nveu32_t start, i;
+
+	memset(&d, 0, sizeof(d));
+	start = (root & MGBE_MTL_FRP_IE2_OKI) >> MGBE_MTL_FRP_IE2_OKI_SHIFT;
+	d.next_ins_ctrl = OSI_ENABLE;
+	d.ok_index = (nveu8_t)start;
+	if ((frp_hw_entry(0U, &d, 0U) == 0) || (start == 0U) ||
+	    ((start + cnt) > nve)) {
+		return 0;
+	}
+
+	for (i = 0U; i < cnt; i++) {
+		if (frp_hw_entry(start + i, &tbl[i].data, start) == 0) {
+			return 0;
+		}
+	}
+
+	memset(&d, 0, sizeof(d));
+	d.accept_frame = OSI_ENABLE;
+	d.reject_frame = OSI_ENABLE;
+
+	return frp_hw_entry(start + cnt, &d, 0U);
+}
+
+/**
+ * @brief test_frp_compile - FRP rule set compile.
+ *
+ * @retval Number of failures
+ */
+static int test_frp_compile(void)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	struct devmodel *dm = devmodel_get();
+	const nveu32_t n = sizeof(frp_exp_tbl) / sizeof(frp_exp_tbl[0]);
+	struct osi_core_frp_entry exp[sizeof(frp_exp_tbl) /
+				      sizeof(frp_exp_tbl[0])];
+	const struct frp_exp *e;
+	struct osi_ioctl ioctl;
+	nveu32_t i;
+	int fail = 0;
+
+	for (i = 0U; i < (sizeof(frp_rules) / sizeof(frp_rules[0])); i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_CONFIG_FRP;
+		ioctl.frp_cmd = frp_rules[i];
+		ioctl.frp_cmd.cmd = OSI_FRP_CMD_ADD;
+		CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "add rule %d",
+		      frp_rules[i].frp_id);
+	}
+
+	memset(exp, 0, sizeof(exp));
+	for (i = 0U; i < n; i++) {
+		e = &frp_exp_tbl[i];
+		exp[i].frp_id = e->frp_id;
+		exp[i].data.match_data = e->md;
+		exp[i].data.match_en = e->me;
+		exp[i].data.frame_offset = e->fo;
+		exp[i].data.accept_frame = FRP_FLAG(e, FRP_AF);
+		exp[i].data.reject_frame = FRP_FLAG(e, FRP_RF);
+		exp[i].data.inverse_match = FRP_FLAG(e, FRP_IM);
+		exp[i].data.next_ins_ctrl = FRP_FLAG(e, FRP_NC);
+		exp[i].data.ok_index = e->oki;
+		exp[i].data.dma_chsel = e->dch;
+	}
+
+	CHECK(osi_core->frp_cnt == n, "%u entries compiled", osi_core->frp_cnt);
+	for (i = 0U; (i < n) && (i < osi_core->frp_cnt); i++) {
+		CHECK(memcmp(&osi_core->frp_table[i], &exp[i],
+			     sizeof(exp[i])) == 0,
+		      "entry %u: id %d md 0x%x me 0x%x fo %u oki %u", i,
+		      osi_core->frp_table[i].frp_id,
+		      osi_core->frp_table[i].data.match_data,
+		      osi_core->frp_table[i].data.match_en,
+		      osi_core->frp_table[i].data.frame_offset,
+		      osi_core->frp_table[i].data.ok_index);
+	}
+
+	CHECK(frp_hw_table(exp, n) == 1, "HW table differs");
+	CHECK((dm->mac[MGBE_MTL_OP_MODE / 4U] & MGBE_MTL_OP_MODE_FRPE) != 0U,
+	      "FRP not enabled");
+
+	return fail;
+}
+
+/** FRP table before the update under test */
+static struct osi_core_frp_entry frp_old[OSI_FRP_MAX_ENTRY];
+static nveu32_t frp_old_cnt;
+/** Parser views checked, views on neither table, writes with FRP off */
+static nveu32_t frp_views;
+static nveu32_t frp_bad;
+static nveu32_t frp_off;
+
+/**
+ * @brief frp_check_view - devmodel frp_check, parser sees a whole table.
+ *
+ * Algorithm: With FRPE set the root entry and NVE must select either the
+ * table before the update or the newly compiled one, every entry fully
+ * written.
+ */
+static void frp_check_view(void)
+{
+	struct devmodel *dm = devmodel_get();
+	const struct osi_core_priv_data *osi_core = stub.osi_core;
+
+	if ((dm->mac[MGBE_MTL_OP_MODE / 4U] & MGBE_MTL_OP_MODE_FRPE) == 0U) {
+		frp_off++;
+		return;
+	}
+
+	frp_views++;
+	if ((frp_hw_table(frp_old, frp_old_cnt) == 0) &&
+	    (frp_hw_table(osi_core->frp_table, osi_core->frp_cnt) == 0)) {
+		frp_bad++;
+	}
+}
+
+/**
+ * @brief frp_step - Run FRP command with parser view checks.
+ *
+ * @param[in] cmd: FRP command.
+ *
+ * @retval Number of failures
+ */
+static int frp_step(const struct osi_core_frp_cmd *cmd)
+{
+	struct osi_core_priv_data *osi_core = stub.osi_core;
+	struct devmodel *dm = devmodel_get();
+	struct osi_ioctl ioctl;
+	int fail = 0;
+
+	memcpy(frp_old, osi_core->frp_table, sizeof(frp_old));
+	frp_old_cnt = osi_core->frp_cnt;
+	frp_views = 0U;
+	frp_bad = 0U;
+	frp_off = 0U;
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_CONFIG_FRP;
+	ioctl.frp_cmd = *cmd;
+	dm->frp_check = frp_check_view;
+	CHECK(osi_handle_ioctl(osi_core, &ioctl) == 0, "cmd %u rule %d",
+	      cmd->cmd, cmd->frp_id);
+	dm->frp_check = NULL;
+
+	CHECK(frp_views != 0U, "cmd %u rule %d: no HW write", cmd->cmd,
+	      cmd->frp_id);
+	CHECK(frp_off == 0U, "cmd %u rule %d: parser disabled", cmd->cmd,
+	      cmd->frp_id);
+	CHECK(frp_bad == 0U, "cmd %u rule %d: %u of %u parser views broken",
+	      cmd->cmd, cmd->frp_id, frp_bad, frp_views);
+	CHECK(frp_hw_table(osi_core->frp_table, osi_core->frp_cnt) == 1,
+	      "cmd %u rule %d: HW table differs", cmd->cmd, cmd->frp_id);
+
+	return fail;
+}
+
+/**
+ * @brief test_frp_update - FRP update without disabling the parser.
+ *
+ * Algorithm: Runs on the rule set of test_frp_compile(). Updates move
+ * the table between the space before and after the active one.
+ *
+ * @retval Number of failures
+ */
+static int test_frp_update(void)
+{
+	struct osi_core_frp_cmd cmd;
+	nveu32_t i;
+	int fail = 0;
+
+	/* Change rule 4 port, each update relocates the table */
+	for (i = 0U; i < 4U; i++) {
+		cmd = frp_rules[3];
+		cmd.cmd = OSI_FRP_CMD_UPDATE;
+		cmd.match[1] = (nveu8_t)(cmd.match[1] + i + 1U);
+		fail += frp_step(&cmd);
+	}
+
+	/* Delete multi atom rule and add it back at the end */
+	memset(&cmd, 0, sizeof(cmd));
+	cmd.cmd = OSI_FRP_CMD_DEL;
+	cmd.frp_id = frp_rules[0].frp_id;
+	fail += frp_step(&cmd);
+
+	cmd = frp_rules[0];
+	cmd.cmd = OSI_FRP_CMD_ADD;
+	fail += frp_step(&cmd);
+
+	/* Rule joining the TCP group */
+	cmd = frp_rules[1];
+	cmd.cmd = OSI_FRP_CMD_ADD;
+	cmd.frp_id = 7;
+	cmd.match[1] = 0x16U;
+	fail += frp_step(&cmd);
+
+	return fail;
+}
+
+int main(void)
+{
+	int fail;
+
+	fail = test_init();
+	if (fail == 0) {
+		fail += test_tx();
+		fail += test_tx_ts();
+		fail += test_rx();
+		fail += test_mmc();
+		fail += test_ptp();
+		fail += test_vm_irq();
+		fail += test_async_timeout();
+		fail += test_rss_profile();
+		fail += test_rss_rebalance();
+		fail += test_frp_compile();
+		fail += test_frp_update();
+	}
+	osd_stub_dma_deinit(&stub);
+	if (stub.cnt.errors != 0U) {
+		printf("FAIL %llu library errors\n",
+		       (unsigned long long)stub.cnt.errors);
+		fail++;
+	}
+	printf("devmodel_test: %s\n", (fail == 0) ? "PASS" : "FAIL");
+
+	return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * DMA hot path benchmark on the device model, see Makefile in this
+ * directory.
+ *
+ * Each packet mix runs over several ring sizes in bursts of a quarter
+ * ring: queue or inject the burst, then reap it with the completion call.
+ * The Tx engine of the model runs between osi_hw_transmit() and
+ * osi_process_tx_completions(), so that osi_dma_priv_data.prof only
+ * accounts library cost. ns/pkt is wall time of the whole loop including
+ * the model and the stub OSD.
+ *
+ *   ./dma_bench [packets per case]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "devmodel.h"
+#include "osd_stub.h"
+
+/** Default packets per ring size and mix */
+#define BENCH_PKTS	200000U
+
+/** Rx frame buffer, largest frame injected */
+#define BENCH_RX_LEN	1514U
+
+/**
+ * @brief One packet mix
+ */
+struct bench_mix {
+	/** Name in the report */
+	const char *name;
+	/** Tx packet, len 0 for Rx mixes */
+	struct osd_stub_pkt tx;
+	/** Rx frame flags, see DEVMODEL_RX */
+	nveu32_t rx_flags;
+	/** Rx frame length */
+	nveu32_t rx_len;
+};
+
+static const struct bench_mix mixes[] = {
+	{ "tx plain", { 1514U, OSD_STUB_PKT_CSUM, 0U, 0U }, 0U, 0U },
+	{ "tx vlan", { 1514U, OSD_STUB_PKT_VLAN, 100U, 0U }, 0U, 0U },
+	{ "tx tso", { 9000U, OSD_STUB_PKT_TSO, 0U, 1448U }, 0U, 0U },
+	{ "tx ptp", { 86U, OSD_STUB_PKT_PTP, 0U, 0U }, 0U, 0U },
+	{ "rx plain", { 0U, 0U, 0U, 0U }, 0U, 1514U },
+	{ "rx vlan", { 0U, 0U, 0U, 0U }, DEVMODEL_RX_VLAN, 1514U },
+	{ "rx csum-err", { 0U, 0U, 0U, 0U }, DEVMODEL_RX_CSUM_ERR, 1514U },
+	{ "rx ptp", { 0U, 0U, 0U, 0U }, DEVMODEL_RX_TS, 90U },
+};
+
+static const nveu32_t ring_sizes[] = { 256U, 1024U, 4096U };
+
+static struct osd_stub stub;
+static nveu8_t rx_frame[BENCH_RX_LEN];
+
+/**
+ * @brief bench_prof_per_pkt - Cycles per packet of one hot path.
+ */
+static double bench_prof_per_pkt(nveu32_t path)
+{
+	const struct osi_dma_prof *p = &stub.osi_dma->prof[path];
+
+	return (p->pkts == 0U) ? 0.0 : ((double)p->cycles / (double)p->pkts);
+}
+
+/**
+ * @brief bench_tx - Run a Tx mix.
+ *
+ * @param[in] mix: Packet mix.
+ * @param[in] total: Packets to send.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+static int bench_tx(const struct bench_mix *mix, nveu64_t total)
+{
+	nveu32_t burst = stub.cfg.ring_sz / 4U;
+	nveu64_t sent = 0U;
+	nveu32_t i;
+	nve32_t done;
+
+	while (sent < total) {
+		for (i = 0U; (i < burst) && (sent < total); i++) {
+			if (osd_stub_xmit(&stub, 0U, &mix->tx) < 0) {
+				break;
+			}
+			sent++;
+		}
+		if (i == 0U) {
+			return -1;
+		}
+
+		devmodel_tx_run(0U);
+		do {
+			done = osi_process_tx_completions(stub.osi_dma, 0U,
+							  (nve32_t)burst);
+		} while (done > 0);
+		if (done < 0) {
+			return -1;
+		}
+		/* Tx timestamp FIFO is drained by the common ISR in an OSD */
+		devmodel_get()->tx_ts_cnt = 0U;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief bench_rx - Run an Rx mix.
+ *
+ * @param[in] mix: Packet mix.
+ * @param[in] total: Packets to receive.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+static int bench_rx(const struct bench_mix *mix, nveu64_t total)
+{
+	const struct devmodel_rx_frame f = {
+		rx_frame, mix->rx_len, mix->rx_flags, 100U
+	};
+	/* Timestamped frames take a context descriptor each */
+	nveu32_t burst = stub.cfg.ring_sz / 4U;
+	nveu64_t got = 0U;
+	nveu32_t more = 0U;
+	nveu32_t i;
+	nve32_t ret;
+
+	while (got < total) {
+		for (i = 0U; (i < burst) && ((got + i) < total); i++) {
+			if (devmodel_rx_inject(0U, &f) < 0) {
+				break;
+			}
+		}
+		if (i == 0U) {
+			return -1;
+		}
+
+		ret = osi_process_rx_completions(stub.osi_dma, 0U,
+						 (nve32_t)i, &more);
+		if (ret != (nve32_t)i) {
+			return -1;
+		}
+		got += i;
+		if (osd_stub_rx_refill(&stub, 0U) < 0) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	nveu64_t total = BENCH_PKTS;
+	nveu64_t t0, ns;
+	nveu32_t r, m;
+	int ret;
+	int fail = 0;
+
+	if (argc > 1) {
+		total = strtoull(argv[1], NULL, 0);
+	}
+
+	memset(rx_frame, 0x5a, sizeof(rx_frame));
+	stub.cfg.nchans = 1U;
+	stub.cfg.mtu = 1500U;
+	stub.cfg.ring_sz = ring_sizes[0];
+	if (osd_stub_core_init(&stub) < 0) {
+		printf("dma_bench: core init failed\n");
+		return 1;
+	}
+	devmodel_get()->tx_defer = OSI_ENABLE;
+
+	printf("%-6s %-12s %10s %9s %11s %11s %11s\n", "ring", "mix", "pkts",
+	       "ns/pkt", "xmit cyc", "txdone cyc", "rxdone cyc");
+
+	for (r = 0U; r < (nveu32_t)(sizeof(ring_sizes) / sizeof(ring_sizes[0]));
+	     r++) {
+		stub.cfg.ring_sz = ring_sizes[r];
+		if (osd_stub_dma_init(&stub) < 0) {
+			printf("dma_bench: dma init ring %u failed\n",
+			       stub.cfg.ring_sz);
+			fail++;
+			osd_stub_dma_deinit(&stub);
+			continue;
+		}
+
+		for (m = 0U; m < (nveu32_t)(sizeof(mixes) / sizeof(mixes[0]));
+		     m++) {
+			memset(stub.osi_dma->prof, 0,
+			       sizeof(stub.osi_dma->prof));
+			t0 = osd_stub_now_ns();
+			if (mixes[m].tx.len != 0U) {
+				ret = bench_tx(&mixes[m], total);
+			} else {
+				ret = bench_rx(&mixes[m], total);
+			}
+			ns = osd_stub_now_ns() - t0;
+			if (ret < 0) {
+				printf("%-6u %-12s FAIL\n", stub.cfg.ring_sz,
+				       mixes[m].name);
+				fail++;
+				continue;
+			}
+
+			printf("%-6u %-12s %10llu %9.1f %11.1f %11.1f %11.1f\n",
+			       stub.cfg.ring_sz, mixes[m].name,
+			       (unsigned long long)total,
+			       (double)ns / (double)total,
+			       bench_prof_per_pkt(OSI_DMA_PROF_XMIT),
+			       bench_prof_per_pkt(OSI_DMA_PROF_TX_DONE),
+			       bench_prof_per_pkt(OSI_DMA_PROF_RX_DONE));
+		}
+
+		osd_stub_dma_deinit(&stub);
+	}
+
+	if (stub.cnt.errors != 0U) {
+		printf("dma_bench: %llu library errors\n",
+		       (unsigned long long)stub.cnt.errors);
+		fail++;
+	}
+
+	return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * IVC loopback test and guest call latency benchmark, see Makefile in this
+ * directory. A virtualized guest core talks to the server core on the
+ * device model through osd_ops.ivc_send.
+ *
+ * - Guest ARP offload passes the IP by value, the guest pointer is kept.
+ * - Guest pointers in legacy and compact requests never reach the server
+ *   core.
+ * - Guest MMC reads don't return a stats page the server didn't update.
+ * - Counters of a short MMC or stats response are not copied.
+ * - With an argument, latency of guest and direct calls per command:
+ *
+ *   ./ivc_test [calls per command]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ivc_core.h>
+#include "devmodel.h"
+#include "osd_stub.h"
+#include "../core/mgbe_core.h"
+#include "../core/mgbe_mmc.h"
+
+static struct osd_stub stub;
+static ivc_msg_common_t msg;
+
+#define CHECK(cond, ...)					\
+	do {							\
+		if (!(cond)) {					\
+			printf("FAIL %s:%d: ", __func__, __LINE__);	\
+			printf(__VA_ARGS__);			\
+			printf("\n");				\
+			fail++;					\
+		}						\
+	} while (0)
+
+/**
+ * @brief test_arp - ARP offload from the guest.
+ *
+ * @retval Number of failures
+ */
+static int test_arp(void)
+{
+	nveu8_t ip[4] = { 192U, 168U, 1U, 2U };
+	struct devmodel *dm = devmodel_get();
+	struct osi_ioctl ioctl;
+	nve32_t ret;
+	int fail = 0;
+
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_ARP_OFFLOAD;
+	ioctl.arg1_u32 = OSI_ENABLE;
+	ioctl.arg7_u8_p = ip;
+	ret = osi_handle_ioctl(stub.guest, &ioctl);
+	CHECK(ret == 0, "arp offload %d", ret);
+	CHECK(dm->mac[MGBE_MAC_ARPPA / 4U] == 0xC0A80102U, "ARPPA 0x%x",
+	      dm->mac[MGBE_MAC_ARPPA / 4U]);
+	CHECK((dm->mac[MGBE_MAC_RMCR / 4U] & MGBE_MAC_RMCR_ARPEN) != 0U,
+	      "ARPEN not set");
+	CHECK(ioctl.arg7_u8_p == ip, "guest pointer overwritten");
+
+	/* Batches can't carry the IP */
+	ret = 0;
+	CHECK(osi_handle_ioctl_batch(stub.guest, &ioctl, &ret, 1U) < 0,
+	      "batched arp offload");
+
+	return fail;
+}
+
+/**
+ * @brief test_guest_ptr - Guest pointers are not used by the server.
+ *
+ * @retval Number of failures
+ */
+static int test_guest_ptr(void)
+{
+	/* Address only valid in some guest, must not be dereferenced */
+	nveu8_t *bad = (nveu8_t *)(uintptr_t)0x10U;
+	struct osi_ioctl ioctl;
+	nveu32_t len;
+	int fail = 0;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.cmd = handle_ioctl;
+	msg.data.ioctl_data.cmd = OSI_CMD_ARP_OFFLOAD;
+	msg.data.ioctl_data.arg1_u32 = OSI_ENABLE;
+	msg.data.ioctl_data.arg7_u8_p = bad;
+	msg.data_len = (nveu32_t)sizeof(struct osi_ioctl);
+	(void)osi_ivc_server_handle(stub.osi_core, &msg);
+	CHECK(msg.status < 0, "legacy arp offload used guest pointer");
+
+	/* Compact request without the IP */
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_ARP_OFFLOAD;
+	ioctl.arg1_u32 = OSI_ENABLE;
+	memset(&msg, 0, sizeof(msg));
+	msg.cmd = handle_ioctl_compact;
+	len = ivc_ioctl_pack(&ioctl, &msg.data.ioctl_c);
+	msg.data_len = len;
+	(void)osi_ivc_server_handle(stub.osi_core, &msg);
+	CHECK(msg.status < 0, "compact arp offload without IP");
+
+	/* Both requests are logged as errors by the server */
+	stub.cnt.errors = 0U;
+
+	return fail;
+}
+
+/**
+ * @brief test_stats_page - Guest MMC reads through the stats page.
+ *
+ * @retval Number of failures
+ */
+static int test_stats_page(void)
+{
+	static struct osi_stats_page page;
+	struct devmodel *dm = devmodel_get();
+	struct osi_ioctl ioctl;
+	int fail = 0;
+
+	memset(&page, 0, sizeof(page));
+	stub.osi_core->stats_page = &page;
+	stub.guest->stats_page = &page;
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_READ_MMC;
+
+	/* Nothing published yet, server reads HW and publishes */
+	dm->mac[MMC_TXPACKETCOUNT_GB_L / 4U] = 5U;
+	CHECK(osi_handle_ioctl(stub.guest, &ioctl) == 0, "read mmc");
+	CHECK(stub.guest->mmc.mmc_tx_framecount_gb == 5U, "tx %llu",
+	      (unsigned long long)stub.guest->mmc.mmc_tx_framecount_gb);
+	CHECK(page.seq == 2U, "page seq %u", page.seq);
+
+	/* Published page is copied once, then HW is read again */
+	dm->mac[MMC_TXPACKETCOUNT_GB_L / 4U] = 3U;
+	CHECK(osi_handle_ioctl(stub.guest, &ioctl) == 0, "read mmc");
+	CHECK(page.seq == 2U, "page read went to server");
+	CHECK(osi_handle_ioctl(stub.guest, &ioctl) == 0, "read mmc");
+	CHECK(stub.guest->mmc.mmc_tx_framecount_gb == 8U, "stale tx %llu",
+	      (unsigned long long)stub.guest->mmc.mmc_tx_framecount_gb);
+
+	stub.osi_core->stats_page = NULL;
+	stub.guest->stats_page = NULL;
+
+	return fail;
+}
+
+/** ivc_send of the stub, wrapped by short_ivc_send() */
+static nve32_t (*stub_send)(void *priv, struct ivc_msg_common *ivc,
+			    nveu32_t len);
+
+/**
+ * @brief short_ivc_send - Serve a request and cut the response payload.
+ */
+static nve32_t short_ivc_send(void *priv, struct ivc_msg_common *ivc,
+			      nveu32_t len)
+{
+	nve32_t ret = stub_send(priv, ivc, len);
+
+	ivc->data_len -= 8U;
+
+	return ret;
+}
+
+/**
+ * @brief test_short_reply - Truncated counter responses are rejected.
+ *
+ * @retval Number of failures
+ */
+static int test_short_reply(void)
+{
+	struct devmodel *dm = devmodel_get();
+	struct osi_ioctl ioctl;
+	nveu64_t tx;
+	int fail = 0;
+
+	stub_send = stub.guest->osd_ops.ivc_send;
+	stub.guest->osd_ops.ivc_send = short_ivc_send;
+
+	tx = stub.guest->mmc.mmc_tx_framecount_gb;
+	dm->mac[MMC_TXPACKETCOUNT_GB_L / 4U] = 7U;
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_READ_MMC;
+	CHECK(osi_handle_ioctl(stub.guest, &ioctl) < 0, "short mmc reply");
+	CHECK(stub.guest->mmc.mmc_tx_framecount_gb == tx, "tx %llu",
+	      (unsigned long long)stub.guest->mmc.mmc_tx_framecount_gb);
+
+	stub.osi_core->stats.const_gate_ctr_err = 9U;
+	stub.guest->stats.const_gate_ctr_err = 0U;
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_READ_STATS;
+	CHECK(osi_handle_ioctl(stub.guest, &ioctl) < 0, "short stats reply");
+	CHECK(stub.guest->stats.const_gate_ctr_err == 0U, "const_gate_ctr_err %llu",
+	      (unsigned long long)stub.guest->stats.const_gate_ctr_err);
+
+	stub.guest->osd_ops.ivc_send = stub_send;
+	/* Both responses are logged as errors by the guest */
+	stub.cnt.errors = 0U;
+
+	return fail;
+}
+
+/**
+ * @brief bench_cmd - Average latency of one command.
+ *
+ * @param[in] osi_core: Core to call.
+ * @param[in] ioctl: Command, copied for each call.
+ * @param[in] calls: Number of calls.
+ *
+ * @return ns per call.
+ */
+static double bench_cmd(struct osi_core_priv_data *osi_core,
+			const struct osi_ioctl *ioctl, nveu64_t calls)
+{
+	struct osi_ioctl data;
+	nveu64_t t0, i;
+
+	t0 = osd_stub_now_ns();
+	for (i = 0U; i < calls; i++) {
+		data = *ioctl;
+		(void)osi_handle_ioctl(osi_core, &data);
+	}
+
+	return (double)(osd_stub_now_ns() - t0) / (double)calls;
+}
+
+/**
+ * @brief bench - Guest call latency against direct calls on the server.
+ *
+ * @param[in] calls: Calls per command.
+ */
+static void bench(nveu64_t calls)
+{
+	static nveu8_t ip[4] = { 10U, 0U, 0U, 1U };
+	static const struct {
+		const char *name;
+		nveu32_t cmd;
+		nveu32_t arg1;
+	} cmds[] = {
+		{ "get_mac_ver", OSI_CMD_GET_MAC_VER, 0U },
+		{ "get_hw_feat", OSI_CMD_GET_HW_FEAT, 0U },
+		{ "arp_offload", OSI_CMD_ARP_OFFLOAD, OSI_ENABLE },
+		{ "read_mmc", OSI_CMD_READ_MMC, 0U },
+	};
+	struct osi_ioctl ioctl;
+	double guest, direct;
+	nveu32_t i;
+
+	printf("%-12s %10s %10s %10s\n", "cmd", "guest ns", "direct ns",
+	       "ivc ns");
+	for (i = 0U; i < (nveu32_t)(sizeof(cmds) / sizeof(cmds[0])); i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = cmds[i].cmd;
+		ioctl.arg1_u32 = cmds[i].arg1;
+		ioctl.arg7_u8_p = ip;
+		guest = bench_cmd(stub.guest, &ioctl, calls);
+		direct = bench_cmd(stub.osi_core, &ioctl, calls);
+		printf("%-12s %10.1f %10.1f %10.1f\n", cmds[i].name, guest,
+		       direct, guest - direct);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int fail = 0;
+
+	stub.cfg.nchans = 1U;
+	stub.cfg.ring_sz = 256U;
+	stub.cfg.mtu = 1500U;
+	if ((osd_stub_core_init(&stub) < 0) ||
+	    (osd_stub_guest_init(&stub) < 0)) {
+		printf("ivc_test: init failed\n");
+		return 1;
+	}
+	/* Busy bits complete on the write, latency is not spent polling */
+	devmodel_get()->busy_reads = 0U;
+
+	fail += test_arp();
+	fail += test_guest_ptr();
+	fail += test_stats_page();
+	fail += test_short_reply();
+	if ((fail == 0) && (argc > 1)) {
+		bench(strtoull(argv[1], NULL, 0));
+	}
+
+	if (stub.cnt.errors != 0U) {
+		printf("FAIL %llu library errors\n",
+		       (unsigned long long)stub.cnt.errors);
+		fail++;
+	}
+	printf("ivc_test: %s\n", (fail == 0) ? "PASS" : "FAIL");
+
+	return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * MMIO trace replay test, see Makefile in this directory. Linked against
+ * a library built with OSI_MMIO_TRACE.
+ *
+ * - osi_hal_hw_core_init() is recorded on the device model.
+ * - Replaying the recorded writes into a reset model yields the register
+ *   state of the recorded init, and every recorded read returns the value
+ *   seen while recording.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "devmodel.h"
+#include "osd_stub.h"
+
+static struct osd_stub stub;
+static struct osi_mmio_trace trace;
+/** Model registers after the recorded init */
+static nveu32_t mac_ref[DEVMODEL_MAC_SZ / 4U];
+static nveu32_t xpcs_ref[DEVMODEL_XPCS_SZ / 4U];
+
+#define CHECK(cond, ...)					\
+	do {							\
+		if (!(cond)) {					\
+			printf("FAIL %s:%d: ", __func__, __LINE__);	\
+			printf(__VA_ARGS__);			\
+			printf("\n");				\
+			fail++;					\
+		}						\
+	} while (0)
+
+/**
+ * @brief Replay state
+ */
+struct replay {
+	/** Records replayed */
+	nveu64_t cnt;
+	/** Reads returning another value than recorded */
+	nveu64_t rd_diff;
+	/** First record of a read mismatch */
+	struct osi_mmio_trace_ent first;
+};
+
+/**
+ * @brief replay_ent - Issue one recorded access on the model.
+ */
+static void replay_ent(void *priv, const struct osi_mmio_trace_ent *ent)
+{
+	struct replay *r = priv;
+	nveu32_t val;
+
+	r->cnt++;
+	if (ent->dir == OSI_MMIO_TRACE_WR) {
+		osi_mmio_hook_write(NULL, ent->val, ent->addr);
+		return;
+	}
+
+	/* Reads are replayed too, they complete busy bits and clear W1C
+	 * status like on the recording.
+	 */
+	val = osi_mmio_hook_read(NULL, ent->addr);
+	if (val != ent->val) {
+		if (r->rd_diff == 0U) {
+			r->first = *ent;
+		}
+		r->rd_diff++;
+	}
+}
+
+/**
+ * @brief test_core_init - Record core init and replay it into the model.
+ */
+static int test_core_init(void)
+{
+	struct devmodel *dm = devmodel_get();
+	struct devmodel_stats st;
+	struct replay r;
+	nveu64_t next;
+	nveu32_t i;
+	int fail = 0;
+
+	stub.cfg.nchans = 1U;
+	stub.cfg.ring_sz = 256U;
+	stub.cfg.mtu = 1500U;
+
+	osi_mmio_trace_start(&trace);
+	CHECK(osd_stub_core_init(&stub) == 0, "core init");
+	osi_mmio_trace_start(NULL);
+
+	/* osd_stub_core_init() resets the model before init */
+	st = dm->stats;
+	CHECK(st.writes != 0U, "no register writes");
+	CHECK(trace.head == (st.reads + st.writes),
+	      "%llu records, %llu accesses",
+	      (unsigned long long)trace.head,
+	      (unsigned long long)(st.reads + st.writes));
+	CHECK(trace.head <= OSI_MMIO_TRACE_SZ,
+	      "%llu records overflow the ring",
+	      (unsigned long long)trace.head);
+	CHECK(st.stray == 0U, "%llu stray accesses",
+	      (unsigned long long)st.stray);
+	if (fail != 0) {
+		return fail;
+	}
+
+	memcpy(mac_ref, dm->mac, sizeof(mac_ref));
+	memcpy(xpcs_ref, dm->xpcs, sizeof(xpcs_ref));
+
+	devmodel_reset();
+	memset(&r, 0, sizeof(r));
+	next = osi_mmio_trace_replay(&trace, 0U, replay_ent, &r);
+	CHECK(next == trace.head, "replay stopped at %llu",
+	      (unsigned long long)next);
+	CHECK(r.cnt == trace.head, "%llu of %llu records replayed",
+	      (unsigned long long)r.cnt, (unsigned long long)trace.head);
+	CHECK(r.rd_diff == 0U, "%llu reads differ, first %s:%u %p",
+	      (unsigned long long)r.rd_diff,
+	      (r.first.func != NULL) ? r.first.func : "?", r.first.line,
+	      r.first.addr);
+
+	for (i = 0U; i < (DEVMODEL_MAC_SZ / 4U); i++) {
+		CHECK(dm->mac[i] == mac_ref[i], "MAC 0x%04x 0x%08x != 0x%08x",
+		      i * 4U, dm->mac[i], mac_ref[i]);
+	}
+	for (i = 0U; i < (DEVMODEL_XPCS_SZ / 4U); i++) {
+		CHECK(dm->xpcs[i] == xpcs_ref[i],
+		      "XPCS 0x%04x 0x%08x != 0x%08x",
+		      i * 4U, dm->xpcs[i], xpcs_ref[i]);
+	}
+
+	/* Replay from the end has nothing left */
+	memset(&r, 0, sizeof(r));
+	CHECK(osi_mmio_trace_replay(&trace, trace.head, replay_ent, &r) ==
+	      trace.head, "replay past head");
+	CHECK(r.cnt == 0U, "%llu records past head",
+	      (unsigned long long)r.cnt);
+
+	return fail;
+}
+
+int main(void)
+{
+	int fail = 0;
+
+	fail += test_core_init();
+
+	if (stub.cnt.errors != 0U) {
+		printf("FAIL %llu library errors\n",
+		       (unsigned long long)stub.cnt.errors);
+		fail++;
+	}
+	printf("mmio_trace_test: %s\n", (fail == 0) ? "PASS" : "FAIL");
+
+	return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Host OSD stub, see osd_stub.h.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#include <ivc_core.h>
+#include "devmodel.h"
+#include "osd_stub.h"
+
+/** Descriptor ring alignment */
+#define STUB_DESC_ALIGN		64U
+/** MTL queues enabled, covers the default PTP Rx queue 3 */
+#define STUB_MTL_QUEUES		4U
+
+static struct osi_hw_features stub_hw_feat;
+
+nveu64_t osd_stub_now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((nveu64_t)ts.tv_sec * OSI_NSEC_PER_SEC) + (nveu64_t)ts.tv_nsec;
+}
+
+nveu64_t osd_stub_get_cycles(void)
+{
+#if defined(__x86_64__)
+	return (nveu64_t)__rdtsc();
+#else
+	return osd_stub_now_ns();
+#endif
+}
+
+static void stub_log(void *priv, const nve8_t *func, nveu32_t line,
+		     nveu32_t level, nveu32_t type, const nve8_t *err,
+		     nveul64_t loga)
+{
+	struct osd_stub *s = priv;
+	size_t n;
+
+	if (level == OSI_LOG_ERR) {
+		if (s != NULL) {
+			s->cnt.errors++;
+		}
+	} else if ((s == NULL) || (s->cfg.verbose == 0U)) {
+		return;
+	}
+
+	n = strlen(err);
+	if ((n != 0U) && (err[n - 1U] == '\n')) {
+		n--;
+	}
+	fprintf(stderr, "osi %s:%u type %u: %.*s (0x%llx)\n", func, line, type,
+		(int)n, err, (unsigned long long)loga);
+}
+
+static void stub_udelay(nveu64_t usec)
+{
+	devmodel_advance(usec * 1000U);
+}
+
+static void stub_usleep_range(nveu64_t umin, nveu64_t umax)
+{
+	(void)umax;
+	devmodel_advance(umin * 1000U);
+}
+
+static void stub_msleep(nveu32_t msec)
+{
+	devmodel_advance((nveu64_t)msec * 1000000U);
+}
+
+#ifdef OSI_DEBUG
+static void stub_core_printf(struct osi_core_priv_data *osi_core,
+			     nveu32_t type, const char *fmt, ...)
+{
+	struct osd_stub *s = osi_core->osd;
+	va_list ap;
+
+	(void)type;
+	if ((s != NULL) && (s->cfg.verbose != 0U)) {
+		va_start(ap, fmt);
+		vfprintf(stderr, fmt, ap);
+		va_end(ap);
+	}
+}
+
+static void stub_dma_printf(struct osi_dma_priv_data *osi_dma,
+			    nveu32_t type, const char *fmt, ...)
+{
+	struct osd_stub *s = osi_dma->osd;
+	va_list ap;
+
+	(void)type;
+	if ((s != NULL) && (s->cfg.verbose != 0U)) {
+		va_start(ap, fmt);
+		vfprintf(stderr, fmt, ap);
+		va_end(ap);
+	}
+}
+#endif /* OSI_DEBUG */
+
+static void stub_transmit_complete(void *priv, const struct osi_tx_swcx *swcx,
+				   const struct osi_txdone_pkt_cx *done)
+{
+	struct osd_stub *s = priv;
+
+	s->cnt.tx_done++;
+	s->cnt.tx_bytes += swcx->len;
+	if ((done->flags & OSI_TXDONE_CX_TS_DELAYED) != 0U) {
+		s->cnt.tx_ts++;
+	}
+}
+
+static void stub_receive_packet(void *priv, struct osi_rx_ring *rx_ring,
+				nveu32_t chan, nveu32_t dma_buf_len,
+				const struct osi_rx_pkt_cx *rx_pkt_cx,
+				struct osi_rx_swcx *rx_swcx)
+{
+	struct osd_stub *s = priv;
+
+	(void)rx_ring;
+	(void)chan;
+	(void)dma_buf_len;
+	s->last_rx = *rx_pkt_cx;
+	rx_swcx->flags |= OSI_RX_SWCX_PROCESSED;
+	if ((rx_pkt_cx->flags & OSI_PKT_CX_VALID) == 0U) {
+		s->cnt.rx_invalid++;
+		return;
+	}
+
+	s->cnt.rx_pkts++;
+	s->cnt.rx_bytes += rx_pkt_cx->pkt_len;
+	if ((rx_pkt_cx->flags & OSI_PKT_CX_VLAN) != 0U) {
+		s->cnt.rx_vlan++;
+	}
+	if ((rx_pkt_cx->flags & OSI_PKT_CX_PTP) != 0U) {
+		s->cnt.rx_ts++;
+	}
+	if ((rx_pkt_cx->rxcsum & (OSI_CHECKSUM_TCP_UDP_BAD |
+				  OSI_CHECKSUM_IPv4_BAD)) != 0U) {
+		s->cnt.rx_csum_err++;
+	}
+}
+
+static void stub_realloc_buf(void *priv, struct osi_rx_ring *rx_ring,
+			     nveu32_t chan)
+{
+	(void)priv;
+	(void)rx_ring;
+	(void)chan;
+}
+
+/**
+ * @brief stub_zalloc - Zeroed aligned host memory, DMA address is the
+ * virtual address.
+ */
+static void *stub_zalloc(size_t size)
+{
+	void *p = NULL;
+
+	if (posix_memalign(&p, STUB_DESC_ALIGN, size) != 0) {
+		return NULL;
+	}
+	memset(p, 0, size);
+
+	return p;
+}
+
+nve32_t osd_stub_core_init(struct osd_stub *s)
+{
+	struct osi_core_priv_data *osi_core;
+	nveu32_t i;
+
+	devmodel_reset();
+
+	osi_core = osi_get_core();
+	if (osi_core == NULL) {
+		return -1;
+	}
+	s->osi_core = osi_core;
+
+	osi_core->base = devmodel_mac_base();
+	osi_core->dma_base = devmodel_mac_base();
+	osi_core->xpcs_base = devmodel_xpcs_base();
+	osi_core->osd = s;
+	osi_core->osd_ops.ops_log = stub_log;
+	osi_core->osd_ops.udelay = stub_udelay;
+	osi_core->osd_ops.usleep_range = stub_usleep_range;
+	osi_core->osd_ops.msleep = stub_msleep;
+#ifdef OSI_DEBUG
+	osi_core->osd_ops.printf = stub_core_printf;
+#endif /* OSI_DEBUG */
+	osi_core->mac = OSI_MAC_HW_MGBE;
+	osi_core->mtu = s->cfg.mtu;
+	stub_hw_feat.est_sel = s->cfg.est;
+	stub_hw_feat.gcl_depth = (s->cfg.est != 0U) ? 1U : 0U;
+	stub_hw_feat.gcl_width = (s->cfg.est != 0U) ? 1U : 0U;
+	osi_core->hw_feature = &stub_hw_feat;
+	/* MTL queues independent of DMA channels, PTP Rx queue must exist */
+	osi_core->num_mtl_queues = STUB_MTL_QUEUES;
+	for (i = 0U; i < STUB_MTL_QUEUES; i++) {
+		osi_core->mtl_queues[i] = i;
+		osi_core->rxq_ctrl[i] = 2U;
+		osi_core->tc[i] = i;
+	}
+	osi_core->pause_frames = OSI_PAUSE_FRAMES_DISABLE;
+
+	if (osi_init_core_ops(osi_core) < 0) {
+		return -1;
+	}
+
+	return osi_hw_core_init(osi_core);
+}
+
+/**
+ * @brief stub_ivc_send - Serve a guest request on the stub core.
+ */
+static nve32_t stub_ivc_send(void *priv, struct ivc_msg_common *ivc,
+			     nveu32_t len)
+{
+	struct osi_core_priv_data *guest = priv;
+	struct osd_stub *s = guest->osd;
+
+	(void)len;
+	(void)osi_ivc_server_handle(s->osi_core, ivc);
+
+	return ivc->status;
+}
+
+nve32_t osd_stub_guest_init(struct osd_stub *s)
+{
+	struct osi_core_priv_data *guest;
+
+	guest = osi_get_core();
+	if (guest == NULL) {
+		return -1;
+	}
+	s->guest = guest;
+
+	guest->osd = s;
+	guest->osd_ops.ops_log = stub_log;
+	guest->osd_ops.udelay = stub_udelay;
+	guest->osd_ops.usleep_range = stub_usleep_range;
+	guest->osd_ops.msleep = stub_msleep;
+	guest->osd_ops.ivc_send = stub_ivc_send;
+#ifdef OSI_DEBUG
+	guest->osd_ops.printf = stub_core_printf;
+#endif /* OSI_DEBUG */
+	guest->mac = OSI_MAC_HW_MGBE;
+	guest->use_virtualization = OSI_ENABLE;
+
+	return osi_init_core_ops(guest);
+}
+
+nve32_t osd_stub_dma_init(struct osd_stub *s)
+{
+	struct osi_dma_priv_data *osi_dma = s->osi_dma;
+	struct osi_rx_swcx *swcx;
+	nveu32_t sz = s->cfg.ring_sz;
+	nveu32_t chan, i;
+
+	if (osi_dma == NULL) {
+		osi_dma = osi_get_dma();
+		if (osi_dma == NULL) {
+			return -1;
+		}
+		s->osi_dma = osi_dma;
+
+		osi_dma->base = devmodel_mac_base();
+		osi_dma->osd = s;
+		osi_dma->mac = OSI_MAC_HW_MGBE;
+		osi_dma->osd_ops.transmit_complete = stub_transmit_complete;
+		osi_dma->osd_ops.receive_packet = stub_receive_packet;
+		osi_dma->osd_ops.realloc_buf = stub_realloc_buf;
+		osi_dma->osd_ops.ops_log = stub_log;
+		osi_dma->osd_ops.udelay = stub_udelay;
+#ifdef OSI_DMA_PROFILE
+		osi_dma->osd_ops.get_cycles = osd_stub_get_cycles;
+#endif /* OSI_DMA_PROFILE */
+#ifdef OSI_DEBUG
+		osi_dma->osd_ops.printf = stub_dma_printf;
+#endif /* OSI_DEBUG */
+		osi_dma->tx_ring_sz = sz;
+		osi_dma->rx_ring_sz = sz;
+		if (osi_init_dma_ops(osi_dma) < 0) {
+			return -1;
+		}
+	}
+
+	/* Ring size of an initialized instance can change across restarts */
+	osi_dma->tx_ring_sz = sz;
+	osi_dma->rx_ring_sz = sz;
+	osi_dma->mtu = s->cfg.mtu;
+	osi_dma->num_dma_chans = s->cfg.nchans;
+	if (osi_set_rx_buf_len(osi_dma) < 0) {
+		return -1;
+	}
+
+	for (chan = 0U; chan < s->cfg.nchans; chan++) {
+		struct osi_tx_ring *tx = &s->tx_ring[chan];
+		struct osi_rx_ring *rx = &s->rx_ring[chan];
+
+		osi_dma->dma_chans[chan] = chan;
+		memset(tx, 0, sizeof(*tx));
+		memset(rx, 0, sizeof(*rx));
+		tx->tx_desc = stub_zalloc(sz * sizeof(struct osi_tx_desc));
+		tx->tx_swcx = stub_zalloc(sz * sizeof(struct osi_tx_swcx));
+		rx->rx_desc = stub_zalloc(sz * sizeof(struct osi_rx_desc));
+		rx->rx_swcx = stub_zalloc(sz * sizeof(struct osi_rx_swcx));
+		s->tx_buf[chan] = stub_zalloc((size_t)sz * OSD_STUB_TX_BUF_SZ);
+		s->rx_buf[chan] = stub_zalloc((size_t)sz * osi_dma->rx_buf_len);
+		if ((tx->tx_desc == NULL) || (tx->tx_swcx == NULL) ||
+		    (rx->rx_desc == NULL) || (rx->rx_swcx == NULL) ||
+		    (s->tx_buf[chan] == NULL) || (s->rx_buf[chan] == NULL)) {
+			return -1;
+		}
+		tx->tx_desc_phy_addr = (nveu64_t)(uintptr_t)tx->tx_desc;
+		rx->rx_desc_phy_addr = (nveu64_t)(uintptr_t)rx->rx_desc;
+
+		for (i = 0U; i < sz; i++) {
+			swcx = rx->rx_swcx + i;
+			swcx->buf_virt_addr = s->rx_buf[chan] +
+					      ((size_t)i * osi_dma->rx_buf_len);
+			swcx->buf_phy_addr = (nveu64_t)(uintptr_t)
+					     swcx->buf_virt_addr;
+			swcx->len = osi_dma->rx_buf_len;
+		}
+
+		osi_dma->tx_ring[chan] = tx;
+		osi_dma->rx_ring[chan] = rx;
+	}
+
+	return osi_hw_dma_init(osi_dma);
+}
+
+void osd_stub_dma_deinit(struct osd_stub *s)
+{
+	nveu32_t chan;
+
+	if (s->osi_dma == NULL) {
+		return;
+	}
+
+	(void)osi_hw_dma_deinit(s->osi_dma);
+	for (chan = 0U; chan < s->cfg.nchans; chan++) {
+		free(s->tx_ring[chan].tx_desc);
+		free(s->tx_ring[chan].tx_swcx);
+		free(s->rx_ring[chan].rx_desc);
+		free(s->rx_ring[chan].rx_swcx);
+		free(s->tx_buf[chan]);
+		free(s->rx_buf[chan]);
+		s->tx_buf[chan] = NULL;
+		s->rx_buf[chan] = NULL;
+		s->osi_dma->tx_ring[chan] = NULL;
+		s->osi_dma->rx_ring[chan] = NULL;
+	}
+}
+
+nveu32_t osd_stub_tx_free(const struct osd_stub *s, nveu32_t chan)
+{
+	const struct osi_tx_ring *tx = &s->tx_ring[chan];
+	nveu32_t sz = s->cfg.ring_sz;
+
+	return (sz - 1U) - ((tx->cur_tx_idx - tx->clean_idx) & (sz - 1U));
+}
+
+nve32_t osd_stub_xmit(struct osd_stub *s, nveu32_t chan,
+		      const struct osd_stub_pkt *pkt)
+{
+	struct osi_tx_ring *tx = &s->tx_ring[chan];
+	struct osi_tx_pkt_cx *cx = &tx->tx_pkt_cx;
+	struct osi_tx_swcx *swcx;
+	nveu32_t sz = s->cfg.ring_sz;
+	nveu32_t idx = tx->cur_tx_idx;
+	nveu32_t left = pkt->len;
+	nveu32_t hdr = 54U;
+	nveu32_t cnt = 0U;
+	nveu32_t blen;
+
+	memset(cx, 0, sizeof(*cx));
+	if ((pkt->flags & OSD_STUB_PKT_CSUM) != 0U) {
+		cx->flags |= OSI_PKT_CX_CSUM;
+	}
+	if ((pkt->flags & OSD_STUB_PKT_VLAN) != 0U) {
+		cx->flags |= OSI_PKT_CX_VLAN;
+		cx->vtag_id = pkt->vlan & 0xFFFFU;
+	}
+	if ((pkt->flags & OSD_STUB_PKT_PTP) != 0U) {
+		cx->flags |= OSI_PKT_CX_PTP;
+	}
+	if ((pkt->flags & OSD_STUB_PKT_TSO) != 0U) {
+		cx->flags |= OSI_PKT_CX_TSO | OSI_PKT_CX_CSUM;
+		cx->mss = pkt->mss;
+		cx->total_hdrlen = hdr;
+		cx->tcp_udp_hdrlen = 20U;
+		cx->payload_len = pkt->len - hdr;
+	}
+
+	if (osd_stub_tx_free(s, chan) < (OSD_STUB_MAX_FRAGS + 1U)) {
+		return -1;
+	}
+
+	/* Context descriptor slot is reserved in front of the buffers */
+	if ((cx->flags & (OSI_PKT_CX_VLAN | OSI_PKT_CX_TSO |
+			  OSI_PKT_CX_PTP)) != 0U) {
+		swcx = tx->tx_swcx + idx;
+		swcx->len = OSI_INVALID_VALUE;
+		swcx->buf_virt_addr = NULL;
+		swcx->buf_phy_addr = 0U;
+		idx = (idx + 1U) & (sz - 1U);
+		cnt++;
+	}
+
+	/* TSO header goes in its own buffer like the Linux OSD does */
+	if ((cx->flags & OSI_PKT_CX_TSO) != 0U) {
+		swcx = tx->tx_swcx + idx;
+		swcx->buf_virt_addr = s->tx_buf[chan] +
+				      ((size_t)idx * OSD_STUB_TX_BUF_SZ);
+		swcx->buf_phy_addr = (nveu64_t)(uintptr_t)swcx->buf_virt_addr;
+		swcx->len = hdr;
+		idx = (idx + 1U) & (sz - 1U);
+		left -= hdr;
+		cnt++;
+	}
+
+	while ((left != 0U) && (cnt < (OSD_STUB_MAX_FRAGS + 1U))) {
+		blen = (left < OSD_STUB_TX_BUF_SZ) ? left : OSD_STUB_TX_BUF_SZ;
+		swcx = tx->tx_swcx + idx;
+		swcx->buf_virt_addr = s->tx_buf[chan] +
+				      ((size_t)idx * OSD_STUB_TX_BUF_SZ);
+		swcx->buf_phy_addr = (nveu64_t)(uintptr_t)swcx->buf_virt_addr;
+		swcx->len = blen;
+		idx = (idx + 1U) & (sz - 1U);
+		left -= blen;
+		cnt++;
+	}
+
+	if (left != 0U) {
+		return -1;
+	}
+
+	cx->desc_cnt = cnt;
+	return osi_hw_transmit(s->osi_dma, chan);
+}
+
+nve32_t osd_stub_rx_refill(struct osd_stub *s, nveu32_t chan)
+{
+	struct osi_rx_ring *rx = &s->rx_ring[chan];
+	nveu32_t sz = s->cfg.ring_sz;
+	nveu32_t idx;
+
+	/* Buffers stay mapped, hand the processed ones back as they are */
+	for (idx = rx->refill_idx; idx != rx->cur_rx_idx;
+	     idx = (idx + 1U) & (sz - 1U)) {
+		rx->rx_swcx[idx].flags = OSI_RX_SWCX_BUF_VALID;
+	}
+
+	return osi_rx_dma_desc_init(s->osi_dma, rx, chan);
+}
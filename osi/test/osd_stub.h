@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef INCLUDED_OSD_STUB_H
+#define INCLUDED_OSD_STUB_H
+
+/*
+ * Minimal host OSD on top of devmodel: OSD callbacks, host memory rings
+ * with 1:1 DMA mapping and Tx/Rx helpers.
+ */
+
+#include <osi_core.h>
+#include <osi_dma.h>
+
+/** Tx buffer bytes per descriptor */
+#define OSD_STUB_TX_BUF_SZ	2048U
+/** Max buffers of one stub Tx packet */
+#define OSD_STUB_MAX_FRAGS	8U
+
+/**
+ * @addtogroup OSD_STUB_PKT Tx packet types for osd_stub_xmit()
+ * @{
+ */
+#define OSD_STUB_PKT_VLAN	OSI_BIT(0)
+#define OSD_STUB_PKT_TSO	OSI_BIT(1)
+#define OSD_STUB_PKT_PTP	OSI_BIT(2)
+#define OSD_STUB_PKT_CSUM	OSI_BIT(3)
+/** @} */
+
+/**
+ * @brief Stub instance configuration
+ */
+struct osd_stub_cfg {
+	/** Number of DMA channels, channels 0..nchans-1 are used */
+	nveu32_t nchans;
+	/** Tx and Rx ring size */
+	nveu32_t ring_sz;
+	/** MTU */
+	nveu32_t mtu;
+	/** Print library INFO logs too */
+	nveu32_t verbose;
+	/** Advertise EST with a 64 entry GCL of 24 bit entries */
+	nveu32_t est;
+};
+
+/**
+ * @brief One Tx packet
+ */
+struct osd_stub_pkt {
+	/** Frame length including headers */
+	nveu32_t len;
+	/** Attributes, see OSD_STUB_PKT */
+	nveu32_t flags;
+	/** VLAN tag with OSD_STUB_PKT_VLAN */
+	nveu32_t vlan;
+	/** MSS with OSD_STUB_PKT_TSO */
+	nveu32_t mss;
+};
+
+/**
+ * @brief Callback counters
+ */
+struct osd_stub_cnt {
+	/** transmit_complete() calls and bytes */
+	nveu64_t tx_done;
+	nveu64_t tx_bytes;
+	/** Tx completions reporting a delayed timestamp */
+	nveu64_t tx_ts;
+	/** receive_packet() calls and bytes */
+	nveu64_t rx_pkts;
+	nveu64_t rx_bytes;
+	/** Received frames with VLAN, bad checksum, timestamp, invalid */
+	nveu64_t rx_vlan;
+	nveu64_t rx_csum_err;
+	nveu64_t rx_ts;
+	nveu64_t rx_invalid;
+	/** Library error logs */
+	nveu64_t errors;
+};
+
+/**
+ * @brief Stub OSD instance
+ */
+struct osd_stub {
+	/** Configuration */
+	struct osd_stub_cfg cfg;
+	/** Core and DMA instances */
+	struct osi_core_priv_data *osi_core;
+	struct osi_dma_priv_data *osi_dma;
+	/** Virtualized core served by osi_core, see osd_stub_guest_init() */
+	struct osi_core_priv_data *guest;
+	/** Rings of each channel */
+	struct osi_tx_ring tx_ring[OSI_MGBE_MAX_NUM_CHANS];
+	struct osi_rx_ring rx_ring[OSI_MGBE_MAX_NUM_CHANS];
+	/** Tx buffers, OSD_STUB_TX_BUF_SZ per descriptor */
+	nveu8_t *tx_buf[OSI_MGBE_MAX_NUM_CHANS];
+	/** Rx buffers, osi_dma->rx_buf_len per descriptor */
+	nveu8_t *rx_buf[OSI_MGBE_MAX_NUM_CHANS];
+	/** Last received packet context */
+	struct osi_rx_pkt_cx last_rx;
+	/** Callback counters */
+	struct osd_stub_cnt cnt;
+};
+
+/**
+ * @brief osd_stub_core_init - Bring up MAC on the device model.
+ *
+ * Algorithm: Resets the model, gets an OSI core instance, fills OSD ops
+ * and MGBE defaults and runs osi_hw_core_init().
+ *
+ * @param[in, out] s: Stub instance, zeroed by caller except cfg.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+nve32_t osd_stub_core_init(struct osd_stub *s);
+
+/**
+ * @brief osd_stub_guest_init - Virtualized core on top of the stub core.
+ *
+ * Algorithm: Gets a second OSI core instance with use_virtualization and
+ * wires its osd_ops.ivc_send to osi_ivc_server_handle() on s->osi_core,
+ * an in process loopback of the IVC path.
+ *
+ * @param[in, out] s: Stub instance with core up.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+nve32_t osd_stub_guest_init(struct osd_stub *s);
+
+/**
+ * @brief osd_stub_dma_init - Allocate rings and bring up DMA.
+ *
+ * Algorithm: Gets an OSI DMA instance, allocates host rings and buffers
+ * and runs osi_hw_dma_init(). Can be called again after osd_stub_dma_deinit()
+ * with a different cfg.ring_sz.
+ *
+ * @param[in, out] s: Stub instance with core up.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+nve32_t osd_stub_dma_init(struct osd_stub *s);
+
+/**
+ * @brief osd_stub_dma_deinit - Stop DMA and free rings.
+ *
+ * @param[in, out] s: Stub instance.
+ */
+void osd_stub_dma_deinit(struct osd_stub *s);
+
+/**
+ * @brief osd_stub_xmit - Queue one packet with osi_hw_transmit().
+ *
+ * Algorithm: Splits the frame over OSD_STUB_TX_BUF_SZ buffers, adds a
+ * context descriptor for VLAN/TSO/PTP and fills the packet context.
+ *
+ * @param[in, out] s: Stub instance.
+ * @param[in] chan: DMA channel.
+ * @param[in] pkt: Packet to send.
+ *
+ * @retval 0 on success
+ * @retval -1 if ring is full or on library failure
+ */
+nve32_t osd_stub_xmit(struct osd_stub *s, nveu32_t chan,
+		      const struct osd_stub_pkt *pkt);
+
+/**
+ * @brief osd_stub_rx_refill - Give processed Rx descriptors back to HW.
+ *
+ * @param[in, out] s: Stub instance.
+ * @param[in] chan: DMA channel.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+nve32_t osd_stub_rx_refill(struct osd_stub *s, nveu32_t chan);
+
+/**
+ * @brief osd_stub_tx_free - Free Tx descriptors of a channel.
+ *
+ * @param[in] s: Stub instance.
+ * @param[in] chan: DMA channel.
+ *
+ * @return Number of descriptors SW can fill.
+ */
+nveu32_t osd_stub_tx_free(const struct osd_stub *s, nveu32_t chan);
+
+/**
+ * @brief osd_stub_now_ns - Monotonic host time.
+ *
+ * @return Time in ns.
+ */
+nveu64_t osd_stub_now_ns(void);
+
+/**
+ * @brief osd_stub_get_cycles - Free running cycle counter, installed as
+ * osd_ops.get_cycles with OSI_DMA_PROFILE.
+ *
+ * @return TSC on x86_64, osd_stub_now_ns() elsewhere.
+ */
+nveu64_t osd_stub_get_cycles(void);
+
+#endif /* INCLUDED_OSD_STUB_H */
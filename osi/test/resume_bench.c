@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Suspend/resume benchmark on the device model, see Makefile in this
+ * directory.
+ *
+ * Programs L3/L4 filters, VLAN IDs, FRP rules and an EST GCL, records the
+ * register file and the indirect tables of the model, then runs
+ * OSI_CMD_SUSPEND, a power on reset of the model and OSI_CMD_RESUME in a
+ * loop. Every resume must bring back the recorded registers. The FRP
+ * table is compared as the parser walks it from the root entry, since an
+ * update may leave it anywhere in the instruction memory. Restore time
+ * is wall time measured by the library through osd_ops.get_time_ns and
+ * includes the model and the stub OSD.
+ *
+ *   ./resume_bench [resume cycles]
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "devmodel.h"
+#include "osd_stub.h"
+#include "../core/mgbe_core.h"
+
+/** Default number of suspend/resume cycles */
+#define BENCH_CYCLES	1000U
+
+/** VLAN IDs programmed, VID = BENCH_VID_BASE + i */
+#define BENCH_VIDS	8U
+#define BENCH_VID_BASE	100U
+
+/** EST GCL entries programmed */
+#define BENCH_GCL_LEN	4U
+
+/** Register mismatches printed per check */
+#define BENCH_DIFF_MAX	8U
+
+/**
+ * @brief Register state compared across suspend/resume
+ */
+struct bench_regs {
+	nveu32_t mac[DEVMODEL_MAC_SZ / 4U];
+	/** FRP entries the parser walks, OKI relative to the first one */
+	nveu32_t frp[DEVMODEL_FRP_WORDS];
+	nveu32_t frp_cnt;
+	nveu32_t l3l4[DEVMODEL_L3L4_WORDS];
+	nveu32_t vlan[DEVMODEL_VLAN_WORDS];
+	nveu32_t gcl[DEVMODEL_GCL_WORDS];
+	nveu32_t gcrr[DEVMODEL_GCRR_WORDS];
+};
+
+/** FRP rules programmed, TCP and UDP destination ports and a drop */
+static const struct osi_core_frp_cmd frp_rules[] = {
+	{ .frp_id = 1, .match_type = OSI_FRP_MATCH_L4_D_TPORT,
+	  .match = { 0x00U, 0x50U }, .match_length = 2U,
+	  .filter_mode = OSI_FRP_MODE_ROUTE, .dma_sel = 0x2U },
+	{ .frp_id = 2, .match_type = OSI_FRP_MATCH_L4_D_UPORT,
+	  .match = { 0x00U, 0x35U }, .match_length = 2U,
+	  .filter_mode = OSI_FRP_MODE_ROUTE, .dma_sel = 0x4U },
+	{ .frp_id = 3, .match_type = OSI_FRP_MATCH_L3_DIP,
+	  .match = { 10U, 0U, 0U, 1U }, .match_length = 4U,
+	  .filter_mode = OSI_FRP_MODE_DROP },
+};
+
+/** L3/L4 filters programmed, TCP/UDP destination port to a channel */
+static const struct {
+	nveu32_t is_udp;
+	nveu16_t port;
+	nveu32_t chan;
+} l3l4_rules[] = {
+	{ OSI_FALSE, 22U, 1U },
+	{ OSI_FALSE, 8080U, 2U },
+	{ OSI_TRUE, 123U, 3U },
+	{ OSI_TRUE, 4789U, 1U },
+};
+
+static struct osd_stub stub;
+static struct bench_regs before;
+static struct bench_regs after;
+
+/**
+ * @brief bench_time_ns - osd_ops.get_time_ns on the host clock.
+ */
+static nveu64_t bench_time_ns(void *priv)
+{
+	(void)priv;
+
+	return osd_stub_now_ns();
+}
+
+/**
+ * @brief bench_ioctl - Run a configuration ioctl.
+ *
+ * @param[in] ioctl: Ioctl data.
+ * @param[in] what: Name in the failure report.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+static int bench_ioctl(struct osi_ioctl *ioctl, const char *what)
+{
+	if (osi_handle_ioctl(stub.osi_core, ioctl) < 0) {
+		printf("resume_bench: %s failed\n", what);
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief bench_program - Program the state restored by resume.
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+static int bench_program(void)
+{
+	struct osi_ioctl ioctl;
+	nveu32_t i;
+
+	for (i = 0U; i < (nveu32_t)(sizeof(l3l4_rules) /
+				    sizeof(l3l4_rules[0])); i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_L3L4_FILTER;
+		ioctl.l3l4_filter.filter_enb_dis = OSI_TRUE;
+		ioctl.l3l4_filter.data.is_udp = l3l4_rules[i].is_udp;
+		ioctl.l3l4_filter.data.dst.port_no = l3l4_rules[i].port;
+		ioctl.l3l4_filter.data.dst.port_match = OSI_TRUE;
+		ioctl.l3l4_filter.dma_routing_enable = OSI_TRUE;
+		ioctl.l3l4_filter.dma_chan = l3l4_rules[i].chan;
+		if (bench_ioctl(&ioctl, "L3/L4 filter") < 0) {
+			return -1;
+		}
+	}
+
+	for (i = 0U; i < BENCH_VIDS; i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_UPDATE_VLAN_ID;
+		ioctl.arg1_u32 = (BENCH_VID_BASE + i) | OSI_VLAN_ACTION_ADD;
+		if (bench_ioctl(&ioctl, "VLAN ID") < 0) {
+			return -1;
+		}
+	}
+
+	for (i = 0U; i < (nveu32_t)(sizeof(frp_rules) /
+				    sizeof(frp_rules[0])); i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_CONFIG_FRP;
+		ioctl.frp_cmd = frp_rules[i];
+		ioctl.frp_cmd.cmd = OSI_FRP_CMD_ADD;
+		if (bench_ioctl(&ioctl, "FRP rule") < 0) {
+			return -1;
+		}
+	}
+
+	/* 1 ms cycle of four 250 us slots, one queue open per slot. BTR
+	 * is given so that resume programs the same base time.
+	 */
+	memset(&ioctl, 0, sizeof(ioctl));
+	ioctl.cmd = OSI_CMD_CONFIG_EST;
+	ioctl.est.en_dis = OSI_ENABLE;
+	ioctl.est.btr[0] = 500000U;
+	ioctl.est.btr[1] = 10U;
+	ioctl.est.ctr[0] = 1000000U;
+	ioctl.est.ter = 0U;
+	ioctl.est.llr = BENCH_GCL_LEN;
+	for (i = 0U; i < BENCH_GCL_LEN; i++) {
+		ioctl.est.gcl[i] = (OSI_BIT(i) << 16U) | 250000U;
+	}
+
+	return bench_ioctl(&ioctl, "EST");
+}
+
+/**
+ * @brief bench_frp_view - Record the FRP table the parser walks.
+ *
+ * Algorithm: Root entry 0 jumps to the table, which ends at NVE. OKI of
+ * NIC entries is made relative to the table start.
+ *
+ * @param[out] r: Register state.
+ */
+static void bench_frp_view(struct bench_regs *r)
+{
+	const struct devmodel *dm = devmodel_get();
+	nveu32_t nve = dm->mac[MGBE_MTL_RXP_CS / 4U] & MGBE_MTL_RXP_CS_NVE;
+	nveu32_t start, pos, ie2, oki;
+	nveu32_t *ie;
+
+	memset(r->frp, 0, sizeof(r->frp));
+	r->frp_cnt = 0U;
+	if ((dm->mac[MGBE_MTL_OP_MODE / 4U] & MGBE_MTL_OP_MODE_FRPE) == 0U) {
+		return;
+	}
+
+	start = (dm->frp[MGBE_MTL_FRP_IE2(0U)] & MGBE_MTL_FRP_IE2_OKI) >>
+		MGBE_MTL_FRP_IE2_OKI_SHIFT;
+	for (pos = start; (start != 0U) && (pos <= nve); pos++) {
+		ie = &r->frp[MGBE_MTL_FRP_IE0(r->frp_cnt)];
+		memcpy(ie, &dm->frp[MGBE_MTL_FRP_IE0(pos)], 4U * sizeof(*ie));
+		ie2 = ie[2];
+		if ((ie2 & MGBE_MTL_FRP_IE2_NC) != 0U) {
+			oki = ((ie2 & MGBE_MTL_FRP_IE2_OKI) >>
+			       MGBE_MTL_FRP_IE2_OKI_SHIFT) - start;
+			ie[2] = (ie2 & ~MGBE_MTL_FRP_IE2_OKI) |
+				((oki << MGBE_MTL_FRP_IE2_OKI_SHIFT) &
+				 MGBE_MTL_FRP_IE2_OKI);
+		}
+		r->frp_cnt++;
+	}
+}
+
+/**
+ * @brief bench_regs_take - Record register state of the model.
+ *
+ * @param[out] r: Register state.
+ */
+static void bench_regs_take(struct bench_regs *r)
+{
+	const struct devmodel *dm = devmodel_get();
+
+	memcpy(r->mac, dm->mac, sizeof(r->mac));
+	/* RXPI is computed on read, table placement is compared below */
+	r->mac[MGBE_MTL_RXP_CS / 4U] &= ~(MGBE_MTL_RXP_CS_RXPI |
+					  MGBE_MTL_RXP_CS_NPE |
+					  MGBE_MTL_RXP_CS_NVE);
+	bench_frp_view(r);
+	memcpy(r->l3l4, dm->l3l4, sizeof(r->l3l4));
+	memcpy(r->vlan, dm->vlan, sizeof(r->vlan));
+	memcpy(r->gcl, dm->gcl, sizeof(r->gcl));
+	memcpy(r->gcrr, dm->gcrr, sizeof(r->gcrr));
+}
+
+/**
+ * @brief bench_diff_tbl - Compare one register table.
+ *
+ * @param[in] name: Table name in the report.
+ * @param[in] a: State before suspend.
+ * @param[in] b: State after resume.
+ * @param[in] n: Number of words.
+ * @param[in] step: Address step of a word in the report.
+ *
+ * @return Number of differing words.
+ */
+static nveu32_t bench_diff_tbl(const char *name, const nveu32_t *a,
+			       const nveu32_t *b, nveu32_t n, nveu32_t step)
+{
+	nveu32_t diff = 0U;
+	nveu32_t i;
+
+	for (i = 0U; i < n; i++) {
+		if (a[i] == b[i]) {
+			continue;
+		}
+
+		if (diff < BENCH_DIFF_MAX) {
+			printf("resume_bench: %s 0x%04x: 0x%08x -> 0x%08x\n",
+			       name, i * step, a[i], b[i]);
+		}
+		diff++;
+	}
+
+	return diff;
+}
+
+/**
+ * @brief bench_diff - Compare register state after resume to suspend.
+ *
+ * @return Number of differing registers.
+ */
+static nveu32_t bench_diff(void)
+{
+	nveu32_t diff = 0U;
+
+	bench_regs_take(&after);
+	diff += bench_diff_tbl("mac", before.mac, after.mac,
+			       DEVMODEL_MAC_SZ / 4U, 4U);
+	diff += bench_diff_tbl("frp entries", &before.frp_cnt,
+			       &after.frp_cnt, 1U, 0U);
+	diff += bench_diff_tbl("frp", before.frp, after.frp,
+			       DEVMODEL_FRP_WORDS, 1U);
+	diff += bench_diff_tbl("l3l4", before.l3l4, after.l3l4,
+			       DEVMODEL_L3L4_WORDS, 1U);
+	diff += bench_diff_tbl("vlan", before.vlan, after.vlan,
+			       DEVMODEL_VLAN_WORDS, 1U);
+	diff += bench_diff_tbl("gcl", before.gcl, after.gcl,
+			       DEVMODEL_GCL_WORDS, 1U);
+	diff += bench_diff_tbl("gcrr", before.gcrr, after.gcrr,
+			       DEVMODEL_GCRR_WORDS, 1U);
+
+	return diff;
+}
+
+int main(int argc, char *argv[])
+{
+	struct osi_ioctl ioctl;
+	nveu64_t cycles = BENCH_CYCLES;
+	nveu64_t sum_us = 0U;
+	nveu32_t min_us = UINT_MAX;
+	nveu32_t max_us = 0U;
+	nveu64_t i;
+	nveu32_t diff;
+	int fail = 0;
+
+	if (argc > 1) {
+		cycles = strtoull(argv[1], NULL, 0);
+	}
+
+	stub.cfg.nchans = 1U;
+	stub.cfg.mtu = 1500U;
+	stub.cfg.est = OSI_ENABLE;
+	if (osd_stub_core_init(&stub) < 0) {
+		printf("resume_bench: core init failed\n");
+		return 1;
+	}
+	stub.osi_core->osd_ops.get_time_ns = bench_time_ns;
+
+	if (bench_program() < 0) {
+		return 1;
+	}
+	bench_regs_take(&before);
+
+	for (i = 0U; i < cycles; i++) {
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_SUSPEND;
+		if (bench_ioctl(&ioctl, "suspend") < 0) {
+			fail++;
+			break;
+		}
+
+		/* Register file is lost while suspended */
+		devmodel_reset();
+
+		memset(&ioctl, 0, sizeof(ioctl));
+		ioctl.cmd = OSI_CMD_RESUME;
+		if (bench_ioctl(&ioctl, "resume") < 0) {
+			fail++;
+			break;
+		}
+
+		sum_us += ioctl.arg4_u32;
+		min_us = (ioctl.arg4_u32 < min_us) ? ioctl.arg4_u32 : min_us;
+		max_us = (ioctl.arg4_u32 > max_us) ? ioctl.arg4_u32 : max_us;
+
+		diff = bench_diff();
+		if (diff != 0U) {
+			printf("resume_bench: cycle %llu: %u registers "
+			       "differ\n", (unsigned long long)i, diff);
+			fail++;
+			break;
+		}
+	}
+
+	if ((fail == 0) && (cycles != 0U)) {
+		printf("%-8s %10s %10s %10s %10s %8s %10s %10s\n", "cycles",
+		       "min us", "avg us", "max us", "categories", "entries",
+		       "indirect", "backoff us");
+		printf("%-8llu %10u %10.1f %10u %#10x %8u %10llu %10u\n",
+		       (unsigned long long)cycles, min_us,
+		       (double)sum_us / (double)cycles, max_us,
+		       ioctl.arg1_u32, ioctl.arg2_u32,
+		       (unsigned long long)ioctl.arg5_u64, ioctl.arg3_u32);
+	}
+
+	if (stub.cnt.errors != 0U) {
+		printf("resume_bench: %llu library errors\n",
+		       (unsigned long long)stub.cnt.errors);
+		fail++;
+	}
+
+	return (fail == 0) ? 0 : 1;
+}
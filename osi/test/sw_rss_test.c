@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Host unit test of software RSS, see Makefile in this directory.
+ *
+ * - Toeplitz bit exactness against the RSS hash verification suite
+ *   published with the Microsoft RSS specification.
+ * - Symmetric key property used by rss_profile_config(): both directions
+ *   of a flow hash the same with a repeating 16-bit key pattern.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../dma/dma_local.h"
+
+/** Ethernet + IPv4 header + L4 ports */
+#define TEST_PKT_LEN	(14U + 40U + 4U)
+/** Verification suite key */
+static const nveu8_t ms_key[OSI_RSS_HASH_KEY_SIZE] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+/**
+ * @brief Verification suite vector, addresses in network byte order
+ */
+struct rss_vec {
+	/** ipv6 (OSI_ENABLE) or ipv4 (OSI_DISABLE) */
+	nveu32_t ipv6;
+	/** Source address, ipv4 uses first 4 bytes */
+	nveu8_t sip[16];
+	/** Destination address */
+	nveu8_t dip[16];
+	/** Source port */
+	nveu16_t sport;
+	/** Destination port */
+	nveu16_t dport;
+	/** Expected hash over addresses */
+	nveu32_t ip_hash;
+	/** Expected hash over addresses and TCP ports */
+	nveu32_t tcp_hash;
+};
+
+static const struct rss_vec vecs[] = {
+	{ OSI_DISABLE, { 66, 9, 149, 187 }, { 161, 142, 100, 80 },
+	  2794U, 1766U, 0x323e8fc2U, 0x51ccc178U },
+	{ OSI_DISABLE, { 199, 92, 111, 2 }, { 65, 69, 140, 83 },
+	  14230U, 4739U, 0xd718262aU, 0xc626b0eaU },
+	{ OSI_DISABLE, { 24, 19, 198, 95 }, { 12, 22, 207, 184 },
+	  12898U, 38024U, 0xd2d0a5deU, 0x5c2b394aU },
+	{ OSI_DISABLE, { 38, 27, 205, 30 }, { 209, 142, 163, 6 },
+	  48228U, 2217U, 0x82989176U, 0xafc7327fU },
+	{ OSI_DISABLE, { 153, 39, 163, 191 }, { 202, 188, 127, 2 },
+	  44251U, 1303U, 0x5d1809c5U, 0x10e828a2U },
+	/* 3ffe:2501:200:1fff::7 -> 3ffe:2501:200:3::1 */
+	{ OSI_ENABLE,
+	  { 0x3f, 0xfe, 0x25, 0x01, 0x02, 0x00, 0x1f, 0xff,
+	    0, 0, 0, 0, 0, 0, 0, 0x07 },
+	  { 0x3f, 0xfe, 0x25, 0x01, 0x02, 0x00, 0x00, 0x03,
+	    0, 0, 0, 0, 0, 0, 0, 0x01 },
+	  2794U, 1766U, 0x2cc18cd5U, 0x40207d3dU },
+	/* 3ffe:501:8::260:97ff:fe40:efab -> ff02::1 */
+	{ OSI_ENABLE,
+	  { 0x3f, 0xfe, 0x05, 0x01, 0x00, 0x08, 0x00, 0x00,
+	    0x02, 0x60, 0x97, 0xff, 0xfe, 0x40, 0xef, 0xab },
+	  { 0xff, 0x02, 0, 0, 0, 0, 0, 0,
+	    0, 0, 0, 0, 0, 0, 0, 0x01 },
+	  14230U, 4739U, 0x0f0c461cU, 0xdde51bbfU },
+	/* 3ffe:1900:4545:3:200:f8ff:fe21:67cf -> fe80::200:f8ff:fe21:67cf */
+	{ OSI_ENABLE,
+	  { 0x3f, 0xfe, 0x19, 0x00, 0x45, 0x45, 0x00, 0x03,
+	    0x02, 0x00, 0xf8, 0xff, 0xfe, 0x21, 0x67, 0xcf },
+	  { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+	    0x02, 0x00, 0xf8, 0xff, 0xfe, 0x21, 0x67, 0xcf },
+	  44251U, 38024U, 0x4b61e985U, 0x02d1feefU },
+};
+
+static struct dma_local l_dma;
+
+/**
+ * @brief test_pkt - Build Ethernet frame of a vector.
+ *
+ * @param[in] v: Test vector.
+ * @param[in] proto: IP protocol.
+ * @param[in] swap: Swap source and destination (OSI_ENABLE) or not.
+ * @param[out] pkt: Frame buffer, 14 + 40 + 4 bytes.
+ *
+ * @retval Frame length
+ */
+static nveu32_t test_pkt(const struct rss_vec *const v, nveu8_t proto,
+			 nveu32_t swap, nveu8_t *const pkt)
+{
+	const nveu8_t *sip = (swap == OSI_ENABLE) ? v->dip : v->sip;
+	const nveu8_t *dip = (swap == OSI_ENABLE) ? v->sip : v->dip;
+	nveu16_t sport = (swap == OSI_ENABLE) ? v->dport : v->sport;
+	nveu16_t dport = (swap == OSI_ENABLE) ? v->sport : v->dport;
+	nveu8_t *ip = &pkt[14];
+	nveu8_t *l4;
+
+	memset(pkt, 0, TEST_PKT_LEN + 20U);
+	if (v->ipv6 == OSI_ENABLE) {
+		pkt[12] = 0x86U;
+		pkt[13] = 0xddU;
+		ip[0] = 0x60U;
+		ip[6] = proto;
+		memcpy(&ip[8], sip, 16U);
+		memcpy(&ip[24], dip, 16U);
+		l4 = &ip[40];
+	} else {
+		pkt[12] = 0x08U;
+		pkt[13] = 0x00U;
+		ip[0] = 0x45U;
+		ip[9] = proto;
+		memcpy(&ip[12], sip, 4U);
+		memcpy(&ip[16], dip, 4U);
+		l4 = &ip[20];
+	}
+	l4[0] = (nveu8_t)(sport >> 8U);
+	l4[1] = (nveu8_t)(sport & 0xFFU);
+	l4[2] = (nveu8_t)(dport >> 8U);
+	l4[3] = (nveu8_t)(dport & 0xFFU);
+
+	return (nveu32_t)(l4 - pkt) + 4U;
+}
+
+/**
+ * @brief test_hash - Software RSS hash of a vector.
+ *
+ * @param[in] v: Test vector.
+ * @param[in] proto: IP protocol.
+ * @param[in] swap: Hash reverse direction (OSI_ENABLE) or not.
+ * @param[out] type: Hash type.
+ *
+ * @retval Hash
+ */
+static nveu32_t test_hash(const struct rss_vec *const v, nveu8_t proto,
+			  nveu32_t swap, nveu32_t *type)
+{
+	nveu8_t pkt[TEST_PKT_LEN + 20U];
+	struct osi_rx_pkt_cx cx;
+
+	memset(&cx, 0, sizeof(cx));
+	cx.pkt_len = test_pkt(v, proto, swap, pkt);
+	sw_rss_hash(&l_dma.osi_dma, pkt, cx.pkt_len, &cx);
+	*type = cx.rx_hash_type;
+
+	return cx.rx_hash;
+}
+
+/**
+ * @brief test_vectors - Check verification suite hashes.
+ *
+ * @retval Number of failures
+ */
+static int test_vectors(void)
+{
+	nveu32_t i, hash, type;
+	int fail = 0;
+
+	memcpy(l_dma.osi_dma.sw_rss.key, ms_key, sizeof(ms_key));
+	sw_rss_build_lut(&l_dma);
+
+	for (i = 0U; i < (nveu32_t)(sizeof(vecs) / sizeof(vecs[0])); i++) {
+		/* L4 protocol not hashed, addresses only */
+		l_dma.osi_dma.sw_rss.hash_types = OSI_RSS_HASH_IP;
+		hash = test_hash(&vecs[i], 6U, OSI_DISABLE, &type);
+		if ((hash != vecs[i].ip_hash) ||
+		    (type != OSI_RX_PKT_HASH_TYPE_L3)) {
+			printf("FAIL vec %u ip: 0x%08x expected 0x%08x\n", i,
+			       hash, vecs[i].ip_hash);
+			fail++;
+		}
+
+		l_dma.osi_dma.sw_rss.hash_types = OSI_RSS_HASH_ALL;
+		hash = test_hash(&vecs[i], 6U, OSI_DISABLE, &type);
+		if ((hash != vecs[i].tcp_hash) ||
+		    (type != OSI_RX_PKT_HASH_TYPE_L4)) {
+			printf("FAIL vec %u tcp: 0x%08x expected 0x%08x\n", i,
+			       hash, vecs[i].tcp_hash);
+			fail++;
+		}
+
+		/* UDP uses the same input as TCP */
+		hash = test_hash(&vecs[i], 17U, OSI_DISABLE, &type);
+		if (hash != vecs[i].tcp_hash) {
+			printf("FAIL vec %u udp: 0x%08x expected 0x%08x\n", i,
+			       hash, vecs[i].tcp_hash);
+			fail++;
+		}
+	}
+
+	return fail;
+}
+
+/**
+ * @brief test_symmetric - Check both flow directions hash the same.
+ *
+ * Algorithm: Fill the key like rss_profile_config() does for a symmetric
+ *	profile with several seeds, and compare forward and reverse hashes
+ *	of all vectors. Verification suite key must not be symmetric.
+ *
+ * @retval Number of failures
+ */
+static int test_symmetric(void)
+{
+	const nveu16_t seeds[] = { 0x6D5AU, 0x0001U, 0xFFFFU, 0xA5C3U };
+	nveu32_t i, s, k, fwd, rev, type;
+	int fail = 0;
+
+	l_dma.osi_dma.sw_rss.hash_types = OSI_RSS_HASH_ALL;
+	for (s = 0U; s < (nveu32_t)(sizeof(seeds) / sizeof(seeds[0])); s++) {
+		for (k = 0U; k < OSI_RSS_HASH_KEY_SIZE; k += 2U) {
+			l_dma.osi_dma.sw_rss.key[k] = (nveu8_t)(seeds[s] >> 8U);
+			l_dma.osi_dma.sw_rss.key[k + 1U] =
+				(nveu8_t)(seeds[s] & 0xFFU);
+		}
+		sw_rss_build_lut(&l_dma);
+
+		for (i = 0U; i < (nveu32_t)(sizeof(vecs) / sizeof(vecs[0]));
+		     i++) {
+			fwd = test_hash(&vecs[i], 6U, OSI_DISABLE, &type);
+			rev = test_hash(&vecs[i], 6U, OSI_ENABLE, &type);
+			if (fwd != rev) {
+				printf("FAIL seed 0x%04x vec %u: 0x%08x != 0x%08x\n",
+				       seeds[s], i, fwd, rev);
+				fail++;
+			}
+		}
+	}
+
+	memcpy(l_dma.osi_dma.sw_rss.key, ms_key, sizeof(ms_key));
+	sw_rss_build_lut(&l_dma);
+	fwd = test_hash(&vecs[0], 6U, OSI_DISABLE, &type);
+	rev = test_hash(&vecs[0], 6U, OSI_ENABLE, &type);
+	if (fwd == rev) {
+		printf("FAIL verification key hashes symmetric\n");
+		fail++;
+	}
+
+	return fail;
+}
+
+int main(void)
+{
+	int fail = 0;
+
+	fail += test_vectors();
+	fail += test_symmetric();
+	printf("sw_rss_test: %s\n", (fail == 0) ? "PASS" : "FAIL");
+
+	return (fail == 0) ? 0 : 1;
+}